@@ -0,0 +1,152 @@
+/*
+ * URStack Project
+ *
+ *
+ * ActionLog.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in ActionLog.h
+ *
+ * List of public ActionLog class Functions:
+ *      explicit ActionLog(const std::string&)
+ *          Maps the action log at the given path.
+ *
+ *      std::vector<Chunk> findLastLines(std::size_t, unsigned) const
+ *          Splits the last lines of the log into chunks of whole lines.
+ *
+ *      static unsigned getThreads(unsigned)
+ *          Returns the number of threads to parse with.
+ *
+ * List of Functions:
+ *      const char* findPreviousNewLine(const char*, const char*)
+ *          Returns the last new line of a range of bytes.
+ */
+
+#include "ActionLog.h"
+
+#include <algorithm>
+
+
+/* Used std utilities */
+using std::size_t, std::string, std::vector, std::max;
+
+/*
+ * Pre-Conditions:
+ *      Pointer to the first byte of a range.
+ *      Pointer to the byte after the range.
+ *
+ * Post-Conditions:
+ *      Returns a pointer to the last new line of the range,
+ *      nullptr if it has none.
+ *
+ * Returns the last new line of a range of bytes.
+ * memrchr is vectorized where available, a plain loop otherwise.
+ */
+static const char* findPreviousNewLine(const char *begin, const char *end) {
+#ifdef __GLIBC__
+    return static_cast<const char*>(memrchr(begin, '\n', end - begin));
+#else
+    while (end != begin) {
+        if (*--end == '\n') {
+            return end;
+        }
+    }
+
+    return nullptr;
+#endif
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of a readable file.
+ *
+ * Post-Conditions:
+ *      The whole file is mapped read-only, nothing is read yet.
+ *      Throws std::runtime_error if the file cannot be mapped.
+ *
+ * Maps the action log at the given path.
+ */
+ActionLog::ActionLog(const string& path): file{path} {}
+
+/*
+ * Pre-Conditions:
+ *      ActionLog is initialized.
+ *      Maximum number of lines.
+ *      Maximum number of chunks, positive.
+ *
+ * Post-Conditions:
+ *      Returns the chunks of the last N lines of the log (all of them
+ *      if it has fewer), oldest first, in at most the given number of
+ *      chunks of at least kMinChunkLines lines, the oldest chunk
+ *      taking the remainder.
+ *
+ * Splits the last lines of the log into chunks of whole lines.
+ * A single backward pass finds the lines & closes a chunk every
+ * per_chunk lines, so the lines of every chunk are known before
+ * parsing & the threads write their actions in place.
+ */
+vector<ActionLog::Chunk> ActionLog::findLastLines(size_t count,
+                                                  unsigned max_chunks) const {
+    vector<Chunk> chunks;
+    const char *data = file.getData();
+    const size_t length = file.getLength();
+
+    if (count == 0 or length == 0) {
+        return chunks;
+    }
+
+    /* The new line ending the last line does not start another one */
+    const char *end = data + length - (data[length - 1] == '\n');
+    const size_t per_chunk = max(kMinChunkLines,
+                                 count / max_chunks
+                                 + (count % max_chunks != 0));
+    const char *chunk_end = end;
+    const char *line_end = end;
+    size_t chunk_lines = 0;
+
+    for (size_t lines = 1; ; lines++) {
+        const char *found = findPreviousNewLine(data, line_end);
+
+        chunk_lines++;
+
+        if (not found or lines == count or chunk_lines == per_chunk) {
+            chunks.push_back({found ? found + 1 : data, chunk_end,
+                              0, chunk_lines});
+
+            chunk_end = found;
+            chunk_lines = 0;
+        }
+
+        if (not found or lines == count) {
+            break;
+        }
+
+        line_end = found;
+    }
+
+    std::reverse(chunks.begin(), chunks.end());
+
+    for (size_t i = 1; i < chunks.size(); i++) {
+        chunks[i].first = chunks[i - 1].first + chunks[i - 1].lines;
+    }
+
+    return chunks;
+}
+
+/*
+ * Pre-Conditions:
+ *      Requested number of threads, 0 for one per core.
+ *
+ * Post-Conditions:
+ *      Returns the given number, or the number of cores if 0,
+ *      at least 1.
+ *
+ * Returns the number of threads to parse with.
+ * As the WorkerPool parsing the chunks counts them.
+ */
+unsigned ActionLog::getThreads(unsigned threads) {
+    return WorkerPool::resolveThreads(threads);
+}
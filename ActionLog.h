@@ -0,0 +1,299 @@
+/*
+ * URStack Project
+ *
+ *
+ * ActionLog.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the ActionLog class, the importer of action
+ *              logs: text files of one action per line, oldest first,
+ *              the last line with or without a new line.
+ *
+ *              A log is memory-mapped, only its last lines are read:
+ *                  the lines to keep are found from the end of the file,
+ *                  backwards, split into chunks of whole lines on the way,
+ *                  the chunks are parsed in parallel, one thread each
+ *                  (see WorkerPool),
+ *                  into a single vector, oldest first,
+ *                  which is moved into a URStack by insertNewActions.
+ *              Seeding a stack of capacity N from a log of any size
+ *              touches its last N lines only, the earlier ones are never
+ *              read, parsed or handed to the eviction policy.
+ *
+ *              Actions are parsed as by the batch insert command:
+ *              strings take the whole line, numbers are parsed in place,
+ *              other types go through their operator>>.
+ *              Unlike the batch script, empty lines are not skipped: they
+ *              are empty strings, & invalid actions of other types, so a
+ *              log holding a single new line is rejected by a URStack<int>.
+ *
+ * List of public ActionLog class Functions:
+ *      explicit ActionLog(const std::string&)
+ *          Maps the action log at the given path.
+ *
+ *      std::vector<Chunk> findLastLines(std::size_t, unsigned) const
+ *          Splits the last lines of the log into chunks of whole lines.
+ *
+ *      template<class DataType>
+ *      std::vector<DataType> parseLastLines(std::size_t,
+ *                                           unsigned threads = 0) const
+ *          Parses the last lines of the log, in parallel.
+ *
+ *      template<class Stack>
+ *      int importInto(Stack&, unsigned threads = 0) const
+ *          Inserts the last lines of the log that fit in a URStack.
+ *
+ *      inline std::size_t getLength() const
+ *          Returns the number of bytes in the log.
+ *
+ *      static unsigned getThreads(unsigned)
+ *          Returns the number of threads to parse with.
+ *
+ * List of private ActionLog class Functions:
+ *      template<class DataType>
+ *      static void parseChunk(const Chunk&, DataType*)
+ *          Parses the lines of a chunk.
+ *
+ *      template<class DataType>
+ *      static void parseLine(std::string_view, DataType&)
+ *          Parses a single line as an action.
+ */
+
+#ifndef URSTACK_ACTIONLOG_H
+#define URSTACK_ACTIONLOG_H
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "CommonIO.h"
+#include "MappedFile.h"
+#include "WorkerPool.h"
+
+
+/*
+ * Read-only, move-only view of an action log, imported in parallel.
+ * Every line is an action, empty lines included, so only string logs
+ * may hold empty lines, other types reject them as invalid actions.
+ */
+class ActionLog {
+public:
+    /*
+     * Lines parsed by a thread at least, fewer are not worth one.
+     */
+    static constexpr std::size_t kMinChunkLines = 4096;
+
+    /*
+     * Whole lines of the log, parsed by a single thread.
+     */
+    struct Chunk {
+        /* First byte of the oldest line */
+        const char *begin;
+
+        /* Byte after the newest line, its new line if any */
+        const char *end;
+
+        /* Index of the oldest line in the parsed vector */
+        std::size_t first;
+
+        /* Number of lines */
+        std::size_t lines;
+    };
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the path of a readable file.
+     *
+     * Post-Conditions:
+     *      The whole file is mapped read-only, nothing is read yet.
+     *      Throws std::runtime_error if the file cannot be mapped.
+     *
+     * Maps the action log at the given path.
+     */
+    explicit ActionLog(const std::string&);
+
+    /*
+     * Pre-Conditions:
+     *      ActionLog is initialized.
+     *      Maximum number of lines.
+     *      Maximum number of chunks, positive.
+     *
+     * Post-Conditions:
+     *      Returns the chunks of the last N lines of the log (all of them
+     *      if it has fewer), oldest first, in at most the given number of
+     *      chunks of at least kMinChunkLines lines, the oldest chunk
+     *      taking the remainder.
+     *
+     * Splits the last lines of the log into chunks of whole lines.
+     * Only the bytes of the returned lines are read.
+     */
+    [[nodiscard]] std::vector<Chunk> findLastLines(std::size_t,
+                                                   unsigned) const;
+
+    /*
+     * Pre-Conditions:
+     *      ActionLog is initialized.
+     *      Maximum number of lines.
+     *      Number of threads (optional, default 0, one per core).
+     *      DataType must be default constructible & either a string,
+     *      arithmetic or have operator>>(istream&, DataType&) defined.
+     *
+     * Post-Conditions:
+     *      Returns the actions of the last N lines of the log, oldest
+     *      first.
+     *      Throws std::invalid_argument if a line is not an action,
+     *      std::system_error if a thread cannot be started.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `log.parseLastLines<int>(20);`.
+     * Parses the last lines of the log, in parallel.
+     * Every chunk is parsed by a thread of a WorkerPool, the calling one
+     * included, writing its own part of the vector.
+     */
+    template<class DataType>
+    [[nodiscard]] std::vector<DataType> parseLastLines(
+            std::size_t count, unsigned threads = 0) const {
+        const std::vector<Chunk> chunks = findLastLines(count,
+                                                        getThreads(threads));
+        std::vector<DataType> actions(chunks.empty()
+                                      ? 0 : chunks.back().first
+                                            + chunks.back().lines);
+
+        if (chunks.empty()) {
+            return actions;
+        }
+
+        WorkerPool pool{static_cast<unsigned>(chunks.size())};
+
+        /* The oldest error first, as a sequential import would report */
+        pool.run(chunks.size(), [&](std::size_t i) {
+            parseChunk(chunks[i], actions.data() + chunks[i].first);
+        });
+
+        return actions;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      ActionLog is initialized.
+     *      Reference to a URStack<DataType, ...>.
+     *      Number of threads (optional, default 0, one per core).
+     *
+     * Post-Conditions:
+     *      The last lines of the log that fit in the stack's capacity are
+     *      inserted, oldest first, as by insertNewActions.
+     *      Returns the number of inserted actions.
+     *      Throws std::invalid_argument if a line is not an action
+     *      (empty lines of non-string types included),
+     *      with the stack unchanged.
+     *
+     * Inserts the last lines of the log that fit in a URStack.
+     * Parsing completes before the stack is modified.
+     */
+    template<class Stack>
+    int importInto(Stack& stack, unsigned threads = 0) const {
+        typedef std::remove_pointer_t<decltype(stack.peek())> DataType;
+
+        std::vector<DataType> actions = parseLastLines<DataType>(
+                static_cast<std::size_t>(stack.getCapacity()), threads);
+
+        return stack.insertNewActions(actions.begin(), actions.end());
+    }
+
+    /*
+     * Pre-Conditions:
+     *      ActionLog is initialized.
+     *
+     * Post-Conditions:
+     *      Number of bytes in the log is returned.
+     *
+     * Returns the number of bytes in the log.
+     */
+    [[nodiscard]] inline std::size_t getLength() const {
+        return file.getLength();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Requested number of threads, 0 for one per core.
+     *
+     * Post-Conditions:
+     *      Returns the given number, or the number of cores if 0,
+     *      at least 1.
+     *
+     * Returns the number of threads to parse with.
+     */
+    [[nodiscard]] static unsigned getThreads(unsigned);
+
+private:
+    /*
+     * Mapping of the whole log.
+     */
+    MappedFile file;
+
+    /*
+     * Pre-Conditions:
+     *      const reference to a chunk of the log.
+     *      Pointer to chunk.lines default constructed actions.
+     *
+     * Post-Conditions:
+     *      The lines of the chunk are parsed into the actions, in order.
+     *      Throws std::invalid_argument if a line is not an action.
+     *
+     * Parses the lines of a chunk.
+     */
+    template<class DataType>
+    static void parseChunk(const Chunk& chunk, DataType *actions) {
+        const char *line = chunk.begin;
+
+        for (std::size_t i = 0; i < chunk.lines; i++) {
+            const char *found = static_cast<const char*>(
+                    std::memchr(line, '\n', chunk.end - line));
+            const char *line_end = found ? found : chunk.end;
+
+            parseLine(std::string_view(line, line_end - line), actions[i]);
+            line = line_end + 1;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      A line of the log, without its new line.
+     *      Reference to the parsed action.
+     *
+     * Post-Conditions:
+     *      The action is parsed into the given reference.
+     *      Throws std::invalid_argument if the line is not an action,
+     *      as an empty line of a non-string type.
+     *
+     * Parses a single line as an action.
+     */
+    template<class DataType>
+    static void parseLine(std::string_view line, DataType& action) {
+        if constexpr (std::is_same_v<DataType, std::string>) {
+            action.assign(line);
+        } else if constexpr (std::is_arithmetic_v<DataType>
+                             and not std::is_same_v<DataType, bool>) {
+            if (parseNumber(line, action) != ParseStatus::kOk) {
+                throw std::invalid_argument("\nInvalid action in log.\n");
+            }
+        } else {
+            std::istringstream parser{std::string{line}};
+
+            /* use operator>> defined in DataType */
+            if (not (parser >> action)) {
+                throw std::invalid_argument("\nInvalid action in log.\n");
+            }
+        }
+    }
+};
+
+#endif //URSTACK_ACTIONLOG_H
@@ -0,0 +1,558 @@
+/*
+ * URStack Project
+ *
+ *
+ * ArenaStringStack.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in ArenaStringStack.h
+ *
+ * List of public ArenaStringStack class Functions:
+ *      explicit ArenaStringStack(int capacity = 20,
+ *                                std::size_t chunk_bytes = kChunkBytes)
+ *          Parameterized/Default constructor of the ArenaStringStack class.
+ *
+ *      void insertNewAction(std::string_view)
+ *          Inserts a new action on top of the stack.
+ *
+ *      bool undo()
+ *          Undo the latest action in the stack.
+ *
+ *      bool redo()
+ *          Redo the latest undone action in the stack.
+ *
+ *      std::string_view peek() const
+ *          Returns the latest action in the stack, without undoing it.
+ *
+ *      std::string_view operator[](int) const
+ *          Returns the action N-hops away from top.
+ *
+ *      int findLastContaining(std::string_view) const
+ *          Returns the position of the newest action that can be undone
+ *          containing a substring.
+ *
+ *      OutputSink& displayAll(OutputSink&) const
+ *          Displays all actions in the stack to a sink.
+ *
+ *      OutputSink& displayPrevious(OutputSink&) const
+ *          Displays all existing actions in the stack to a sink.
+ *
+ *      OutputSink& displayNext(OutputSink&) const
+ *          Displays all deleted actions in the stack to a sink.
+ *
+ *      MemoryUsage memoryUsage() const
+ *          Returns the memory owned by the stack.
+ *
+ * List of private ArenaStringStack class Functions:
+ *      std::string_view view(const Slot&) const
+ *          Returns the characters of an action.
+ *
+ *      const char* allocate(std::string_view)
+ *          Copies the characters of a long action into the arena.
+ *
+ *      void release(const Slot&, bool newest)
+ *          Gives the characters of a long action back to the arena.
+ *
+ *      void retire(Chunk&&)
+ *          Keeps a chunk without actions for reuse, or frees it.
+ *
+ *      void grow()
+ *          Doubles the number of slots, keeping the actions in order.
+ *
+ *      OutputSink& displayRange(int from, int to, OutputSink&,
+ *                               bool reverse) const
+ *          Displays the actions in a range of slots.
+ */
+
+#include "ArenaStringStack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "StringSearch.h"
+
+
+/* Used std utilities */
+using std::size_t, std::string_view, std::invalid_argument,
+        std::out_of_range, std::length_error, std::memcpy;
+
+/*
+ * Pre-Conditions:
+ *      Maximum number of actions in the stack
+ *      (optional, default 20).
+ *      Size of an arena chunk (optional, default kChunkBytes).
+ *
+ * Post-Conditions:
+ *      An empty stack is created, nothing is allocated.
+ *      Throws std::invalid_argument if the capacity or the chunk size
+ *      is not positive.
+ *
+ * Parameterized/Default constructor of the ArenaStringStack class.
+ */
+ArenaStringStack::ArenaStringStack(int capacity, size_t chunk_bytes):
+        spare{nullptr, 0, 0, 0}, chunk_bytes{chunk_bytes}, first{0},
+        capacity{capacity}, length{0}, size{0} {
+    if (capacity <= 0) {
+        throw invalid_argument("\nCapacity must be a positive integer.\n");
+    }
+
+    if (chunk_bytes == 0) {
+        throw invalid_argument("\nChunk size must be a positive integer.\n");
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *      Characters of the action, at most 4 GiB.
+ *
+ * Post-Conditions:
+ *      The undone actions are discarded, the action is copied on top
+ *      & is the latest action. If the stack was full, the oldest
+ *      action is evicted.
+ *      Throws std::length_error if the action is too long,
+ *      std::bad_alloc if out of memory, with the undone actions
+ *      already discarded.
+ *
+ * Inserts a new action on top of the stack.
+ * Discarding before copying lets the copy reuse the characters of the
+ * discarded actions, the newest of the arena.
+ */
+void ArenaStringStack::insertNewAction(string_view action) {
+    if (action.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw length_error("\nAction too long.\n");
+    }
+
+    /* Newest first, so every one is the newest of the arena */
+    for (; length > size; length--) {
+        release(slotAt(length - 1), true);
+    }
+
+    if (size == capacity) {
+        release(slotAt(0), false);
+        first = (first + 1) & (slots.size() - 1);
+        length--;
+        size--;
+    }
+
+    if (static_cast<size_t>(length) == slots.size()) {
+        grow();
+    }
+
+    Slot& slot = slots[(first + length) & (slots.size() - 1)];
+
+    slot.length = static_cast<std::uint32_t>(action.size());
+
+    if (action.size() <= kInlineBytes) {
+        memcpy(slot.bytes, action.data(), action.size());
+    } else {
+        const char *characters = allocate(action);
+
+        memcpy(slot.bytes, &characters, sizeof(characters));
+    }
+
+    size = ++length;
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *
+ * Post-Conditions:
+ *      The latest action is undone (if possible).
+ *      Returns false if there was no action to undo.
+ *
+ * Undo the latest action in the stack.
+ */
+bool ArenaStringStack::undo() {
+    if (size == 0) {
+        return false;
+    }
+
+    size--;
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *
+ * Post-Conditions:
+ *      The latest undone action is redone (if possible).
+ *      Returns false if there was no action to redo.
+ *
+ * Redo the latest undone action in the stack.
+ */
+bool ArenaStringStack::redo() {
+    if (size == length) {
+        return false;
+    }
+
+    size++;
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *
+ * Post-Conditions:
+ *      Returns the latest action.
+ *      Throws std::out_of_range if there are no actions to undo.
+ *
+ * Returns the latest action in the stack, without undoing it.
+ */
+string_view ArenaStringStack::peek() const {
+    if (size == 0) {
+        throw out_of_range("\nNo previous actions.\n");
+    }
+
+    return view(slotAt(size - 1));
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *      Number of hops from top, less than getLength().
+ *
+ * Post-Conditions:
+ *      Returns the action N-hops away from top, undone or not.
+ *      Throws std::out_of_range if there is no action there.
+ *
+ * Returns the action N-hops away from top.
+ */
+string_view ArenaStringStack::operator[](int position) const {
+    if (position < 0 or position >= length) {
+        throw out_of_range("\nPosition out of range.\n");
+    }
+
+    return view(slotAt(length - 1 - position));
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *      Text to search for.
+ *
+ * Post-Conditions:
+ *      Returns the number of undos from current to the newest action
+ *      that can be undone & contains the text, 0 for current,
+ *      or -1 if there is none. Every action contains an empty text.
+ *
+ * Returns the position of the newest action that can be undone
+ * containing a substring.
+ * Same search as URStack::findLastContaining, over consecutive slots.
+ */
+int ArenaStringStack::findLastContaining(string_view text) const {
+    const SearchKernel kernel = getSearchKernel();
+
+    for (int index = size - 1; index >= 0; index--) {
+        if (findSubstring(view(slotAt(index)), text, kernel)
+            != string_view::npos) {
+            return size - 1 - index;
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays all actions to the given sink, newest first,
+ *      as URStack::displayAll.
+ *      Returns reference to the sink.
+ *
+ * Displays all actions in the stack to a sink.
+ */
+OutputSink& ArenaStringStack::displayAll(OutputSink& out) const {
+    if (length == 0) {
+        /* There are truly no actions */
+        return out.invalid("No actions");
+    }
+
+    return displayRange(length - 1, -1, out, false);
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays the actions that can be undone to the given sink,
+ *      newest first, as URStack::displayPrevious.
+ *      Returns reference to the sink.
+ *
+ * Displays all existing actions in the stack to a sink.
+ */
+OutputSink& ArenaStringStack::displayPrevious(OutputSink& out) const {
+    if (size == 0) {
+        /* No actions to undo */
+        return out.data("No previous actions");
+    }
+
+    return displayRange(size - 1, -1, out, false);
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays the actions that can be redone to the given sink,
+ *      next redo first, as URStack::displayNext.
+ *      Returns reference to the sink.
+ *
+ * Displays all deleted actions in the stack to a sink.
+ */
+OutputSink& ArenaStringStack::displayNext(OutputSink& out) const {
+    if (size == length) {
+        /* No undone actions */
+        return out.data("No next actions");
+    }
+
+    return displayRange(length - 1, size - 1, out, true);
+}
+
+/*
+ * Pre-Conditions:
+ *      ArenaStringStack is initialized.
+ *
+ * Post-Conditions:
+ *      Returns the memory owned by the stack, in the fields of
+ *      URStack::memoryUsage: slots as nodes, the used bytes of the
+ *      arena as payload, its unused bytes & the spare chunk as pooled.
+ *
+ * Returns the memory owned by the stack.
+ * Empty slots of the ring are counted as pooled as well.
+ */
+MemoryUsage ArenaStringStack::memoryUsage() const {
+    MemoryUsage usage;
+
+    usage.object_bytes = sizeof(ArenaStringStack);
+    usage.nodes = static_cast<size_t>(length);
+    usage.node_bytes = usage.nodes * sizeof(Slot);
+    usage.redo_nodes = static_cast<size_t>(length - size);
+    usage.redo_bytes = usage.redo_nodes * sizeof(Slot);
+    usage.pooled_bytes = (slots.size() - usage.nodes) * sizeof(Slot)
+                         + spare.capacity;
+
+    for (int index = size; index < length; index++) {
+        if (slotAt(index).length > kInlineBytes) {
+            usage.redo_bytes += slotAt(index).length;
+        }
+    }
+
+    for (const Chunk& chunk: chunks) {
+        usage.payload_bytes += chunk.used;
+        usage.pooled_bytes += chunk.capacity - chunk.used;
+    }
+
+    return usage;
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to a held slot.
+ *
+ * Post-Conditions:
+ *      Returns a view of its characters.
+ */
+string_view ArenaStringStack::view(const Slot& slot) const {
+    if (slot.length <= kInlineBytes) {
+        return {slot.bytes, slot.length};
+    }
+
+    const char *characters;
+
+    memcpy(&characters, slot.bytes, sizeof(characters));
+
+    return {characters, slot.length};
+}
+
+/*
+ * Pre-Conditions:
+ *      Characters of a long action.
+ *
+ * Post-Conditions:
+ *      Returns the address of their copy, at the end of the arena.
+ *      Throws std::bad_alloc if out of memory.
+ *
+ * Copies the characters of a long action into the arena.
+ * A new chunk is started when the newest one is full, from the spare
+ * if it is large enough. Actions longer than a chunk get their own.
+ */
+const char* ArenaStringStack::allocate(string_view action) {
+    if (chunks.empty()
+        or chunks.back().capacity - chunks.back().used < action.size()) {
+        const size_t bytes = std::max(chunk_bytes, action.size());
+
+        /* Emptied by discards, every chunk but the newest holds actions */
+        if (not chunks.empty() and chunks.back().live == 0) {
+            retire(std::move(chunks.back()));
+            chunks.pop_back();
+        }
+
+        if (spare.capacity >= bytes) {
+            chunks.push_back(std::move(spare));
+            spare = {nullptr, 0, 0, 0};
+        } else {
+            chunks.push_back({std::make_unique<char[]>(bytes), bytes, 0, 0});
+        }
+    }
+
+    Chunk& chunk = chunks.back();
+    char *characters = chunk.bytes.get() + chunk.used;
+
+    memcpy(characters, action.data(), action.size());
+    chunk.used += action.size();
+    chunk.live++;
+
+    return characters;
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the slot of a held action,
+ *      either the oldest or the newest.
+ *      Whether it is the newest.
+ *
+ * Post-Conditions:
+ *      If the action is long, its characters are given back: the
+ *      newest chunk's bump pointer is moved back for the newest
+ *      action, a chunk left without actions is freed.
+ *
+ * Gives the characters of a long action back to the arena.
+ * Every chunk but the newest holds at least one action, so the
+ * oldest action is in the first chunk, & the newest in the last one
+ * holding any.
+ * A freed chunk of the default size is kept as the spare.
+ */
+void ArenaStringStack::release(const Slot& slot, bool newest) {
+    if (slot.length <= kInlineBytes) {
+        return;
+    }
+
+    if (newest) {
+        if (chunks.back().live == 0 and chunks.size() > 1) {
+            retire(std::move(chunks.back()));
+            chunks.pop_back();
+        }
+
+        Chunk& chunk = chunks.back();
+
+        chunk.used = static_cast<size_t>(view(slot).data()
+                                         - chunk.bytes.get());
+        chunk.live--;
+    } else {
+        Chunk& chunk = chunks.front();
+
+        if (--chunk.live) {
+            return;
+        }
+
+        if (chunks.size() == 1) {
+            /* Nothing left in the arena, reuse the chunk from its start */
+            chunk.used = 0;
+        } else {
+            retire(std::move(chunk));
+            chunks.pop_front();
+        }
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      rvalue reference to a chunk holding no action.
+ *
+ * Post-Conditions:
+ *      The chunk is the spare if it has the default size,
+ *      otherwise it is freed when the caller drops it.
+ *
+ * Keeps a chunk without actions for reuse, or frees it.
+ */
+void ArenaStringStack::retire(Chunk&& chunk) {
+    if (chunk.capacity == chunk_bytes) {
+        spare = std::move(chunk);
+        spare.used = spare.live = 0;
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      The number of slots is doubled, at least 16.
+ *      The actions are moved to the first slots, oldest first.
+ *
+ * Doubles the number of slots, keeping the actions in order.
+ * Slots are only added as actions are, up to the capacity.
+ */
+void ArenaStringStack::grow() {
+    std::vector<Slot> moved(std::max<size_t>(16, 2 * slots.size()));
+
+    for (int index = 0; index < length; index++) {
+        moved[index] = slotAt(index);
+    }
+
+    slots = std::move(moved);
+    first = 0;
+}
+
+/*
+ * Pre-Conditions:
+ *      Index of the newest action to display, from the oldest.
+ *      Index before the oldest action to display, may be -1.
+ *      OutputSink reference to display the output.
+ *      Whether the oldest action is displayed first.
+ *
+ * Post-Conditions:
+ *      Displays the actions separated by ", ".
+ *      Returns reference to the sink.
+ *
+ * Displays the actions in a range of slots.
+ * Same output as URStack::displayDirectional, the slots are walked in
+ * either direction, without collecting them first.
+ */
+OutputSink& ArenaStringStack::displayRange(int from, int to,
+                                           OutputSink& out,
+                                           bool reverse) const {
+    /* Separator between actions in the output */
+    static constexpr string_view kSep = ", ";
+
+    out.beginData();
+
+    if (reverse) {
+        for (int index = to + 1; index <= from; index++) {
+            out << view(slotAt(index));
+
+            if (index != from) {
+                out << kSep;
+            }
+        }
+    } else {
+        for (int index = from; index > to; index--) {
+            out << view(slotAt(index));
+
+            if (index - 1 != to) {
+                out << kSep;
+            }
+        }
+    }
+
+    return out.endColour();
+}
@@ -0,0 +1,471 @@
+/*
+ * URStack Project
+ *
+ *
+ * ArenaStringStack.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the ArenaStringStack class, an undo/redo stack
+ *              of string actions with the behaviour of URStack<std::string>,
+ *              stored for traversal rather than as a chain of Nodes.
+ *
+ *              Every action takes a 24 byte slot of a single ring, oldest
+ *              first. Actions of up to kInlineBytes characters are stored
+ *              in the slot, longer ones in chunks of a bump arena owned by
+ *              the stack, in insertion order:
+ *                  an insert appends to the newest chunk,
+ *                  discarded actions are the newest, so their characters
+ *                  are taken back by moving the bump pointer back,
+ *                  evicted actions are the oldest, so a chunk is freed
+ *                  wholesale once its last action is evicted.
+ *              Walking the history reads consecutive slots, & the
+ *              characters of consecutive long actions are consecutive,
+ *              instead of two scattered allocations per action.
+ *
+ *              Actions are handed out as std::string_view, valid until
+ *              the action is evicted or discarded.
+ *
+ * List of public ArenaStringStack class Functions:
+ *      explicit ArenaStringStack(int capacity = 20,
+ *                                std::size_t chunk_bytes = kChunkBytes)
+ *          Parameterized/Default constructor of the ArenaStringStack class.
+ *
+ *      void insertNewAction(std::string_view)
+ *          Inserts a new action on top of the stack.
+ *
+ *      bool undo()
+ *          Undo the latest action in the stack.
+ *
+ *      bool redo()
+ *          Redo the latest undone action in the stack.
+ *
+ *      std::string_view peek() const
+ *          Returns the latest action in the stack, without undoing it.
+ *
+ *      std::string_view operator[](int) const
+ *          Returns the action N-hops away from top.
+ *
+ *      template<class Visitor>
+ *      int visitPrevious(Visitor&&) const
+ *          Visits every action that can be undone, newest first.
+ *
+ *      int findLastContaining(std::string_view) const
+ *          Returns the position of the newest action that can be undone
+ *          containing a substring.
+ *
+ *      OutputSink& displayAll(OutputSink&) const
+ *          Displays all actions in the stack to a sink.
+ *
+ *      OutputSink& displayPrevious(OutputSink&) const
+ *          Displays all existing actions in the stack to a sink.
+ *
+ *      OutputSink& displayNext(OutputSink&) const
+ *          Displays all deleted actions in the stack to a sink.
+ *
+ *      inline int getSize() const
+ *          Returns the number of actions in the stack.
+ *
+ *      inline int getCapacity() const
+ *          Returns the capacity of the stack.
+ *
+ *      inline int getLength() const
+ *          Returns the number of held actions, undone ones included.
+ *
+ *      MemoryUsage memoryUsage() const
+ *          Returns the memory owned by the stack.
+ *
+ * List of private ArenaStringStack class Functions:
+ *      std::string_view view(const Slot&) const
+ *          Returns the characters of an action.
+ *
+ *      inline const Slot& slotAt(int) const
+ *          Returns the slot of an action, counted from the oldest.
+ *
+ *      const char* allocate(std::string_view)
+ *          Copies the characters of a long action into the arena.
+ *
+ *      void release(const Slot&, bool newest)
+ *          Gives the characters of a long action back to the arena.
+ *
+ *      void retire(Chunk&&)
+ *          Keeps a chunk without actions for reuse, or frees it.
+ *
+ *      void grow()
+ *          Doubles the number of slots, keeping the actions in order.
+ *
+ *      OutputSink& displayRange(int from, int to, OutputSink&,
+ *                               bool reverse) const
+ *          Displays the actions in a range of slots.
+ */
+
+#ifndef URSTACK_ARENASTRINGSTACK_H
+#define URSTACK_ARENASTRINGSTACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "OutputSink.h"
+#include "URStackMemory.h"
+
+
+class ArenaStringStack {
+public:
+    /* Longest action stored in its slot */
+    static constexpr std::size_t kInlineBytes = 20;
+
+    /* Default size of an arena chunk */
+    static constexpr std::size_t kChunkBytes = 64 * 1024;
+
+    /*
+     * Pre-Conditions:
+     *      Maximum number of actions in the stack
+     *      (optional, default 20).
+     *      Size of an arena chunk (optional, default kChunkBytes).
+     *
+     * Post-Conditions:
+     *      An empty stack is created, nothing is allocated.
+     *      Throws std::invalid_argument if the capacity or the chunk size
+     *      is not positive.
+     *
+     * Parameterized/Default constructor of the ArenaStringStack class.
+     */
+    explicit ArenaStringStack(int capacity = 20,
+                              std::size_t chunk_bytes = kChunkBytes);
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *      Characters of the action, at most 4 GiB.
+     *
+     * Post-Conditions:
+     *      The undone actions are discarded, the action is copied on top
+     *      & is the latest action. If the stack was full, the oldest
+     *      action is evicted.
+     *      Throws std::length_error if the action is too long,
+     *      std::bad_alloc if out of memory, with the undone actions
+     *      already discarded.
+     *
+     * Inserts a new action on top of the stack.
+     * O(1), plus the copy of the characters.
+     */
+    void insertNewAction(std::string_view);
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *
+     * Post-Conditions:
+     *      The latest action is undone (if possible).
+     *      Returns false if there was no action to undo.
+     *
+     * Undo the latest action in the stack.
+     */
+    bool undo();
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *
+     * Post-Conditions:
+     *      The latest undone action is redone (if possible).
+     *      Returns false if there was no action to redo.
+     *
+     * Redo the latest undone action in the stack.
+     */
+    bool redo();
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the latest action.
+     *      Throws std::out_of_range if there are no actions to undo.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `stack.peek();`.
+     * Returns the latest action in the stack, without undoing it.
+     */
+    [[nodiscard]] std::string_view peek() const;
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *      Number of hops from top, less than getLength().
+     *
+     * Post-Conditions:
+     *      Returns the action N-hops away from top, undone or not.
+     *      Throws std::out_of_range if there is no action there.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `stack[5];`.
+     * Returns the action N-hops away from top.
+     */
+    [[nodiscard]] std::string_view operator[](int) const;
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *      Callable taking a std::string_view.
+     *
+     * Post-Conditions:
+     *      The callable is invoked with every action that can be undone,
+     *      newest first. The stack is not modified.
+     *      Returns the number of visited actions.
+     *
+     * Visits every action that can be undone, newest first.
+     */
+    template<class Visitor>
+    int visitPrevious(Visitor&& visit) const {
+        for (int index = size - 1; index >= 0; index--) {
+            visit(view(slotAt(index)));
+        }
+
+        return size;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *      Text to search for.
+     *
+     * Post-Conditions:
+     *      Returns the number of undos from current to the newest action
+     *      that can be undone & contains the text, 0 for current,
+     *      or -1 if there is none. Every action contains an empty text.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `stack.findLastContaining("text");`.
+     * Returns the position of the newest action that can be undone
+     * containing a substring.
+     */
+    [[nodiscard]] int findLastContaining(std::string_view) const;
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Displays all actions to the given sink, newest first,
+     *      as URStack::displayAll.
+     *      Returns reference to the sink.
+     *
+     * Displays all actions in the stack to a sink.
+     */
+    OutputSink& displayAll(OutputSink&) const;
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Displays the actions that can be undone to the given sink,
+     *      newest first, as URStack::displayPrevious.
+     *      Returns reference to the sink.
+     *
+     * Displays all existing actions in the stack to a sink.
+     */
+    OutputSink& displayPrevious(OutputSink&) const;
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Displays the actions that can be redone to the given sink,
+     *      next redo first, as URStack::displayNext.
+     *      Returns reference to the sink.
+     *
+     * Displays all deleted actions in the stack to a sink.
+     */
+    OutputSink& displayNext(OutputSink&) const;
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of actions that can be undone.
+     */
+    [[nodiscard]] inline int getSize() const {
+        return size;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the maximum number of actions.
+     */
+    [[nodiscard]] inline int getCapacity() const {
+        return capacity;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of held actions, undone ones included.
+     */
+    [[nodiscard]] inline int getLength() const {
+        return length;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      ArenaStringStack is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the memory owned by the stack, in the fields of
+     *      URStack::memoryUsage: slots as nodes, the used bytes of the
+     *      arena as payload, its unused bytes & the spare chunk as pooled.
+     *
+     * Returns the memory owned by the stack.
+     */
+    [[nodiscard]] MemoryUsage memoryUsage() const;
+
+private:
+    /*
+     * Storage of a single action.
+     * The characters are in bytes if length <= kInlineBytes, otherwise
+     * bytes starts with the address of the characters in the arena.
+     */
+    struct Slot {
+        std::uint32_t length;
+        char bytes[kInlineBytes];
+    };
+
+    /*
+     * Block of the arena, the characters of consecutive long actions.
+     */
+    struct Chunk {
+        std::unique_ptr<char[]> bytes;
+        std::size_t capacity;
+        std::size_t used;
+
+        /* Long actions held in the chunk */
+        std::size_t live;
+    };
+
+    /* Ring of a power of 2 slots, oldest first from first */
+    std::vector<Slot> slots;
+
+    /* Chunks of the arena, oldest first */
+    std::deque<Chunk> chunks;
+
+    /* Freed chunk of chunk_bytes, reused by the next chunk */
+    Chunk spare;
+
+    std::size_t chunk_bytes;
+
+    std::size_t first;
+
+    int capacity;
+
+    /* Held actions, undone ones included */
+    int length;
+
+    /* The oldest applied actions, all the others are undone */
+    int size;
+
+    /*
+     * Pre-Conditions:
+     *      const reference to a held slot.
+     *
+     * Post-Conditions:
+     *      Returns a view of its characters.
+     */
+    [[nodiscard]] std::string_view view(const Slot&) const;
+
+    /*
+     * Pre-Conditions:
+     *      Index of a held action, from the oldest.
+     *
+     * Post-Conditions:
+     *      Returns its slot.
+     */
+    [[nodiscard]] inline const Slot& slotAt(int index) const {
+        return slots[(first + index) & (slots.size() - 1)];
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Characters of a long action.
+     *
+     * Post-Conditions:
+     *      Returns the address of their copy, at the end of the arena.
+     *      Throws std::bad_alloc if out of memory.
+     *
+     * Copies the characters of a long action into the arena.
+     */
+    const char* allocate(std::string_view);
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the slot of a held action,
+     *      either the oldest or the newest.
+     *      Whether it is the newest.
+     *
+     * Post-Conditions:
+     *      If the action is long, its characters are given back: the
+     *      newest chunk's bump pointer is moved back for the newest
+     *      action, a chunk left without actions is freed.
+     *
+     * Gives the characters of a long action back to the arena.
+     */
+    void release(const Slot&, bool newest);
+
+    /*
+     * Pre-Conditions:
+     *      rvalue reference to a chunk holding no action.
+     *
+     * Post-Conditions:
+     *      The chunk is the spare if it has the default size,
+     *      otherwise it is freed when the caller drops it.
+     *
+     * Keeps a chunk without actions for reuse, or frees it.
+     */
+    void retire(Chunk&&);
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      The number of slots is doubled, at least 16.
+     *      The actions are moved to the first slots, oldest first.
+     *
+     * Doubles the number of slots, keeping the actions in order.
+     */
+    void grow();
+
+    /*
+     * Pre-Conditions:
+     *      Index of the newest action to display, from the oldest.
+     *      Index before the oldest action to display, may be -1.
+     *      OutputSink reference to display the output.
+     *      Whether the oldest action is displayed first.
+     *
+     * Post-Conditions:
+     *      Displays the actions separated by ", ".
+     *      Returns reference to the sink.
+     *
+     * Displays the actions in a range of slots.
+     */
+    OutputSink& displayRange(int from, int to, OutputSink&,
+                             bool reverse) const;
+};
+
+#endif //URSTACK_ARENASTRINGSTACK_H
@@ -0,0 +1,383 @@
+/*
+ * URStack Project
+ *
+ *
+ * CommandEngine.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in CommandEngine.h
+ *
+ * List of public Command<State> class Functions:
+ *      template<class Apply, class Revert>
+ *      Command(Apply, Revert)
+ *          Constructs a command from the given apply & revert callables.
+ *
+ *      ~Command()
+ *          Destructor for the Command class.
+ *
+ * List of private Command<State> class Functions:
+ *      void relocateFrom(Command&) noexcept
+ *          Takes over the callables of another command.
+ *
+ *      void reset() noexcept
+ *          Destroys the callables.
+ *
+ * List of public CommandEngine<State> class Functions:
+ *      explicit CommandEngine(State, int capacity = 20)
+ *          Parameterized/Default constructor of the CommandEngine class.
+ *
+ *      template<class Apply, class Revert>
+ *      void execute(Apply&&, Revert&&)
+ *          Applies a new command & records it.
+ *
+ *      void execute(Command<State>&&)
+ *          Applies the given command & records it.
+ *
+ *      template<class Iterator>
+ *      int executeBatch(Iterator, Iterator)
+ *          Applies a range of commands & records all of them.
+ *
+ *      bool undo()
+ *          Reverts the latest command.
+ *
+ *      bool redo()
+ *          Applies the latest reverted command again.
+ *
+ *      int undo(int)
+ *          Reverts up to N commands.
+ *
+ *      int redo(int)
+ *          Applies up to N reverted commands again.
+ */
+
+#ifndef URSTACK_COMMANDENGINE_CPP
+#define URSTACK_COMMANDENGINE_CPP
+
+#include <cstring>
+#include <new>
+
+#include "CommandEngine.h"
+#include "URStack.cpp"
+
+
+/*
+ * Pre-Conditions:
+ *      Callable taking a State& reference, applying the command.
+ *      Callable taking a State& reference, reverting the command.
+ *
+ * Post-Conditions:
+ *      A Command instance owning both callables is created.
+ *
+ * Constructs a command from the given apply & revert callables.
+ * The invokers are captureless lambdas converted to function pointers,
+ * one pair per callables type & storage kind.
+ */
+template<class State>
+template<class Apply, class Revert, class>
+Command<State>::Command(Apply&& apply, Revert&& revert) {
+    typedef Callables<std::decay_t<Apply>, std::decay_t<Revert>> Stored;
+
+    if constexpr (fitsInline<Stored>()) {
+        new (storage) Stored{std::forward<Apply>(apply),
+                             std::forward<Revert>(revert)};
+
+        applier = [](void *callables, State& state) {
+            static_cast<Stored*>(callables)->apply(state);
+        };
+        reverter = [](void *callables, State& state) {
+            static_cast<Stored*>(callables)->revert(state);
+        };
+
+        if constexpr (std::is_trivially_copyable_v<Stored>) {
+            manager = nullptr;
+        } else {
+            manager = [](void *source, void *destination) {
+                auto *stored = static_cast<Stored*>(source);
+
+                if (destination) {
+                    new (destination) Stored{std::move(*stored)};
+                }
+
+                stored->~Stored();
+            };
+        }
+    } else {
+        auto *stored = new Stored{std::forward<Apply>(apply),
+                                  std::forward<Revert>(revert)};
+
+        std::memcpy(storage, &stored, sizeof(stored));
+
+        applier = [](void *callables, State& state) {
+            (*static_cast<Stored**>(callables))->apply(state);
+        };
+        reverter = [](void *callables, State& state) {
+            (*static_cast<Stored**>(callables))->revert(state);
+        };
+        manager = [](void *source, void *destination) {
+            /* The pointer is relocated, the callables never move */
+            if (destination) {
+                std::memcpy(destination, source, sizeof(Stored*));
+            } else {
+                delete *static_cast<Stored**>(source);
+            }
+        };
+    }
+}
+
+template<class State>
+Command<State>::Command(Command&& other) noexcept {
+    relocateFrom(other);
+}
+
+template<class State>
+Command<State>& Command<State>::operator=(Command&& other) noexcept {
+    if (this != &other) {
+        reset();
+        relocateFrom(other);
+    }
+
+    return *this;
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` Command instance is not destroyed.
+ *
+ * Post-Conditions:
+ *      The callables are destroyed.
+ *
+ * Destructor for the Command class.
+ */
+template<class State>
+Command<State>::~Command() {
+    reset();
+}
+
+/*
+ * Pre-Conditions:
+ *      Command instance being moved from.
+ *
+ * Post-Conditions:
+ *      `this` owns the callables of the given command,
+ *      the given command is left empty.
+ *
+ * Takes over the callables of another command.
+ * Heap allocated callables are relocated by copying their pointer,
+ * trivially copyable inline ones by copying the storage.
+ */
+template<class State>
+void Command<State>::relocateFrom(Command& other) noexcept {
+    applier = other.applier;
+    reverter = other.reverter;
+    manager = other.manager;
+
+    if (manager) {
+        /* The manager destroys what is left in the source */
+        manager(other.storage, storage);
+    } else {
+        std::memcpy(storage, other.storage, kInlineBytes);
+    }
+
+    other.applier = nullptr;
+    other.reverter = nullptr;
+    other.manager = nullptr;
+}
+
+/*
+ * Pre-Conditions:
+ *      Command is initialized.
+ *
+ * Post-Conditions:
+ *      The callables are destroyed, the command is empty.
+ *
+ * Destroys the callables.
+ */
+template<class State>
+void Command<State>::reset() noexcept {
+    if (manager) {
+        manager(storage, nullptr);
+    }
+
+    applier = nullptr;
+    reverter = nullptr;
+    manager = nullptr;
+}
+
+/*
+ * Pre-Conditions:
+ *      Initial target state (optional, default constructed).
+ *      Capacity of the history (optional, default 20).
+ *
+ * Post-Conditions:
+ *      CommandEngine instance is created with an empty history.
+ *      Throws std::invalid_argument if the capacity is not positive.
+ *
+ * Parameterized/Default constructor of the CommandEngine class.
+ */
+template<class State>
+CommandEngine<State>::CommandEngine(State initial, int capacity):
+        state{std::move(initial)}, history{capacity} {}
+
+/*
+ * Pre-Conditions:
+ *      CommandEngine is initialized.
+ *      Callable taking a State& reference, applying the command.
+ *      Callable taking a State& reference, reverting the command.
+ *
+ * Post-Conditions:
+ *      The command is applied to the state, then recorded.
+ *      If applying throws, nothing is recorded.
+ *
+ * Applies a new command & records it.
+ */
+template<class State>
+template<class Apply, class Revert>
+void CommandEngine<State>::execute(Apply&& apply, Revert&& revert) {
+    execute(Command<State>{std::forward<Apply>(apply),
+                           std::forward<Revert>(revert)});
+}
+
+/*
+ * Pre-Conditions:
+ *      CommandEngine is initialized.
+ *      rvalue reference to a command.
+ *
+ * Post-Conditions:
+ *      The command is applied to the state, then recorded.
+ *      If applying throws, nothing is recorded.
+ *
+ * Applies the given command & records it.
+ */
+template<class State>
+void CommandEngine<State>::execute(Command<State>&& command) {
+    command.apply(state);
+
+    history.insertNewAction(std::move(command));
+}
+
+/*
+ * Pre-Conditions:
+ *      CommandEngine is initialized.
+ *      Iterators over a range of Command<State>.
+ *
+ * Post-Conditions:
+ *      All commands are applied in order, then moved into the history.
+ *      If applying one throws, the ones applied before it are reverted,
+ *      nothing is recorded & the exception is rethrown.
+ *      Returns the number of executed commands.
+ *
+ * Applies a range of commands & records all of them.
+ * Applying the whole range before touching the history keeps
+ * the dispatch loop tight & gives the batch all-or-nothing semantics.
+ */
+template<class State>
+template<class Iterator>
+int CommandEngine<State>::executeBatch(Iterator first, Iterator last) {
+    Iterator applied = first;
+
+    try {
+        for (; applied != last; ++applied) {
+            applied->apply(state);
+        }
+    } catch (...) {
+        /* Revert the applied prefix, newest first */
+        while (applied != first) {
+            --applied;
+            applied->revert(state);
+        }
+
+        throw;
+    }
+
+    int executed = 0;
+
+    for (; first != last; ++first, executed++) {
+        history.insertNewAction(std::move(*first));
+    }
+
+    return executed;
+}
+
+/*
+ * Pre-Conditions:
+ *      CommandEngine is initialized.
+ *
+ * Post-Conditions:
+ *      The latest applied command is reverted (if possible).
+ *      Returns true if a command was reverted.
+ *
+ * Reverts the latest command.
+ */
+template<class State>
+bool CommandEngine<State>::undo() {
+    Command<State> *command = history.undo();
+
+    if (command) {
+        command->revert(state);
+    }
+
+    return command;
+}
+
+/*
+ * Pre-Conditions:
+ *      CommandEngine is initialized.
+ *
+ * Post-Conditions:
+ *      The latest reverted command is applied (if possible).
+ *      Returns true if a command was applied.
+ *
+ * Applies the latest reverted command again.
+ */
+template<class State>
+bool CommandEngine<State>::redo() {
+    Command<State> *command = history.redo();
+
+    if (command) {
+        command->apply(state);
+    }
+
+    return command;
+}
+
+/*
+ * Pre-Conditions:
+ *      CommandEngine is initialized.
+ *      Maximum number of commands to revert.
+ *
+ * Post-Conditions:
+ *      Up to N commands are reverted, newest first.
+ *      Returns the number of reverted commands.
+ *
+ * Reverts up to N commands.
+ */
+template<class State>
+int CommandEngine<State>::undo(int count) {
+    return history.undo(count, [this](Command<State>& command) {
+        command.revert(state);
+    });
+}
+
+/*
+ * Pre-Conditions:
+ *      CommandEngine is initialized.
+ *      Maximum number of commands to apply.
+ *
+ * Post-Conditions:
+ *      Up to N reverted commands are applied, oldest first.
+ *      Returns the number of applied commands.
+ *
+ * Applies up to N reverted commands again.
+ * Uses the batched URStack::redo, which finds all of them in one walk.
+ */
+template<class State>
+int CommandEngine<State>::redo(int count) {
+    return history.redo(count, [this](Command<State>& command) {
+        command.apply(state);
+    });
+}
+
+#endif //URSTACK_COMMANDENGINE_CPP
@@ -0,0 +1,387 @@
+/*
+ * URStack Project
+ *
+ *
+ * CommandEngine.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the Command<State> class, a reversible action
+ *              & the CommandEngine<State> class, which records commands
+ *              in a URStack & executes them against a target state.
+ *
+ * List of public Command<State> class Functions:
+ *      template<class Apply, class Revert>
+ *      Command(Apply, Revert)
+ *          Constructs a command from the given apply & revert callables.
+ *
+ *      ~Command()
+ *          Destructor for the Command class.
+ *
+ *      inline void apply(State&)
+ *          Applies the command to the given state.
+ *
+ *      inline void revert(State&)
+ *          Reverts the command from the given state.
+ *
+ * List of public CommandEngine<State> class Functions:
+ *      explicit CommandEngine(State, int capacity = 20)
+ *          Parameterized/Default constructor of the CommandEngine class.
+ *
+ *      template<class Apply, class Revert>
+ *      void execute(Apply&&, Revert&&)
+ *          Applies a new command & records it.
+ *
+ *      void execute(Command<State>&&)
+ *          Applies the given command & records it.
+ *
+ *      template<class Iterator>
+ *      int executeBatch(Iterator, Iterator)
+ *          Applies a range of commands & records all of them.
+ *
+ *      bool undo()
+ *          Reverts the latest command.
+ *
+ *      bool redo()
+ *          Applies the latest reverted command again.
+ *
+ *      int undo(int)
+ *          Reverts up to N commands.
+ *
+ *      int redo(int)
+ *          Applies up to N reverted commands again.
+ *
+ *      inline const State& getState() const
+ *          Returns the target state.
+ *
+ *      inline const URStack<Command<State>>& getHistory() const
+ *          Returns the recorded commands.
+ */
+
+#ifndef URSTACK_COMMANDENGINE_H
+#define URSTACK_COMMANDENGINE_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "URStack.h"
+
+
+/*
+ * Reversible action on a State.
+ * The apply & revert callables are type-erased into plain function
+ * pointers stored in the command itself, & kept inline when small enough,
+ * so dispatching a command is a single indirect call without allocation.
+ */
+template<class State>
+class Command {
+public:
+    /*
+     * Number of bytes available for inline callables.
+     * Chosen so a URStack Node of a Command fills a 64-byte cache line.
+     */
+    static constexpr std::size_t kInlineBytes = 32;
+
+    /*
+     * Pre-Conditions:
+     *      Callable taking a State& reference, applying the command.
+     *      Callable taking a State& reference, reverting the command.
+     *
+     * Post-Conditions:
+     *      A Command instance owning both callables is created.
+     *      The callables are stored inline if they fit in kInlineBytes
+     *      & are nothrow movable, otherwise on the heap.
+     *
+     * Constructs a command from the given apply & revert callables.
+     */
+    template<class Apply, class Revert,
+             class = std::enable_if_t<
+                     not std::is_same_v<std::decay_t<Apply>, Command>>>
+    Command(Apply&&, Revert&&);
+
+    Command(Command&&) noexcept;
+
+    Command& operator=(Command&&) noexcept;
+
+    Command(const Command&) = delete;
+
+    Command& operator=(const Command&) = delete;
+
+    /*
+     * Pre-Conditions:
+     *      `this` Command instance is not destroyed.
+     *
+     * Post-Conditions:
+     *      The callables are destroyed.
+     *
+     * Destructor for the Command class.
+     */
+    ~Command();
+
+    /*
+     * Pre-Conditions:
+     *      Command is initialized.
+     *      Reference to the target state.
+     *
+     * Post-Conditions:
+     *      The apply callable is invoked with the given state.
+     *
+     * Applies the command to the given state.
+     */
+    inline void apply(State& state) {
+        applier(storage, state);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Command is initialized.
+     *      Reference to the target state, the command is applied to it.
+     *
+     * Post-Conditions:
+     *      The revert callable is invoked with the given state.
+     *
+     * Reverts the command from the given state.
+     */
+    inline void revert(State& state) {
+        reverter(storage, state);
+    }
+
+private:
+    /*
+     * Both callables of a command, stored together.
+     */
+    template<class Apply, class Revert>
+    struct Callables {
+        Apply apply;
+        Revert revert;
+    };
+
+    /*
+     * Type of the functions invoking a stored callable.
+     */
+    typedef void (*Invoker)(void*, State&);
+
+    /*
+     * Type of the function relocating (destination is not nullptr)
+     * or destroying (destination is nullptr) the stored callables.
+     */
+    typedef void (*Manager)(void* /* source */, void* /* destination */);
+
+    /*
+     * Invokes the apply callable.
+     */
+    Invoker applier;
+
+    /*
+     * Invokes the revert callable.
+     */
+    Invoker reverter;
+
+    /*
+     * Relocates or destroys the callables.
+     * nullptr for trivially copyable inline callables,
+     * which are relocated by copying the storage.
+     */
+    Manager manager;
+
+    /*
+     * Inline callables, or a pointer to the heap allocated ones.
+     * Only the invokers & the manager know which one it holds.
+     */
+    alignas(void*) unsigned char storage[kInlineBytes];
+
+    /*
+     * Pre-Conditions:
+     *      Type of the stored callables.
+     *
+     * Post-Conditions:
+     *      True if it can be stored inline, otherwise false.
+     *
+     * Checks if the callables type fits in storage.
+     */
+    template<class Stored>
+    static constexpr bool fitsInline() {
+        return sizeof(Stored) <= kInlineBytes
+               and alignof(Stored) <= alignof(void*)
+               and std::is_nothrow_move_constructible_v<Stored>;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Command instance being moved from.
+     *
+     * Post-Conditions:
+     *      `this` owns the callables of the given command,
+     *      the given command is left empty.
+     *
+     * Takes over the callables of another command.
+     */
+    void relocateFrom(Command&) noexcept;
+
+    /*
+     * Pre-Conditions:
+     *      Command is initialized.
+     *
+     * Post-Conditions:
+     *      The callables are destroyed, the command is empty.
+     *
+     * Destroys the callables.
+     */
+    void reset() noexcept;
+};
+
+/*
+ * Executes reversible commands against a State,
+ * recording them in a URStack for undo & redo.
+ */
+template<class State>
+class CommandEngine {
+public:
+    /*
+     * Pre-Conditions:
+     *      Initial target state (optional, default constructed).
+     *      Capacity of the history (optional, default 20).
+     *
+     * Post-Conditions:
+     *      CommandEngine instance is created with an empty history.
+     *
+     * Parameterized/Default constructor of the CommandEngine class.
+     */
+    explicit CommandEngine(State = State{}, int capacity = 20);
+
+    /*
+     * Pre-Conditions:
+     *      CommandEngine is initialized.
+     *      Callable taking a State& reference, applying the command.
+     *      Callable taking a State& reference, reverting the command.
+     *
+     * Post-Conditions:
+     *      The command is applied to the state, then recorded.
+     *      If applying throws, nothing is recorded.
+     *
+     * Applies a new command & records it.
+     */
+    template<class Apply, class Revert>
+    void execute(Apply&&, Revert&&);
+
+    /*
+     * Pre-Conditions:
+     *      CommandEngine is initialized.
+     *      rvalue reference to a command.
+     *
+     * Post-Conditions:
+     *      The command is applied to the state, then recorded.
+     *      If applying throws, nothing is recorded.
+     *
+     * Applies the given command & records it.
+     */
+    void execute(Command<State>&&);
+
+    /*
+     * Pre-Conditions:
+     *      CommandEngine is initialized.
+     *      Iterators over a range of Command<State>.
+     *
+     * Post-Conditions:
+     *      All commands are applied in order, then moved into the history.
+     *      If applying one throws, the ones applied before it are reverted,
+     *      nothing is recorded & the exception is rethrown.
+     *      Returns the number of executed commands.
+     *
+     * Applies a range of commands & records all of them.
+     */
+    template<class Iterator>
+    int executeBatch(Iterator /* first */, Iterator /* last */);
+
+    /*
+     * Pre-Conditions:
+     *      CommandEngine is initialized.
+     *
+     * Post-Conditions:
+     *      The latest applied command is reverted (if possible).
+     *      Returns true if a command was reverted.
+     *
+     * Reverts the latest command.
+     */
+    bool undo();
+
+    /*
+     * Pre-Conditions:
+     *      CommandEngine is initialized.
+     *
+     * Post-Conditions:
+     *      The latest reverted command is applied (if possible).
+     *      Returns true if a command was applied.
+     *
+     * Applies the latest reverted command again.
+     */
+    bool redo();
+
+    /*
+     * Pre-Conditions:
+     *      CommandEngine is initialized.
+     *      Maximum number of commands to revert.
+     *
+     * Post-Conditions:
+     *      Up to N commands are reverted, newest first.
+     *      Returns the number of reverted commands.
+     *
+     * Reverts up to N commands.
+     */
+    int undo(int);
+
+    /*
+     * Pre-Conditions:
+     *      CommandEngine is initialized.
+     *      Maximum number of commands to apply.
+     *
+     * Post-Conditions:
+     *      Up to N reverted commands are applied, oldest first.
+     *      Returns the number of applied commands.
+     *
+     * Applies up to N reverted commands again.
+     */
+    int redo(int);
+
+    /*
+     * Pre-Conditions:
+     *      CommandEngine is initialized.
+     *
+     * Post-Conditions:
+     *      const reference to the target state is returned.
+     *
+     * Returns the target state.
+     */
+    [[nodiscard]] inline const State& getState() const {
+        return state;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      CommandEngine is initialized.
+     *
+     * Post-Conditions:
+     *      const reference to the history is returned.
+     *
+     * Returns the recorded commands.
+     */
+    [[nodiscard]] inline const URStack<Command<State>>& getHistory() const {
+        return history;
+    }
+
+private:
+    /*
+     * State the commands are executed against.
+     */
+    State state;
+
+    /*
+     * Recorded commands.
+     */
+    URStack<Command<State>> history;
+};
+
+#endif //URSTACK_COMMANDENGINE_H
@@ -24,12 +24,23 @@
  *          Displays the given prompt, places user string input into a
  *          given variable
  *
+ *     bool getLine(const string&, ostream&, istream&, LineReader&)
+ *          Displays the given prompt, reads a line of user input
+ *          into the given LineReader.
+ *
  *     int getInt(const string&, ostream&, istream&,
  *                  int lower = -1,
  *                  int upper = -1,
  *                  int defaultValue = -1)
  *          Displays the given prompt, keeps on trying to take int
  *          input from the user until a valid value is given.
+ *
+ * List of public LineReader class Functions:
+ *      LineReader()
+ *          Creates a reader with an empty line.
+ *
+ *      bool read(istream&)
+ *          Reads the next line, reusing the buffer of the previous one.
  */
 
 #include "CommonIO.h"
@@ -37,7 +48,7 @@
 
 /* Used std features in the file, shortens typing */
 using std::string, std::endl, std::ostream,
-        std::istream, std::to_string, std::invalid_argument;
+        std::istream, std::to_string;
 
 /*
  * Pre-Conditions:
@@ -61,10 +72,15 @@ ostream& displaySeparator(ostream& out) {
  *      Displays an error message in red color to the user.
  *
  * Displays an error message.
+ * Plain if coloured output is disabled.
  * This method of coloring text is not supported by Windows 10 cmd;
  * use a terminal simulator.
  */
 ostream& displayInvalidMessage(const string& msg, ostream& out) {
+    if (not isColoured()) {
+        return out << msg;
+    }
+
     return
         out << "\033[31;1;1m"   /* Text color becomes red, underlined, bold */
             << msg
@@ -80,15 +96,51 @@ ostream& displayInvalidMessage(const string& msg, ostream& out) {
  *      Displays a message in cyan color to the user.
  *
  * Displays a message.
+ * Plain if coloured output is disabled.
  * This method of coloring text is not supported by Windows 10 cmd;
  * use a terminal simulator.
  */
 ostream& displayDataMessage(const string& msg, ostream& out) {
+    if (not isColoured()) {
+        return out << msg;
+    }
+
     return out << "\033[36;1;1m"   /* Text becomes cyan, bold */
                << msg
                << "\033[0m";        /* Text becomes normal */
 }
 
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      A LineReader instance with an empty line is created.
+ *
+ * Creates a reader with an empty line.
+ * Reserves room for typical lines, longer ones grow the buffer once.
+ */
+LineReader::LineReader() {
+    line.reserve(kReservedBytes);
+}
+
+/*
+ * Pre-Conditions:
+ *      LineReader is initialized.
+ *      istream reference to read from.
+ *
+ * Post-Conditions:
+ *      The next line, without its new line, replaces the last one.
+ *      Returns false if no line is left, otherwise true.
+ *
+ * Reads the next line, reusing the buffer of the previous one.
+ * getline overwrites the string in place, allocating only when a line
+ * is longer than every line before it.
+ */
+bool LineReader::read(istream& in) {
+    return static_cast<bool>(getline(in, line));
+}
+
 /*
  * Pre-Conditions:
  *      const string reference to the prompt.
@@ -104,17 +156,45 @@ ostream& displayDataMessage(const string& msg, ostream& out) {
  */
 string getString(const string& prompt, ostream& out,
                istream& in) {
-    string result;
+    thread_local LineReader reader;
+
+    getLine(prompt, out, in, reader);
+
+    return string{reader.getLine()};
+}
+
+/*
+ * Pre-Conditions:
+ *      const string reference to the prompt.
+ *      ostream reference to display the prompt.
+ *      istream reference read user input.
+ *      Reference to the LineReader to read into.
+ *
+ * Post-Conditions:
+ *      The user input line is held by the given LineReader.
+ *      Returns false if the input has ended, otherwise true.
+ *
+ * Displays the given prompt, reads a line of user input
+ * into the given LineReader.
+ * Plain if coloured output is disabled.
+ * This method of coloring text is not supported by Windows 10 cmd;
+ * use a terminal simulator.
+ */
+bool getLine(const string& prompt, ostream& out, istream& in,
+             LineReader& reader) {
+    out << prompt << ": ";
 
-    out << prompt
-        << ": "
-        << "\033[36;1;1m";   /* Text becomes cyan, bold */
+    if (isColoured()) {
+        out << "\033[36;1;1m";   /* Text becomes cyan, bold */
+    }
 
-    getline(in, result);
+    const bool read = reader.read(in);
 
-    out << "\033[0m";  /* Text becomes normal */
+    if (isColoured()) {
+        out << "\033[0m";  /* Text becomes normal */
+    }
 
-    return result;
+    return read;
 }
 
 /*
@@ -131,49 +211,55 @@ string getString(const string& prompt, ostream& out,
  *
  * Displays the given prompt, keeps on trying to take int
  * input from the user until a given value is given.
+ * Lines are read into a reused LineReader & parsed with from_chars,
+ * bad input is reported through ParseStatus rather than exceptions.
+ * An empty line & the end of input return the default value.
  */
 int getInt(const string& prompt, ostream& out, istream& in,
            int lower, int upper, int default_val) {
-    string response;
+    thread_local LineReader reader;
+    int result;
 
     /* Insure istream is blank */
     in.clear();
 
     /* Take input until user gives a valid value */
-    while (true) {
-        try {
-            response = getString(prompt, out, in);
-
-            /* No input */
-            if (not response.length()) {
-                return default_val;
-            }
-
-            /* Try to convert string response to int */
-            const int result = stoi(response);
-
-            if (lower != -1 and result < lower) {
-                /* Lower than minimum */
-                displayInvalidMessage(
-                        "Invalid integer must be >= "
-                        + to_string(lower),
-                        out
-                ) << '\n' << endl;
-                continue;
-            } else if (upper != -1 and upper < result) {
-                /* Higher than maximum */
-                displayInvalidMessage(
-                        "Invalid integer must be between "
-                        + to_string(lower) + " & " + to_string(upper),
-                        out
-                ) << '\n' << endl;
-                continue;
-            }
-
-            return result;
-        } catch (invalid_argument& ignored) {
-            displayInvalidMessage("Invalid integer input!", out)
-            << '\n' << endl;
+    while (getLine(prompt, out, in, reader)) {
+        /* No input */
+        if (reader.getLine().empty()) {
+            return default_val;
+        }
+
+        switch (reader.parse(result)) {
+            case ParseStatus::kOk:
+                if (lower != -1 and result < lower) {
+                    /* Lower than minimum */
+                    displayInvalidMessage(
+                            "Invalid integer must be >= "
+                            + to_string(lower),
+                            out
+                    ) << '\n' << endl;
+                } else if (upper != -1 and upper < result) {
+                    /* Higher than maximum */
+                    displayInvalidMessage(
+                            "Invalid integer must be between "
+                            + to_string(lower) + " & " + to_string(upper),
+                            out
+                    ) << '\n' << endl;
+                } else {
+                    return result;
+                }
+
+                break;
+            case ParseStatus::kEmpty:
+            case ParseStatus::kInvalid:
+            case ParseStatus::kOutOfRange:
+                displayInvalidMessage("Invalid integer input!", out)
+                << '\n' << endl;
+                break;
         }
     }
+
+    /* No input left */
+    return default_val;
 }
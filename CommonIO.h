@@ -25,24 +25,119 @@
  *          Displays the given prompt, places user string input into a
  *          given variable
  *
+ *     bool getLine(const string&, ostream&, istream&, LineReader&)
+ *          Displays the given prompt, reads a line of user input
+ *          into the given LineReader.
+ *
  *     int getInt(const string&, ostream&, istream&,
  *                  int lower = -1,
  *                  int upper = -1,
  *                  int defaultValue = -1)
  *          Displays the given prompt, keeps on trying to take int
  *          input from the user until a valid value is given.
+ *
+ * List of public LineReader class Functions:
+ *      LineReader()
+ *          Creates a reader with an empty line.
+ *
+ *      bool read(istream&)
+ *          Reads the next line, reusing the buffer of the previous one.
+ *
+ *      inline std::string_view getLine() const
+ *          Returns the last line read.
+ *
+ *      template<class T>
+ *      ParseStatus parse(T&) const
+ *          Parses the last line read as a number.
  */
 
 #ifndef URSTACK_COMMONIO_H
 #define URSTACK_COMMONIO_H
 
+#include <cstddef>
 #include <exception>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "GenericIO.cpp"
 
 
+/*
+ * Reads input line by line into a single buffer kept between lines,
+ * so once it holds the longest line, reading & parsing never allocate.
+ * Meant to be kept alive across reads, piped input is read in bulk.
+ */
+class LineReader {
+public:
+    /*
+     * Bytes reserved for the line up front.
+     */
+    static constexpr std::size_t kReservedBytes = 256;
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      A LineReader instance with an empty line is created.
+     *
+     * Creates a reader with an empty line.
+     */
+    LineReader();
+
+    /*
+     * Pre-Conditions:
+     *      LineReader is initialized.
+     *      istream reference to read from.
+     *
+     * Post-Conditions:
+     *      The next line, without its new line, replaces the last one.
+     *      Returns false if no line is left, otherwise true.
+     *
+     * Reads the next line, reusing the buffer of the previous one.
+     */
+    bool read(std::istream&);
+
+    /*
+     * Pre-Conditions:
+     *      LineReader is initialized.
+     *
+     * Post-Conditions:
+     *      Returns a view of the last line read,
+     *      valid until the next read.
+     *
+     * Returns the last line read.
+     */
+    [[nodiscard]] inline std::string_view getLine() const {
+        return line;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      LineReader is initialized.
+     *      Reference to an arithmetic type T.
+     *
+     * Post-Conditions:
+     *      Returns ParseStatus::kOk & writes the number into the given
+     *      reference if the whole line is one, otherwise the reference
+     *      is left unchanged.
+     *
+     * Parses the last line read as a number.
+     */
+    template<class T>
+    ParseStatus parse(T& result) const {
+        return parseNumber(line, result);
+    }
+
+private:
+    /*
+     * Last line read, its capacity is kept between reads.
+     */
+    std::string line;
+};
+
+
 /*
  * Pre-Conditions:
  *      ostream reference to display the output.
@@ -95,6 +190,24 @@ std::string getString(const std::string&,
                       std::ostream&,
                       std::istream&);
 
+/*
+ * Pre-Conditions:
+ *      const string reference to the prompt.
+ *      ostream reference to display the prompt.
+ *      istream reference read user input.
+ *      Reference to the LineReader to read into.
+ *
+ * Post-Conditions:
+ *      The user input line is held by the given LineReader.
+ *      Returns false if the input has ended, otherwise true.
+ *
+ * Displays the given prompt, reads a line of user input
+ * into the given LineReader.
+ */
+bool getLine(const std::string&,
+             std::ostream&, std::istream&,
+             LineReader&);
+
 /*
  * Pre-Conditions:
  *      const string reference to the prompt.
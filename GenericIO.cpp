@@ -11,12 +11,26 @@
  * Purpose:     Implementation of generic input/output functions.
  *
  * List of Functions:
+ *      inline bool& colouredOutput()
+ *          Returns the flag enabling coloured output.
+ *
+ *      inline void setColoured(bool)
+ *          Enables or disables coloured output.
+ *
+ *      inline bool isColoured()
+ *          Used to check if output is coloured.
+ *
  *      template<class T>
  *      std::ostream& display(const T&, std::ostream&)
  *          Displays the given instance of type T, using its operator<<
  *
  *      template<class T>
- *      void get(const std::string&, std::ostream&, std::istream&, T&)
+ *      ParseStatus parseNumber(std::string_view, T&)
+ *          Parses a whole string as a number, without allocating
+ *          or throwing.
+ *
+ *      template<class T>
+ *      ParseStatus get(const std::string&, std::ostream&, std::istream&, T&)
  *          Displays the given prompt, writes user input into the given
  *          reference of T.
  */
@@ -24,11 +38,58 @@
 #ifndef URSTACK_GENERICIO_CPP
 #define URSTACK_GENERICIO_CPP
 
-#include <climits>
+#include <charconv>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 
 
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Returns a reference to the flag, true unless disabled.
+ *
+ * Returns the flag enabling coloured output.
+ * A function-local static, so it is shared by every translation unit.
+ */
+inline bool& colouredOutput() {
+    static bool coloured = true;
+
+    return coloured;
+}
+
+/*
+ * Pre-Conditions:
+ *      true to colour output, false for plain text.
+ *
+ * Post-Conditions:
+ *      Display functions use or skip colour codes from now on.
+ *
+ * Enables or disables coloured output.
+ * Plain text is meant for output consumed by other programs.
+ */
+inline void setColoured(bool coloured) {
+    colouredOutput() = coloured;
+}
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Returns true if output is coloured, otherwise false.
+ *
+ * Used to check if output is coloured.
+ */
+inline bool isColoured() {
+    return colouredOutput();
+}
+
 /*
  * Pre-Conditions:
  *      const T reference to a value.
@@ -45,40 +106,131 @@
  */
 template<class T>
 std::ostream& display(const T& val, std::ostream& out) {
+    if (not isColoured()) {
+        return out << val;
+    }
+
     return out << "\033[36;1;1m"   /* Text becomes cyan, bold */
                << val
                << "\033[0m";       /* Text becomes normal */
 }
 
+/*
+ * Outcome of parsing user input, returned instead of throwing,
+ * bad input is expected & not exceptional.
+ */
+enum class ParseStatus {
+    kOk,            /* The whole input was parsed */
+    kEmpty,         /* Nothing but white space */
+    kInvalid,       /* Not a value of the requested type */
+    kOutOfRange     /* A number not representable by the requested type */
+};
+
+/*
+ * Pre-Conditions:
+ *      Text to parse.
+ *      Reference to an arithmetic type T.
+ *
+ * Post-Conditions:
+ *      Returns ParseStatus::kOk & writes the number into the given
+ *      reference if the whole text is one, otherwise the reference is
+ *      left unchanged.
+ *
+ * Parses a whole string as a number, without allocating or throwing.
+ * Surrounding white space & a leading '+' are accepted,
+ * trailing characters are not.
+ */
+template<class T>
+ParseStatus parseNumber(std::string_view text, T& result) {
+    static_assert(std::is_arithmetic_v<T> and not std::is_same_v<T, bool>,
+                  "parseNumber parses integers & floating point numbers");
+
+    constexpr std::string_view kSpaces = " \t\r";
+
+    const std::size_t first = text.find_first_not_of(kSpaces);
+
+    if (first == std::string_view::npos) {
+        return ParseStatus::kEmpty;
+    }
+
+    text = text.substr(first, text.find_last_not_of(kSpaces) - first + 1);
+
+    /* from_chars only accepts a leading '-' */
+    if (text.size() > 1 and text[0] == '+' and text[1] != '-') {
+        text.remove_prefix(1);
+    }
+
+    T parsed;
+    auto [end, error] = std::from_chars(text.data(),
+                                        text.data() + text.size(), parsed);
+
+    if (error == std::errc::result_out_of_range) {
+        return ParseStatus::kOutOfRange;
+    } else if (error != std::errc{} or end != text.data() + text.size()) {
+        return ParseStatus::kInvalid;
+    }
+
+    result = parsed;
+
+    return ParseStatus::kOk;
+}
+
 /*
  * Pre-Conditions:
  *      const string reference to a prompt.
  *      ostream reference to display a prompt.
  *      istream reference read user input.
- *      Reference to a type T that has operator>>(istream&, T&) defined.
+ *      Reference to an arithmetic type T, or a type T that has
+ *      operator>>(istream&, T&) defined.
  *
  * Post-Conditions:
  *      Reads user input into the given variable reference of type T.
+ *      Returns ParseStatus::kOk if it was read, the reference is left
+ *      unchanged for arithmetic types otherwise.
  *
  * Displays the given prompt, takes string input from the user.
+ * Numbers are parsed from a whole line with parseNumber,
+ * the line buffer is reused so steady state input does not allocate.
+ * Other types are read with their operator>>, the rest of the line is
+ * ignored & a failed stream is cleared for the next read.
  *
  * This method of coloring text is not supported by Windows 10 cmd;
  * use a terminal simulator.
  */
 template<class T>
-void get(const std::string& prompt, std::ostream& out,
-         std::istream& in, T& result) {
-    out << prompt
-    << ": "
-    << "\033[36;1;1m"   /* Text becomes cyan, bold */
-    << std::endl;
+ParseStatus get(const std::string& prompt, std::ostream& out,
+                std::istream& in, T& result) {
+    ParseStatus status = ParseStatus::kOk;
+
+    out << prompt << ": ";
+
+    if (isColoured()) {
+        out << "\033[36;1;1m";  /* Text becomes cyan, bold */
+    }
+
+    out << std::endl;
+
+    if constexpr (std::is_arithmetic_v<T> and not std::is_same_v<T, bool>) {
+        thread_local std::string line;
+
+        status = std::getline(in, line) ? parseNumber(line, result)
+                                        : ParseStatus::kEmpty;
+    } else {
+        /* use operator>> defined in T */
+        if (not (in >> result)) {
+            status = in.eof() ? ParseStatus::kEmpty : ParseStatus::kInvalid;
+            in.clear();
+        }
 
-    in >> result;
+        /* Ignore all unused input, a max count means no limit */
+        in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
 
-    /* Ignore all unused input */
-    in.ignore(LLONG_MAX, '\n');
+    if (isColoured()) {
+        out << "\033[0m";  /* Text becomes normal */
+    }
 
-    out << "\033[0m";  /* Text becomes normal */
+    return status;
 }
 
 #endif //URSTACK_GENERICIO_CPP
@@ -0,0 +1,104 @@
+/*
+ * URStack Project
+ *
+ *
+ * HistoryExport.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in HistoryExport.h
+ *
+ * List of public ExportBuffer class Functions:
+ *      explicit ExportBuffer(ExportFormat)
+ *          Creates an empty buffer of the given format.
+ *
+ *      void write(std::ostream&)
+ *          Writes the buffered bytes at once & empties the buffer.
+ *
+ * List of private ExportBuffer class Functions:
+ *      void appendJsonString(std::string_view)
+ *          Appends a JSON string of the given characters.
+ */
+
+#include "HistoryExport.h"
+
+
+/* Used std utilities */
+using std::ostream, std::string_view, std::streamsize;
+
+/*
+ * Pre-Conditions:
+ *      Format of the buffered actions.
+ *
+ * Post-Conditions:
+ *      An empty ExportBuffer instance is created.
+ *
+ * Creates an empty buffer of the given format.
+ */
+ExportBuffer::ExportBuffer(ExportFormat format):
+        format{format}, appender{bytes}, formatter{&appender} {}
+
+/*
+ * Pre-Conditions:
+ *      ExportBuffer is initialized.
+ *      ostream reference to write to.
+ *
+ * Post-Conditions:
+ *      The buffered bytes are written with a single write,
+ *      the buffer is empty, its capacity is kept.
+ *
+ * Writes the buffered bytes at once & empties the buffer.
+ */
+void ExportBuffer::write(ostream& out) {
+    out.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+    bytes.clear();
+}
+
+/*
+ * Pre-Conditions:
+ *      Characters of a string, UTF-8 if not ASCII.
+ *
+ * Post-Conditions:
+ *      The characters are appended quoted, with quotes, backslashes
+ *      & control characters escaped.
+ *
+ * Appends a JSON string of the given characters.
+ * Runs of characters needing no escape are appended at once.
+ */
+void ExportBuffer::appendJsonString(string_view text) {
+    static constexpr char kHex[] = "0123456789abcdef";
+
+    std::size_t run = 0;
+
+    bytes += '"';
+
+    for (std::size_t i = 0; i < text.size(); i++) {
+        const auto c = static_cast<unsigned char>(text[i]);
+
+        if (c >= 0x20 and c != '"' and c != '\\') {
+            continue;
+        }
+
+        bytes.append(text.substr(run, i - run));
+        run = i + 1;
+
+        switch (c) {
+            case '"':  bytes += "\\\""; break;
+            case '\\': bytes += "\\\\"; break;
+            case '\b': bytes += "\\b";  break;
+            case '\f': bytes += "\\f";  break;
+            case '\n': bytes += "\\n";  break;
+            case '\r': bytes += "\\r";  break;
+            case '\t': bytes += "\\t";  break;
+            default:
+                bytes += "\\u00";
+                bytes += kHex[c >> 4];
+                bytes += kHex[c & 0xF];
+        }
+    }
+
+    bytes.append(text.substr(run));
+    bytes += '"';
+}
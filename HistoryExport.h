@@ -0,0 +1,297 @@
+/*
+ * URStack Project
+ *
+ *
+ * HistoryExport.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the export formats of URStack histories &
+ *              of the ExportBuffer class, formatting a chunk of actions
+ *              into memory, so chunks can be formatted by separate
+ *              threads & written in order (see URStack::exportAll).
+ *
+ *              Formats, the actions in the order of the matching display
+ *              function in every one of them:
+ *                  kText       As displayAll, without colours:
+ *                              actions separated by ", ".
+ *                  kJsonLines  One JSON value per line: strings escaped,
+ *                              numbers as is, other types as the string
+ *                              their operator<< writes.
+ *                  kBinary     The snapshot encoding (see SnapshotCodec):
+ *                              raw values for kFixed types, a uint64_t
+ *                              length & the encoded bytes for kBytes,
+ *                              in native byte order.
+ *
+ * List of public ExportBuffer class Functions:
+ *      explicit ExportBuffer(ExportFormat)
+ *          Creates an empty buffer of the given format.
+ *
+ *      template<class DataType>
+ *      void append(const DataType&, bool)
+ *          Appends an action in the format of the buffer.
+ *
+ *      void write(std::ostream&)
+ *          Writes the buffered bytes at once & empties the buffer.
+ *
+ *      inline std::size_t getBytes() const
+ *          Returns the number of buffered bytes.
+ *
+ * List of private ExportBuffer class Functions:
+ *      template<class DataType>
+ *      void appendText(const DataType&)
+ *          Appends an action as OutputSink formats it.
+ *
+ *      void appendJsonString(std::string_view)
+ *          Appends a JSON string of the given characters.
+ *
+ * List of Functions:
+ *      inline constexpr bool isBinaryExportable<DataType>
+ *          Used to check if a type has a binary export encoding.
+ */
+
+#ifndef URSTACK_HISTORYEXPORT_H
+#define URSTACK_HISTORYEXPORT_H
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "OutputSink.h"
+#include "URStackSnapshot.h"
+
+
+/*
+ * Formats of an exported history.
+ */
+enum class ExportFormat : std::uint8_t {
+    /* As displayAll, actions separated by ", " */
+    kText = 0,
+
+    /* One JSON value per line */
+    kJsonLines = 1,
+
+    /* The snapshot encoding of every action */
+    kBinary = 2,
+};
+
+/*
+ * Detects whether SnapshotCodec<DataType> is defined.
+ */
+template<class DataType, class = void>
+inline constexpr bool isBinaryExportable = false;
+
+template<class DataType>
+inline constexpr bool isBinaryExportable<DataType,
+        std::void_t<decltype(SnapshotCodec<DataType>::kEncoding)>> = true;
+
+/*
+ * Bytes of a chunk of exported actions, in a single format.
+ * Reused between chunks, so once it holds the largest chunk
+ * formatting never allocates. Not copyable, its formatter writes to it.
+ */
+class ExportBuffer {
+public:
+    /*
+     * Actions formatted by a thread at once, bounding the memory of
+     * an export to a chunk per thread, whatever the history's length.
+     */
+    static constexpr int kChunkEntries = 1 << 14;
+
+    /*
+     * Pre-Conditions:
+     *      Format of the buffered actions.
+     *
+     * Post-Conditions:
+     *      An empty ExportBuffer instance is created.
+     *
+     * Creates an empty buffer of the given format.
+     */
+    explicit ExportBuffer(ExportFormat);
+
+    ExportBuffer(const ExportBuffer&) = delete;
+
+    ExportBuffer& operator=(const ExportBuffer&) = delete;
+
+    /*
+     * Pre-Conditions:
+     *      ExportBuffer is initialized.
+     *      const reference to an action, string-like, arithmetic or with
+     *      operator<<(ostream&, const DataType&) defined.
+     *      true if it is the last action of the export.
+     *
+     * Post-Conditions:
+     *      The action is buffered in the format of the buffer,
+     *      followed by ", " in kText unless it is the last.
+     *      Throws std::invalid_argument in kBinary if the type has no
+     *      SnapshotCodec.
+     *
+     * Appends an action in the format of the buffer.
+     * Strings are copied & integers formatted with to_chars, as by
+     * OutputSink, other types go through their operator<<.
+     */
+    template<class DataType>
+    void append(const DataType& action, bool last) {
+        switch (format) {
+            case ExportFormat::kText:
+                appendText(action);
+
+                if (not last) {
+                    bytes += ", ";
+                }
+
+                return;
+            case ExportFormat::kJsonLines:
+                if constexpr (std::is_convertible_v<const DataType&,
+                                                    std::string_view>) {
+                    appendJsonString(std::string_view{action});
+                } else if constexpr (std::is_arithmetic_v<DataType>
+                                     and not std::is_same_v<DataType,
+                                                            bool>) {
+                    if constexpr (std::is_floating_point_v<DataType>) {
+                        /* Shortest exact form, NaN & infinities as null */
+                        char digits[64];
+                        auto result = std::to_chars(
+                                digits, digits + sizeof(digits), action);
+
+                        if (std::isfinite(action)) {
+                            bytes.append(digits, result.ptr);
+                        } else {
+                            bytes += "null";
+                        }
+                    } else {
+                        appendText(action);
+                    }
+                } else {
+                    /* Formatted in place, then replaced by its escape */
+                    const std::size_t start = bytes.size();
+
+                    formatter << action;
+
+                    const std::string text = bytes.substr(start);
+
+                    bytes.resize(start);
+                    appendJsonString(text);
+                }
+
+                bytes += '\n';
+                return;
+            case ExportFormat::kBinary:
+                if constexpr (isBinaryExportable<DataType>) {
+                    typedef SnapshotCodec<DataType> Codec;
+
+                    if constexpr (Codec::kEncoding
+                                  == SnapshotEncoding::kFixed) {
+                        bytes.append(reinterpret_cast<const char*>(&action),
+                                     sizeof(DataType));
+                    } else {
+                        /* Length first, patched once the value is encoded */
+                        const std::size_t start = bytes.size();
+                        std::uint64_t length = 0;
+
+                        bytes.append(sizeof(length), '\0');
+                        Codec::encode(action, bytes);
+                        length = bytes.size() - start - sizeof(length);
+                        bytes.replace(start, sizeof(length),
+                                      reinterpret_cast<const char*>(&length),
+                                      sizeof(length));
+                    }
+
+                    return;
+                } else {
+                    throw std::invalid_argument(
+                            "\nActions have no binary encoding.\n");
+                }
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      ExportBuffer is initialized.
+     *      ostream reference to write to.
+     *
+     * Post-Conditions:
+     *      The buffered bytes are written with a single write,
+     *      the buffer is empty, its capacity is kept.
+     *
+     * Writes the buffered bytes at once & empties the buffer.
+     */
+    void write(std::ostream&);
+
+    /*
+     * Pre-Conditions:
+     *      ExportBuffer is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the number of buffered bytes.
+     */
+    [[nodiscard]] inline std::size_t getBytes() const {
+        return bytes.size();
+    }
+
+private:
+    ExportFormat format;
+
+    /*
+     * Bytes not written yet, its capacity is kept between writes.
+     */
+    std::string bytes;
+
+    /*
+     * Appends to bytes, as OutputSink's does to its buffer.
+     */
+    StringAppender appender;
+
+    /*
+     * Formats values with their operator<< through appender.
+     */
+    std::ostream formatter;
+
+    /*
+     * Pre-Conditions:
+     *      const reference to an action accepted by OutputSink.
+     *
+     * Post-Conditions:
+     *      The action is appended as OutputSink formats it.
+     *
+     * Appends an action as OutputSink formats it.
+     */
+    template<class DataType>
+    void appendText(const DataType& action) {
+        if constexpr (std::is_convertible_v<const DataType&,
+                                            std::string_view>) {
+            bytes.append(std::string_view{action});
+        } else if constexpr (std::is_integral_v<DataType>
+                             and not std::is_same_v<DataType, bool>) {
+            char digits[24];
+            auto result = std::to_chars(digits, digits + sizeof(digits),
+                                        action);
+
+            bytes.append(digits, result.ptr);
+        } else {
+            formatter << action;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Characters of a string, UTF-8 if not ASCII.
+     *
+     * Post-Conditions:
+     *      The characters are appended quoted, with quotes, backslashes
+     *      & control characters escaped.
+     *
+     * Appends a JSON string of the given characters.
+     */
+    void appendJsonString(std::string_view);
+};
+
+#endif //URSTACK_HISTORYEXPORT_H
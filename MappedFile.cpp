@@ -0,0 +1,169 @@
+/*
+ * URStack Project
+ *
+ *
+ * MappedFile.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in MappedFile.h
+ *
+ * List of public MappedFile class Functions:
+ *      MappedFile()
+ *          No-arg constructor, creates an empty mapping.
+ *
+ *      explicit MappedFile(const std::string&)
+ *          Maps the file at the given path.
+ *
+ *      ~MappedFile()
+ *          Unmaps the file.
+ */
+
+#include "MappedFile.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define URSTACK_HAS_MMAP 1
+#endif
+
+
+/* Used std utilities */
+using std::string, std::runtime_error, std::ifstream, std::exchange;
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      An empty MappedFile instance is created.
+ *
+ * No-arg constructor of the MappedFile class.
+ */
+MappedFile::MappedFile(): data{nullptr}, length{0}, owned{false} {}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of a readable file.
+ *
+ * Post-Conditions:
+ *      The whole file is mapped read-only.
+ *      Throws std::runtime_error if the file cannot be mapped.
+ *
+ * Maps the file at the given path.
+ * Empty files are valid and result in an empty mapping.
+ */
+MappedFile::MappedFile(const string& path): MappedFile() {
+#ifdef URSTACK_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        throw runtime_error("\nCannot open " + path + ".\n");
+    }
+
+    struct stat info{};
+
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw runtime_error("\nCannot stat " + path + ".\n");
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+
+    if (length) {
+        void *mapping = ::mmap(nullptr, length, PROT_READ,
+                               MAP_PRIVATE, fd, 0);
+
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw runtime_error("\nCannot map " + path + ".\n");
+        }
+
+        data = static_cast<const char*>(mapping);
+    }
+
+    /* The mapping keeps its own reference to the file */
+    ::close(fd);
+#else
+    ifstream in(path, std::ios::binary | std::ios::ate);
+
+    if (not in) {
+        throw runtime_error("\nCannot open " + path + ".\n");
+    }
+
+    length = static_cast<std::size_t>(in.tellg());
+
+    if (length) {
+        char *buffer = new char[length];
+
+        in.seekg(0);
+        in.read(buffer, static_cast<std::streamsize>(length));
+
+        data = buffer;
+        owned = true;
+    }
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept:
+        data{exchange(other.data, nullptr)},
+        length{exchange(other.length, 0)},
+        owned{exchange(other.owned, false)} {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+
+        data = exchange(other.data, nullptr);
+        length = exchange(other.length, 0);
+        owned = exchange(other.owned, false);
+    }
+
+    return *this;
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` MappedFile instance is not destroyed.
+ *
+ * Post-Conditions:
+ *      The mapping is released, pointers obtained from it dangle.
+ *
+ * Destructor for the MappedFile class.
+ */
+MappedFile::~MappedFile() {
+    release();
+}
+
+/*
+ * Pre-Conditions:
+ *      MappedFile is initialized.
+ *
+ * Post-Conditions:
+ *      The mapping is released, the instance is empty.
+ *
+ * Releases the mapping.
+ */
+void MappedFile::release() {
+    if (data) {
+        if (owned) {
+            delete[] data;
+        } else {
+#ifdef URSTACK_HAS_MMAP
+            ::munmap(const_cast<char*>(data), length);
+#endif
+        }
+    }
+
+    data = nullptr;
+    length = 0;
+    owned = false;
+}
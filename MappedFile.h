@@ -0,0 +1,145 @@
+/*
+ * URStack Project
+ *
+ *
+ * MappedFile.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the MappedFile class, a read-only view of a
+ *              whole file that is memory-mapped where the platform allows.
+ *
+ * List of public MappedFile class Functions:
+ *      MappedFile()
+ *          No-arg constructor, creates an empty mapping.
+ *
+ *      explicit MappedFile(const std::string&)
+ *          Maps the file at the given path.
+ *
+ *      ~MappedFile()
+ *          Unmaps the file.
+ *
+ *      inline const char* getData() const
+ *          Returns a pointer to the first byte of the file.
+ *
+ *      inline std::size_t getLength() const
+ *          Returns the number of bytes in the file.
+ */
+
+#ifndef URSTACK_MAPPEDFILE_H
+#define URSTACK_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+
+/*
+ * Read-only, move-only view over the contents of a file.
+ * Uses mmap on POSIX systems, falls back to reading the file into memory.
+ */
+class MappedFile {
+public:
+    /*
+     * Pre-Conditions:
+     *      No preconditions.
+     *
+     * Post-Conditions:
+     *      An empty MappedFile instance is created.
+     *      data is nullptr.
+     *      length is 0.
+     *
+     * No-arg constructor of the MappedFile class.
+     */
+    MappedFile();
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the path of a readable file.
+     *
+     * Post-Conditions:
+     *      The whole file is mapped read-only.
+     *      Throws std::runtime_error if the file cannot be mapped.
+     *
+     * Maps the file at the given path.
+     */
+    explicit MappedFile(const std::string&);
+
+    MappedFile(MappedFile&&) noexcept;
+
+    MappedFile& operator=(MappedFile&&) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /*
+     * Pre-Conditions:
+     *      `this` MappedFile instance is not destroyed.
+     *
+     * Post-Conditions:
+     *      The mapping is released, pointers obtained from it dangle.
+     *
+     * Destructor for the MappedFile class.
+     */
+    ~MappedFile();
+
+    /*
+     * Pre-Conditions:
+     *      MappedFile is initialized.
+     *
+     * Post-Conditions:
+     *      Pointer to the first byte of the file is returned.
+     *
+     * Returns a pointer to the first byte of the file.
+     */
+    [[nodiscard]] inline const char* getData() const {
+        return data;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      MappedFile is initialized.
+     *
+     * Post-Conditions:
+     *      Number of bytes in the file is returned.
+     *
+     * Returns the number of bytes in the file.
+     */
+    [[nodiscard]] inline std::size_t getLength() const {
+        return length;
+    }
+
+private:
+    /*
+     * Pointer to the first byte of the mapping.
+     * Default is nullptr.
+     */
+    const char *data;
+
+    /*
+     * Number of mapped bytes.
+     * Default is 0.
+     */
+    std::size_t length;
+
+    /*
+     * True if data was allocated by the read fallback,
+     * instead of being mapped.
+     */
+    bool owned;
+
+    /*
+     * Pre-Conditions:
+     *      MappedFile is initialized.
+     *
+     * Post-Conditions:
+     *      The mapping is released, the instance is empty.
+     *
+     * Releases the mapping.
+     */
+    void release();
+};
+
+#endif //URSTACK_MAPPEDFILE_H
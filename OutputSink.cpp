@@ -0,0 +1,244 @@
+/*
+ * URStack Project
+ *
+ *
+ * OutputSink.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in OutputSink.h
+ *
+ * List of public OutputSink class Functions:
+ *      explicit OutputSink(std::ostream&, bool coloured = isColoured())
+ *          Creates a sink writing to the given ostream.
+ *
+ *      ~OutputSink()
+ *          Writes the buffered output, without flushing the ostream.
+ *
+ *      OutputSink& operator<<(char)
+ *          Appends a character.
+ *
+ *      OutputSink& beginData()
+ *          Starts cyan, bold text.
+ *
+ *      OutputSink& beginInvalid()
+ *          Starts red, bold text.
+ *
+ *      OutputSink& endColour()
+ *          Returns to normal text.
+ *
+ *      OutputSink& invalid(std::string_view)
+ *          Appends an error message as red, bold text.
+ *
+ *      void flush()
+ *          Writes the buffered output & flushes the ostream.
+ *
+ * List of private OutputSink class Functions:
+ *      void drain()
+ *          Writes the buffered output, keeping the buffer's capacity.
+ *
+ * List of protected StringAppender class Functions:
+ *      int_type overflow(int_type)
+ *          Appends a single character to the target.
+ *
+ *      std::streamsize xsputn(const char_type*, std::streamsize)
+ *          Appends characters to the target.
+ */
+
+#include "OutputSink.h"
+
+
+/* Used std utilities */
+using std::ostream, std::string_view, std::streamsize;
+
+/*
+ * Pre-Conditions:
+ *      ostream reference to write to, outliving the sink.
+ *      true to write colour codes (optional, default isColoured()).
+ *
+ * Post-Conditions:
+ *      An empty OutputSink instance is created.
+ *
+ * Creates a sink writing to the given ostream.
+ * The buffer is reserved once, writes never grow it past kDrainBytes
+ * by more than a single value.
+ */
+OutputSink::OutputSink(ostream& out, bool coloured):
+        out{out}, coloured{coloured}, appender{buffer}, formatter{&appender} {
+    buffer.reserve(kDrainBytes);
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` OutputSink instance is not destroyed.
+ *
+ * Post-Conditions:
+ *      The buffered output is written to the ostream,
+ *      which is not flushed.
+ *
+ * Writes the buffered output, without flushing the ostream.
+ * Flushing is left to the caller, once per logical operation.
+ */
+OutputSink::~OutputSink() {
+    drain();
+}
+
+/*
+ * Pre-Conditions:
+ *      OutputSink is initialized.
+ *      Character to append.
+ *
+ * Post-Conditions:
+ *      The character is buffered.
+ *
+ * Appends a character.
+ */
+OutputSink& OutputSink::operator<<(char character) {
+    buffer.push_back(character);
+
+    if (buffer.size() >= kDrainBytes) {
+        drain();
+    }
+
+    return *this;
+}
+
+/*
+ * Pre-Conditions:
+ *      OutputSink is initialized.
+ *
+ * Post-Conditions:
+ *      Following text is cyan & bold, if colours are enabled.
+ *
+ * Starts cyan, bold text.
+ * This method of coloring text is not supported by Windows 10 cmd;
+ * use a terminal simulator.
+ */
+OutputSink& OutputSink::beginData() {
+    if (coloured) {
+        buffer.append("\033[36;1;1m");   /* Text becomes cyan, bold */
+    }
+
+    return *this;
+}
+
+/*
+ * Pre-Conditions:
+ *      OutputSink is initialized.
+ *
+ * Post-Conditions:
+ *      Following text is red & bold, if colours are enabled.
+ *
+ * Starts red, bold text.
+ */
+OutputSink& OutputSink::beginInvalid() {
+    if (coloured) {
+        buffer.append("\033[31;1;1m");   /* Text becomes red, bold */
+    }
+
+    return *this;
+}
+
+/*
+ * Pre-Conditions:
+ *      OutputSink is initialized.
+ *
+ * Post-Conditions:
+ *      Following text is normal.
+ *
+ * Returns to normal text.
+ */
+OutputSink& OutputSink::endColour() {
+    if (coloured) {
+        buffer.append("\033[0m");        /* Text becomes normal */
+    }
+
+    return *this;
+}
+
+/*
+ * Pre-Conditions:
+ *      OutputSink is initialized.
+ *      Error message.
+ *
+ * Post-Conditions:
+ *      The message is buffered as red, bold text.
+ *
+ * Appends an error message as red, bold text.
+ */
+OutputSink& OutputSink::invalid(string_view message) {
+    beginInvalid() << message;
+
+    return endColour();
+}
+
+/*
+ * Pre-Conditions:
+ *      OutputSink is initialized.
+ *
+ * Post-Conditions:
+ *      The buffered output is written & the ostream is flushed.
+ *
+ * Writes the buffered output & flushes the ostream.
+ */
+void OutputSink::flush() {
+    drain();
+    out.flush();
+}
+
+/*
+ * Pre-Conditions:
+ *      OutputSink is initialized.
+ *
+ * Post-Conditions:
+ *      The buffered output is written to the ostream, which is not
+ *      flushed, & the buffer is emptied.
+ *
+ * Writes the buffered output, keeping the buffer's capacity.
+ * A single write call per chunk.
+ */
+void OutputSink::drain() {
+    if (not buffer.empty()) {
+        out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      Character to append, or eof.
+ *
+ * Post-Conditions:
+ *      The character is appended to the target.
+ *
+ * Appends a single character to the target.
+ * Called by the formatter for every character it cannot buffer,
+ * which is all of them, the StringAppender has no buffer of its own.
+ */
+StringAppender::int_type StringAppender::overflow(int_type c) {
+    if (not traits_type::eq_int_type(c, traits_type::eof())) {
+        target.push_back(traits_type::to_char_type(c));
+    }
+
+    return traits_type::not_eof(c);
+}
+
+/*
+ * Pre-Conditions:
+ *      Characters to append & their count.
+ *
+ * Post-Conditions:
+ *      The characters are appended to the target.
+ *      Returns the count.
+ *
+ * Appends characters to the target.
+ * Called by the formatter for whole strings.
+ */
+streamsize StringAppender::xsputn(const char_type *characters,
+                                  streamsize count) {
+    target.append(characters, static_cast<std::size_t>(count));
+
+    return count;
+}
@@ -0,0 +1,321 @@
+/*
+ * URStack Project
+ *
+ *
+ * OutputSink.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the OutputSink class, a buffered writer
+ *              in front of an ostream, with optional colours, & of the
+ *              StringAppender class, the streambuf it formats values with.
+ *
+ * List of public StringAppender class Functions:
+ *      explicit StringAppender(std::string&)
+ *          Creates a streambuf appending to the given string.
+ *
+ * List of protected StringAppender class Functions:
+ *      int_type overflow(int_type)
+ *          Appends a single character to the target.
+ *
+ *      std::streamsize xsputn(const char_type*, std::streamsize)
+ *          Appends characters to the target.
+ *
+ * List of public OutputSink class Functions:
+ *      explicit OutputSink(std::ostream&, bool coloured = isColoured())
+ *          Creates a sink writing to the given ostream.
+ *
+ *      ~OutputSink()
+ *          Writes the buffered output, without flushing the ostream.
+ *
+ *      OutputSink& operator<<(char)
+ *          Appends a character.
+ *
+ *      template<class T>
+ *      OutputSink& operator<<(const T&)
+ *          Appends a value.
+ *
+ *      OutputSink& beginData()
+ *          Starts cyan, bold text.
+ *
+ *      OutputSink& beginInvalid()
+ *          Starts red, bold text.
+ *
+ *      OutputSink& endColour()
+ *          Returns to normal text.
+ *
+ *      template<class T>
+ *      OutputSink& data(const T&)
+ *          Appends a value as cyan, bold text.
+ *
+ *      OutputSink& invalid(std::string_view)
+ *          Appends an error message as red, bold text.
+ *
+ *      void flush()
+ *          Writes the buffered output & flushes the ostream.
+ *
+ *      inline bool hasColour() const
+ *          Used to check if the sink writes colour codes.
+ *
+ * List of private OutputSink class Functions:
+ *      void drain()
+ *          Writes the buffered output, keeping the buffer's capacity.
+ */
+
+#ifndef URSTACK_OUTPUTSINK_H
+#define URSTACK_OUTPUTSINK_H
+
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "GenericIO.cpp"
+
+
+/*
+ * streambuf appending everything written to it to a string,
+ * lets types with their own operator<< format straight into a buffer.
+ * Shared by OutputSink & ExportBuffer (see HistoryExport.h).
+ */
+class StringAppender: public std::streambuf {
+public:
+    /*
+     * Pre-Conditions:
+     *      Reference to the string to append to, outliving the streambuf.
+     *
+     * Post-Conditions:
+     *      A StringAppender instance appending to the string is created.
+     *
+     * Creates a streambuf appending to the given string.
+     */
+    explicit StringAppender(std::string& target): target{target} {}
+
+protected:
+    int_type overflow(int_type) override;
+
+    std::streamsize xsputn(const char_type*, std::streamsize) override;
+
+private:
+    std::string& target;
+};
+
+/*
+ * Collects output in a reusable buffer & writes it to an ostream in large
+ * chunks, so a logical operation costs one write & at most one flush.
+ * Colour codes are written once per coloured run of text,
+ * & not at all when colours are disabled.
+ */
+class OutputSink {
+public:
+    /*
+     * Number of buffered bytes written to the ostream at once.
+     */
+    static constexpr std::size_t kDrainBytes = 1 << 16;
+
+    /*
+     * Pre-Conditions:
+     *      ostream reference to write to, outliving the sink.
+     *      true to write colour codes (optional, default isColoured()).
+     *
+     * Post-Conditions:
+     *      An empty OutputSink instance is created.
+     *
+     * Creates a sink writing to the given ostream.
+     */
+    explicit OutputSink(std::ostream&, bool coloured = isColoured());
+
+    OutputSink(const OutputSink&) = delete;
+
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    /*
+     * Pre-Conditions:
+     *      `this` OutputSink instance is not destroyed.
+     *
+     * Post-Conditions:
+     *      The buffered output is written to the ostream,
+     *      which is not flushed.
+     *
+     * Writes the buffered output, without flushing the ostream.
+     */
+    ~OutputSink();
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *      Character to append.
+     *
+     * Post-Conditions:
+     *      The character is buffered.
+     *
+     * Appends a character.
+     */
+    OutputSink& operator<<(char);
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *      const reference to a string-like, arithmetic value,
+     *      or a type with operator<<(ostream&, const T&) defined.
+     *
+     * Post-Conditions:
+     *      The value is buffered.
+     *
+     * Appends a value.
+     * Strings are copied, integers are formatted with to_chars,
+     * other types go through their operator<< into the same buffer.
+     */
+    template<class T>
+    OutputSink& operator<<(const T& value) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            buffer.append(std::string_view{value});
+        } else if constexpr (std::is_integral_v<T>
+                             and not std::is_same_v<T, bool>) {
+            char digits[24];
+            auto result = std::to_chars(digits, digits + sizeof(digits),
+                                        value);
+
+            buffer.append(digits, result.ptr);
+        } else {
+            formatter << value;
+        }
+
+        if (buffer.size() >= kDrainBytes) {
+            drain();
+        }
+
+        return *this;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *
+     * Post-Conditions:
+     *      Following text is cyan & bold, if colours are enabled.
+     *
+     * Starts cyan, bold text.
+     */
+    OutputSink& beginData();
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *
+     * Post-Conditions:
+     *      Following text is red & bold, if colours are enabled.
+     *
+     * Starts red, bold text.
+     */
+    OutputSink& beginInvalid();
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *
+     * Post-Conditions:
+     *      Following text is normal.
+     *
+     * Returns to normal text.
+     */
+    OutputSink& endColour();
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *      const reference to a value accepted by operator<<.
+     *
+     * Post-Conditions:
+     *      The value is buffered as cyan, bold text.
+     *
+     * Appends a value as cyan, bold text.
+     */
+    template<class T>
+    OutputSink& data(const T& value) {
+        beginData() << value;
+
+        return endColour();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *      Error message.
+     *
+     * Post-Conditions:
+     *      The message is buffered as red, bold text.
+     *
+     * Appends an error message as red, bold text.
+     */
+    OutputSink& invalid(std::string_view);
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *
+     * Post-Conditions:
+     *      The buffered output is written & the ostream is flushed.
+     *
+     * Writes the buffered output & flushes the ostream.
+     */
+    void flush();
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *
+     * Post-Conditions:
+     *      True if colour codes are written, otherwise false.
+     *
+     * Used to check if the sink writes colour codes.
+     */
+    [[nodiscard]] inline bool hasColour() const {
+        return coloured;
+    }
+
+private:
+    /*
+     * Destination of the output.
+     */
+    std::ostream& out;
+
+    /*
+     * Whether colour codes are written.
+     */
+    bool coloured;
+
+    /*
+     * Output not written yet, its capacity is kept between writes.
+     */
+    std::string buffer;
+
+    /*
+     * Appends to buffer.
+     */
+    StringAppender appender;
+
+    /*
+     * Formats values with their operator<< through appender.
+     */
+    std::ostream formatter;
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink is initialized.
+     *
+     * Post-Conditions:
+     *      The buffered output is written to the ostream, which is not
+     *      flushed, & the buffer is emptied.
+     *
+     * Writes the buffered output, keeping the buffer's capacity.
+     */
+    void drain();
+};
+
+#endif //URSTACK_OUTPUTSINK_H
@@ -0,0 +1,625 @@
+/*
+ * URStack Project
+ *
+ *
+ * SegmentedURStack.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in
+ *              SegmentedURStack.h
+ *
+ * List of public SegmentedURStack<DataType> class Functions:
+ *      explicit SegmentedURStack(std::uint64_t capacity = kUnbounded)
+ *          Parameterized/Default constructor of the SegmentedURStack class.
+ *
+ *      ~SegmentedURStack()
+ *          Destructor for the SegmentedURStack class.
+ *
+ *      void insertNewAction(const DataType&)
+ *          Inserts a new action on top of the stack.
+ *
+ *      void insertNewAction(DataType&&)
+ *          Inserts a new action on top of the stack, moving it.
+ *
+ *      DataType* undo()
+ *          Undo the latest action in the stack.
+ *
+ *      DataType* redo()
+ *          Redo the latest undone action in the stack.
+ *
+ *      DataType* peek()
+ *          Returns the latest action in the stack, without undoing it.
+ *
+ *      const DataType& operator[](std::uint64_t) const
+ *          Returns the action N-hops away from top.
+ *
+ *      template<class Visitor>
+ *      std::uint64_t visitPrevious(Visitor&&) const
+ *          Visits every action that can be undone, newest first.
+ *
+ *      std::uint64_t trim(std::uint64_t)
+ *          Destroys up to N of the oldest actions.
+ *
+ *      OutputSink& displayAll(OutputSink&) const
+ *          Displays all actions in the stack to a sink.
+ *
+ *      OutputSink& displayPrevious(OutputSink&) const
+ *          Displays all existing actions in the stack to a sink.
+ *
+ *      OutputSink& displayNext(OutputSink&) const
+ *          Displays all deleted actions in the stack to a sink.
+ *
+ *      MemoryUsage memoryUsage() const
+ *          Returns the memory owned by the stack.
+ *
+ * List of private SegmentedURStack<DataType> class Functions:
+ *      void destroyOldest()
+ *          Destroys the oldest action.
+ *
+ *      void destroyNewest()
+ *          Destroys the newest action.
+ *
+ *      void releaseUnused()
+ *          Releases the segments after the newest action.
+ *
+ *      DataType* allocateSegment()
+ *          Returns the memory of a segment, reusing the spare if any.
+ *
+ *      void releaseSegment(DataType*)
+ *          Keeps the memory of a segment as the spare, or frees it.
+ *
+ *      OutputSink& displayRange(std::uint64_t begin, std::uint64_t end,
+ *                               OutputSink&, bool reverse) const
+ *          Displays the actions in a range.
+ */
+
+#ifndef URSTACK_SEGMENTEDURSTACK_CPP
+#define URSTACK_SEGMENTEDURSTACK_CPP
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "SegmentedURStack.h"
+
+
+/* Used std utilities */
+using std::uint64_t, std::size_t, std::string_view, std::invalid_argument,
+        std::out_of_range, std::exchange;
+
+/*
+ * Pre-Conditions:
+ *      Maximum number of actions (optional, default kUnbounded).
+ *
+ * Post-Conditions:
+ *      An empty stack is created, nothing is allocated.
+ *      Throws std::invalid_argument if the capacity is 0.
+ *
+ * Parameterized/Default constructor of the SegmentedURStack class.
+ */
+template<class DataType>
+SegmentedURStack<DataType>::SegmentedURStack(uint64_t capacity):
+        spare{nullptr}, capacity{capacity}, length{0}, size{0}, first{0} {
+    if (capacity == 0) {
+        throw invalid_argument("\nCapacity must be a positive integer.\n");
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      rvalue reference to a SegmentedURStack.
+ *
+ * Post-Conditions:
+ *      The segments are taken over, the actions are not moved.
+ *      The other stack is left empty.
+ */
+template<class DataType>
+SegmentedURStack<DataType>::SegmentedURStack(
+        SegmentedURStack&& other) noexcept:
+        segments{exchange(other.segments, {})},
+        spare{exchange(other.spare, nullptr)}, capacity{other.capacity},
+        length{exchange(other.length, 0)}, size{exchange(other.size, 0)},
+        first{exchange(other.first, 0)} {}
+
+/*
+ * Pre-Conditions:
+ *      rvalue reference to a SegmentedURStack.
+ *
+ * Post-Conditions:
+ *      The actions of `this` are destroyed, the segments of the other
+ *      stack are taken over. The other stack is left empty.
+ *      Returns reference to `this`.
+ */
+template<class DataType>
+SegmentedURStack<DataType>& SegmentedURStack<DataType>::operator=(
+        SegmentedURStack&& other) noexcept {
+    if (this != &other) {
+        this->~SegmentedURStack();
+        new(this) SegmentedURStack(std::move(other));
+    }
+
+    return *this;
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` SegmentedURStack instance is not destroyed.
+ *
+ * Post-Conditions:
+ *      Every action is destroyed, every segment is freed.
+ *
+ * Destructor for the SegmentedURStack class.
+ */
+template<class DataType>
+SegmentedURStack<DataType>::~SegmentedURStack() {
+    for (uint64_t index = 0; index < length; index++) {
+        at(index).~DataType();
+    }
+
+    std::allocator<DataType> allocator;
+
+    for (DataType *segment: segments) {
+        allocator.deallocate(segment, kSegmentEntries);
+    }
+
+    if (spare) {
+        allocator.deallocate(spare, kSegmentEntries);
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *      const reference to action to be added.
+ *
+ * Post-Conditions:
+ *      Same as insertNewAction(DataType&&), with a copy of the action.
+ *
+ * Inserts a new action on top of the stack.
+ * The copy is made before discarding, the action may be held by the
+ * stack itself, as in `stack.insertNewAction(*stack.peek())`.
+ * Parenthesised, as URStack::insertNewAction, so the action is copied.
+ */
+template<class DataType>
+void SegmentedURStack<DataType>::insertNewAction(const DataType& action) {
+    insertNewAction(DataType(action));
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *      rvalue reference to action to be added.
+ *
+ * Post-Conditions:
+ *      The undone actions are discarded, the action is moved on top
+ *      & is the latest action. If the stack is bounded & was full,
+ *      the oldest action is evicted.
+ *      If allocating or constructing throws, the undone actions are
+ *      already discarded & the stack is otherwise unchanged.
+ *
+ * Inserts a new action on top of the stack, moving it.
+ * A segment started for an action that failed to construct is kept,
+ * the next insert uses it.
+ */
+template<class DataType>
+void SegmentedURStack<DataType>::insertNewAction(DataType&& action) {
+    if (length > size) {
+        /* Newest first, as URStack discards them */
+        while (length > size) {
+            destroyNewest();
+        }
+
+        releaseUnused();
+    }
+
+    if (size == capacity) {
+        destroyOldest();
+    }
+
+    const uint64_t entry = first + length;
+
+    if (entry / kSegmentEntries == segments.size()) {
+        DataType *segment = allocateSegment();
+
+        try {
+            segments.push_back(segment);
+        } catch (...) {
+            releaseSegment(segment);
+            throw;
+        }
+    }
+
+    new(&segments[entry / kSegmentEntries][entry % kSegmentEntries])
+            DataType(std::move(action));
+
+    size = ++length;
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *
+ * Post-Conditions:
+ *      The latest action is undone (if possible).
+ *      Returns a pointer to its data, or nullptr if there was
+ *      no action to undo.
+ *
+ * Undo the latest action in the stack.
+ */
+template<class DataType>
+DataType* SegmentedURStack<DataType>::undo() {
+    if (size == 0) {
+        return nullptr;
+    }
+
+    return &at(--size);
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *
+ * Post-Conditions:
+ *      The latest undone action is redone (if possible).
+ *      Returns a pointer to its data, or nullptr if there was
+ *      no action to redo.
+ *
+ * Redo the latest undone action in the stack.
+ */
+template<class DataType>
+DataType* SegmentedURStack<DataType>::redo() {
+    if (size == length) {
+        return nullptr;
+    }
+
+    return &at(size++);
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *
+ * Post-Conditions:
+ *      Returns a pointer to the data of the latest action,
+ *      or nullptr if there are no actions to undo.
+ *
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `stack.peek();`.
+ * Returns the latest action in the stack, without undoing it.
+ */
+template<class DataType>
+DataType* SegmentedURStack<DataType>::peek() {
+    return size == 0 ? nullptr : &at(size - 1);
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *      Number of hops from top, less than getLength().
+ *
+ * Post-Conditions:
+ *      Returns the action N-hops away from top, undone or not, in O(1).
+ *      Throws std::out_of_range if there is no action there.
+ *
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `stack[5];`.
+ * The top is the newest held action, as in URStack::operator[].
+ */
+template<class DataType>
+const DataType& SegmentedURStack<DataType>::operator[](
+        uint64_t position) const {
+    if (position >= length) {
+        throw out_of_range("\nPosition out of range.\n");
+    }
+
+    return at(length - 1 - position);
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *      Callable taking a const DataType& reference.
+ *
+ * Post-Conditions:
+ *      The callable is invoked with every action that can be undone,
+ *      newest first. The stack is not modified.
+ *      Returns the number of visited actions.
+ *
+ * Visits every action that can be undone, newest first.
+ */
+template<class DataType>
+template<class Visitor>
+uint64_t SegmentedURStack<DataType>::visitPrevious(Visitor&& visit) const {
+    for (uint64_t index = size; index > 0; index--) {
+        visit(at(index - 1));
+    }
+
+    return size;
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *      Maximum number of actions to destroy.
+ *
+ * Post-Conditions:
+ *      Up to N of the oldest actions are destroyed, undone ones
+ *      only once every applied action is.
+ *      Every segment left empty is released.
+ *      Returns the number of destroyed actions.
+ *
+ * Destroys up to N of the oldest actions.
+ * O(1) per destroyed action, the segments are released as they empty.
+ */
+template<class DataType>
+uint64_t SegmentedURStack<DataType>::trim(uint64_t count) {
+    const uint64_t trimmed = count < length ? count : length;
+
+    for (uint64_t index = 0; index < trimmed; index++) {
+        destroyOldest();
+    }
+
+    return trimmed;
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays all actions to the given sink, newest first,
+ *      as URStack::displayAll.
+ *      Returns reference to the sink.
+ *
+ * Displays all actions in the stack to a sink.
+ */
+template<class DataType>
+OutputSink& SegmentedURStack<DataType>::displayAll(OutputSink& out) const {
+    if (length == 0) {
+        /* There are truly no actions */
+        return out.invalid("No actions");
+    }
+
+    return displayRange(0, length, out, false);
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays the actions that can be undone to the given sink,
+ *      newest first, as URStack::displayPrevious.
+ *      Returns reference to the sink.
+ *
+ * Displays all existing actions in the stack to a sink.
+ */
+template<class DataType>
+OutputSink& SegmentedURStack<DataType>::displayPrevious(
+        OutputSink& out) const {
+    if (size == 0) {
+        /* No actions to undo */
+        return out.data("No previous actions");
+    }
+
+    return displayRange(0, size, out, false);
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays the actions that can be redone to the given sink,
+ *      next redo first, as URStack::displayNext.
+ *      Returns reference to the sink.
+ *
+ * Displays all deleted actions in the stack to a sink.
+ */
+template<class DataType>
+OutputSink& SegmentedURStack<DataType>::displayNext(OutputSink& out) const {
+    if (size == length) {
+        /* No undone actions */
+        return out.data("No next actions");
+    }
+
+    return displayRange(size, length, out, true);
+}
+
+/*
+ * Pre-Conditions:
+ *      SegmentedURStack is initialized.
+ *
+ * Post-Conditions:
+ *      Returns the memory owned by the stack, in the fields of
+ *      URStack::memoryUsage: held actions as nodes, the unused
+ *      entries of the segments & the spare as pooled.
+ *
+ * Returns the memory owned by the stack.
+ * The heap memory of the actions themselves is not counted.
+ */
+template<class DataType>
+MemoryUsage SegmentedURStack<DataType>::memoryUsage() const {
+    MemoryUsage usage;
+
+    usage.object_bytes = sizeof(SegmentedURStack);
+    usage.nodes = static_cast<size_t>(length);
+    usage.node_bytes = usage.nodes * sizeof(DataType);
+    usage.payload_bytes = usage.node_bytes;
+    usage.redo_nodes = static_cast<size_t>(length - size);
+    usage.redo_bytes = usage.redo_nodes * sizeof(DataType);
+    usage.pooled_bytes = (segments.size() * kSegmentEntries - usage.nodes)
+                         * sizeof(DataType)
+                         + segments.size() * sizeof(DataType*);
+
+    if (spare) {
+        usage.pooled_bytes += kSegmentEntries * sizeof(DataType);
+    }
+
+    return usage;
+}
+
+/*
+ * Pre-Conditions:
+ *      At least one held action.
+ *
+ * Post-Conditions:
+ *      The oldest action is destroyed, its segment is released
+ *      if it is left empty.
+ */
+template<class DataType>
+void SegmentedURStack<DataType>::destroyOldest() {
+    at(0).~DataType();
+
+    /* The undone actions are the newest, the oldest is applied if any is */
+    if (size > 0) {
+        size--;
+    }
+
+    length--;
+
+    if (++first == kSegmentEntries) {
+        releaseSegment(segments.front());
+        segments.pop_front();
+        first = 0;
+    }
+
+    if (length == 0) {
+        releaseUnused();
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      At least one held action.
+ *
+ * Post-Conditions:
+ *      The newest action is destroyed.
+ *      Its segment is released by releaseUnused.
+ */
+template<class DataType>
+void SegmentedURStack<DataType>::destroyNewest() {
+    at(--length).~DataType();
+}
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Every segment after the one of the newest action is released,
+ *      the first one is kept. If no action is held, the next insert
+ *      starts at the beginning of the first segment.
+ *
+ * Releases the segments after the newest action.
+ */
+template<class DataType>
+void SegmentedURStack<DataType>::releaseUnused() {
+    if (length == 0) {
+        first = 0;
+    }
+
+    /* Segments needed by the held actions, at least the first one */
+    const uint64_t used = length == 0
+                          ? 1 : (first + length - 1) / kSegmentEntries + 1;
+
+    while (segments.size() > used) {
+        releaseSegment(segments.back());
+        segments.pop_back();
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Returns uninitialized memory for kSegmentEntries actions.
+ *      Throws std::bad_alloc if out of memory.
+ *
+ * Returns the memory of a segment, reusing the spare if any.
+ */
+template<class DataType>
+DataType* SegmentedURStack<DataType>::allocateSegment() {
+    if (spare) {
+        return exchange(spare, nullptr);
+    }
+
+    return std::allocator<DataType>{}.allocate(kSegmentEntries);
+}
+
+/*
+ * Pre-Conditions:
+ *      Memory of a segment holding no action.
+ *
+ * Post-Conditions:
+ *      The memory is the spare, or freed if there already is one.
+ *
+ * Keeps the memory of a segment as the spare, or frees it.
+ * A single spare is enough for a stack growing & shrinking across
+ * the end of a segment, more would only hold memory.
+ */
+template<class DataType>
+void SegmentedURStack<DataType>::releaseSegment(DataType *segment) {
+    if (spare) {
+        std::allocator<DataType>{}.deallocate(segment, kSegmentEntries);
+    } else {
+        spare = segment;
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      Index of the oldest action to display.
+ *      Index after the newest action to display, greater than begin.
+ *      OutputSink reference to display the output.
+ *      Whether the oldest action is displayed first.
+ *
+ * Post-Conditions:
+ *      Displays the actions separated by ", ".
+ *      Returns reference to the sink.
+ *
+ * Displays the actions in a range.
+ * Same output as URStack::displayDirectional, the segments are walked in
+ * either direction, without collecting the actions first.
+ */
+template<class DataType>
+OutputSink& SegmentedURStack<DataType>::displayRange(uint64_t begin,
+                                                     uint64_t end,
+                                                     OutputSink& out,
+                                                     bool reverse) const {
+    /* Separator between actions in the output */
+    static constexpr string_view kSep = ", ";
+
+    out.beginData();
+
+    if (reverse) {
+        for (uint64_t index = begin; index < end; index++) {
+            out << at(index);
+
+            if (index + 1 != end) {
+                out << kSep;
+            }
+        }
+    } else {
+        for (uint64_t index = end; index > begin; index--) {
+            out << at(index - 1);
+
+            if (index - 1 != begin) {
+                out << kSep;
+            }
+        }
+    }
+
+    return out.endColour();
+}
+
+#endif //URSTACK_SEGMENTEDURSTACK_CPP
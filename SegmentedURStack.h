@@ -0,0 +1,486 @@
+/*
+ * URStack Project
+ *
+ *
+ * SegmentedURStack.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the SegmentedURStack<DataType> class, an
+ *              undo/redo stack with the behaviour of URStack<DataType>,
+ *              unbounded by default & counted in 64 bits, for histories
+ *              that are never meant to fall off capacity, such as audits.
+ *
+ *              Actions are stored oldest first in fixed-size segments of
+ *              kSegmentEntries actions, like the blocks of a deque:
+ *                  an insert constructs the action at the end of the
+ *                  newest segment, starting a new one when it is full,
+ *                  so growing never relocates an action,
+ *                  trimming or evicting the oldest actions releases
+ *                  their segment wholesale once it is empty,
+ *                  every operation is O(1), discarding undone actions
+ *                  O(1) per discarded action.
+ *              A released segment is kept as the spare, reused by the
+ *              next segment.
+ *
+ * List of public SegmentedURStack<DataType> class Functions:
+ *      explicit SegmentedURStack(std::uint64_t capacity = kUnbounded)
+ *          Parameterized/Default constructor of the SegmentedURStack class.
+ *
+ *      ~SegmentedURStack()
+ *          Destructor for the SegmentedURStack class.
+ *
+ *      void insertNewAction(const DataType&)
+ *          Inserts a new action on top of the stack.
+ *
+ *      void insertNewAction(DataType&&)
+ *          Inserts a new action on top of the stack, moving it.
+ *
+ *      DataType* undo()
+ *          Undo the latest action in the stack.
+ *
+ *      DataType* redo()
+ *          Redo the latest undone action in the stack.
+ *
+ *      DataType* peek()
+ *          Returns the latest action in the stack, without undoing it.
+ *
+ *      const DataType& operator[](std::uint64_t) const
+ *          Returns the action N-hops away from top.
+ *
+ *      template<class Visitor>
+ *      std::uint64_t visitPrevious(Visitor&&) const
+ *          Visits every action that can be undone, newest first.
+ *
+ *      std::uint64_t trim(std::uint64_t)
+ *          Destroys up to N of the oldest actions.
+ *
+ *      OutputSink& displayAll(OutputSink&) const
+ *          Displays all actions in the stack to a sink.
+ *
+ *      OutputSink& displayPrevious(OutputSink&) const
+ *          Displays all existing actions in the stack to a sink.
+ *
+ *      OutputSink& displayNext(OutputSink&) const
+ *          Displays all deleted actions in the stack to a sink.
+ *
+ *      inline std::uint64_t getSize() const
+ *          Returns the number of actions in the stack.
+ *
+ *      inline std::uint64_t getCapacity() const
+ *          Returns the capacity of the stack.
+ *
+ *      inline std::uint64_t getLength() const
+ *          Returns the number of held actions, undone ones included.
+ *
+ *      MemoryUsage memoryUsage() const
+ *          Returns the memory owned by the stack.
+ *
+ * List of private SegmentedURStack<DataType> class Functions:
+ *      inline DataType& at(std::uint64_t)
+ *          Returns an action, counted from the oldest.
+ *
+ *      inline const DataType& at(std::uint64_t) const
+ *          Returns an action, counted from the oldest.
+ *
+ *      void destroyOldest()
+ *          Destroys the oldest action.
+ *
+ *      void destroyNewest()
+ *          Destroys the newest action.
+ *
+ *      void releaseUnused()
+ *          Releases the segments after the newest action.
+ *
+ *      DataType* allocateSegment()
+ *          Returns the memory of a segment, reusing the spare if any.
+ *
+ *      void releaseSegment(DataType*)
+ *          Keeps the memory of a segment as the spare, or frees it.
+ *
+ *      OutputSink& displayRange(std::uint64_t begin, std::uint64_t end,
+ *                               OutputSink&, bool reverse) const
+ *          Displays the actions in a range.
+ */
+
+#ifndef URSTACK_SEGMENTEDURSTACK_H
+#define URSTACK_SEGMENTEDURSTACK_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+
+#include "OutputSink.h"
+#include "URStackMemory.h"
+
+
+/*
+ * Unbounded stack with redo/undo functionality, in segments.
+ */
+template<class DataType>
+class SegmentedURStack {
+public:
+    /* Capacity of a stack that never evicts */
+    static constexpr std::uint64_t kUnbounded =
+            std::numeric_limits<std::uint64_t>::max();
+
+    /* Actions per segment, about 4 KiB of them, at least 16 */
+    static constexpr std::size_t kSegmentEntries =
+            std::max<std::size_t>(16, 4096 / sizeof(DataType));
+
+    /*
+     * Pre-Conditions:
+     *      Maximum number of actions (optional, default kUnbounded).
+     *
+     * Post-Conditions:
+     *      An empty stack is created, nothing is allocated.
+     *      Throws std::invalid_argument if the capacity is 0.
+     *
+     * Parameterized/Default constructor of the SegmentedURStack class.
+     */
+    explicit SegmentedURStack(std::uint64_t capacity = kUnbounded);
+
+    SegmentedURStack(SegmentedURStack&&) noexcept;
+
+    SegmentedURStack& operator=(SegmentedURStack&&) noexcept;
+
+    SegmentedURStack(const SegmentedURStack&) = delete;
+
+    SegmentedURStack& operator=(const SegmentedURStack&) = delete;
+
+    /*
+     * Pre-Conditions:
+     *      `this` SegmentedURStack instance is not destroyed.
+     *
+     * Post-Conditions:
+     *      Every action is destroyed, every segment is freed.
+     *
+     * Destructor for the SegmentedURStack class.
+     */
+    ~SegmentedURStack();
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *      const reference to action to be added.
+     *
+     * Post-Conditions:
+     *      Same as insertNewAction(DataType&&), with a copy of the action.
+     *
+     * Inserts a new action on top of the stack.
+     */
+    void insertNewAction(const DataType&);
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *      rvalue reference to action to be added.
+     *
+     * Post-Conditions:
+     *      The undone actions are discarded, the action is moved on top
+     *      & is the latest action. If the stack is bounded & was full,
+     *      the oldest action is evicted.
+     *      If allocating or constructing throws, the undone actions are
+     *      already discarded & the stack is otherwise unchanged.
+     *
+     * Inserts a new action on top of the stack, moving it.
+     */
+    void insertNewAction(DataType&&);
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *
+     * Post-Conditions:
+     *      The latest action is undone (if possible).
+     *      Returns a pointer to its data, or nullptr if there was
+     *      no action to undo.
+     *
+     * Undo the latest action in the stack.
+     * The returned pointer stays valid until the action is discarded,
+     * evicted or trimmed.
+     */
+    DataType* undo();
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *
+     * Post-Conditions:
+     *      The latest undone action is redone (if possible).
+     *      Returns a pointer to its data, or nullptr if there was
+     *      no action to redo.
+     *
+     * Redo the latest undone action in the stack.
+     */
+    DataType* redo();
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *
+     * Post-Conditions:
+     *      Returns a pointer to the data of the latest action,
+     *      or nullptr if there are no actions to undo.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `stack.peek();`.
+     * Returns the latest action in the stack, without undoing it.
+     */
+    [[nodiscard]] DataType* peek();
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *      Number of hops from top, less than getLength().
+     *
+     * Post-Conditions:
+     *      Returns the action N-hops away from top, undone or not, in O(1).
+     *      Throws std::out_of_range if there is no action there.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `stack[5];`.
+     * Returns the action N-hops away from top.
+     */
+    [[nodiscard]] const DataType& operator[](std::uint64_t) const;
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *      Callable taking a const DataType& reference.
+     *
+     * Post-Conditions:
+     *      The callable is invoked with every action that can be undone,
+     *      newest first. The stack is not modified.
+     *      Returns the number of visited actions.
+     *
+     * Visits every action that can be undone, newest first.
+     */
+    template<class Visitor>
+    std::uint64_t visitPrevious(Visitor&&) const;
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *      Maximum number of actions to destroy.
+     *
+     * Post-Conditions:
+     *      Up to N of the oldest actions are destroyed, undone ones
+     *      only once every applied action is.
+     *      Every segment left empty is released.
+     *      Returns the number of destroyed actions.
+     *
+     * Destroys up to N of the oldest actions.
+     */
+    std::uint64_t trim(std::uint64_t);
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Displays all actions to the given sink, newest first,
+     *      as URStack::displayAll.
+     *      Returns reference to the sink.
+     *
+     * Displays all actions in the stack to a sink.
+     */
+    OutputSink& displayAll(OutputSink&) const;
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Displays the actions that can be undone to the given sink,
+     *      newest first, as URStack::displayPrevious.
+     *      Returns reference to the sink.
+     *
+     * Displays all existing actions in the stack to a sink.
+     */
+    OutputSink& displayPrevious(OutputSink&) const;
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Displays the actions that can be redone to the given sink,
+     *      next redo first, as URStack::displayNext.
+     *      Returns reference to the sink.
+     *
+     * Displays all deleted actions in the stack to a sink.
+     */
+    OutputSink& displayNext(OutputSink&) const;
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of actions that can be undone.
+     */
+    [[nodiscard]] inline std::uint64_t getSize() const {
+        return size;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the maximum number of actions, kUnbounded if none.
+     */
+    [[nodiscard]] inline std::uint64_t getCapacity() const {
+        return capacity;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of held actions, undone ones included.
+     */
+    [[nodiscard]] inline std::uint64_t getLength() const {
+        return length;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      SegmentedURStack is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the memory owned by the stack, in the fields of
+     *      URStack::memoryUsage: held actions as nodes, the unused
+     *      entries of the segments & the spare as pooled.
+     *
+     * Returns the memory owned by the stack.
+     */
+    [[nodiscard]] MemoryUsage memoryUsage() const;
+
+private:
+    /* Segments of kSegmentEntries actions, oldest first */
+    std::deque<DataType*> segments;
+
+    /* Released segment, reused by the next one */
+    DataType *spare;
+
+    std::uint64_t capacity;
+
+    /* Held actions, undone ones included */
+    std::uint64_t length;
+
+    /* The oldest applied actions, all the others are undone */
+    std::uint64_t size;
+
+    /* Entry of the oldest action in the first segment */
+    std::size_t first;
+
+    /*
+     * Pre-Conditions:
+     *      Index of a held action, from the oldest.
+     *
+     * Post-Conditions:
+     *      Returns a reference to the action.
+     */
+    inline DataType& at(std::uint64_t index) {
+        const std::uint64_t entry = first + index;
+
+        return segments[entry / kSegmentEntries][entry % kSegmentEntries];
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Index of a held action, from the oldest.
+     *
+     * Post-Conditions:
+     *      Returns a const reference to the action.
+     */
+    inline const DataType& at(std::uint64_t index) const {
+        const std::uint64_t entry = first + index;
+
+        return segments[entry / kSegmentEntries][entry % kSegmentEntries];
+    }
+
+    /*
+     * Pre-Conditions:
+     *      At least one held action.
+     *
+     * Post-Conditions:
+     *      The oldest action is destroyed, its segment is released
+     *      if it is left empty.
+     */
+    void destroyOldest();
+
+    /*
+     * Pre-Conditions:
+     *      At least one held action.
+     *
+     * Post-Conditions:
+     *      The newest action is destroyed.
+     *      Its segment is released by releaseUnused.
+     */
+    void destroyNewest();
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Every segment after the one of the newest action is released,
+     *      the first one is kept. If no action is held, the next insert
+     *      starts at the beginning of the first segment.
+     *
+     * Releases the segments after the newest action.
+     */
+    void releaseUnused();
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns uninitialized memory for kSegmentEntries actions.
+     *      Throws std::bad_alloc if out of memory.
+     *
+     * Returns the memory of a segment, reusing the spare if any.
+     */
+    DataType* allocateSegment();
+
+    /*
+     * Pre-Conditions:
+     *      Memory of a segment holding no action.
+     *
+     * Post-Conditions:
+     *      The memory is the spare, or freed if there already is one.
+     *
+     * Keeps the memory of a segment as the spare, or frees it.
+     */
+    void releaseSegment(DataType*);
+
+    /*
+     * Pre-Conditions:
+     *      Index of the oldest action to display.
+     *      Index after the newest action to display, greater than begin.
+     *      OutputSink reference to display the output.
+     *      Whether the oldest action is displayed first.
+     *
+     * Post-Conditions:
+     *      Displays the actions separated by ", ".
+     *      Returns reference to the sink.
+     *
+     * Displays the actions in a range.
+     */
+    OutputSink& displayRange(std::uint64_t begin, std::uint64_t end,
+                             OutputSink&, bool reverse) const;
+};
+
+#endif //URSTACK_SEGMENTEDURSTACK_H
@@ -0,0 +1,278 @@
+/*
+ * URStack Project
+ *
+ *
+ * StringSearch.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in StringSearch.h
+ *
+ * List of Functions:
+ *      SearchKernel getSearchKernel()
+ *          Returns the fastest kernel supported by the CPU.
+ *
+ *      bool isSupported(SearchKernel)
+ *          Returns whether the CPU can run the given kernel.
+ *
+ *      const char* getName(SearchKernel)
+ *          Returns the name of a kernel.
+ *
+ *      std::size_t findSubstring(std::string_view, std::string_view)
+ *          Returns the offset of the first occurrence of a needle,
+ *          with the fastest kernel.
+ *
+ *      std::size_t findSubstring(std::string_view, std::string_view,
+ *                                SearchKernel)
+ *          Returns the offset of the first occurrence of a needle,
+ *          with the given kernel.
+ *
+ * List of private Functions:
+ *      static std::size_t findSse2(std::string_view, std::string_view)
+ *          SSE2 kernel of findSubstring.
+ *
+ *      static std::size_t findAvx2(std::string_view, std::string_view)
+ *          AVX2 kernel of findSubstring.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "StringSearch.h"
+
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+#include <immintrin.h>
+#endif
+
+
+/* Used std utilities */
+using std::size_t, std::string_view, std::uint32_t;
+
+#if defined(__GNUC__) and defined(__SSE2__)
+
+/*
+ * Pre-Conditions:
+ *      Text to search.
+ *      Text to search for.
+ *
+ * Post-Conditions:
+ *      Same as findSubstring.
+ *
+ * SSE2 kernel of findSubstring.
+ * Every 16 positions, the bytes under the first & the last byte of the
+ * needle are compared at once, the whole needle only where both match.
+ * The positions left at the end are searched by string_view::find.
+ */
+static size_t findSse2(string_view haystack, string_view needle) {
+    const size_t length = needle.size();
+
+    if (length == 0 or length > haystack.size()) {
+        return haystack.find(needle);
+    }
+
+    const char *text = haystack.data();
+    const __m128i first = _mm_set1_epi8(needle.front());
+    const __m128i last = _mm_set1_epi8(needle.back());
+    size_t position = 0;
+
+    /* The last byte of the needle is read up to position + length + 14 */
+    for (; position + length + 15 <= haystack.size(); position += 16) {
+        const __m128i at_first = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(text + position));
+        const __m128i at_last = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(text + position
+                                                 + length - 1));
+        auto candidates = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(first, at_first),
+                              _mm_cmpeq_epi8(last, at_last))));
+
+        while (candidates) {
+            const size_t found = position + __builtin_ctz(candidates);
+
+            /* First & last bytes already match */
+            if (length <= 2 or not std::memcmp(text + found + 1,
+                                               needle.data() + 1,
+                                               length - 2)) {
+                return found;
+            }
+
+            candidates &= candidates - 1;
+        }
+    }
+
+    return haystack.find(needle, position);
+}
+
+#endif
+
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+
+/*
+ * Pre-Conditions:
+ *      Text to search.
+ *      Text to search for.
+ *      The CPU supports AVX2.
+ *
+ * Post-Conditions:
+ *      Same as findSubstring.
+ *
+ * AVX2 kernel of findSubstring, findSse2 with 32 positions at a time.
+ * Compiled for AVX2 on its own, the rest of the program is not.
+ */
+__attribute__((target("avx2")))
+static size_t findAvx2(string_view haystack, string_view needle) {
+    const size_t length = needle.size();
+
+    if (length == 0 or length > haystack.size()) {
+        return haystack.find(needle);
+    }
+
+    const char *text = haystack.data();
+    const __m256i first = _mm256_set1_epi8(needle.front());
+    const __m256i last = _mm256_set1_epi8(needle.back());
+    size_t position = 0;
+
+    /* The last byte of the needle is read up to position + length + 30 */
+    for (; position + length + 31 <= haystack.size(); position += 32) {
+        const __m256i at_first = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(text + position));
+        const __m256i at_last = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(text + position
+                                                 + length - 1));
+        auto candidates = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(first, at_first),
+                                 _mm256_cmpeq_epi8(last, at_last))));
+
+        while (candidates) {
+            const size_t found = position + __builtin_ctz(candidates);
+
+            /* First & last bytes already match */
+            if (length <= 2 or not std::memcmp(text + found + 1,
+                                               needle.data() + 1,
+                                               length - 2)) {
+                return found;
+            }
+
+            candidates &= candidates - 1;
+        }
+    }
+
+    return haystack.find(needle, position);
+}
+
+#endif
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Returns kAvx2, kSse2 or kScalar, the first the CPU supports.
+ *      Detected once, on the first call.
+ *
+ * Returns the fastest kernel supported by the CPU.
+ */
+SearchKernel getSearchKernel() {
+    static const SearchKernel kernel = isSupported(SearchKernel::kAvx2)
+                                       ? SearchKernel::kAvx2
+                                       : isSupported(SearchKernel::kSse2)
+                                         ? SearchKernel::kSse2
+                                         : SearchKernel::kScalar;
+
+    return kernel;
+}
+
+/*
+ * Pre-Conditions:
+ *      A kernel.
+ *
+ * Post-Conditions:
+ *      Returns true if the kernel was compiled in & the CPU runs it.
+ *
+ * Returns whether the CPU can run the given kernel.
+ */
+bool isSupported(SearchKernel kernel) {
+    switch (kernel) {
+        case SearchKernel::kScalar:
+            return true;
+        case SearchKernel::kSse2:
+#if defined(__GNUC__) and defined(__SSE2__)
+            return true;
+#else
+            return false;
+#endif
+        case SearchKernel::kAvx2:
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+    }
+
+    return false;
+}
+
+/*
+ * Pre-Conditions:
+ *      A kernel.
+ *
+ * Post-Conditions:
+ *      Returns the name of the kernel.
+ */
+const char* getName(SearchKernel kernel) {
+    switch (kernel) {
+        case SearchKernel::kSse2:
+            return "sse2";
+        case SearchKernel::kAvx2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      Text to search.
+ *      Text to search for.
+ *
+ * Post-Conditions:
+ *      Returns the offset of the first occurrence of the needle in the
+ *      haystack, 0 for an empty needle, std::string_view::npos if none.
+ *
+ * Returns the offset of the first occurrence of a needle,
+ * with the fastest kernel.
+ */
+size_t findSubstring(string_view haystack, string_view needle) {
+    return findSubstring(haystack, needle, getSearchKernel());
+}
+
+/*
+ * Pre-Conditions:
+ *      Text to search.
+ *      Text to search for.
+ *      Kernel supported by the CPU, see isSupported.
+ *
+ * Post-Conditions:
+ *      Same as findSubstring(std::string_view, std::string_view).
+ *
+ * Returns the offset of the first occurrence of a needle,
+ * with the given kernel.
+ * Kernels that are not compiled in fall back to the scalar one.
+ */
+size_t findSubstring(string_view haystack, string_view needle,
+                     SearchKernel kernel) {
+    switch (kernel) {
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+        case SearchKernel::kAvx2:
+            return findAvx2(haystack, needle);
+#endif
+#if defined(__GNUC__) and defined(__SSE2__)
+        case SearchKernel::kSse2:
+            return findSse2(haystack, needle);
+#endif
+        default:
+            return haystack.find(needle);
+    }
+}
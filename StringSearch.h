@@ -0,0 +1,123 @@
+/*
+ * URStack Project
+ *
+ *
+ * StringSearch.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Substring search kernels used to search the history of
+ *              string actions: a scalar one, & vectorised SSE2 & AVX2
+ *              ones on x86, picked once at startup from the CPU.
+ *
+ *              The vectorised kernels compare the first & last byte of
+ *              the needle against 16 or 32 positions of the haystack at
+ *              once, & only compare the whole needle where both match,
+ *              so most of the haystack is rejected without a branch.
+ *
+ * List of Functions:
+ *      SearchKernel getSearchKernel()
+ *          Returns the fastest kernel supported by the CPU.
+ *
+ *      bool isSupported(SearchKernel)
+ *          Returns whether the CPU can run the given kernel.
+ *
+ *      const char* getName(SearchKernel)
+ *          Returns the name of a kernel.
+ *
+ *      std::size_t findSubstring(std::string_view, std::string_view)
+ *          Returns the offset of the first occurrence of a needle,
+ *          with the fastest kernel.
+ *
+ *      std::size_t findSubstring(std::string_view, std::string_view,
+ *                                SearchKernel)
+ *          Returns the offset of the first occurrence of a needle,
+ *          with the given kernel.
+ */
+
+#ifndef URSTACK_STRINGSEARCH_H
+#define URSTACK_STRINGSEARCH_H
+
+#include <cstddef>
+#include <string_view>
+
+
+/*
+ * Implementations of findSubstring.
+ */
+enum class SearchKernel {
+    /* std::string_view::find, available everywhere */
+    kScalar,
+
+    /* 16 positions at a time, x86 only */
+    kSse2,
+
+    /* 32 positions at a time, x86 CPUs with AVX2 only */
+    kAvx2
+};
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Returns kAvx2, kSse2 or kScalar, the first the CPU supports.
+ *      Detected once, on the first call.
+ *
+ * Returns the fastest kernel supported by the CPU.
+ */
+SearchKernel getSearchKernel();
+
+/*
+ * Pre-Conditions:
+ *      A kernel.
+ *
+ * Post-Conditions:
+ *      Returns true if the kernel was compiled in & the CPU runs it.
+ *
+ * Returns whether the CPU can run the given kernel.
+ */
+bool isSupported(SearchKernel);
+
+/*
+ * Pre-Conditions:
+ *      A kernel.
+ *
+ * Post-Conditions:
+ *      Returns the name of the kernel.
+ */
+const char* getName(SearchKernel);
+
+/*
+ * Pre-Conditions:
+ *      Text to search.
+ *      Text to search for.
+ *
+ * Post-Conditions:
+ *      Returns the offset of the first occurrence of the needle in the
+ *      haystack, 0 for an empty needle, std::string_view::npos if none.
+ *
+ * Returns the offset of the first occurrence of a needle,
+ * with the fastest kernel.
+ */
+std::size_t findSubstring(std::string_view /* haystack */,
+                          std::string_view /* needle */);
+
+/*
+ * Pre-Conditions:
+ *      Text to search.
+ *      Text to search for.
+ *      Kernel supported by the CPU, see isSupported.
+ *
+ * Post-Conditions:
+ *      Same as findSubstring(std::string_view, std::string_view).
+ *
+ * Returns the offset of the first occurrence of a needle,
+ * with the given kernel.
+ */
+std::size_t findSubstring(std::string_view /* haystack */,
+                          std::string_view /* needle */, SearchKernel);
+
+#endif //URSTACK_STRINGSEARCH_H
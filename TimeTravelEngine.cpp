@@ -0,0 +1,279 @@
+/*
+ * URStack Project
+ *
+ *
+ * TimeTravelEngine.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in TimeTravelEngine.h
+ *
+ * List of public TimeTravelEngine<State> class Functions:
+ *      explicit TimeTravelEngine(State, int capacity = 20,
+ *                                CheckpointPolicy = {})
+ *          Parameterized/Default constructor of the TimeTravelEngine class.
+ *
+ *      template<class Apply, class Revert>
+ *      void execute(Apply&&, Revert&&, double cost = 1)
+ *          Applies a new command & records it.
+ *
+ *      void execute(Command<State>&&, double cost = 1)
+ *          Applies the given command & records it.
+ *
+ *      int undo(int count = 1)
+ *          Reverts up to N commands.
+ *
+ *      int redo(int count = 1)
+ *          Applies up to N reverted commands again.
+ *
+ *      State stateAt(std::uint64_t) const
+ *          Materialises the state at the given position.
+ *
+ * List of private TimeTravelEngine<State> class Functions:
+ *      std::size_t checkpointBelow(std::uint64_t) const
+ *          Finds the checkpoint to replay a position from.
+ *
+ *      void evictOldest()
+ *          Evicts the oldest command & the checkpoints it covers.
+ */
+
+#ifndef URSTACK_TIMETRAVELENGINE_CPP
+#define URSTACK_TIMETRAVELENGINE_CPP
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "CommandEngine.cpp"
+#include "TimeTravelEngine.h"
+
+
+/*
+ * Pre-Conditions:
+ *      Initial target state (optional, default constructed).
+ *      Capacity of the history (optional, default 20).
+ *      Checkpoint policy (optional, a checkpoint every 64 commands).
+ *
+ * Post-Conditions:
+ *      TimeTravelEngine instance is created with an empty history.
+ *      Position 0 is checkpointed with the initial state.
+ *
+ * Parameterized/Default constructor of the TimeTravelEngine class.
+ */
+template<class State>
+TimeTravelEngine<State>::TimeTravelEngine(State initial, int capacity,
+                                          CheckpointPolicy checkpointing):
+        state{std::move(initial)}, history{capacity},
+        policy{checkpointing}, position{0} {
+    if (policy.interval <= 0) {
+        throw std::invalid_argument(
+                "\nCheckpoint interval must be a positive integer.\n");
+    }
+
+    checkpoints.push_back(Checkpoint{0, 0, state});
+}
+
+/*
+ * Pre-Conditions:
+ *      TimeTravelEngine is initialized.
+ *      Callable taking a State& reference, applying the command.
+ *      Callable taking a State& reference, reverting the command.
+ *      Replay cost of the command (optional, default 1).
+ *
+ * Post-Conditions:
+ *      Same as execute(Command<State>&&, double).
+ *
+ * Applies a new command & records it.
+ */
+template<class State>
+template<class Apply, class Revert>
+void TimeTravelEngine<State>::execute(Apply&& apply, Revert&& revert,
+                                      double cost) {
+    execute(Command<State>{std::forward<Apply>(apply),
+                           std::forward<Revert>(revert)}, cost);
+}
+
+/*
+ * Pre-Conditions:
+ *      TimeTravelEngine is initialized.
+ *      rvalue reference to a command.
+ *      Replay cost of the command (optional, default 1).
+ *
+ * Post-Conditions:
+ *      The command is applied to the state, then recorded.
+ *      Undone positions & their checkpoints are discarded.
+ *      If the history is full, the oldest command & the checkpoints
+ *      it covers are evicted.
+ *      A checkpoint is taken if the policy requires it.
+ *      If applying throws, nothing is recorded.
+ *
+ * Applies the given command & records it.
+ * Mirrors what URStack::insertNewAction does to the Nodes,
+ * so steps stays aligned with history.
+ */
+template<class State>
+void TimeTravelEngine<State>::execute(Command<State>&& command, double cost) {
+    command.apply(state);
+
+    /* The undone positions are discarded by insertNewAction */
+    steps.resize(position - getFirstPosition());
+
+    while (checkpoints.back().position > position) {
+        checkpoints.pop_back();
+    }
+
+    /* A full history evicts its oldest Node on insertion */
+    if (history.getSize() == history.getCapacity()) {
+        evictOldest();
+    }
+
+    const double total = (steps.empty() ? checkpoints.front().cost
+                                        : steps.back().cost) + cost;
+
+    history.insertNewAction(std::move(command));
+    steps.push_back(Step{history.peek(), total});
+    position++;
+
+    /* The last checkpoint is now the nearest one below position */
+    const Checkpoint& nearest = checkpoints.back();
+
+    if (position - nearest.position
+            >= static_cast<std::uint64_t>(policy.interval)
+        or (policy.cost_budget > 0
+            and total - nearest.cost >= policy.cost_budget)) {
+        checkpoints.push_back(Checkpoint{position, total, state});
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      TimeTravelEngine is initialized.
+ *      Maximum number of commands to revert (optional, default 1).
+ *
+ * Post-Conditions:
+ *      Up to N commands are reverted, newest first.
+ *      Returns the number of reverted commands.
+ *
+ * Reverts up to N commands.
+ * Checkpoints above the new position are kept for redo.
+ */
+template<class State>
+int TimeTravelEngine<State>::undo(int count) {
+    return history.undo(count, [this](Command<State>& command) {
+        command.revert(state);
+        position--;
+    });
+}
+
+/*
+ * Pre-Conditions:
+ *      TimeTravelEngine is initialized.
+ *      Maximum number of commands to apply (optional, default 1).
+ *
+ * Post-Conditions:
+ *      Up to N reverted commands are applied, oldest first.
+ *      Returns the number of applied commands.
+ *
+ * Applies up to N reverted commands again.
+ */
+template<class State>
+int TimeTravelEngine<State>::redo(int count) {
+    return history.redo(count, [this](Command<State>& command) {
+        command.apply(state);
+        position++;
+    });
+}
+
+/*
+ * Pre-Conditions:
+ *      TimeTravelEngine is initialized.
+ *      Position between getFirstPosition() & getLastPosition().
+ *
+ * Post-Conditions:
+ *      Returns a copy of the state at the given position.
+ *      Throws std::out_of_range if the position is not retained.
+ *
+ * Materialises the state at the given position.
+ * Copies the nearest checkpoint below the position & replays the commands
+ * after it, at most one interval of them.
+ * The current position is served from the current state.
+ */
+template<class State>
+State TimeTravelEngine<State>::stateAt(std::uint64_t target) const {
+    const std::uint64_t first = getFirstPosition();
+
+    if (target < first or target > getLastPosition()) {
+        throw std::out_of_range("\nPosition is not retained.\n");
+    }
+
+    if (target == position) {
+        return state;
+    }
+
+    const Checkpoint& nearest = checkpoints[checkpointBelow(target)];
+    State result = nearest.state;
+
+    for (std::uint64_t at = nearest.position; at < target; at++) {
+        steps[at - first].command->apply(result);
+    }
+
+    return result;
+}
+
+/*
+ * Pre-Conditions:
+ *      TimeTravelEngine is initialized.
+ *      Position between getFirstPosition() & getLastPosition().
+ *
+ * Post-Conditions:
+ *      Returns the index of the nearest checkpoint at or below
+ *      the given position.
+ *
+ * Finds the checkpoint to replay a position from.
+ * Binary search, checkpoints are sorted by position.
+ */
+template<class State>
+std::size_t TimeTravelEngine<State>::checkpointBelow(
+        std::uint64_t target) const {
+    auto above = std::upper_bound(
+            checkpoints.begin(), checkpoints.end(), target,
+            [](std::uint64_t at, const Checkpoint& checkpoint) {
+                return at < checkpoint.position;
+            });
+
+    /* The first checkpoint is at or below every retained position */
+    return static_cast<std::size_t>(above - checkpoints.begin()) - 1;
+}
+
+/*
+ * Pre-Conditions:
+ *      The history is full & about to evict its oldest command.
+ *
+ * Post-Conditions:
+ *      The first checkpoint is moved one position up,
+ *      the oldest step is dropped.
+ *
+ * Evicts the oldest command & the checkpoints it covers.
+ * The first checkpoint is rolled forward by applying the evicted command,
+ * unless the next checkpoint already covers the new first position.
+ * Either way it costs at most one replay.
+ */
+template<class State>
+void TimeTravelEngine<State>::evictOldest() {
+    Checkpoint& first = checkpoints.front();
+    Step& oldest = steps.front();
+
+    if (checkpoints.size() > 1
+        and checkpoints[1].position == first.position + 1) {
+        checkpoints.pop_front();
+    } else {
+        oldest.command->apply(first.state);
+        first.position++;
+        first.cost = oldest.cost;
+    }
+
+    steps.pop_front();
+}
+
+#endif //URSTACK_TIMETRAVELENGINE_CPP
@@ -0,0 +1,324 @@
+/*
+ * URStack Project
+ *
+ *
+ * TimeTravelEngine.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the TimeTravelEngine<State> class,
+ *              a command engine keeping periodic checkpoints of its state,
+ *              so the state at any retained history position can be
+ *              materialised with a bounded number of replays.
+ *
+ *              Positions count applied commands since the engine was
+ *              created, along the current line of history.
+ *              Position P is the state after P commands.
+ *
+ * List of public TimeTravelEngine<State> class Functions:
+ *      explicit TimeTravelEngine(State, int capacity = 20,
+ *                                CheckpointPolicy = {})
+ *          Parameterized/Default constructor of the TimeTravelEngine class.
+ *
+ *      template<class Apply, class Revert>
+ *      void execute(Apply&&, Revert&&, double cost = 1)
+ *          Applies a new command & records it.
+ *
+ *      void execute(Command<State>&&, double cost = 1)
+ *          Applies the given command & records it.
+ *
+ *      int undo(int count = 1)
+ *          Reverts up to N commands.
+ *
+ *      int redo(int count = 1)
+ *          Applies up to N reverted commands again.
+ *
+ *      State stateAt(std::uint64_t) const
+ *          Materialises the state at the given position.
+ *
+ *      inline const State& getState() const
+ *          Returns the current state.
+ *
+ *      inline std::uint64_t getPosition() const
+ *          Returns the current position.
+ *
+ *      inline std::uint64_t getFirstPosition() const
+ *          Returns the oldest retained position.
+ *
+ *      inline std::uint64_t getLastPosition() const
+ *          Returns the newest retained position, including undone ones.
+ *
+ *      inline std::size_t getCheckpointCount() const
+ *          Returns the number of stored checkpoints.
+ */
+
+#ifndef URSTACK_TIMETRAVELENGINE_H
+#define URSTACK_TIMETRAVELENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+#include "CommandEngine.h"
+#include "URStack.h"
+
+
+/*
+ * Decides when TimeTravelEngine takes a checkpoint.
+ * A checkpoint is taken as soon as either limit is reached
+ * since the nearest checkpoint below the current position.
+ */
+struct CheckpointPolicy {
+    /* Maximum number of commands between checkpoints (K) */
+    int interval = 64;
+
+    /* Maximum replay cost between checkpoints, 0 disables the cost model */
+    double cost_budget = 0;
+};
+
+/*
+ * Command engine able to materialise its state at any retained position.
+ */
+template<class State>
+class TimeTravelEngine {
+public:
+    /*
+     * Pre-Conditions:
+     *      Initial target state (optional, default constructed).
+     *      Capacity of the history (optional, default 20).
+     *      Checkpoint policy (optional, a checkpoint every 64 commands).
+     *
+     * Post-Conditions:
+     *      TimeTravelEngine instance is created with an empty history.
+     *      Position 0 is checkpointed with the initial state.
+     *      Throws std::invalid_argument if the capacity or the interval
+     *      is not positive.
+     *
+     * Parameterized/Default constructor of the TimeTravelEngine class.
+     */
+    explicit TimeTravelEngine(State = State{}, int capacity = 20,
+                              CheckpointPolicy = {});
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *      Callable taking a State& reference, applying the command.
+     *      Callable taking a State& reference, reverting the command.
+     *      Replay cost of the command (optional, default 1).
+     *
+     * Post-Conditions:
+     *      Same as execute(Command<State>&&, double).
+     *
+     * Applies a new command & records it.
+     */
+    template<class Apply, class Revert>
+    void execute(Apply&&, Revert&&, double cost = 1);
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *      rvalue reference to a command.
+     *      Replay cost of the command (optional, default 1).
+     *
+     * Post-Conditions:
+     *      The command is applied to the state, then recorded.
+     *      Undone positions & their checkpoints are discarded.
+     *      If the history is full, the oldest command & the checkpoints
+     *      it covers are evicted.
+     *      A checkpoint is taken if the policy requires it.
+     *      If applying throws, nothing is recorded.
+     *
+     * Applies the given command & records it.
+     */
+    void execute(Command<State>&&, double cost = 1);
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *      Maximum number of commands to revert (optional, default 1).
+     *
+     * Post-Conditions:
+     *      Up to N commands are reverted, newest first.
+     *      Returns the number of reverted commands.
+     *
+     * Reverts up to N commands.
+     */
+    int undo(int count = 1);
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *      Maximum number of commands to apply (optional, default 1).
+     *
+     * Post-Conditions:
+     *      Up to N reverted commands are applied, oldest first.
+     *      Returns the number of applied commands.
+     *
+     * Applies up to N reverted commands again.
+     */
+    int redo(int count = 1);
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *      Position between getFirstPosition() & getLastPosition().
+     *
+     * Post-Conditions:
+     *      Returns a copy of the state at the given position.
+     *      At most one interval of commands is replayed.
+     *      Throws std::out_of_range if the position is not retained.
+     *
+     * Materialises the state at the given position.
+     */
+    [[nodiscard]] State stateAt(std::uint64_t) const;
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *
+     * Post-Conditions:
+     *      const reference to the current state is returned.
+     *
+     * Returns the current state.
+     */
+    [[nodiscard]] inline const State& getState() const {
+        return state;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *
+     * Post-Conditions:
+     *      Position of the current state is returned.
+     *
+     * Returns the current position.
+     */
+    [[nodiscard]] inline std::uint64_t getPosition() const {
+        return position;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *
+     * Post-Conditions:
+     *      Oldest position that can be materialised is returned.
+     *
+     * Returns the oldest retained position.
+     */
+    [[nodiscard]] inline std::uint64_t getFirstPosition() const {
+        return checkpoints.front().position;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *
+     * Post-Conditions:
+     *      Newest position that can be materialised is returned.
+     *
+     * Returns the newest retained position, including undone ones.
+     */
+    [[nodiscard]] inline std::uint64_t getLastPosition() const {
+        return getFirstPosition() + steps.size();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *
+     * Post-Conditions:
+     *      Number of stored checkpoints is returned.
+     *
+     * Returns the number of stored checkpoints.
+     */
+    [[nodiscard]] inline std::size_t getCheckpointCount() const {
+        return checkpoints.size();
+    }
+
+private:
+    /*
+     * Materialised state at a position.
+     */
+    struct Checkpoint {
+        std::uint64_t position;
+
+        /* Total cost of the commands leading to position */
+        double cost;
+
+        State state;
+    };
+
+    /*
+     * Recorded command taking position P to P + 1.
+     * The command itself lives in a Node of history, which never moves.
+     */
+    struct Step {
+        Command<State> *command;
+
+        /* Total cost of the commands up to & including this one */
+        double cost;
+    };
+
+    /*
+     * Current state.
+     */
+    State state;
+
+    /*
+     * Recorded commands, the source of truth for undo & redo.
+     */
+    URStack<Command<State>> history;
+
+    /*
+     * Retained commands by position, the first one starts at
+     * getFirstPosition().
+     */
+    std::deque<Step> steps;
+
+    /*
+     * Checkpoints sorted by position.
+     * The first one is always at getFirstPosition().
+     */
+    std::deque<Checkpoint> checkpoints;
+
+    /*
+     * When to take a checkpoint.
+     */
+    CheckpointPolicy policy;
+
+    /*
+     * Position of the current state.
+     */
+    std::uint64_t position;
+
+    /*
+     * Pre-Conditions:
+     *      TimeTravelEngine is initialized.
+     *      Position between getFirstPosition() & getLastPosition().
+     *
+     * Post-Conditions:
+     *      Returns the index of the nearest checkpoint at or below
+     *      the given position.
+     *
+     * Finds the checkpoint to replay a position from.
+     */
+    [[nodiscard]] std::size_t checkpointBelow(std::uint64_t) const;
+
+    /*
+     * Pre-Conditions:
+     *      The history is full & about to evict its oldest command.
+     *
+     * Post-Conditions:
+     *      The first checkpoint is moved one position up,
+     *      the oldest step is dropped.
+     *
+     * Evicts the oldest command & the checkpoints it covers.
+     */
+    void evictOldest();
+};
+
+#endif //URSTACK_TIMETRAVELENGINE_H
@@ -23,11 +23,17 @@
  *      Node* getNext() const
  *          Returns the pointer to the next Node instance.
  *
- *      DataType getData() const
+ *      Node* getPrevious() const
+ *          Returns the pointer to the previous Node instance.
+ *
+ *      const DataType& getData() const
  *          Returns the data stored in the Node instance.
  *
+ *      DataType& getData()
+ *          Returns the data stored in the Node instance, for modification.
+ *
  *      void chain(Node*)
- *          Assigns the next Node instance.
+ *          Assigns the next Node instance, & its previous one.
  *
  *      void setData(const DataType&)
  *          Assigns the data field in the Node instance.
@@ -52,23 +58,111 @@
  *      inline bool hasNext() const
  *          Used to check if the stack has next actions.
  *
- *      std::ostream& displayDirectional(NodePtr from, NodePtr to,
- *                                       std::ostream&, bool reverse) const
+ *      OutputSink& displayDirectional(NodePtr from, NodePtr to,
+ *                                     OutputSink&, bool reverse) const
  *          Displays Nodes' data from `from` till `to`
  *
+ *      std::uint64_t exportDirectional(NodePtr from, int count,
+ *                                      bool reverse, std::ostream&,
+ *                                      ExportFormat, unsigned) const
+ *          Exports N Nodes' data from `from`, in chunks formatted
+ *          in parallel.
+ *
+ *      long long countUndone() const
+ *          Counts the undone actions, the held Nodes after the applied ones.
+ *
+ *      void observeDiscarded()
+ *          Tells the observer of the undone actions about to be discarded.
+ *
+ *      NodePtr createNode(DataType&&)
+ *          Creates a Node, reusing the spare memory if any.
+ *
+ *      void recycle(NodePtr)
+ *          Destroys a detached Node, keeping its memory as the spare.
+ *
+ *      void evictOldest()
+ *          Hands the oldest action to the eviction policy.
+ *
+ *      static void release(void*)
+ *          Frees the memory of a destroyed Node.
+ *
  * List of public URStack<DataType> class Functions:
- *      URStack(int capacity = 20)
+ *      URStack(int capacity = 20, Observer = Observer{},
+ *              Eviction = Eviction{})
  *          Parameterized/Default constructor of the URStack class.
  *
+ *      explicit URStack(const URStackSnapshot<DataType>&)
+ *          Constructs a URStack from the given snapshot.
+ *
+ *      ~URStack()
+ *          Destructor for the URStack class.
+ *
+ *      static URStack load(const std::string&)
+ *          Loads a URStack from the snapshot file at the given path.
+ *
+ *      void save(const std::string&) const
+ *          Saves the whole stack to a snapshot file at the given path.
+ *
+ *      SnapshotHeader save(std::ostream&) const
+ *          Writes the whole stack as a snapshot to the given ostream.
+ *
  *      insertNewAction(const DataType&)
  *          Inserts a new action on top of the stack.
  *
+ *      insertNewAction(DataType&&)
+ *          Inserts a new action on top of the stack, moving it.
+ *
+ *      template<class Iterator>
+ *      int insertNewActions(Iterator, Iterator)
+ *          Inserts the actions of a range on top of the stack, moving them.
+ *
+ *      int setCapacity(int)
+ *          Changes the capacity of the stack, keeping the newest actions.
+ *
+ *      DataType* undo()
+ *          Undo the latest action in the stack, without displaying it.
+ *
+ *      DataType* redo()
+ *          Redo the latest undone action in the stack,
+ *          without displaying it.
+ *
+ *      DataType* peek()
+ *          Returns the latest action in the stack, without undoing it.
+ *
+ *      template<class Visitor>
+ *      int undo(int, Visitor&&)
+ *          Undo up to N actions, visiting each of them.
+ *
+ *      template<class Visitor>
+ *      int redo(int, Visitor&&)
+ *          Redo up to N actions, visiting each of them.
+ *
+ *      template<class Visitor>
+ *      int visitPrevious(Visitor&&) const
+ *          Visits every action that can be undone, newest first.
+ *
+ *      template<class Predicate>
+ *      int findLast(Predicate&&) const
+ *          Returns the position of the newest action that can be undone
+ *          matching a predicate.
+ *
+ *      int findLastContaining(std::string_view) const
+ *          Returns the position of the newest action that can be undone
+ *          containing a substring.
+ *
  *      void undo(std::ostream&)
  *          Undo the latest action in the stack.
  *
  *      void redo(std::ostream&)
  *          Redo the latest undone action in the stack.
  *
+ *      void undo(OutputSink&)
+ *          Undo the latest action in the stack, displaying it to a sink.
+ *
+ *      void redo(OutputSink&)
+ *          Redo the latest undone action in the stack,
+ *          displaying it to a sink.
+ *
  *      std::ostream& displayAll(std::ostream&) const
  *          Displays all actions in the stack.
  *
@@ -78,19 +172,79 @@
  *      std::ostream& displayNext(std::ostream&) const
  *          Displays all deleted actions in the stack.
  *
+ *      OutputSink& displayAll(OutputSink&) const
+ *          Displays all actions in the stack to a sink.
+ *
+ *      OutputSink& displayPrevious(OutputSink&) const
+ *          Displays all existing actions in the stack to a sink.
+ *
+ *      OutputSink& displayNext(OutputSink&) const
+ *          Displays all deleted actions in the stack to a sink.
+ *
+ *      std::uint64_t exportAll(std::ostream&,
+ *                              ExportFormat = ExportFormat::kText,
+ *                              unsigned threads = 0) const
+ *          Exports all actions in the stack, formatted in parallel.
+ *
+ *      std::uint64_t exportPrevious(std::ostream&,
+ *                                   ExportFormat = ExportFormat::kText,
+ *                                   unsigned threads = 0) const
+ *          Exports all existing actions in the stack,
+ *          formatted in parallel.
+ *
+ *      std::uint64_t exportNext(std::ostream&,
+ *                               ExportFormat = ExportFormat::kText,
+ *                               unsigned threads = 0) const
+ *          Exports all deleted actions in the stack, formatted in parallel.
+ *
  *      inline int getSize() const
  *          Returns the number of actions in the stack.
  *
  *      inline int getCapacity() const
  *          Returns the capacity of the stack.
+ *
+ *      inline const Stats& getStats() const
+ *          Returns the statistics gathered by the stack.
+ *
+ *      inline Stats& getStats()
+ *          Returns the statistics gathered by the stack, to reset them.
+ *
+ *      inline const Observer& getObserver() const
+ *          Returns the observer of the stack.
+ *
+ *      inline Observer& getObserver()
+ *          Returns the observer of the stack, for modification.
+ *
+ *      inline const Eviction& getEviction() const
+ *          Returns the eviction policy of the stack.
+ *
+ *      inline Eviction& getEviction()
+ *          Returns the eviction policy of the stack, for modification.
+ *
+ *      MemoryUsage memoryUsage() const
+ *          Returns the memory owned by the stack.
  */
 
+#ifndef URSTACK_URSTACK_CPP
+#define URSTACK_URSTACK_CPP
+
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
 #include "URStack.h"
+#include "URStackSnapshot.cpp"
+#include "WorkerPool.h"
 
 
 /* Used std utilities */
-using std::string, std::ostream,
-        std::min, std::max, std::invalid_argument;
+using std::string, std::ostream, std::ofstream, std::runtime_error,
+        std::min, std::max, std::invalid_argument, std::exchange,
+        std::size_t, std::string_view;
 
 /*
  * Pre-Conditions:
@@ -98,13 +252,14 @@ using std::string, std::ostream,
  *
  * Post-Conditions:
  *      A default Node instance is created.
- *      next is nullptr.
+ *      next & previous are nullptr.
  *      data is default value of the type.
  *
  * No-arg constructor of the Node class.
  */
-template<class DataType>
-URStack<DataType>::Node::Node(): data{}, next{nullptr} {}
+template<class DataType, class Stats, class Observer, class Eviction>
+URStack<DataType, Stats, Observer, Eviction>::Node::Node():
+        data{}, next{nullptr}, previous{nullptr} {}
 
 /*
  * Pre-Conditions:
@@ -112,14 +267,16 @@ URStack<DataType>::Node::Node(): data{}, next{nullptr} {}
  *
  * Post-Conditions:
  *      A Node instance with the given data is created.
- *      next is nullptr.
+ *      next & previous are nullptr.
  *      data is a copy of the given value.
  *
  * Parameterized constructor of the Node class,
  * that takes the data to be stored.
+ * data is parenthesised, as in insertNewAction(const DataType&).
  */
-template<class DataType>
-URStack<DataType>::Node::Node(DataType data): data{data}, next{nullptr} {}
+template<class DataType, class Stats, class Observer, class Eviction>
+URStack<DataType, Stats, Observer, Eviction>::Node::Node(DataType data):
+        data(std::move(data)), next{nullptr}, previous{nullptr} {}
 
 /*
  * Pre-Conditions:
@@ -131,15 +288,26 @@ URStack<DataType>::Node::Node(DataType data): data{data}, next{nullptr} {}
  *      next is nullptr.
  *
  * Destructor for the Node class.
+ * The following Nodes are detached & deleted one at a time,
+ * so destroying a long chain does not recurse once per Node.
  */
-template<class DataType>
-URStack<DataType>::Node::~Node() {
-    /* Deleting nullptr has no effect */
-    delete next;
+template<class DataType, class Stats, class Observer, class Eviction>
+URStack<DataType, Stats, Observer, Eviction>::Node::~Node() {
+    NodePtr following = next;
 
     /* Provides protection against illegal access */
     next = nullptr;
 
+    while (following) {
+        /* Detach before deleting, so its destructor has nothing to follow */
+        NodePtr after = following->next;
+        following->next = nullptr;
+
+        delete following;
+
+        following = after;
+    }
+
     /* Data released automatically */
 }
 
@@ -155,8 +323,9 @@ URStack<DataType>::Node::~Node() {
  * wasteful calls. For example `node.getNext();`.
  * Returns a copy of the pointer to the next Node instance.
  */
-template<class DataType>
-typename URStack<DataType>::NodePtr URStack<DataType>::Node::getNext() const {
+template<class DataType, class Stats, class Observer, class Eviction>
+typename URStack<DataType, Stats, Observer, Eviction>::NodePtr
+    URStack<DataType, Stats, Observer, Eviction>::Node::getNext() const {
     return next;
 }
 
@@ -165,15 +334,52 @@ typename URStack<DataType>::NodePtr URStack<DataType>::Node::getNext() const {
  *      `this` Node instance is initialized.
  *
  * Post-Conditions:
- *      Data of type `DataType` is returned.
+ *      A Node pointer to the previous Node or nullptr is returned.
  *      No changes to this.
  *
  * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `node.getPrevious();`.
+ * Returns a copy of the pointer to the previous Node instance.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+typename URStack<DataType, Stats, Observer, Eviction>::NodePtr
+    URStack<DataType, Stats, Observer, Eviction>::Node::getPrevious() const {
+    return previous;
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` Node instance is initialized.
+ *
+ * Post-Conditions:
+ *      const reference to the data of type `DataType` is returned.
+ *      No changes to this.
+ *
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `node.getData();`.
+ * Returns a const reference to the data stored in the Node instance,
+ * valid as long as the Node is not deleted.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+const DataType&
+    URStack<DataType, Stats, Observer, Eviction>::Node::getData() const {
+    return data;
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` Node instance is initialized.
+ *
+ * Post-Conditions:
+ *      Reference to the data of type `DataType` is returned.
+ *
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
  * wasteful calls. For example `node.getData();`.
- * Returns a copy of the data stored in the Node instance.
+ * Returns a reference to the data stored in the Node instance,
+ * valid as long as the Node is not deleted.
  */
-template<class DataType>
-DataType URStack<DataType>::Node::getData() const {
+template<class DataType, class Stats, class Observer, class Eviction>
+DataType& URStack<DataType, Stats, Observer, Eviction>::Node::getData() {
     return data;
 }
 
@@ -193,8 +399,9 @@ DataType URStack<DataType>::Node::getData() const {
  * Returns a pointer to a Node,
  * after performing the given number of hops.
  */
-template<class DataType>
-typename URStack<DataType>::NodePtr URStack<DataType>::Node::skip(int n) {
+template<class DataType, class Stats, class Observer, class Eviction>
+typename URStack<DataType, Stats, Observer, Eviction>::NodePtr
+    URStack<DataType, Stats, Observer, Eviction>::Node::skip(int n) {
     Node *result = this;
 
     /* Perform n-hops */
@@ -217,9 +424,10 @@ typename URStack<DataType>::NodePtr URStack<DataType>::Node::skip(int n) {
  *
  * Returns a Node pointer to the Node before the given Node.
  */
-template<class DataType>
-typename URStack<DataType>::NodePtr
-    URStack<DataType>::Node::before(NodePtr end_node) {
+template<class DataType, class Stats, class Observer, class Eviction>
+typename URStack<DataType, Stats, Observer, Eviction>::NodePtr
+    URStack<DataType, Stats, Observer, Eviction>::Node::before(
+        NodePtr end_node) {
     Node *result = this;
 
     /*
@@ -244,9 +452,11 @@ typename URStack<DataType>::NodePtr
  *      nothing occurs.
  *
  * Deletes all nodes from this till (excluding) the given Node.
+ * The Node before chain_end is found through previous, without a walk.
  */
-template<class DataType>
-void URStack<DataType>::Node::unchain(Node *chain_end) {
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::Node::unchain(
+        Node *chain_end) {
     if (this == chain_end) {
         return;
     }
@@ -255,7 +465,10 @@ void URStack<DataType>::Node::unchain(Node *chain_end) {
      * Chain the node before the last node to nullptr,
      * to keep the rest of the chain starting from chain_end
      */
-    before(chain_end)->chain(nullptr);
+    if (chain_end) {
+        chain_end->previous->chain(nullptr);
+        chain_end->previous = nullptr;
+    }
 
     delete this;
 }
@@ -267,12 +480,17 @@ void URStack<DataType>::Node::unchain(Node *chain_end) {
  *
  * Post-Conditions:
  *      next points to the Node represented by the given pointer.
+ *      previous of that Node, if any, points to this.
  *
  * Assigns the given pointer to next.
  */
-template<class DataType>
-void URStack<DataType>::Node::chain(Node *new_next) {
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::Node::chain(Node *new_next) {
     next = new_next;
+
+    if (new_next) {
+        new_next->previous = this;
+    }
 }
 
 /*
@@ -285,8 +503,9 @@ void URStack<DataType>::Node::chain(Node *new_next) {
  *
  * Deletes all Nodes after N-hops.
  */
-template<class DataType>
-void URStack<DataType>::Node::cut(int after_distance) {
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::Node::cut(
+        int after_distance) {
     /* Node (N-1) hops away */
     NodePtr before_last = skip(after_distance - 1);
 
@@ -300,25 +519,206 @@ void URStack<DataType>::Node::cut(int after_distance) {
 /*
  * Pre-Conditions:
  *      Capacity of the URStack (optional, default 20).
+ *      Observer of the URStack (optional, default constructed).
+ *      Eviction policy of the URStack (optional, default constructed).
  *
  * Post-Conditions:
  *      URStack instance is created.
  *      current initialized to nullptr.
  *      top initialized to nullptr.
+ *      bottom initialized to nullptr.
  *      size initialized to 0.
  *      capacity initialized to given value or default 20.
+ *      observer & eviction initialized to the given ones.
+ *      spare initialized to nullptr.
  *
  * Parameterized/Default constructor of the URStack class.
  */
-template<class DataType>
-URStack<DataType>::URStack(int capacity): size{0}, top{nullptr},
-                                          current{nullptr},
-                                          capacity{capacity} {
+template<class DataType, class Stats, class Observer, class Eviction>
+URStack<DataType, Stats, Observer, Eviction>::URStack(
+        int capacity, Observer observer, Eviction eviction):
+        top{nullptr}, current{nullptr}, bottom{nullptr}, capacity{capacity},
+        size{0}, length{0}, observer{std::move(observer)},
+        eviction{std::move(eviction)}, spare{nullptr} {
     if (capacity <= 0) {
         throw invalid_argument("\nCapacity must be a positive integer.\n");
     }
 }
 
+/*
+ * Pre-Conditions:
+ *      const reference to a valid snapshot of a URStack<DataType>.
+ *
+ * Post-Conditions:
+ *      URStack instance is created.
+ *      top, current, size & capacity are the saved values.
+ *      Every saved action is decoded into its own Node.
+ *
+ * Constructs a URStack from the given snapshot.
+ * The chain is built in a single pass from top to the oldest action,
+ * values are copied straight out of the snapshot without parsing.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+URStack<DataType, Stats, Observer, Eviction>::URStack(
+        const URStackSnapshot<DataType>& snapshot):
+        URStack(snapshot.getCapacity()) {
+    const std::uint64_t held = snapshot.getLength();
+    NodePtr last = nullptr;
+
+    for (std::uint64_t i = 0; i < held; i++) {
+        auto node = new Node{snapshot.decode(i)};
+
+        if (last) {
+            last->chain(node);
+        } else {
+            top = node;
+        }
+
+        if (i == snapshot.getCurrent()) {
+            current = node;
+        }
+
+        last = node;
+    }
+
+    bottom = last;
+    size = snapshot.getSize();
+    length = static_cast<int>(held);
+}
+
+template<class DataType, class Stats, class Observer, class Eviction>
+URStack<DataType, Stats, Observer, Eviction>::URStack(URStack&& other) noexcept:
+        top{exchange(other.top, nullptr)},
+        current{exchange(other.current, nullptr)},
+        bottom{exchange(other.bottom, nullptr)},
+        capacity{other.capacity},
+        size{exchange(other.size, 0)},
+        length{exchange(other.length, 0)},
+        stats{std::move(other.stats)},
+        observer{std::move(other.observer)},
+        eviction{std::move(other.eviction)},
+        spare{exchange(other.spare, nullptr)} {}
+
+template<class DataType, class Stats, class Observer, class Eviction>
+URStack<DataType, Stats, Observer, Eviction>&
+    URStack<DataType, Stats, Observer, Eviction>::operator=(
+        URStack&& other) noexcept {
+    if (this != &other) {
+        delete top;
+        release(spare);
+
+        top = exchange(other.top, nullptr);
+        current = exchange(other.current, nullptr);
+        bottom = exchange(other.bottom, nullptr);
+        size = exchange(other.size, 0);
+        length = exchange(other.length, 0);
+        capacity = other.capacity;
+        stats = std::move(other.stats);
+        observer = std::move(other.observer);
+        eviction = std::move(other.eviction);
+        spare = exchange(other.spare, nullptr);
+    }
+
+    return *this;
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` URStack instance is not destroyed.
+ *
+ * Post-Conditions:
+ *      All Nodes of the stack are destroyed.
+ *      The spare memory is freed.
+ *
+ * Destructor for the URStack class.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+URStack<DataType, Stats, Observer, Eviction>::~URStack() {
+    /* Deleting nullptr has no effect, top owns the whole chain */
+    delete top;
+    release(spare);
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of a snapshot file
+ *      written by save.
+ *
+ * Post-Conditions:
+ *      A URStack equal to the saved one is returned.
+ *      Throws std::runtime_error if the file is not a valid snapshot.
+ *
+ * Loads a URStack from the snapshot file at the given path.
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `URStack<int>::load(path);`.
+ * Use URStackSnapshot directly to read the actions in place,
+ * without materialising any Node.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+URStack<DataType, Stats, Observer, Eviction>
+    URStack<DataType, Stats, Observer, Eviction>::load(const string& path) {
+    return URStack{URStackSnapshot<DataType>{path}};
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      const reference to the path of the snapshot file.
+ *
+ * Post-Conditions:
+ *      The whole stack, including the undone actions,
+ *      is written to the file.
+ *      Throws std::runtime_error if the file cannot be written.
+ *
+ * Saves the whole stack to a snapshot file at the given path.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::save(
+        const string& path) const {
+    ofstream out(path, std::ios::binary | std::ios::trunc);
+
+    if (not out) {
+        throw runtime_error("\nCannot open " + path + ".\n");
+    }
+
+    save(out);
+
+    if (not out.flush()) {
+        throw runtime_error("\nCannot write " + path + ".\n");
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      ostream opened in binary mode.
+ *
+ * Post-Conditions:
+ *      The whole stack is written to the ostream as a snapshot.
+ *      Returns the header of the written snapshot.
+ *
+ * Writes the whole stack as a snapshot to the given ostream.
+ * current is saved as its distance from top, which stays valid
+ * for an empty stack, where current is the oldest Node.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+SnapshotHeader URStack<DataType, Stats, Observer, Eviction>::save(
+        ostream& out) const {
+    SnapshotWriter<DataType> writer;
+    std::uint64_t current_hops = 0;
+    std::uint64_t hops = 0;
+
+    for (NodePtr node = top; node; node = node->getNext(), hops++) {
+        if (node == current) {
+            current_hops = hops;
+        }
+
+        writer.append(node->getData());
+    }
+
+    return writer.write(out, current_hops, size, capacity);
+}
+
 /*
  * Pre-Conditions:
  *      URStack is initialized.
@@ -335,33 +735,77 @@ URStack<DataType>::URStack(int capacity): size{0}, top{nullptr},
  *                  both top & current point to the new action.
  *                  size incremented by 1.
  *              Otherwise:
- *                  The oldest action is discarded & continue the
- *                  same as the previous case, but no incrementation of size.
+ *                  The oldest action is handed to the eviction policy,
+ *                  then discarded, & continue the same as the previous
+ *                  case, but no incrementation of size.
  *          If they are not the same:
  *              Delete all the actions from top (inclusive)
  *              till current (exclusive) & then continue as
  *              the previous case.
  *
  * Inserts a new action on top of the stack.
+ * Copies the action, then moves it into the stack.
+ * Parenthesised, braces would wrap the action in an initializer_list
+ * for types constructible from one of themselves (std::vector<std::any>).
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::insertNewAction(
+        const DataType& action) {
+    insertNewAction(DataType(action));
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      rvalue reference to action to be added.
+ *
+ * Post-Conditions:
+ *      Same as insertNewAction(const DataType&),
+ *      the given action is moved from.
+ *
+ * Inserts a new action on top of the stack, moving it.
+ * The oldest action is bottom, so evicting it takes no walk.
+ * Observing visits the discarded undone actions, a walk compiled away
+ * otherwise.
  */
-template<class DataType>
-void URStack<DataType>::insertNewAction(const DataType& action) {
-    auto new_action = new Node{action};
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::insertNewAction(
+        DataType&& action) {
+    const auto started = stats.start();
+    NodePtr new_action = createNode(std::move(action));
 
     if (isEmpty()) {
+        if constexpr (Stats::kEnabled) {
+            /* Every Node left is an undone action */
+            stats.recordInsert(started, countUndone(), false);
+        }
+
+        observeDiscarded();
+
         current = new_action;
-        size = 1;
+        size = length = 1;
 
         /*
          * Deletes all actions in the stack, if any.
          * (Deleting nullptr is safe).
          */
         delete top;
-        top = current;
+        top = bottom = current;
+
+        observer.onInsert(std::as_const(current->getData()));
 
         return;
     }
 
+    /* Counted before they are deleted, only when gathering statistics */
+    long long discarded = 0;
+
+    if constexpr (Stats::kEnabled) {
+        discarded = countUndone();
+    }
+
+    observeDiscarded();
+
     /*
      * Stack not empty, top cannot be nullptr.
      * Deletes any nodes from top till current, if any.
@@ -374,188 +818,908 @@ void URStack<DataType>::insertNewAction(const DataType& action) {
     /* Adjust top & current to proper value */
     top = current = new_action;
 
-    if (size == capacity) {
-        /* Delete the oldest action Node, no change on size */
-        current->cut(size);
+    const bool evict = size == capacity;
+
+    if (evict) {
+        /* Detach the oldest action Node, no change on size */
+        NodePtr oldest = bottom;
+
+        bottom = oldest->getPrevious();
+        bottom->chain(nullptr);
+        observer.onEvict(std::as_const(oldest->getData()));
+
+        try {
+            eviction.evict(oldest->getData());
+        } catch (...) {
+            /* The insert is complete, only the evicted action is lost */
+            recycle(oldest);
+            length = size;
+            stats.recordInsert(started, discarded, true);
+            observer.onInsert(std::as_const(current->getData()));
+            throw;
+        }
+
+        /* Its memory is reused by the next insert */
+        recycle(oldest);
     } else {
         size++;
     }
+
+    /* Every undone action is discarded */
+    length = size;
+
+    stats.recordInsert(started, discarded, evict);
+    observer.onInsert(std::as_const(current->getData()));
 }
 
 /*
  * Pre-Conditions:
  *      URStack is initialized.
- *      ostream reference to display the output (requirement).
+ *      New maximum number of actions.
  *
  * Post-Conditions:
- *      Display the data of the latest action to the given ostream,
- *      then undo it (if possible).
- *
- * Undo the latest action in the stack.
+ *      capacity is the given value, the history is kept:
+ *          If more actions are held, the oldest applied ones are
+ *          handed to the eviction policy, as inserts evict them,
+ *          until the held actions fit.
+ *          If the undone actions alone do not fit, every applied
+ *          action is evicted & the newest undone ones are discarded,
+ *          those a redo reaches last.
+ *      Returns the number of evicted & discarded actions.
+ *      Throws std::invalid_argument if the capacity is not positive,
+ *      with the stack unchanged.
+ *      If the eviction policy throws, the actions removed so far stay
+ *      removed, the stack is valid & the exception propagates.
+ *
+ * Changes the capacity of the stack, keeping the newest actions.
+ * Discarded actions are cut from top, evicted ones detached from bottom
+ * one at a time, so the work is proportional to the removed actions,
+ * never to the held ones. Statistics are not recorded, as no insert,
+ * undo or redo is made.
  */
-template<class DataType>
-void URStack<DataType>::undo(ostream& out) {
-    /* Check if there are actions to undo */
-    if (not isEmpty()) {
-        display("Undoing: ", out);
-        display(current->getData(), out);
+template<class DataType, class Stats, class Observer, class Eviction>
+int URStack<DataType, Stats, Observer, Eviction>::setCapacity(
+        int new_capacity) {
+    if (new_capacity <= 0) {
+        throw invalid_argument("\nCapacity must be a positive integer.\n");
+    }
 
-        /*
-         * Keeps the value of current non-null, as next is nullptr.
-         * Allows us to undo & redo all actions in the stack.
-         * An alternative solution is using a trailing Node, but this approach
-         * makes good use of the size data field in this & other functions.
-         */
-        if (size != 1) {
-            current = current->getNext();
+    capacity = new_capacity;
+
+    if (length <= capacity) {
+        return 0;
+    }
+
+    const int removed = length - capacity;
+
+    /* Undone actions beyond capacity, only if they alone do not fit */
+    const int discarded = max(0, length - size - capacity);
+
+    if (discarded) {
+        /* Every applied action is evicted below, current is kept apart */
+        NodePtr kept = top->skip(discarded);
+
+        if constexpr (Observer::kEnabled) {
+            for (NodePtr node = top; node != kept; node = node->getNext()) {
+                observer.onDiscard(node->getData());
+            }
         }
 
-        size--;
-    } else {
-        displayInvalidMessage("No actions\a", out);
+        top->unchain(kept);
+        top = kept;
+        length -= discarded;
+    }
+
+    /* Oldest first, as inserts evict them */
+    for (int evicted = discarded; evicted < removed; evicted++) {
+        evictOldest();
     }
+
+    return removed;
 }
 
 /*
  * Pre-Conditions:
  *      URStack is initialized.
- *      ostream reference to display the output (requirement).
+ *      Forward iterators to a range of mutable actions, oldest first.
  *
  * Post-Conditions:
- *      Redo the latest deleted action,
- *      then display its data to the given ostream (if possible).
- *
- * Redo the latest undone action in the stack.
+ *      Same as insertNewAction(DataType&&) for every action of the
+ *      range in order, the actions are moved from:
+ *          The undone actions are discarded once.
+ *          Actions a later one of the range would evict are handed
+ *          straight to the eviction policy, never becoming Nodes,
+ *          the observer is told of their insert & eviction in a row,
+ *          so indices number them as sequential inserts would.
+ *      Returns the number of actions in the range.
+ *      If the eviction policy or an allocation throws, the actions
+ *      before stay inserted or evicted & the exception propagates.
+ *
+ * Inserts the actions of a range on top of the stack, moving them.
+ * The evictions are known up front, so the held actions that fall off
+ * are evicted first, then only the last capacity actions of the range
+ * are chained on top, each in O(1).
+ * Statistics count every insert, without a latency.
  */
-template<class DataType>
-void URStack<DataType>::redo(ostream &out) {
-    /* Check if there are actions to redo */
-    if (hasNext()) {
-        /*
-         * Allows us to undo & redo all actions in the stack.
-         * In case the stack is empty,
-         * current is actually the last Node in the stack (see undo).
-         */
-        if (not isEmpty()) {
-            current = top->before(current);
-        }
+template<class DataType, class Stats, class Observer, class Eviction>
+template<class Iterator>
+int URStack<DataType, Stats, Observer, Eviction>::insertNewActions(
+        Iterator first, Iterator last) {
+    const long long count = std::distance(first, last);
+
+    if (count <= 0) {
+        return 0;
+    }
 
-        display("Redoing: ", out);
-        display(current->getData(), out);
+    /* Counted by the first insert, as insertNewAction would */
+    long long discarded = countUndone();
 
-        size++;
+    observeDiscarded();
+
+    if (isEmpty()) {
+        /* Every Node is undone (see undo) */
+        delete top;
+        top = current = bottom = nullptr;
     } else {
-        displayInvalidMessage("No previous actions\a", out);
+        top->unchain(current);
+        top = current;
     }
-}
 
-/*
- * Pre-Conditions:
- *      URStack<DataType> is initialized.
- *      ostream to display the output.
- *      The stack is not empty.
- *      Current must have a Node before it, if reverse is true.
- *      The given from pointer is before to.
- *      reverse, true displays the Nodes' data in reverse.
- *      DataType must have an operator<< implementation.
- *
- * Post-Conditions:
- *      The data in the Nodes is displayed into the given ostream&
- *
- * Displays Nodes' data from `from` till `to`.
- * Uses recursion to achieve the reversal of nodes without wasting space.
- */
-template<class DataType>
-ostream& URStack<DataType>::displayDirectional(
-        NodePtr from,
-        NodePtr to,
-        ostream& out,
-        bool reverse) const {
-    /* Separator between Nodes data in ostream */
-    static const string& kSep = ", ";
+    length = size;
 
-    /* Base case */
-    if (not from or (from == to and not isEmpty())) {
-        return out;
+    /* Actions falling off capacity, held ones first, as inserts evict */
+    const long long overflow = max(0LL, size + count - capacity);
+    long long held = min<long long>(size, overflow);
+    long long skipped = overflow - held;
+
+    for (long long evicted = 0; evicted < held; evicted++) {
+        evictOldest();
     }
 
-    if (reverse) {
-        /* Display the rest of the Nodes */
-        displayDirectional(from->getNext(), to,
-                           out, reverse);
+    for (; skipped > 0; skipped--, ++first) {
+        stats.countInsert(exchange(discarded, 0), true);
 
-        /* Display the `from` node */
-        display(from->getData(), out);
+        auto&& action = *first;
 
-        /* No separator for last Node (which is actually the first) */
-        if (from != top) {
-            display(kSep, out);
-        }
-    } else {
-        /* Display the `from` node  */
-        display(from->getData(),out);
+        /* Inserted, then evicted by a later action, in a row */
+        observer.onInsert(std::as_const(action));
+        observer.onEvict(std::as_const(action));
+        eviction.evict(action);
+    }
+
+    for (; first != last; ++first) {
+        NodePtr node = createNode(std::move(*first));
 
-        /* No separator for last Node */
-        if (from->getNext()) {
-            display(kSep, out);
+        node->chain(top);
+        top = current = node;
+
+        if (not bottom) {
+            bottom = node;
         }
 
-        /* Display the rest of the Nodes */
-        return displayDirectional(from->getNext(), to,
-                                  out, reverse);
+        size++;
+        length++;
+
+        stats.countInsert(exchange(discarded, 0), held > 0);
+        held--;
+        observer.onInsert(std::as_const(node->getData()));
     }
 
-    return out;
+    return static_cast<int>(count);
 }
 
 /*
  * Pre-Conditions:
  *      URStack is initialized.
- *      ostream reference to display the output.
  *
  * Post-Conditions:
- *      Displays all actions in the stack to the given ostream.
- *      Returns reference to the ostream.
+ *      The latest action is undone (if possible).
+ *      Returns a pointer to its data, or nullptr if there was
+ *      no action to undo.
  *
- * Displays all actions in the stack.
- * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
- * wasteful calls. For example `stack.displayAll(cout);`.
- * Depends on displayDirectional.
+ * Undo the latest action in the stack, without displaying it.
+ * The returned pointer stays valid until the action is discarded
+ * by a later insertNewAction.
  */
-template<class DataType>
-ostream& URStack<DataType>::displayAll(ostream& out) const {
-    if (not top) {
-        /* There are truly no actions */
-        return displayInvalidMessage("No actions", out);
+template<class DataType, class Stats, class Observer, class Eviction>
+DataType* URStack<DataType, Stats, Observer, Eviction>::undo() {
+    /* Check if there are actions to undo */
+    if (isEmpty()) {
+        return nullptr;
     }
 
-    /* Display all nodes from top till the end of the chain */
-    return displayDirectional(top, nullptr,
-                              out, false);
+    const auto started = stats.start();
+    NodePtr undone = current;
+
+    /*
+     * Keeps the value of current non-null, as next is nullptr.
+     * Allows us to undo & redo all actions in the stack.
+     * An alternative solution is using a trailing Node, but this approach
+     * makes good use of the size data field in this & other functions.
+     */
+    if (size != 1) {
+        current = current->getNext();
+    }
+
+    size--;
+    stats.recordUndo(started);
+    observer.onUndo(std::as_const(undone->getData()));
+
+    return &undone->getData();
 }
 
 /*
  * Pre-Conditions:
  *      URStack is initialized.
- *      ostream reference to display the output.
  *
  * Post-Conditions:
- *      Displays all currently existing actions in the stack
+ *      The latest undone action is redone (if possible).
+ *      Returns a pointer to its data, or nullptr if there was
+ *      no action to redo.
+ *
+ * Redo the latest undone action in the stack, without displaying it.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+DataType* URStack<DataType, Stats, Observer, Eviction>::redo() {
+    /* Check if there are actions to redo */
+    if (not hasNext()) {
+        return nullptr;
+    }
+
+    const auto started = stats.start();
+
+    /*
+     * Allows us to undo & redo all actions in the stack.
+     * In case the stack is empty,
+     * current is actually the last Node in the stack (see undo).
+     */
+    if (not isEmpty()) {
+        current = current->getPrevious();
+    }
+
+    size++;
+    stats.recordRedo(started);
+    observer.onRedo(std::as_const(current->getData()));
+
+    return &current->getData();
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *
+ * Post-Conditions:
+ *      Returns a pointer to the data of the latest action,
+ *      or nullptr if there are no actions to undo.
+ *      No changes to this.
+ *
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `stack.peek();`.
+ * Returns the latest action in the stack, without undoing it.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+DataType* URStack<DataType, Stats, Observer, Eviction>::peek() {
+    return isEmpty() ? nullptr : &current->getData();
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack<DataType> is initialized.
+ *
+ * Post-Conditions:
+ *      Returns the number of actions that can be redone.
+ *      No changes to this.
+ *
+ * Counts the undone actions, the held Nodes after the applied ones.
+ * In case the stack is empty, current is actually the last Node in the
+ * stack (see undo), & is undone as well.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+long long URStack<DataType, Stats, Observer, Eviction>::countUndone() const {
+    return length - size;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack<DataType> is initialized.
+ *
+ * Post-Conditions:
+ *      observer.onDiscard is called with every action that can be redone,
+ *      newest first. Nothing is done unless Observer::kEnabled.
+ *
+ * Tells the observer of the undone actions about to be discarded.
+ * Same Nodes as countUndone, walked only when observing.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::observeDiscarded() {
+    if constexpr (Observer::kEnabled) {
+        NodePtr end = isEmpty() ? nullptr : current;
+
+        for (NodePtr node = top; node != end; node = node->getNext()) {
+            observer.onDiscard(node->getData());
+        }
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack<DataType> is initialized.
+ *      rvalue reference to the action of the Node.
+ *
+ * Post-Conditions:
+ *      Returns a new Node holding the action, next is nullptr.
+ *      spare is nullptr if it was used.
+ *      Throws std::bad_alloc if out of memory.
+ *
+ * Creates a Node, reusing the spare memory if any.
+ * The spare is kept if constructing the action throws.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+typename URStack<DataType, Stats, Observer, Eviction>::NodePtr
+    URStack<DataType, Stats, Observer, Eviction>::createNode(
+        DataType&& action) {
+    if (not spare) {
+        return new Node{std::move(action)};
+    }
+
+    auto node = new(spare) Node{std::move(action)};
+    spare = nullptr;
+
+    return node;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack<DataType> is initialized.
+ *      Node detached from the stack, next is nullptr.
+ *
+ * Post-Conditions:
+ *      The Node is destroyed.
+ *      Its memory is the spare, or freed if there is one already.
+ *
+ * Destroys a detached Node, keeping its memory as the spare.
+ * Inserting into a full stack evicts one Node per insert,
+ * a single spare is enough for it to never allocate.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::recycle(NodePtr node) {
+    if (spare) {
+        delete node;
+        return;
+    }
+
+    node->~Node();
+    spare = node;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack<DataType> is initialized.
+ *      At least one applied action, size is positive.
+ *
+ * Post-Conditions:
+ *      The oldest action is detached, size & length decremented,
+ *      current is bottom if no applied action is left (see undo).
+ *      It is handed to the observer & the eviction policy,
+ *      then destroyed, even if the eviction policy throws.
+ *
+ * Hands the oldest action to the eviction policy.
+ * Shared by the bulk evictions of setCapacity & insertNewActions,
+ * insertNewAction evicts inline, as its size does not change.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::evictOldest() {
+    NodePtr oldest = bottom;
+
+    bottom = oldest->getPrevious();
+
+    if (bottom) {
+        bottom->chain(nullptr);
+    } else {
+        top = nullptr;
+    }
+
+    length--;
+
+    /* The last applied action is gone, every held one is undone */
+    if (--size == 0) {
+        current = bottom;
+    }
+
+    observer.onEvict(std::as_const(oldest->getData()));
+
+    try {
+        eviction.evict(oldest->getData());
+    } catch (...) {
+        recycle(oldest);
+        throw;
+    }
+
+    recycle(oldest);
+}
+
+/*
+ * Pre-Conditions:
+ *      Memory of a destroyed Node, allocated by new Node, or nullptr.
+ *
+ * Post-Conditions:
+ *      The memory is freed.
+ *
+ * Frees the memory of a destroyed Node,
+ * the same way delete would after running its destructor.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::release(void *memory) {
+    if constexpr (alignof(Node) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(memory, std::align_val_t{alignof(Node)});
+    } else {
+        ::operator delete(memory);
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      PayloadBytes<DataType> measures the heap memory of an action.
+ *
+ * Post-Conditions:
+ *      Returns the bytes of the stack, its Nodes & their actions,
+ *      with the share of the actions that can be redone.
+ *      No changes to this.
+ *
+ * Returns the memory owned by the stack.
+ * Walks every Node, the undone ones from top to current first.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+MemoryUsage URStack<DataType, Stats, Observer, Eviction>::memoryUsage() const {
+    MemoryUsage usage;
+
+    usage.object_bytes = sizeof(*this);
+    usage.pooled_bytes = spare ? sizeof(Node) : 0;
+
+    /* In case the stack is empty, every Node is undone (see undo) */
+    NodePtr redo_end = isEmpty() ? nullptr : current;
+    bool undone = true;
+
+    for (NodePtr node = top; node; node = node->getNext()) {
+        const size_t payload = PayloadBytes<DataType>::of(node->getData());
+
+        undone = undone and node != redo_end;
+
+        usage.nodes++;
+        usage.node_bytes += sizeof(Node);
+        usage.payload_bytes += payload;
+
+        if (undone) {
+            usage.redo_nodes++;
+            usage.redo_bytes += sizeof(Node) + payload;
+        }
+    }
+
+    return usage;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      Maximum number of actions to undo.
+ *      Callable taking a DataType& reference.
+ *
+ * Post-Conditions:
+ *      Up to N actions are undone, newest first.
+ *      The callable is invoked with each of them, right after it
+ *      is undone.
+ *      Returns the number of undone actions.
+ *
+ * Undo up to N actions, visiting each of them.
+ * If the callable throws, the actions undone so far stay undone.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+template<class Visitor>
+int URStack<DataType, Stats, Observer, Eviction>::undo(
+        int count, Visitor&& visit) {
+    int undone = 0;
+
+    while (undone < count) {
+        DataType *data = undo();
+
+        if (not data) {
+            break;
+        }
+
+        undone++;
+        visit(*data);
+    }
+
+    return undone;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      Maximum number of actions to redo.
+ *      Callable taking a DataType& reference.
+ *
+ * Post-Conditions:
+ *      Up to N actions are redone, oldest undone action first.
+ *      The callable is invoked with each of them, right after it
+ *      is redone.
+ *      Returns the number of redone actions.
+ *
+ * Redo up to N actions, visiting each of them.
+ * Each redo follows previous from current, without walking from top.
+ * If the callable throws, the actions redone so far stay redone.
+ * Statistics count every redone action, without a latency.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+template<class Visitor>
+int URStack<DataType, Stats, Observer, Eviction>::redo(
+        int count, Visitor&& visit) {
+    int redone = 0;
+
+    while (redone < count and hasNext()) {
+        /* In case the stack is empty, current is the undone Node (see undo) */
+        if (not isEmpty()) {
+            current = current->getPrevious();
+        }
+
+        size++;
+        redone++;
+        stats.countRedo();
+        observer.onRedo(std::as_const(current->getData()));
+
+        visit(current->getData());
+    }
+
+    return redone;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      Callable taking a const DataType& reference.
+ *
+ * Post-Conditions:
+ *      The callable is invoked with every action that can be undone,
+ *      newest first. The stack is not modified.
+ *      Returns the number of visited actions.
+ *
+ * Visits every action that can be undone, newest first.
+ * Same Nodes as displayPrevious, without formatting them.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+template<class Visitor>
+int URStack<DataType, Stats, Observer, Eviction>::visitPrevious(
+        Visitor&& visit) const {
+    NodePtr node = current;
+
+    for (int visited = 0; visited < size; visited++) {
+        visit(static_cast<const Node*>(node)->getData());
+        node = node->getNext();
+    }
+
+    return size;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      Callable taking a const DataType& reference, returning bool.
+ *
+ * Post-Conditions:
+ *      Returns the number of undos from current to the newest action
+ *      that can be undone & satisfies the predicate, 0 for current,
+ *      or -1 if there is none. The stack is not modified.
+ *
+ * Returns the position of the newest action that can be undone
+ * matching a predicate.
+ * Same Nodes as visitPrevious, stopping at the first match.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+template<class Predicate>
+int URStack<DataType, Stats, Observer, Eviction>::findLast(
+        Predicate&& matches) const {
+    NodePtr node = current;
+
+    for (int position = 0; position < size; position++) {
+        if (matches(static_cast<const Node*>(node)->getData())) {
+            return position;
+        }
+
+        node = node->getNext();
+    }
+
+    return -1;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      DataType is convertible to std::string_view.
+ *      Text to search for.
+ *
+ * Post-Conditions:
+ *      Same as findLast, with a predicate matching the actions
+ *      containing the text. Every action contains an empty text.
+ *
+ * Returns the position of the newest action that can be undone
+ * containing a substring.
+ * Every action is scanned by the fastest kernel of findSubstring,
+ * see StringSearch.h.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+int URStack<DataType, Stats, Observer, Eviction>::findLastContaining(
+        string_view text) const {
+    static_assert(std::is_convertible_v<const DataType&, string_view>,
+                  "findLastContaining requires string-like actions");
+
+    const SearchKernel kernel = getSearchKernel();
+
+    return findLast([text, kernel](const DataType& action) {
+        return findSubstring(action, text, kernel) != string_view::npos;
+    });
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      ostream reference to display the output (requirement).
+ *
+ * Post-Conditions:
+ *      Display the data of the latest action to the given ostream,
+ *      then undo it (if possible).
+ *
+ * Undo the latest action in the stack.
+ * Depends on undo(OutputSink&).
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::undo(ostream& out) {
+    OutputSink sink{out};
+
+    undo(sink);
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      ostream reference to display the output (requirement).
+ *
+ * Post-Conditions:
+ *      Redo the latest deleted action,
+ *      then display its data to the given ostream (if possible).
+ *
+ * Redo the latest undone action in the stack.
+ * Depends on redo(OutputSink&).
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::redo(ostream &out) {
+    OutputSink sink{out};
+
+    redo(sink);
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Same as undo(std::ostream&), buffered in the sink.
+ *
+ * Undo the latest action in the stack, displaying it to a sink.
+ * One coloured run for the message & the action.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::undo(OutputSink& out) {
+    if (const DataType *undone = undo()) {
+        out.beginData() << "Undoing: " << *undone;
+        out.endColour();
+    } else {
+        out.invalid("No actions\a");
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Same as redo(std::ostream&), buffered in the sink.
+ *
+ * Redo the latest undone action in the stack, displaying it to a sink.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+void URStack<DataType, Stats, Observer, Eviction>::redo(OutputSink& out) {
+    if (const DataType *redone = redo()) {
+        out.beginData() << "Redoing: " << *redone;
+        out.endColour();
+    } else {
+        out.invalid("No previous actions\a");
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack<DataType> is initialized.
+ *      OutputSink to display the output.
+ *      The stack is not empty.
+ *      Current must have a Node before it, if reverse is true.
+ *      The given from pointer is before to.
+ *      reverse, true displays the Nodes' data in reverse.
+ *      DataType must have an operator<< implementation.
+ *
+ * Post-Conditions:
+ *      The data in the Nodes is displayed into the given OutputSink&
+ *
+ * Displays Nodes' data from `from` till `to`.
+ * Iterative, so long histories cannot overflow the call stack,
+ * the reversal collects the Nodes first.
+ * The whole list is a single coloured run.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+OutputSink& URStack<DataType, Stats, Observer, Eviction>::displayDirectional(
+        NodePtr from,
+        NodePtr to,
+        OutputSink& out,
+        bool reverse) const {
+    /* Separator between Nodes data in the output */
+    static constexpr std::string_view kSep = ", ";
+
+    /* `to` is included if the stack is empty, as current is undone too */
+    const NodePtr end = isEmpty() ? nullptr : to;
+
+    out.beginData();
+
+    if (reverse) {
+        std::vector<NodePtr> nodes;
+
+        for (NodePtr node = from; node != end; node = node->getNext()) {
+            nodes.push_back(node);
+        }
+
+        /* The furthest Node first, no separator after the closest */
+        for (auto node = nodes.rbegin(); node != nodes.rend(); ++node) {
+            out << static_cast<const Node*>(*node)->getData();
+
+            if (*node != from) {
+                out << kSep;
+            }
+        }
+    } else {
+        for (NodePtr node = from; node != end; node = node->getNext()) {
+            out << static_cast<const Node*>(node)->getData();
+
+            /* No separator for last Node */
+            if (node->getNext() != end) {
+                out << kSep;
+            }
+        }
+    }
+
+    return out.endColour();
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      ostream reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays all actions in the stack to the given ostream.
+ *      Returns reference to the ostream.
+ *
+ * Displays all actions in the stack.
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `stack.displayAll(cout);`.
+ * Buffers the output in an OutputSink, written once, without flushing.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+ostream& URStack<DataType, Stats, Observer, Eviction>::displayAll(
+        ostream& out) const {
+    OutputSink sink{out};
+
+    displayAll(sink);
+
+    return out;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      ostream reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays all currently existing actions in the stack
  *      to the given ostream.
  *      Returns reference to the ostream.
  *
  * Displays all existing actions in the stack.
- * Effectively displays all nodes to the right of current,
- * including current.
  * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
  * wasteful calls. For example `stack.displayPrevious(cout);`.
+ * Buffers the output in an OutputSink, written once, without flushing.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+ostream& URStack<DataType, Stats, Observer, Eviction>::displayPrevious(
+        ostream& out) const {
+    OutputSink sink{out};
+
+    displayPrevious(sink);
+
+    return out;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      ostream reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays all previously deleted actions in the stack
+ *      to the given ostream.
+ *      Returns reference to the ostream.
+ *
+ * Displays all deleted actions in the stack.
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `stack.displayNext(cout);`.
+ * Buffers the output in an OutputSink, written once, without flushing.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+ostream& URStack<DataType, Stats, Observer, Eviction>::displayNext(
+        ostream& out) const {
+    OutputSink sink{out};
+
+    displayNext(sink);
+
+    return out;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays all actions in the stack to the given sink.
+ *      Returns reference to the sink.
+ *
+ * Displays all actions in the stack to a sink.
  * Depends on displayDirectional.
  */
-template<class DataType>
-ostream& URStack<DataType>::displayPrevious(ostream& out) const {
+template<class DataType, class Stats, class Observer, class Eviction>
+OutputSink& URStack<DataType, Stats, Observer, Eviction>::displayAll(
+        OutputSink& out) const {
+    if (not top) {
+        /* There are truly no actions */
+        return out.invalid("No actions");
+    }
+
+    /* Display all nodes from top till the end of the chain */
+    return displayDirectional(top, nullptr,
+                              out, false);
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays all currently existing actions in the stack
+ *      to the given sink.
+ *      Returns reference to the sink.
+ *
+ * Displays all existing actions in the stack to a sink.
+ * Effectively displays all nodes to the right of current,
+ * including current.
+ * Depends on displayDirectional.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+OutputSink& URStack<DataType, Stats, Observer, Eviction>::displayPrevious(
+        OutputSink& out) const {
     if (isEmpty()) {
         /* No actions to undo */
-        return display("No previous actions", out);
+        return out.data("No previous actions");
     }
 
     /* Display all the nodes from current to the end of the chain */
@@ -566,27 +1730,231 @@ ostream& URStack<DataType>::displayPrevious(ostream& out) const {
 /*
  * Pre-Conditions:
  *      URStack is initialized.
- *      ostream reference to display the output.
+ *      OutputSink reference to display the output.
  *
  * Post-Conditions:
  *      Displays all previously deleted actions in the stack
- *      to the given ostream.
- *      Returns reference to the ostream.
+ *      to the given sink.
+ *      Returns reference to the sink.
  *
- * Displays all deleted actions in the stack.
+ * Displays all deleted actions in the stack to a sink.
  * Effectively displays all the nodes to the right of current,
  * from closest to furthest.
- * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
- * wasteful calls. For example `stack.displayNext(cout);`.
  * Depends on displayDirectional.
  */
-template<class DataType>
-ostream& URStack<DataType>::displayNext(ostream& out) const {
+template<class DataType, class Stats, class Observer, class Eviction>
+OutputSink& URStack<DataType, Stats, Observer, Eviction>::displayNext(
+        OutputSink& out) const {
     if (not hasNext()) {
         /* No undone actions */
-        return display("No next actions", out);
+        return out.data("No next actions");
     }
 
     /* Display all the nodes from current to top in reverse */
     return displayDirectional(top, current, out, true);
 }
+
+/*
+ * Pre-Conditions:
+ *      URStack<DataType> is initialized.
+ *      The given from pointer has at least N-1 Nodes after it,
+ *      or before it if reverse is true.
+ *      Number of Nodes to export, positive.
+ *      reverse, true exports the Nodes from `from` up towards top.
+ *      ostream reference to export to.
+ *      Format of the export.
+ *      Number of threads, 0 for one per core.
+ *
+ * Post-Conditions:
+ *      The data in the Nodes is written to the given ostream,
+ *      in the given format.
+ *      Returns the number of written bytes.
+ *
+ * Exports N Nodes' data from `from`, in chunks formatted in parallel.
+ * Works in rounds of a chunk per thread, on a single WorkerPool started
+ * for the whole export: the calling thread walks the list to the first
+ * Node of every chunk of a round but the first, then every chunk is
+ * formatted, walking its own Nodes, into a buffer of its own, the last
+ * one finding the first Node of the next round. So every Node is walked
+ * past twice, once to be skipped & once to be formatted, bar the Nodes of
+ * the first & last chunks. The buffers are written in order, a single
+ * write each, & reused by every round, so memory stays bounded
+ * by the threads, not the history.
+ * Unlike displayNext, reversed exports walk the previous pointers,
+ * without collecting the Nodes first.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+std::uint64_t URStack<DataType, Stats, Observer, Eviction>::exportDirectional(
+        NodePtr from,
+        int count,
+        bool reverse,
+        ostream& out,
+        ExportFormat format,
+        unsigned threads) const {
+    const int chunks = (count - 1) / ExportBuffer::kChunkEntries + 1;
+
+    /* No more threads than chunks, a short export starts none */
+    WorkerPool pool{min<unsigned>(WorkerPool::resolveThreads(threads),
+                                  static_cast<unsigned>(chunks))};
+
+    std::deque<ExportBuffer> buffers;
+    std::vector<NodePtr> starts;
+    std::uint64_t written = 0;
+    NodePtr node = from;
+    int first = 0;
+
+    const auto step = [reverse](NodePtr node) {
+        return reverse ? node->getPrevious() : node->getNext();
+    };
+
+    const std::function<void(size_t)> formatChunk = [&](size_t chunk) {
+        const int begin = first
+                          + static_cast<int>(chunk)
+                            * ExportBuffer::kChunkEntries;
+        const int end = min(count, begin + ExportBuffer::kChunkEntries);
+        NodePtr formatted = starts[chunk];
+
+        for (int i = begin; i < end; i++) {
+            buffers[chunk].append(
+                    static_cast<const Node*>(formatted)->getData(),
+                    i == count - 1);
+            formatted = step(formatted);
+        }
+
+        /* The last chunk finds the first Node of the next round */
+        if (chunk + 1 == starts.size()) {
+            node = formatted;
+        }
+    };
+
+    for (; first < count; first += static_cast<int>(
+            starts.size()) * ExportBuffer::kChunkEntries) {
+        starts.clear();
+
+        /* The first Node of every chunk of the round, after the first */
+        for (int start = first;
+             start < count and starts.size() < pool.getThreads();
+             start += ExportBuffer::kChunkEntries) {
+            for (int i = 0; not starts.empty()
+                            and i < ExportBuffer::kChunkEntries; i++) {
+                node = step(node);
+            }
+
+            starts.push_back(node);
+        }
+
+        while (buffers.size() < starts.size()) {
+            buffers.emplace_back(format);
+        }
+
+        /* The first error in export order, as a serial export would */
+        pool.run(starts.size(), formatChunk);
+
+        for (size_t chunk = 0; chunk < starts.size(); chunk++) {
+            written += buffers[chunk].getBytes();
+            buffers[chunk].write(out);
+        }
+    }
+
+    return written;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      ostream reference to export to, opened in binary mode
+ *      for kBinary.
+ *      Format of the export (optional, default kText).
+ *      Number of threads (optional, default 0, one per core).
+ *
+ * Post-Conditions:
+ *      Writes all actions in the stack to the given ostream, in the
+ *      order of displayAll, nothing if there are none.
+ *      Returns the number of written bytes.
+ *      Throws std::invalid_argument in kBinary if DataType has no
+ *      SnapshotCodec, std::system_error if a thread cannot be started.
+ *
+ * Exports all actions in the stack, formatted in parallel.
+ * Depends on exportDirectional.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+std::uint64_t URStack<DataType, Stats, Observer, Eviction>::exportAll(
+        ostream& out, ExportFormat format, unsigned threads) const {
+    if (not top) {
+        /* There are truly no actions */
+        return 0;
+    }
+
+    /* Export all nodes from top till the end of the chain */
+    return exportDirectional(top, length, false, out, format, threads);
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      ostream reference to export to, opened in binary mode
+ *      for kBinary.
+ *      Format of the export (optional, default kText).
+ *      Number of threads (optional, default 0, one per core).
+ *
+ * Post-Conditions:
+ *      Writes all currently existing actions in the stack to the
+ *      given ostream, in the order of displayPrevious, nothing if
+ *      there are none.
+ *      Returns the number of written bytes.
+ *      Throws as exportAll.
+ *
+ * Exports all existing actions in the stack, formatted in parallel.
+ * Effectively exports all nodes to the right of current,
+ * including current.
+ * Depends on exportDirectional.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+std::uint64_t URStack<DataType, Stats, Observer, Eviction>::exportPrevious(
+        ostream& out, ExportFormat format, unsigned threads) const {
+    if (isEmpty()) {
+        /* No actions to undo */
+        return 0;
+    }
+
+    /* Export all the nodes from current to the end of the chain */
+    return exportDirectional(current, size, false, out, format, threads);
+}
+
+/*
+ * Pre-Conditions:
+ *      URStack is initialized.
+ *      ostream reference to export to, opened in binary mode
+ *      for kBinary.
+ *      Format of the export (optional, default kText).
+ *      Number of threads (optional, default 0, one per core).
+ *
+ * Post-Conditions:
+ *      Writes all previously deleted actions in the stack to the
+ *      given ostream, in the order of displayNext, nothing if
+ *      there are none.
+ *      Returns the number of written bytes.
+ *      Throws as exportAll.
+ *
+ * Exports all deleted actions in the stack, formatted in parallel.
+ * Effectively exports all the nodes to the left of current,
+ * from closest to furthest.
+ * Depends on exportDirectional.
+ */
+template<class DataType, class Stats, class Observer, class Eviction>
+std::uint64_t URStack<DataType, Stats, Observer, Eviction>::exportNext(
+        ostream& out, ExportFormat format, unsigned threads) const {
+    if (not hasNext()) {
+        /* No undone actions */
+        return 0;
+    }
+
+    /* Current is undone too if the stack is empty */
+    const NodePtr closest = isEmpty() ? current : current->getPrevious();
+
+    /* Export all the nodes from current to top in reverse */
+    return exportDirectional(closest, length - size, true,
+                             out, format, threads);
+}
+
+#endif //URSTACK_URSTACK_CPP
@@ -8,8 +8,15 @@
  *
  * Author:      Mahmoud Yaman Seraj Alddin
  *
- * Purpose:     Definition of the URStack<DataType> class
+ * Purpose:     Definition of the
+ *              URStack<DataType, Stats, Observer, Eviction> class
  *              & its nested Node class.
+ *              Stats is the statistics policy, NoStats by default,
+ *              see URStackStats.h.
+ *              Observer is the observer policy, NoObserver by default,
+ *              see URStackObserver.h.
+ *              Eviction is the eviction policy, DropEviction by default,
+ *              see URStackEviction.h.
  *
  * List of public Node class Functions nested in URStack<DataType>:
  *      Node()
@@ -24,11 +31,17 @@
  *      Node* getNext() const
  *          Returns the pointer to the next Node instance.
  *
- *      DataType getData() const
+ *      Node* getPrevious() const
+ *          Returns the pointer to the previous Node instance.
+ *
+ *      const DataType& getData() const
  *          Returns the data stored in the Node instance.
  *
+ *      DataType& getData()
+ *          Returns the data stored in the Node instance, for modification.
+ *
  *      void chain(Node*)
- *          Assigns the next Node instance.
+ *          Assigns the next Node instance, & its previous one.
  *
  *      void setData(const DataType&)
  *          Assigns the data field in the Node instance.
@@ -53,23 +66,111 @@
  *      inline bool hasNext() const
  *          Used to check if the stack has next actions.
  *
- *      std::ostream& displayDirectional(NodePtr from, NodePtr to,
- *                                       std::ostream&, bool reverse) const
+ *      OutputSink& displayDirectional(NodePtr from, NodePtr to,
+ *                                     OutputSink&, bool reverse) const
  *          Displays Nodes' data from `from` till `to`
  *
+ *      std::uint64_t exportDirectional(NodePtr from, int count,
+ *                                      bool reverse, std::ostream&,
+ *                                      ExportFormat, unsigned) const
+ *          Exports N Nodes' data from `from`, in chunks formatted
+ *          in parallel.
+ *
+ *      long long countUndone() const
+ *          Counts the undone actions, the held Nodes after the applied ones.
+ *
+ *      void observeDiscarded()
+ *          Tells the observer of the undone actions about to be discarded.
+ *
+ *      NodePtr createNode(DataType&&)
+ *          Creates a Node, reusing the spare memory if any.
+ *
+ *      void recycle(NodePtr)
+ *          Destroys a detached Node, keeping its memory as the spare.
+ *
+ *      void evictOldest()
+ *          Hands the oldest action to the eviction policy.
+ *
+ *      static void release(void*)
+ *          Frees the memory of a destroyed Node.
+ *
  * List of public URStack<DataType> class Functions:
- *      URStack(int capacity = 20)
+ *      URStack(int capacity = 20, Observer = Observer{},
+ *              Eviction = Eviction{})
  *          Parameterized/Default constructor of the URStack class.
  *
+ *      explicit URStack(const URStackSnapshot<DataType>&)
+ *          Constructs a URStack from the given snapshot.
+ *
+ *      ~URStack()
+ *          Destructor for the URStack class.
+ *
+ *      static URStack load(const std::string&)
+ *          Loads a URStack from the snapshot file at the given path.
+ *
+ *      void save(const std::string&) const
+ *          Saves the whole stack to a snapshot file at the given path.
+ *
+ *      SnapshotHeader save(std::ostream&) const
+ *          Writes the whole stack as a snapshot to the given ostream.
+ *
  *      insertNewAction(const DataType&)
  *          Inserts a new action on top of the stack.
  *
+ *      insertNewAction(DataType&&)
+ *          Inserts a new action on top of the stack, moving it.
+ *
+ *      template<class Iterator>
+ *      int insertNewActions(Iterator, Iterator)
+ *          Inserts the actions of a range on top of the stack, moving them.
+ *
+ *      int setCapacity(int)
+ *          Changes the capacity of the stack, keeping the newest actions.
+ *
+ *      DataType* undo()
+ *          Undo the latest action in the stack, without displaying it.
+ *
+ *      DataType* redo()
+ *          Redo the latest undone action in the stack,
+ *          without displaying it.
+ *
+ *      DataType* peek()
+ *          Returns the latest action in the stack, without undoing it.
+ *
+ *      template<class Visitor>
+ *      int undo(int, Visitor&&)
+ *          Undo up to N actions, visiting each of them.
+ *
+ *      template<class Visitor>
+ *      int redo(int, Visitor&&)
+ *          Redo up to N actions, visiting each of them.
+ *
+ *      template<class Visitor>
+ *      int visitPrevious(Visitor&&) const
+ *          Visits every action that can be undone, newest first.
+ *
+ *      template<class Predicate>
+ *      int findLast(Predicate&&) const
+ *          Returns the position of the newest action that can be undone
+ *          matching a predicate.
+ *
+ *      int findLastContaining(std::string_view) const
+ *          Returns the position of the newest action that can be undone
+ *          containing a substring.
+ *
  *      void undo(std::ostream&)
  *          Undo the latest action in the stack.
  *
  *      void redo(std::ostream&)
  *          Redo the latest undone action in the stack.
  *
+ *      void undo(OutputSink&)
+ *          Undo the latest action in the stack, displaying it to a sink.
+ *
+ *      void redo(OutputSink&)
+ *          Redo the latest undone action in the stack,
+ *          displaying it to a sink.
+ *
  *      std::ostream& displayAll(std::ostream&) const
  *          Displays all actions in the stack.
  *
@@ -79,11 +180,60 @@
  *      std::ostream& displayNext(std::ostream&) const
  *          Displays all deleted actions in the stack.
  *
+ *      OutputSink& displayAll(OutputSink&) const
+ *          Displays all actions in the stack to a sink.
+ *
+ *      OutputSink& displayPrevious(OutputSink&) const
+ *          Displays all existing actions in the stack to a sink.
+ *
+ *      OutputSink& displayNext(OutputSink&) const
+ *          Displays all deleted actions in the stack to a sink.
+ *
+ *      std::uint64_t exportAll(std::ostream&,
+ *                              ExportFormat = ExportFormat::kText,
+ *                              unsigned threads = 0) const
+ *          Exports all actions in the stack, formatted in parallel.
+ *
+ *      std::uint64_t exportPrevious(std::ostream&,
+ *                                   ExportFormat = ExportFormat::kText,
+ *                                   unsigned threads = 0) const
+ *          Exports all existing actions in the stack,
+ *          formatted in parallel.
+ *
+ *      std::uint64_t exportNext(std::ostream&,
+ *                               ExportFormat = ExportFormat::kText,
+ *                               unsigned threads = 0) const
+ *          Exports all deleted actions in the stack, formatted in parallel.
+ *
  *      inline int getSize() const
  *          Returns the number of actions in the stack.
  *
  *      inline int getCapacity() const
  *          Returns the capacity of the stack.
+ *
+ *      inline int getLength() const
+ *          Returns the number of held actions, applied & undone.
+ *
+ *      inline const Stats& getStats() const
+ *          Returns the statistics gathered by the stack.
+ *
+ *      inline Stats& getStats()
+ *          Returns the statistics gathered by the stack, to reset them.
+ *
+ *      inline const Observer& getObserver() const
+ *          Returns the observer of the stack.
+ *
+ *      inline Observer& getObserver()
+ *          Returns the observer of the stack, for modification.
+ *
+ *      inline const Eviction& getEviction() const
+ *          Returns the eviction policy of the stack.
+ *
+ *      inline Eviction& getEviction()
+ *          Returns the eviction policy of the stack, for modification.
+ *
+ *      MemoryUsage memoryUsage() const
+ *          Returns the memory owned by the stack.
  */
 
 #ifndef URSTACK_URSTACK_H
@@ -93,30 +243,124 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "CommonIO.h"
+#include "HistoryExport.h"
+#include "OutputSink.h"
+#include "StringSearch.h"
+#include "URStackEviction.h"
+#include "URStackMemory.h"
+#include "URStackObserver.h"
+#include "URStackSnapshot.h"
+#include "URStackStats.h"
 
 
 /*
  * Stack with redo/undo functionality
+ * Operations are counted & timed by the Stats policy,
+ * & reported to the Observer policy,
+ * NoStats & NoObserver compile all of it away.
+ * Actions falling off capacity are handed to the Eviction policy,
+ * DropEviction destroys them.
  */
-template<class DataType>
+template<class DataType, class Stats = NoStats, class Observer = NoObserver,
+         class Eviction = DropEviction>
 class URStack {
 public:
     /*
      * Pre-Conditions:
      *      Capacity of the URStack (optional, default 20).
+     *      Observer of the URStack (optional, default constructed).
+     *      Eviction policy of the URStack (optional, default constructed).
      *
      * Post-Conditions:
      *      URStack instance is created.
      *      current is nullptr.
      *      top is nullptr.
+     *      bottom is nullptr.
      *      size is 0.
      *      capacity is given.
+     *      observer & eviction are given.
+     *      spare is nullptr.
      *
      * Parameterized/Default constructor of the URStack class.
      */
-    explicit URStack(int capacity = 20);
+    explicit URStack(int capacity = 20, Observer = Observer{},
+                     Eviction = Eviction{});
+
+    /*
+     * Pre-Conditions:
+     *      const reference to a valid snapshot of a URStack<DataType>.
+     *
+     * Post-Conditions:
+     *      URStack instance is created.
+     *      top, current, size & capacity are the saved values.
+     *      Every saved action is decoded into its own Node.
+     *
+     * Constructs a URStack from the given snapshot.
+     */
+    explicit URStack(const URStackSnapshot<DataType>&);
+
+    URStack(URStack&&) noexcept;
+
+    URStack& operator=(URStack&&) noexcept;
+
+    URStack(const URStack&) = delete;
+
+    URStack& operator=(const URStack&) = delete;
+
+    /*
+     * Pre-Conditions:
+     *      `this` URStack instance is not destroyed.
+     *
+     * Post-Conditions:
+     *      All Nodes of the stack are destroyed.
+     *
+     * Destructor for the URStack class.
+     */
+    ~URStack();
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the path of a snapshot file
+     *      written by save.
+     *
+     * Post-Conditions:
+     *      A URStack equal to the saved one is returned.
+     *      Throws std::runtime_error if the file is not a valid snapshot.
+     *
+     * Loads a URStack from the snapshot file at the given path.
+     */
+    [[nodiscard]] static URStack load(const std::string&);
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      const reference to the path of the snapshot file.
+     *
+     * Post-Conditions:
+     *      The whole stack, including the undone actions,
+     *      is written to the file.
+     *      Throws std::runtime_error if the file cannot be written.
+     *
+     * Saves the whole stack to a snapshot file at the given path.
+     */
+    void save(const std::string&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      ostream opened in binary mode.
+     *
+     * Post-Conditions:
+     *      The whole stack is written to the ostream as a snapshot.
+     *      Returns the header of the written snapshot.
+     *
+     * Writes the whole stack as a snapshot to the given ostream.
+     */
+    SnapshotHeader save(std::ostream&) const;
 
     /*
      * Pre-Conditions:
@@ -131,6 +375,189 @@ public:
      */
     void insertNewAction(const DataType&);
 
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      rvalue reference to action to be added.
+     *
+     * Post-Conditions:
+     *      New action is moved into the stack,
+     *      necessary adjustments are made according to the requirements.
+     *
+     * Inserts a new action on top of the stack, moving it.
+     */
+    void insertNewAction(DataType&&);
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      New maximum number of actions.
+     *
+     * Post-Conditions:
+     *      capacity is the given value, the history is kept:
+     *          If more actions are held, the oldest applied ones are
+     *          handed to the eviction policy, as inserts evict them,
+     *          until the held actions fit.
+     *          If the undone actions alone do not fit, every applied
+     *          action is evicted & the newest undone ones are discarded,
+     *          those a redo reaches last.
+     *      Returns the number of evicted & discarded actions.
+     *      Throws std::invalid_argument if the capacity is not positive,
+     *      with the stack unchanged.
+     *      If the eviction policy throws, the actions removed so far stay
+     *      removed, the stack is valid & the exception propagates.
+     *
+     * Changes the capacity of the stack, keeping the newest actions.
+     * O(1) per removed action, the oldest is bottom, growing is O(1).
+     */
+    int setCapacity(int);
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      Forward iterators to a range of mutable actions, oldest first.
+     *
+     * Post-Conditions:
+     *      Same as insertNewAction(DataType&&) for every action of the
+     *      range in order, the actions are moved from:
+     *          The undone actions are discarded once.
+     *          Actions a later one of the range would evict are handed
+     *          straight to the eviction policy, never becoming Nodes,
+     *          the observer is told of their insert & eviction in a row,
+     *          so indices number them as sequential inserts would.
+     *      Returns the number of actions in the range.
+     *      If the eviction policy or an allocation throws, the actions
+     *      before stay inserted or evicted & the exception propagates.
+     *
+     * Inserts the actions of a range on top of the stack, moving them.
+     * Statistics count every insert, without a latency.
+     */
+    template<class Iterator>
+    int insertNewActions(Iterator, Iterator);
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      The latest action is undone (if possible).
+     *      Returns a pointer to its data, or nullptr if there was
+     *      no action to undo.
+     *
+     * Undo the latest action in the stack, without displaying it.
+     */
+    DataType* undo();
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      The latest undone action is redone (if possible).
+     *      Returns a pointer to its data, or nullptr if there was
+     *      no action to redo.
+     *
+     * Redo the latest undone action in the stack, without displaying it.
+     */
+    DataType* redo();
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      Returns a pointer to the data of the latest action,
+     *      or nullptr if there are no actions to undo.
+     *      No changes to this.
+     *
+     * Returns the latest action in the stack, without undoing it.
+     */
+    [[nodiscard]] DataType* peek();
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      Maximum number of actions to undo.
+     *      Callable taking a DataType& reference.
+     *
+     * Post-Conditions:
+     *      Up to N actions are undone, newest first.
+     *      The callable is invoked with each of them, right after it
+     *      is undone.
+     *      Returns the number of undone actions.
+     *
+     * Undo up to N actions, visiting each of them.
+     */
+    template<class Visitor>
+    int undo(int, Visitor&&);
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      Maximum number of actions to redo.
+     *      Callable taking a DataType& reference.
+     *
+     * Post-Conditions:
+     *      Up to N actions are redone, oldest undone action first.
+     *      The callable is invoked with each of them, right after it
+     *      is redone.
+     *      Returns the number of redone actions.
+     *
+     * Redo up to N actions, visiting each of them.
+     */
+    template<class Visitor>
+    int redo(int, Visitor&&);
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      Callable taking a const DataType& reference.
+     *
+     * Post-Conditions:
+     *      The callable is invoked with every action that can be undone,
+     *      newest first. The stack is not modified.
+     *      Returns the number of visited actions.
+     *
+     * Visits every action that can be undone, newest first.
+     */
+    template<class Visitor>
+    int visitPrevious(Visitor&&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      Callable taking a const DataType& reference, returning bool.
+     *
+     * Post-Conditions:
+     *      Returns the number of undos from current to the newest action
+     *      that can be undone & satisfies the predicate, 0 for current,
+     *      or -1 if there is none. The stack is not modified.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `stack.findLast(predicate);`.
+     * Returns the position of the newest action that can be undone
+     * matching a predicate.
+     */
+    template<class Predicate>
+    [[nodiscard]] int findLast(Predicate&&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      DataType is convertible to std::string_view.
+     *      Text to search for.
+     *
+     * Post-Conditions:
+     *      Same as findLast, with a predicate matching the actions
+     *      containing the text. Every action contains an empty text.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `stack.findLastContaining("text");`.
+     * Returns the position of the newest action that can be undone
+     * containing a substring.
+     */
+    [[nodiscard]] int findLastContaining(std::string_view) const;
+
     /*
      * Pre-Conditions:
      *      URStack is initialized.
@@ -198,6 +625,134 @@ public:
      */
     [[nodiscard]] std::ostream& displayNext(std::ostream&) const;
 
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Same as undo(std::ostream&), buffered in the sink.
+     *
+     * Undo the latest action in the stack, displaying it to a sink.
+     */
+    void undo(OutputSink&);
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Same as redo(std::ostream&), buffered in the sink.
+     *
+     * Redo the latest undone action in the stack, displaying it to a sink.
+     */
+    void redo(OutputSink&);
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Displays all actions in the stack to the given sink.
+     *      Returns reference to the sink.
+     *
+     * Displays all actions in the stack to a sink.
+     */
+    OutputSink& displayAll(OutputSink&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Displays all currently existing actions in the stack
+     *      to the given sink.
+     *      Returns reference to the sink.
+     *
+     * Displays all existing actions in the stack to a sink.
+     */
+    OutputSink& displayPrevious(OutputSink&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      Displays all previously deleted actions in the stack
+     *      to the given sink.
+     *      Returns reference to the sink.
+     *
+     * Displays all deleted actions in the stack to a sink.
+     */
+    OutputSink& displayNext(OutputSink&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      ostream reference to export to, opened in binary mode
+     *      for kBinary.
+     *      Format of the export (optional, default kText).
+     *      Number of threads (optional, default 0, one per core).
+     *
+     * Post-Conditions:
+     *      Writes all actions in the stack to the given ostream, in the
+     *      order of displayAll, nothing if there are none.
+     *      Returns the number of written bytes.
+     *      Throws std::invalid_argument in kBinary if DataType has no
+     *      SnapshotCodec, std::system_error if a thread cannot be started.
+     *
+     * Exports all actions in the stack, formatted in parallel.
+     */
+    std::uint64_t exportAll(std::ostream&,
+                            ExportFormat = ExportFormat::kText,
+                            unsigned threads = 0) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      ostream reference to export to, opened in binary mode
+     *      for kBinary.
+     *      Format of the export (optional, default kText).
+     *      Number of threads (optional, default 0, one per core).
+     *
+     * Post-Conditions:
+     *      Writes all currently existing actions in the stack to the
+     *      given ostream, in the order of displayPrevious, nothing if
+     *      there are none.
+     *      Returns the number of written bytes.
+     *      Throws as exportAll.
+     *
+     * Exports all existing actions in the stack, formatted in parallel.
+     */
+    std::uint64_t exportPrevious(std::ostream&,
+                                 ExportFormat = ExportFormat::kText,
+                                 unsigned threads = 0) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      ostream reference to export to, opened in binary mode
+     *      for kBinary.
+     *      Format of the export (optional, default kText).
+     *      Number of threads (optional, default 0, one per core).
+     *
+     * Post-Conditions:
+     *      Writes all previously deleted actions in the stack to the
+     *      given ostream, in the order of displayNext, nothing if
+     *      there are none.
+     *      Returns the number of written bytes.
+     *      Throws as exportAll.
+     *
+     * Exports all deleted actions in the stack, formatted in parallel.
+     */
+    std::uint64_t exportNext(std::ostream&,
+                             ExportFormat = ExportFormat::kText,
+                             unsigned threads = 0) const;
+
     /*
      * Pre-Conditions:
      *      URStack is initialized.
@@ -224,6 +779,114 @@ public:
         return capacity;
     };
 
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      Number of Nodes in the stack is returned, the actions that can
+     *      be undone & those that can be redone.
+     *
+     * Returns the number of held actions, applied & undone.
+     */
+    [[nodiscard]] inline int getLength() const {
+        return length;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      Statistics of the operations since construction,
+     *      or the last reset, are returned.
+     *
+     * Returns the statistics gathered by the stack.
+     */
+    [[nodiscard]] inline const Stats& getStats() const {
+        return stats;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      Reference to the statistics is returned.
+     *
+     * Returns the statistics gathered by the stack, to reset them.
+     */
+    [[nodiscard]] inline Stats& getStats() {
+        return stats;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      const reference to the observer is returned.
+     *
+     * Returns the observer of the stack.
+     */
+    [[nodiscard]] inline const Observer& getObserver() const {
+        return observer;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      Reference to the observer is returned.
+     *
+     * Returns the observer of the stack, for modification.
+     */
+    [[nodiscard]] inline Observer& getObserver() {
+        return observer;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      const reference to the eviction policy is returned.
+     *
+     * Returns the eviction policy of the stack.
+     */
+    [[nodiscard]] inline const Eviction& getEviction() const {
+        return eviction;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *
+     * Post-Conditions:
+     *      Reference to the eviction policy is returned.
+     *
+     * Returns the eviction policy of the stack, for modification,
+     * such as flushing a BatchEviction.
+     */
+    [[nodiscard]] inline Eviction& getEviction() {
+        return eviction;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStack is initialized.
+     *      PayloadBytes<DataType> measures the heap memory of an action.
+     *
+     * Post-Conditions:
+     *      Returns the bytes of the stack, its Nodes & their actions,
+     *      with the share of the actions that can be redone.
+     *      No changes to this.
+     *
+     * Returns the memory owned by the stack.
+     */
+    [[nodiscard]] MemoryUsage memoryUsage() const;
+
 private:
     /*
      * Node class used in URStack to manage actions
@@ -236,7 +899,7 @@ private:
          *
          * Post-Conditions:
          *      A default Node instance is created.
-         *      next is nullptr.
+         *      next & previous are nullptr.
          *      data is default value of the type.
          *
          * No-arg constructor of the Node class.
@@ -249,7 +912,7 @@ private:
          *
          * Post-Conditions:
          *      A Node instance with the given data is created.
-         *      next is nullptr.
+         *      next & previous are nullptr.
          *      data is a copy of the given value.
          *
          * Parameterized constructor of the Node class,
@@ -257,6 +920,10 @@ private:
          */
         explicit Node(DataType);
 
+        Node(const Node&) = delete;
+
+        Node& operator=(const Node&) = delete;
+
         /*
          * Pre-Conditions:
          *      `this` Node instance is not destroyed.
@@ -287,12 +954,35 @@ private:
          *      `this` Node instance is initialized.
          *
          * Post-Conditions:
-         *      Data of type `DataType` is returned.
+         *      A Node pointer to the previous Node or nullptr is returned.
          *      No changes to this.
          *
-         * Returns a copy of the data stored in the Node instance.
+         * Returns a copy of the pointer to the previous Node instance.
+         */
+        [[nodiscard]] Node* getPrevious() const;
+
+        /*
+         * Pre-Conditions:
+         *      `this` Node instance is initialized.
+         *
+         * Post-Conditions:
+         *      const reference to the data of type `DataType` is returned.
+         *      No changes to this.
+         *
+         * Returns a const reference to the data stored in the Node instance.
+         */
+        [[nodiscard]] const DataType& getData() const;
+
+        /*
+         * Pre-Conditions:
+         *      `this` Node instance is initialized.
+         *
+         * Post-Conditions:
+         *      Reference to the data of type `DataType` is returned.
+         *
+         * Returns a reference to the data stored in the Node instance.
          */
-        [[nodiscard]] DataType getData() const;
+        [[nodiscard]] DataType& getData();
 
         /*
          * Pre-Conditions:
@@ -343,6 +1033,7 @@ private:
          *
          * Post-Conditions:
          *      next points to the Node represented by the given pointer.
+         *      previous of that Node, if any, points to this.
          *
          * Assigns the given pointer to next.
          */
@@ -366,6 +1057,12 @@ private:
          */
         Node *next;
 
+        /*
+         * Pointer to the previous Node, the one whose next is this.
+         * Initialized to nullptr by default.
+         */
+        Node *previous;
+
         /*
          * Data stored in the Node instance.
          * Initialized to the default value of the type.
@@ -391,6 +1088,13 @@ private:
      */
     NodePtr current;
 
+    /*
+     * Pointer to the last Node of the chain, the oldest action,
+     * evicted without walking the chain.
+     * Default is nullptr.
+     */
+    NodePtr bottom;
+
     /*
      * Integer representing the maximum number of actions allowed to be
      * saved in the URStack instance.
@@ -405,10 +1109,42 @@ private:
      */
     int size;
 
+    /*
+     * Integer representing the number of Nodes held by the URStack
+     * instance, undone ones included, at most capacity.
+     * Default is 0.
+     */
+    int length;
+
+    /*
+     * Statistics of the operations.
+     * Takes no space with NoStats.
+     */
+    [[no_unique_address]] Stats stats;
+
+    /*
+     * Observer of the changes to the actions.
+     * Takes no space with NoObserver.
+     */
+    [[no_unique_address]] Observer observer;
+
+    /*
+     * Policy of the actions falling off capacity.
+     * Takes no space with DropEviction.
+     */
+    [[no_unique_address]] Eviction eviction;
+
+    /*
+     * Memory of the last evicted Node, reused by the next insert,
+     * so a full stack skips the allocator in steady state.
+     * Default is nullptr.
+     */
+    void *spare;
+
     /*
      * Pre-Conditions:
      *      URStack<DataType> is initialized.
-     *      ostream to display the output.
+     *      OutputSink to display the output.
      *      The stack is not empty.
      *      Current must have a Node before it, if reverse is true.
      *      The given from pointer is before to.
@@ -416,16 +1152,42 @@ private:
      *      DataType must have an operator<< implementation.
      *
      * Post-Conditions:
-     *      The data in the Nodes is displayed into the given ostream&
+     *      The data in the Nodes is displayed into the given OutputSink&
      *
      * Displays Nodes' data from `from` till `to`
      */
-    std::ostream& displayDirectional(
+    OutputSink& displayDirectional(
             NodePtr /* from */,
             NodePtr /* to */,
-            std::ostream&,
+            OutputSink&,
             bool /* reverse */) const;
 
+    /*
+     * Pre-Conditions:
+     *      URStack<DataType> is initialized.
+     *      The given from pointer has at least N-1 Nodes after it,
+     *      or before it if reverse is true.
+     *      Number of Nodes to export, positive.
+     *      reverse, true exports the Nodes from `from` up towards top.
+     *      ostream reference to export to.
+     *      Format of the export.
+     *      Number of threads, 0 for one per core.
+     *
+     * Post-Conditions:
+     *      The data in the Nodes is written to the given ostream,
+     *      in the given format.
+     *      Returns the number of written bytes.
+     *
+     * Exports N Nodes' data from `from`, in chunks formatted in parallel.
+     */
+    std::uint64_t exportDirectional(
+            NodePtr /* from */,
+            int /* count */,
+            bool /* reverse */,
+            std::ostream&,
+            ExportFormat,
+            unsigned /* threads */) const;
+
     /*
      * Pre-Conditions:
      *      URStack<DataType> is initialized.
@@ -451,6 +1213,83 @@ private:
     [[nodiscard]] inline bool hasNext() const {
         return top and (top != current or isEmpty());
     }
+
+    /*
+     * Pre-Conditions:
+     *      URStack<DataType> is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the number of actions that can be redone.
+     *      No changes to this.
+     *
+     * Counts the undone actions, the held Nodes after the applied ones.
+     */
+    [[nodiscard]] long long countUndone() const;
+
+    /*
+     * Pre-Conditions:
+     *      URStack<DataType> is initialized.
+     *
+     * Post-Conditions:
+     *      observer.onDiscard is called with every action that can be redone,
+     *      newest first. Nothing is done unless Observer::kEnabled.
+     *
+     * Tells the observer of the undone actions about to be discarded.
+     */
+    void observeDiscarded();
+
+    /*
+     * Pre-Conditions:
+     *      URStack<DataType> is initialized.
+     *      rvalue reference to the action of the Node.
+     *
+     * Post-Conditions:
+     *      Returns a new Node holding the action, next is nullptr.
+     *      spare is nullptr if it was used.
+     *      Throws std::bad_alloc if out of memory.
+     *
+     * Creates a Node, reusing the spare memory if any.
+     */
+    [[nodiscard]] NodePtr createNode(DataType&&);
+
+    /*
+     * Pre-Conditions:
+     *      URStack<DataType> is initialized.
+     *      Node detached from the stack, next is nullptr.
+     *
+     * Post-Conditions:
+     *      The Node is destroyed.
+     *      Its memory is the spare, or freed if there is one already.
+     *
+     * Destroys a detached Node, keeping its memory as the spare.
+     */
+    void recycle(NodePtr);
+
+    /*
+     * Pre-Conditions:
+     *      URStack<DataType> is initialized.
+     *      At least one applied action, size is positive.
+     *
+     * Post-Conditions:
+     *      The oldest action is detached, size & length decremented,
+     *      current is bottom if no applied action is left (see undo).
+     *      It is handed to the observer & the eviction policy,
+     *      then destroyed, even if the eviction policy throws.
+     *
+     * Hands the oldest action to the eviction policy.
+     */
+    void evictOldest();
+
+    /*
+     * Pre-Conditions:
+     *      Memory of a destroyed Node, allocated by new Node, or nullptr.
+     *
+     * Post-Conditions:
+     *      The memory is freed.
+     *
+     * Frees the memory of a destroyed Node.
+     */
+    static void release(void*);
 };
 
 #endif //URSTACK_URSTACK_H
@@ -0,0 +1,443 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackAggregate.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of AggregateIndex, an observer policy of URStack
+ *              (see URStackObserver.h) keeping the sum, minimum & maximum
+ *              of the numeric values of the held actions, such as deltas
+ *              or costs, so they are not recomputed by walking the stack.
+ *
+ *              The values are kept oldest first in a ring, under a
+ *              segment tree of {sum, min, max}: an insert updates a single
+ *              leaf in O(log n), eviction, discard, undo & redo only move
+ *              an end of the ring or of the applied actions in O(1), &
+ *              every query combines O(log n) nodes.
+ *
+ *              Usage:
+ *                  URStack<int, NoStats, AggregateIndex<int>> stack;
+ *                  stack.insertNewAction(5);
+ *                  stack.getObserver().getApplied().sum;
+ *
+ *              Only actions inserted through the observed stack are
+ *              aggregated, those of a loaded snapshot are not.
+ *
+ * List of public AggregateIndex<DataType, ValueOf> class Functions:
+ *      explicit AggregateIndex(ValueOf = ValueOf{})
+ *          Creates an empty index, valued by the given callable.
+ *
+ *      void onInsert(const DataType&)
+ *          Adds the value of the inserted action.
+ *
+ *      void onEvict(const DataType&)
+ *          Removes the value of the evicted action.
+ *
+ *      void onDiscard(DataType&)
+ *          Removes the value of the discarded action.
+ *
+ *      void onUndo(const DataType&)
+ *          Excludes the value of the undone action.
+ *
+ *      void onRedo(const DataType&)
+ *          Includes the value of the redone action.
+ *
+ *      Aggregate getApplied() const
+ *          Returns the aggregate of the applied actions.
+ *
+ *      Aggregate getHeld() const
+ *          Returns the aggregate of the applied & undone actions.
+ *
+ *      Value getCumulative(int) const
+ *          Returns the sum of the values up to a position.
+ *
+ *      inline int getUndone() const
+ *          Returns the number of actions that can be redone.
+ *
+ *      inline std::size_t getLength() const
+ *          Returns the number of aggregated actions.
+ *
+ * List of private AggregateIndex<DataType, ValueOf> class Functions:
+ *      static Aggregate combine(const Aggregate&, const Aggregate&)
+ *          Returns the aggregate of two consecutive ranges.
+ *
+ *      Aggregate query(std::size_t, std::size_t) const
+ *          Returns the aggregate of a range of actions, oldest first.
+ *
+ *      Aggregate queryRing(std::size_t, std::size_t) const
+ *          Returns the aggregate of a range of slots.
+ *
+ *      void set(std::size_t, const Aggregate&)
+ *          Assigns a leaf & updates the nodes above it.
+ *
+ *      void grow()
+ *          Doubles the number of slots, keeping the values in order.
+ *
+ *      inline std::size_t slotOf(std::size_t) const
+ *          Returns the slot of an action, counted from the oldest.
+ */
+
+#ifndef URSTACK_URSTACKAGGREGATE_H
+#define URSTACK_URSTACKAGGREGATE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/*
+ * Value of an action that is a number itself, the default of AggregateIndex.
+ */
+struct AggregateIdentity {
+    template<class DataType>
+    inline const DataType& operator()(const DataType& action) const {
+        return action;
+    }
+};
+
+/*
+ * Observer policy aggregating the value ValueOf returns for every
+ * held action. ValueOf is called as value_of(const DataType&),
+ * its result must be arithmetic, & is summed in its own type.
+ * The actions are identified by address, a Node never moves,
+ * not even when the stack is moved.
+ */
+template<class DataType, class ValueOf = AggregateIdentity>
+class AggregateIndex {
+public:
+    typedef std::decay_t<std::invoke_result_t<ValueOf&, const DataType&>>
+            Value;
+
+    static_assert(std::is_arithmetic_v<Value>,
+                  "AggregateIndex requires arithmetic values");
+
+    /*
+     * Sum, minimum & maximum of a range of actions.
+     * An empty range has a sum of 0, the largest Value as its minimum &
+     * the lowest as its maximum.
+     */
+    struct Aggregate {
+        Value sum = 0;
+        Value min = std::numeric_limits<Value>::max();
+        Value max = std::numeric_limits<Value>::lowest();
+    };
+
+    static constexpr bool kEnabled = true;
+
+    /*
+     * Pre-Conditions:
+     *      Callable returning the value of an action
+     *      (optional, default constructed).
+     *
+     * Post-Conditions:
+     *      An empty index owning the callable is created.
+     *
+     * Creates an empty index, valued by the given callable.
+     */
+    explicit AggregateIndex(ValueOf value_of = ValueOf{}):
+            value_of{std::move(value_of)} {}
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the inserted action, on top of the stack.
+     *
+     * Post-Conditions:
+     *      The value of the action is the newest applied value.
+     */
+    void onInsert(const DataType& action) {
+        if (length == actions.size()) {
+            grow();
+        }
+
+        const std::size_t slot = slotOf(length);
+        const Value value = value_of(action);
+
+        actions[slot] = &action;
+        set(slot, {value, value, value});
+        length++;
+        applied = length;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the evicted action, the oldest of the stack.
+     *
+     * Post-Conditions:
+     *      Its value is no longer aggregated, if it was.
+     *      Its leaf is left as is, outside of every query.
+     */
+    void onEvict(const DataType& action) {
+        if (length and actions[first] == &action) {
+            first = slotOf(1);
+            length--;
+            applied--;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Reference to the discarded action, the newest undone action
+     *      of the stack.
+     *
+     * Post-Conditions:
+     *      Its value is no longer aggregated, if it was.
+     */
+    void onDiscard(DataType& action) {
+        if (length > applied and actions[slotOf(length - 1)] == &action) {
+            length--;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the undone action.
+     *
+     * Post-Conditions:
+     *      Its value, if aggregated, is no longer applied.
+     */
+    void onUndo(const DataType& action) {
+        if (applied and actions[slotOf(applied - 1)] == &action) {
+            applied--;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the redone action.
+     *
+     * Post-Conditions:
+     *      Its value, if aggregated, is applied again.
+     */
+    void onRedo(const DataType& action) {
+        if (applied < length and actions[slotOf(applied)] == &action) {
+            applied++;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the aggregate of the actions from current
+     *      to the oldest, in O(log n).
+     */
+    [[nodiscard]] Aggregate getApplied() const {
+        return query(0, applied);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the aggregate of the actions from top
+     *      to the oldest, in O(log n).
+     */
+    [[nodiscard]] Aggregate getHeld() const {
+        return query(0, length);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Number of hops from top, less than getLength().
+     *
+     * Post-Conditions:
+     *      Returns the sum of the values of the oldest action up to the
+     *      action at the position (inclusive), in O(log n).
+     *      Throws std::out_of_range if there is no action there.
+     *
+     * Returns the sum of the values up to a position.
+     * At getUndone() hops from top, the sum of the applied actions,
+     * at getUndone() + k, the sum after undoing k more.
+     */
+    [[nodiscard]] Value getCumulative(int position) const {
+        if (position < 0 or static_cast<std::size_t>(position) >= length) {
+            throw std::out_of_range("\nPosition out of range.\n");
+        }
+
+        return query(0, length - position).sum;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of aggregated actions that can be redone.
+     */
+    [[nodiscard]] inline int getUndone() const {
+        return static_cast<int>(length - applied);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of aggregated actions.
+     */
+    [[nodiscard]] inline std::size_t getLength() const {
+        return length;
+    }
+
+private:
+    ValueOf value_of;
+
+    /* Aggregated actions in a ring of a power of 2 slots, oldest first */
+    std::vector<const DataType*> actions;
+
+    /* Segment tree over the slots, node i has children 2i & 2i + 1 */
+    std::vector<Aggregate> tree;
+
+    /* Slot of the oldest action */
+    std::size_t first = 0;
+
+    std::size_t length = 0;
+
+    /* The oldest applied actions, all the others are undone */
+    std::size_t applied = 0;
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the aggregate of a range.
+     *      const reference to the aggregate of the range right after it.
+     *
+     * Post-Conditions:
+     *      Returns the aggregate of both ranges.
+     */
+    static Aggregate combine(const Aggregate& left, const Aggregate& right) {
+        return {static_cast<Value>(left.sum + right.sum),
+                std::min(left.min, right.min), std::max(left.max, right.max)};
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Index of the first action, from the oldest.
+     *      Index after the last action, at most length.
+     *
+     * Post-Conditions:
+     *      Returns the aggregate of the actions in the range.
+     *
+     * Returns the aggregate of a range of actions, oldest first.
+     * A range wrapping around the ring is queried in two parts.
+     */
+    Aggregate query(std::size_t from, std::size_t to) const {
+        if (from >= to) {
+            return {};
+        }
+
+        const std::size_t begin = slotOf(from);
+        const std::size_t end = begin + (to - from);
+
+        if (end <= actions.size()) {
+            return queryRing(begin, end);
+        }
+
+        return combine(queryRing(begin, actions.size()),
+                       queryRing(0, end - actions.size()));
+    }
+
+    /*
+     * Pre-Conditions:
+     *      First slot.
+     *      Slot after the last, at most the number of slots.
+     *
+     * Post-Conditions:
+     *      Returns the aggregate of the slots in the range.
+     *
+     * Returns the aggregate of a range of slots.
+     * Walks up from both ends, combining in order.
+     * Only nodes whose slots are all in the range are read, so the
+     * stale leaves of evicted & discarded actions are never seen.
+     */
+    Aggregate queryRing(std::size_t begin, std::size_t end) const {
+        Aggregate left;
+        Aggregate right;
+
+        for (begin += actions.size(), end += actions.size(); begin < end;
+             begin /= 2, end /= 2) {
+            if (begin & 1) {
+                left = combine(left, tree[begin++]);
+            }
+
+            if (end & 1) {
+                right = combine(tree[--end], right);
+            }
+        }
+
+        return combine(left, right);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      A slot.
+     *      const reference to its new aggregate.
+     *
+     * Post-Conditions:
+     *      The leaf of the slot & every node above it are updated.
+     */
+    void set(std::size_t slot, const Aggregate& leaf) {
+        std::size_t node = slot + actions.size();
+
+        tree[node] = leaf;
+
+        for (node /= 2; node; node /= 2) {
+            tree[node] = combine(tree[2 * node], tree[2 * node + 1]);
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      The number of slots is doubled, at least 16.
+     *      The actions are moved to the first slots, oldest first,
+     *      the tree is rebuilt in O(n).
+     *
+     * Doubles the number of slots, keeping the values in order.
+     */
+    void grow() {
+        const std::size_t slots = std::max<std::size_t>(16,
+                                                        2 * actions.size());
+        std::vector<const DataType*> moved(slots, nullptr);
+        std::vector<Aggregate> rebuilt(2 * slots);
+
+        for (std::size_t i = 0; i < length; i++) {
+            const std::size_t slot = slotOf(i);
+
+            moved[i] = actions[slot];
+            rebuilt[slots + i] = tree[actions.size() + slot];
+        }
+
+        for (std::size_t node = slots - 1; node; node--) {
+            rebuilt[node] = combine(rebuilt[2 * node], rebuilt[2 * node + 1]);
+        }
+
+        actions = std::move(moved);
+        tree = std::move(rebuilt);
+        first = 0;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Index of an action, from the oldest.
+     *
+     * Post-Conditions:
+     *      Returns its slot in the ring.
+     */
+    [[nodiscard]] inline std::size_t slotOf(std::size_t index) const {
+        return (first + index) & (actions.size() - 1);
+    }
+};
+
+#endif //URSTACK_URSTACKAGGREGATE_H
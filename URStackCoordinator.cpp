@@ -0,0 +1,271 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackCoordinator.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in URStackCoordinator.h
+ *
+ * List of public URStackCoordinator<DataType> class Functions:
+ *      explicit URStackCoordinator(int capacity = 20)
+ *          Parameterized/Default constructor of the URStackCoordinator class.
+ *
+ *      int attach(URStack<DataType>&)
+ *          Attaches a participant stack.
+ *
+ *      template<class Iterator>
+ *      void insertNewAction(Iterator, Iterator)
+ *          Inserts one logical action across the given participants.
+ *
+ *      void insertNewAction(std::initializer_list<Entry>)
+ *          Inserts one logical action across the given participants.
+ *
+ *      bool undo()
+ *          Undo the latest logical action on all of its participants.
+ *
+ *      bool redo()
+ *          Redo the latest undone logical action on all of its participants.
+ *
+ * List of private URStackCoordinator<DataType> class Functions:
+ *      void validate(int participant)
+ *          Checks a participant id of the logical action being inserted.
+ */
+
+#ifndef URSTACK_URSTACKCOORDINATOR_CPP
+#define URSTACK_URSTACKCOORDINATOR_CPP
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "URStack.cpp"
+#include "URStackCoordinator.h"
+
+
+/*
+ * Pre-Conditions:
+ *      Capacity of the coordinator (optional, default 20).
+ *
+ * Post-Conditions:
+ *      URStackCoordinator instance is created without participants.
+ *      Throws std::invalid_argument if the capacity is not positive.
+ *
+ * Parameterized/Default constructor of the URStackCoordinator class.
+ */
+template<class DataType>
+URStackCoordinator<DataType>::URStackCoordinator(int capacity):
+        transactions{capacity}, serial{0} {}
+
+/*
+ * Pre-Conditions:
+ *      URStackCoordinator is initialized.
+ *      Reference to a stack outliving the coordinator.
+ *
+ * Post-Conditions:
+ *      The stack is attached, its id is returned.
+ *      Actions already in the stack are kept, but never undone
+ *      by the coordinator.
+ *      Throws std::invalid_argument if the capacity of the stack
+ *      is less than the coordinator's, or if it is already attached.
+ *
+ * Attaches a participant stack.
+ * A stack attached twice would be undone twice per logical action.
+ * The coordinator only undoes a participant after undoing every later
+ * logical action it took part in, so its older actions are never reached.
+ */
+template<class DataType>
+int URStackCoordinator<DataType>::attach(URStack<DataType>& participant) {
+    if (participant.getCapacity() < getCapacity()) {
+        throw std::invalid_argument(
+                "\nParticipant capacity must be at least the capacity"
+                " of the coordinator.\n");
+    }
+
+    if (std::find(participants.begin(), participants.end(), &participant)
+        != participants.end()) {
+        throw std::invalid_argument("\nParticipant is already attached.\n");
+    }
+
+    participants.push_back(&participant);
+    stamps.push_back(0);
+
+    return getParticipantCount() - 1;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackCoordinator is initialized.
+ *      Iterators over a non-empty range of Entry,
+ *      with at most one entry per participant.
+ *
+ * Post-Conditions:
+ *      Each action is inserted into its participant (moved if possible)
+ *      & the participants are recorded as one logical action.
+ *      Throws std::invalid_argument, inserting nothing, if the range is
+ *      empty, a participant id is unknown or repeated.
+ *
+ * Inserts one logical action across the given participants.
+ * The whole range is validated before any participant is touched.
+ * Inserting into a participant discards its undone actions, like the
+ * transactions stack discards the undone logical actions.
+ */
+template<class DataType>
+template<class Iterator>
+void URStackCoordinator<DataType>::insertNewAction(Iterator first,
+                                                   Iterator last) {
+    if (first == last) {
+        throw std::invalid_argument(
+                "\nLogical action must have at least one participant.\n");
+    }
+
+    serial++;
+
+    Transaction transaction;
+
+    for (Iterator entry = first; entry != last; ++entry) {
+        validate(entry->first);
+        transaction.push_back(entry->first);
+    }
+
+    for (; first != last; ++first) {
+        participants[first->first]->insertNewAction(std::move(first->second));
+    }
+
+    transactions.insertNewAction(std::move(transaction));
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackCoordinator is initialized.
+ *      Non-empty list of Entry, with at most one entry per participant.
+ *
+ * Post-Conditions:
+ *      Same as insertNewAction(Iterator, Iterator).
+ *
+ * Inserts one logical action across the given participants.
+ * initializer_list elements are const, so the actions are copied.
+ */
+template<class DataType>
+void URStackCoordinator<DataType>::insertNewAction(
+        std::initializer_list<Entry> entries) {
+    insertNewAction(entries.begin(), entries.end());
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackCoordinator is initialized.
+ *
+ * Post-Conditions:
+ *      The latest logical action is undone on every participant
+ *      (if possible).
+ *      Returns true if a logical action was undone.
+ *      Throws std::logic_error, with every participant & the logical
+ *      action as they were, if a participant has no action to undo
+ *      (it was modified outside of the coordinator).
+ *
+ * Undo the latest logical action on all of its participants.
+ * Every later logical action is undone already, so the latest action of
+ * each participant is the one belonging to this logical action.
+ */
+template<class DataType>
+bool URStackCoordinator<DataType>::undo() {
+    Transaction *transaction = transactions.undo();
+
+    if (not transaction) {
+        return false;
+    }
+
+    for (auto entry = transaction->begin(); entry != transaction->end();
+         ++entry) {
+        if (not participants[*entry]->undo()) {
+            /* Those undone already are redone, as the logical action */
+            for (auto undone = transaction->begin(); undone != entry;
+                 ++undone) {
+                participants[*undone]->redo();
+            }
+
+            transactions.redo();
+
+            throw std::logic_error(
+                    "\nParticipant was modified outside of the"
+                    " coordinator.\n");
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackCoordinator is initialized.
+ *
+ * Post-Conditions:
+ *      The latest undone logical action is redone on every participant
+ *      (if possible).
+ *      Returns true if a logical action was redone.
+ *      Throws std::logic_error, with every participant & the logical
+ *      action as they were, if a participant has no action to redo
+ *      (it was modified outside of the coordinator).
+ *
+ * Redo the latest undone logical action on all of its participants.
+ */
+template<class DataType>
+bool URStackCoordinator<DataType>::redo() {
+    Transaction *transaction = transactions.redo();
+
+    if (not transaction) {
+        return false;
+    }
+
+    for (auto entry = transaction->begin(); entry != transaction->end();
+         ++entry) {
+        if (not participants[*entry]->redo()) {
+            /* Those redone already are undone, as the logical action */
+            for (auto redone = transaction->begin(); redone != entry;
+                 ++redone) {
+                participants[*redone]->undo();
+            }
+
+            transactions.undo();
+
+            throw std::logic_error(
+                    "\nParticipant was modified outside of the"
+                    " coordinator.\n");
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackCoordinator is initialized.
+ *      Participant id of an entry of the logical action being inserted.
+ *
+ * Post-Conditions:
+ *      The participant is marked as part of the logical action.
+ *      Throws std::invalid_argument if the id is unknown or
+ *      already part of the logical action.
+ *
+ * Checks a participant id of the logical action being inserted.
+ * Stamping with the insertion serial avoids clearing the marks
+ * between insertions.
+ */
+template<class DataType>
+void URStackCoordinator<DataType>::validate(int participant) {
+    if (participant < 0 or participant >= getParticipantCount()) {
+        throw std::invalid_argument("\nUnknown participant.\n");
+    }
+
+    if (stamps[participant] == serial) {
+        throw std::invalid_argument(
+                "\nParticipant is repeated in the logical action.\n");
+    }
+
+    stamps[participant] = serial;
+}
+
+#endif //URSTACK_URSTACKCOORDINATOR_CPP
@@ -0,0 +1,282 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackCoordinator.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the URStackCoordinator<DataType> class,
+ *              which records one logical action spanning several
+ *              URStack<DataType> instances (participants),
+ *              & undoes or redoes it on all of them at once.
+ *
+ *              The coordinator owns its participants exclusively once they
+ *              are attached: they must only be modified through it, though
+ *              callers keep mutable references to them. Their capacity is
+ *              checked once, by attach, so shrinking one with setCapacity
+ *              later may evict actions of retained logical actions.
+ *              A participant modified elsewhere is only detected once it
+ *              has no action left to undo or redo, undo & redo then throw.
+ *
+ * List of public URStackCoordinator<DataType> class Functions:
+ *      explicit URStackCoordinator(int capacity = 20)
+ *          Parameterized/Default constructor of the URStackCoordinator class.
+ *
+ *      int attach(URStack<DataType>&)
+ *          Attaches a participant stack.
+ *
+ *      template<class Iterator>
+ *      void insertNewAction(Iterator, Iterator)
+ *          Inserts one logical action across the given participants.
+ *
+ *      void insertNewAction(std::initializer_list<Entry>)
+ *          Inserts one logical action across the given participants.
+ *
+ *      bool undo()
+ *          Undo the latest logical action on all of its participants.
+ *
+ *      bool redo()
+ *          Redo the latest undone logical action on all of its participants.
+ *
+ *      inline const URStack<DataType>& getParticipant(int) const
+ *          Returns the participant with the given id.
+ *
+ *      inline int getParticipantCount() const
+ *          Returns the number of attached participants.
+ *
+ *      inline int getSize() const
+ *          Returns the number of logical actions that can be undone.
+ *
+ *      inline int getCapacity() const
+ *          Returns the capacity of the coordinator.
+ *
+ * List of private URStackCoordinator<DataType> class Functions:
+ *      void validate(int participant)
+ *          Checks a participant id of the logical action being inserted.
+ */
+
+#ifndef URSTACK_URSTACKCOORDINATOR_H
+#define URSTACK_URSTACKCOORDINATOR_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "URStack.h"
+
+
+/*
+ * Records logical actions spanning several URStacks.
+ *
+ * Each logical action (transaction) keeps the ids of its participants only,
+ * one entry per participant, the actions themselves live in the participants.
+ * Undoing a transaction undoes its participants once each, so the cost is
+ * constant per participating stack.
+ *
+ * Every participant's capacity is at least the coordinator's when it is
+ * attached, so as long as it is only modified through the coordinator,
+ * a participant only ever evicts actions whose transaction the coordinator
+ * has already evicted (or is evicting by the same insertion):
+ * a retained transaction is never partially evicted.
+ */
+template<class DataType>
+class URStackCoordinator {
+public:
+    /*
+     * Action of a single participant in a logical action,
+     * the first member is the participant id returned by attach.
+     */
+    typedef std::pair<int, DataType> Entry;
+
+    /*
+     * Pre-Conditions:
+     *      Capacity of the coordinator (optional, default 20).
+     *
+     * Post-Conditions:
+     *      URStackCoordinator instance is created without participants.
+     *      Throws std::invalid_argument if the capacity is not positive.
+     *
+     * Parameterized/Default constructor of the URStackCoordinator class.
+     */
+    explicit URStackCoordinator(int capacity = 20);
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *      Reference to a stack outliving the coordinator.
+     *
+     * Post-Conditions:
+     *      The stack is attached, its id is returned.
+     *      Actions already in the stack are kept, but never undone
+     *      by the coordinator.
+     *      Throws std::invalid_argument if the capacity of the stack
+     *      is less than the coordinator's, or if it is already attached.
+     *
+     * Attaches a participant stack.
+     * The stack must not be modified outside of the coordinator afterwards,
+     * nor its capacity lowered below the coordinator's.
+     */
+    int attach(URStack<DataType>&);
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *      Iterators over a non-empty range of Entry,
+     *      with at most one entry per participant.
+     *
+     * Post-Conditions:
+     *      Each action is inserted into its participant (moved if possible)
+     *      & the participants are recorded as one logical action.
+     *      Throws std::invalid_argument, inserting nothing, if the range is
+     *      empty, a participant id is unknown or repeated.
+     *
+     * Inserts one logical action across the given participants.
+     */
+    template<class Iterator>
+    void insertNewAction(Iterator /* first */, Iterator /* last */);
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *      Non-empty list of Entry, with at most one entry per participant.
+     *
+     * Post-Conditions:
+     *      Same as insertNewAction(Iterator, Iterator).
+     *
+     * Inserts one logical action across the given participants.
+     */
+    void insertNewAction(std::initializer_list<Entry>);
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *
+     * Post-Conditions:
+     *      The latest logical action is undone on every participant
+     *      (if possible).
+     *      Returns true if a logical action was undone.
+     *      Throws std::logic_error, with every participant & the logical
+     *      action as they were, if a participant has no action to undo
+     *      (it was modified outside of the coordinator).
+     *
+     * Undo the latest logical action on all of its participants.
+     */
+    bool undo();
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *
+     * Post-Conditions:
+     *      The latest undone logical action is redone on every participant
+     *      (if possible).
+     *      Returns true if a logical action was redone.
+     *      Throws std::logic_error, with every participant & the logical
+     *      action as they were, if a participant has no action to redo
+     *      (it was modified outside of the coordinator).
+     *
+     * Redo the latest undone logical action on all of its participants.
+     */
+    bool redo();
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *      Id returned by attach.
+     *
+     * Post-Conditions:
+     *      const reference to the participant is returned.
+     *
+     * Returns the participant with the given id.
+     */
+    [[nodiscard]] inline const URStack<DataType>& getParticipant(
+            int participant) const {
+        return *participants[participant];
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *
+     * Post-Conditions:
+     *      Number of attached participants is returned.
+     *
+     * Returns the number of attached participants.
+     */
+    [[nodiscard]] inline int getParticipantCount() const {
+        return static_cast<int>(participants.size());
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *
+     * Post-Conditions:
+     *      Number of logical actions that can be undone is returned.
+     *
+     * Returns the number of logical actions that can be undone.
+     */
+    [[nodiscard]] inline int getSize() const {
+        return transactions.getSize();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *
+     * Post-Conditions:
+     *      Capacity of the coordinator is returned.
+     *
+     * Returns the capacity of the coordinator.
+     */
+    [[nodiscard]] inline int getCapacity() const {
+        return transactions.getCapacity();
+    }
+
+private:
+    /*
+     * Ids of the participants of a logical action.
+     */
+    typedef std::vector<int> Transaction;
+
+    /*
+     * Attached stacks, indexed by id.
+     */
+    std::vector<URStack<DataType>*> participants;
+
+    /*
+     * Recorded logical actions.
+     */
+    URStack<Transaction> transactions;
+
+    /*
+     * Serial of the insertion each participant was last validated in,
+     * used to reject repeated participants without searching.
+     */
+    std::vector<std::uint64_t> stamps;
+
+    /*
+     * Serial of the insertion being validated.
+     */
+    std::uint64_t serial;
+
+    /*
+     * Pre-Conditions:
+     *      URStackCoordinator is initialized.
+     *      Participant id of an entry of the logical action being inserted.
+     *
+     * Post-Conditions:
+     *      The participant is marked as part of the logical action.
+     *      Throws std::invalid_argument if the id is unknown or
+     *      already part of the logical action.
+     *
+     * Checks a participant id of the logical action being inserted.
+     */
+    void validate(int);
+};
+
+#endif //URSTACK_URSTACKCOORDINATOR_H
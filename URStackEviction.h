@@ -0,0 +1,448 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackEviction.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the eviction policies of URStack, deciding
+ *              what becomes of the oldest action of a full stack when
+ *              a new one is inserted:
+ *              DropEviction, the default, destroys it,
+ *              SinkEviction hands it to a callable,
+ *              BatchEviction hands them to a callable in groups,
+ *              ColdTierEviction packs them into a snapshot buffer,
+ *              & SquashEviction folds them into a base value.
+ *
+ *              An Eviction policy provides:
+ *                  template<class DataType> void evict(DataType&)
+ *                      Called with the evicted action, after it is
+ *                      detached & before it is destroyed, so it may be
+ *                      moved out. Never copied by the stack.
+ *
+ *              The policy runs inside insertNewAction, which stays O(1).
+ *              If it throws, the insert is complete, recorded by the
+ *              statistics & the observer, the evicted action is destroyed
+ *              & the exception propagates.
+ *
+ * List of public SinkEviction<Sink> class Functions:
+ *      explicit SinkEviction(Sink = Sink{})
+ *          Creates a policy handing every evicted action to the sink.
+ *
+ *      template<class DataType>
+ *      void evict(DataType&)
+ *          Moves the evicted action into the sink.
+ *
+ *      inline Sink& getSink()
+ *          Returns the sink.
+ *
+ * List of public BatchEviction<DataType, Sink, kBatch> class Functions:
+ *      explicit BatchEviction(Sink = Sink{})
+ *          Creates a policy handing evicted actions to the sink in groups.
+ *
+ *      ~BatchEviction()
+ *          Hands the pending actions to the sink.
+ *
+ *      void evict(DataType&)
+ *          Moves the evicted action into the pending group.
+ *
+ *      void flush()
+ *          Hands the pending actions to the sink.
+ *
+ *      inline std::size_t getPending() const
+ *          Returns the number of pending actions.
+ *
+ *      inline Sink& getSink()
+ *          Returns the sink.
+ *
+ * List of public ColdTierEviction<DataType> class Functions:
+ *      void evict(const DataType&)
+ *          Encodes the evicted action into the cold tier.
+ *
+ *      inline std::uint64_t getLength() const
+ *          Returns the number of actions in the cold tier.
+ *
+ *      inline std::size_t getBytes() const
+ *          Returns the number of bytes held by the cold tier.
+ *
+ *      SnapshotHeader save(std::ostream&) const
+ *          Writes the cold tier as a snapshot.
+ *
+ * List of public SquashEviction<Base, Fold> class Functions:
+ *      explicit SquashEviction(Base = Base{}, Fold = Fold{})
+ *          Creates a policy folding evicted actions into the base.
+ *
+ *      template<class DataType>
+ *      void evict(DataType&)
+ *          Folds the evicted action into the base.
+ *
+ *      inline const Base& getBase() const
+ *          Returns the base.
+ *
+ *      inline std::uint64_t getSquashed() const
+ *          Returns the number of folded actions.
+ */
+
+#ifndef URSTACK_URSTACKEVICTION_H
+#define URSTACK_URSTACKEVICTION_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "URStackSnapshot.h"
+
+
+/*
+ * Eviction policy destroying the evicted action, the default of URStack.
+ * Empty & evict is an inline no-op, so a URStack using it
+ * is the same size & does the same work as one without a policy.
+ */
+struct DropEviction {
+    template<class DataType>
+    inline void evict(DataType&) {}
+};
+
+/*
+ * Eviction policy moving every evicted action into a callable,
+ * such as one appending to an archive or a stream.
+ * Sink is called as sink(DataType&&).
+ */
+template<class Sink>
+class SinkEviction {
+public:
+    /*
+     * Pre-Conditions:
+     *      Callable taking an rvalue reference to an action
+     *      (optional, default constructed).
+     *
+     * Post-Conditions:
+     *      A policy owning the sink is created.
+     *
+     * Creates a policy handing every evicted action to the sink.
+     */
+    explicit SinkEviction(Sink sink = Sink{}): sink{std::move(sink)} {}
+
+    /*
+     * Pre-Conditions:
+     *      Reference to the evicted action.
+     *
+     * Post-Conditions:
+     *      The action is moved into the sink.
+     */
+    template<class DataType>
+    void evict(DataType& action) {
+        sink(std::move(action));
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Reference to the sink is returned.
+     */
+    [[nodiscard]] inline Sink& getSink() {
+        return sink;
+    }
+
+private:
+    Sink sink;
+};
+
+/*
+ * Eviction policy moving evicted actions into a group of kBatch,
+ * handed to a callable once full, so the cost of the sink (a write,
+ * a lock, a compression round) is paid once per group.
+ * Sink is called as sink(std::vector<DataType>&), & may move from it.
+ * The group is reused, a full stack does not allocate in steady state.
+ */
+template<class DataType, class Sink, std::size_t kBatch = 64>
+class BatchEviction {
+public:
+    static_assert(kBatch > 0, "BatchEviction groups at least one action");
+
+    /*
+     * Pre-Conditions:
+     *      Callable taking a reference to a vector of actions
+     *      (optional, default constructed).
+     *
+     * Post-Conditions:
+     *      A policy owning the sink is created, nothing is pending.
+     *
+     * Creates a policy handing evicted actions to the sink in groups.
+     */
+    explicit BatchEviction(Sink sink = Sink{}): sink{std::move(sink)} {}
+
+    BatchEviction(BatchEviction&&) = default;
+
+    /*
+     * Pre-Conditions:
+     *      rvalue reference to another policy.
+     *
+     * Post-Conditions:
+     *      The pending actions of this are handed to its sink first,
+     *      then the other policy is moved into this.
+     */
+    BatchEviction& operator=(BatchEviction&& other) {
+        if (this != &other) {
+            finish();
+
+            sink = std::move(other.sink);
+            pending = std::move(other.pending);
+        }
+
+        return *this;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      `this` BatchEviction instance is not destroyed.
+     *
+     * Post-Conditions:
+     *      The pending actions are handed to the sink,
+     *      exceptions thrown by it are ignored.
+     *
+     * Hands the pending actions to the sink.
+     */
+    ~BatchEviction() {
+        finish();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Reference to the evicted action.
+     *
+     * Post-Conditions:
+     *      The action is moved into the pending group,
+     *      handed to the sink with the others once kBatch are pending.
+     */
+    void evict(DataType& action) {
+        if (pending.capacity() < kBatch) {
+            pending.reserve(kBatch);
+        }
+
+        pending.push_back(std::move(action));
+
+        if (pending.size() == kBatch) {
+            flush();
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      The pending actions, if any, are handed to the sink.
+     *      Nothing is pending, even if the sink throws.
+     *
+     * Hands the pending actions to the sink.
+     */
+    void flush() {
+        if (pending.empty()) {
+            return;
+        }
+
+        /* Cleared however the sink returns, keeping its capacity */
+        struct Clear {
+            std::vector<DataType>& pending;
+
+            ~Clear() {
+                pending.clear();
+            }
+        } clear{pending};
+
+        sink(pending);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of actions not handed to the sink yet.
+     */
+    [[nodiscard]] inline std::size_t getPending() const {
+        return pending.size();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Reference to the sink is returned.
+     */
+    [[nodiscard]] inline Sink& getSink() {
+        return sink;
+    }
+
+private:
+    Sink sink;
+
+    /* Evicted actions not handed to the sink yet, oldest first */
+    std::vector<DataType> pending;
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Same as flush, exceptions thrown by the sink are ignored.
+     *
+     * Flushes from a destructor or a move assignment.
+     */
+    void finish() noexcept {
+        try {
+            flush();
+        } catch (...) {
+            /* Nowhere to report it, the actions are lost either way */
+        }
+    }
+};
+
+/*
+ * Eviction policy packing evicted actions into a cold tier: a single
+ * buffer encoded as in a snapshot (see URStackSnapshot.h), without the
+ * Node, allocation & small string overhead of every action.
+ * A string of n characters takes n + 8 bytes instead of about 64.
+ */
+template<class DataType>
+class ColdTierEviction {
+public:
+    /*
+     * Pre-Conditions:
+     *      const reference to the evicted action.
+     *
+     * Post-Conditions:
+     *      The action is encoded at the end of the cold tier.
+     */
+    void evict(const DataType& action) {
+        tier.append(action);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of evicted actions.
+     */
+    [[nodiscard]] inline std::uint64_t getLength() const {
+        return tier.getLength();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the bytes of the encoded actions.
+     */
+    [[nodiscard]] inline std::size_t getBytes() const {
+        return tier.getBytes();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      ostream opened in binary mode.
+     *      At most INT_MAX evicted actions.
+     *
+     * Post-Conditions:
+     *      The cold tier is written as a snapshot, the oldest evicted
+     *      action first, every action undone.
+     *      Returns the written header.
+     *      Throws std::length_error if there are too many actions.
+     *
+     * Writes the cold tier as a snapshot.
+     * URStackSnapshot reads it back in place, in eviction order.
+     */
+    SnapshotHeader save(std::ostream& out) const {
+        const std::uint64_t length = tier.getLength();
+
+        if (length > INT_MAX) {
+            throw std::length_error("\nCold tier too long for a snapshot.\n");
+        }
+
+        return tier.write(out, 0, 0, length ? static_cast<int>(length) : 1);
+    }
+
+private:
+    SnapshotWriter<DataType> tier;
+};
+
+/*
+ * Eviction policy folding evicted actions into a base value,
+ * as an event log squashes its oldest events into a base snapshot.
+ * Fold is called as fold(Base&, DataType&&).
+ */
+template<class Base, class Fold>
+class SquashEviction {
+public:
+    /*
+     * Pre-Conditions:
+     *      Initial base (optional, default constructed).
+     *      Callable folding an action into the base
+     *      (optional, default constructed).
+     *
+     * Post-Conditions:
+     *      A policy owning the base & the fold is created.
+     *
+     * Creates a policy folding evicted actions into the base.
+     */
+    explicit SquashEviction(Base base = Base{}, Fold fold = Fold{}):
+            base{std::move(base)}, fold{std::move(fold)} {}
+
+    /*
+     * Pre-Conditions:
+     *      Reference to the evicted action.
+     *
+     * Post-Conditions:
+     *      The action is moved into the fold, with the base.
+     */
+    template<class DataType>
+    void evict(DataType& action) {
+        fold(base, std::move(action));
+        squashed++;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      const reference to the base is returned, every evicted action
+     *      folded into it, oldest first.
+     */
+    [[nodiscard]] inline const Base& getBase() const {
+        return base;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of actions folded into the base.
+     */
+    [[nodiscard]] inline std::uint64_t getSquashed() const {
+        return squashed;
+    }
+
+private:
+    Base base;
+
+    Fold fold;
+
+    std::uint64_t squashed = 0;
+};
+
+#endif //URSTACK_URSTACKEVICTION_H
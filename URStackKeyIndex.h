@@ -0,0 +1,355 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackKeyIndex.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of KeyIndex, an observer policy of URStack
+ *              (see URStackObserver.h) indexing the held actions by a key,
+ *              such as the id of the object an action edits, & of
+ *              revertLast, the selective undo built on it.
+ *
+ *              The newest applied action of a key is found in O(1),
+ *              instead of walking the history. The index is kept up to
+ *              date by the hooks of every insert, eviction, discard,
+ *              undo & redo, each O(1) on average.
+ *
+ *              Selective undo reverts a single action without undoing
+ *              the actions after it: a compensating action, computed from
+ *              it by the caller, is inserted on top, so the history stays
+ *              linear & the revert can itself be undone.
+ *
+ *              Usage:
+ *                  auto key_of = [](const Edit& edit) { return edit.id; };
+ *                  URStack<Edit, NoStats,
+ *                          KeyIndex<Edit, decltype(key_of)>> stack(
+ *                          100, KeyIndex<Edit, decltype(key_of)>{key_of});
+ *                  revertLast(stack, 42, [](const Edit& edit) {
+ *                      return edit.inverse();
+ *                  });
+ *
+ *              Only actions inserted through the observed stack are
+ *              indexed, those of a loaded snapshot are not.
+ *
+ * List of public KeyIndex<DataType, KeyOf, Hash> class Functions:
+ *      explicit KeyIndex(KeyOf = KeyOf{})
+ *          Creates an empty index, keyed by the given callable.
+ *
+ *      void onInsert(const DataType&)
+ *          Indexes the inserted action under its key.
+ *
+ *      void onEvict(const DataType&)
+ *          Forgets the evicted action.
+ *
+ *      void onDiscard(DataType&)
+ *          Forgets the discarded action.
+ *
+ *      void onUndo(const DataType&)
+ *          Marks the undone action of its key.
+ *
+ *      void onRedo(const DataType&)
+ *          Marks the redone action of its key.
+ *
+ *      const DataType* findLast(const Key&) const
+ *          Returns the newest applied action of a key.
+ *
+ *      std::size_t count(const Key&) const
+ *          Returns the number of applied actions of a key.
+ *
+ *      inline std::size_t getKeys() const
+ *          Returns the number of keys with held actions.
+ *
+ * List of private KeyIndex<DataType, KeyOf, Hash> class Functions:
+ *      Bucket* bucketOf(const DataType&)
+ *          Returns the bucket of the key of an action.
+ *
+ * List of Functions:
+ *      template<class Stack, class Key, class Invert>
+ *      bool revertLast(Stack&, const Key&, Invert&&)
+ *          Reverts the newest applied action of a key.
+ */
+
+#ifndef URSTACK_URSTACKKEYINDEX_H
+#define URSTACK_URSTACKKEYINDEX_H
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+/*
+ * Observer policy indexing the held actions by the key KeyOf returns.
+ * KeyOf is called as key_of(const DataType&), its result must be
+ * hashable by Hash & comparable with ==.
+ * The actions are indexed by address, a Node never moves,
+ * not even when the stack is moved.
+ */
+template<class DataType, class KeyOf,
+         class Hash = std::hash<std::decay_t<
+                 std::invoke_result_t<KeyOf&, const DataType&>>>>
+class KeyIndex {
+public:
+    typedef std::decay_t<std::invoke_result_t<KeyOf&, const DataType&>> Key;
+
+    static constexpr bool kEnabled = true;
+
+    /*
+     * Pre-Conditions:
+     *      Callable returning the key of an action
+     *      (optional, default constructed).
+     *
+     * Post-Conditions:
+     *      An empty index owning the callable is created.
+     *
+     * Creates an empty index, keyed by the given callable.
+     */
+    explicit KeyIndex(KeyOf key_of = KeyOf{}): key_of{std::move(key_of)} {}
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the inserted action, on top of the stack.
+     *
+     * Post-Conditions:
+     *      The action is the newest applied action of its key.
+     */
+    void onInsert(const DataType& action) {
+        buckets[key_of(action)].actions.push_back(&action);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the evicted action, the oldest of the stack.
+     *
+     * Post-Conditions:
+     *      The action is no longer indexed, if it was.
+     *      Its key is dropped if it has no other action.
+     *
+     * The oldest action of the stack is the oldest of its key.
+     */
+    void onEvict(const DataType& action) {
+        const auto found = buckets.find(key_of(action));
+
+        if (found == buckets.end()) {
+            return;
+        }
+
+        Bucket& bucket = found->second;
+
+        if (bucket.actions[bucket.first] != &action) {
+            return;
+        }
+
+        bucket.first++;
+
+        if (bucket.first == bucket.actions.size()) {
+            buckets.erase(found);
+        } else if (bucket.first * 2 >= bucket.actions.size()) {
+            /* Amortized O(1), every action is moved at most once per half */
+            bucket.actions.erase(bucket.actions.begin(),
+                                 bucket.actions.begin() + bucket.first);
+            bucket.first = 0;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Reference to the discarded action, the newest undone action
+     *      of the stack.
+     *
+     * Post-Conditions:
+     *      The action is no longer indexed, if it was.
+     *      Its key is dropped if it has no other action.
+     *
+     * The newest undone action of the stack is the newest of its key.
+     */
+    void onDiscard(DataType& action) {
+        const auto found = buckets.find(key_of(action));
+
+        if (found == buckets.end()
+            or found->second.actions.back() != &action) {
+            return;
+        }
+
+        Bucket& bucket = found->second;
+
+        bucket.actions.pop_back();
+        bucket.undone--;
+
+        if (bucket.first == bucket.actions.size()) {
+            buckets.erase(found);
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the undone action.
+     *
+     * Post-Conditions:
+     *      The action, if indexed, is no longer the newest applied
+     *      action of its key.
+     *
+     * The undone action of the stack is the newest applied of its key.
+     */
+    void onUndo(const DataType& action) {
+        Bucket *bucket = bucketOf(action);
+
+        if (bucket and bucket->getApplied()
+            and bucket->actions[bucket->actions.size() - bucket->undone - 1]
+                == &action) {
+            bucket->undone++;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the redone action.
+     *
+     * Post-Conditions:
+     *      The action, if indexed, is the newest applied action of its key.
+     *
+     * The redone action of the stack is the oldest undone of its key.
+     */
+    void onRedo(const DataType& action) {
+        Bucket *bucket = bucketOf(action);
+
+        if (bucket and bucket->undone
+            and bucket->actions[bucket->actions.size() - bucket->undone]
+                == &action) {
+            bucket->undone--;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to a key.
+     *
+     * Post-Conditions:
+     *      Returns a pointer to the newest applied action of the key,
+     *      nullptr if there is none.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `index.findLast(key);`.
+     * The pointer stays valid until the action is evicted or discarded.
+     */
+    [[nodiscard]] const DataType* findLast(const Key& key) const {
+        const auto found = buckets.find(key);
+
+        if (found == buckets.end() or not found->second.getApplied()) {
+            return nullptr;
+        }
+
+        const Bucket& bucket = found->second;
+
+        return bucket.actions[bucket.actions.size() - bucket.undone - 1];
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to a key.
+     *
+     * Post-Conditions:
+     *      Returns the number of applied actions of the key.
+     */
+    [[nodiscard]] std::size_t count(const Key& key) const {
+        const auto found = buckets.find(key);
+
+        return found == buckets.end() ? 0 : found->second.getApplied();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of keys with applied or undone actions.
+     */
+    [[nodiscard]] inline std::size_t getKeys() const {
+        return buckets.size();
+    }
+
+private:
+    /*
+     * Held actions of a single key.
+     */
+    struct Bucket {
+        /* Oldest first, the evicted ones before first */
+        std::vector<const DataType*> actions;
+
+        std::size_t first = 0;
+
+        /* The newest undone actions of the key */
+        std::size_t undone = 0;
+
+        /*
+         * Pre-Conditions:
+         *      No code-related preconditions.
+         *
+         * Post-Conditions:
+         *      Returns the number of applied actions of the key.
+         */
+        [[nodiscard]] std::size_t getApplied() const {
+            return actions.size() - first - undone;
+        }
+    };
+
+    KeyOf key_of;
+
+    std::unordered_map<Key, Bucket, Hash> buckets;
+
+    /*
+     * Pre-Conditions:
+     *      const reference to an action.
+     *
+     * Post-Conditions:
+     *      Returns a pointer to the bucket of its key, nullptr if none.
+     *
+     * Returns the bucket of the key of an action.
+     */
+    Bucket* bucketOf(const DataType& action) {
+        const auto found = buckets.find(key_of(action));
+
+        return found == buckets.end() ? nullptr : &found->second;
+    }
+};
+
+/*
+ * Pre-Conditions:
+ *      Reference to a URStack observed by a KeyIndex.
+ *      const reference to a key.
+ *      Callable taking a const DataType& reference, returning the action
+ *      compensating it.
+ *
+ * Post-Conditions:
+ *      If the key has an applied action, the action returned by the
+ *      callable for the newest of them is inserted on top of the stack,
+ *      & true is returned. Otherwise the stack is not modified & false
+ *      is returned.
+ *
+ * Reverts the newest applied action of a key.
+ * The actions after it are not undone. The compensating action is
+ * computed before inserting it, as the insert may evict or discard
+ * the reverted action.
+ * If it has the same key, it is the newest applied action of the key,
+ * reverting the key again reverts the revert.
+ */
+template<class Stack, class Key, class Invert>
+bool revertLast(Stack& stack, const Key& key, Invert&& invert) {
+    const auto *action = stack.getObserver().findLast(key);
+
+    if (not action) {
+        return false;
+    }
+
+    stack.insertNewAction(invert(*action));
+
+    return true;
+}
+
+#endif //URSTACK_URSTACKKEYINDEX_H
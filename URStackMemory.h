@@ -0,0 +1,146 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackMemory.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Memory accounting of URStack: the MemoryUsage report &
+ *              the PayloadBytes trait measuring the heap memory owned by
+ *              an action.
+ *
+ * List of public PayloadBytes<T> struct Functions:
+ *      static std::size_t of(const T&)
+ *          Returns the heap bytes owned by the given value.
+ *
+ * List of public MemoryUsage struct Functions:
+ *      inline std::size_t getTotalBytes() const
+ *          Returns the bytes owned by the stack.
+ */
+
+#ifndef URSTACK_URSTACKMEMORY_H
+#define URSTACK_URSTACKMEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/*
+ * Heap bytes owned by a value of type T, besides sizeof(T).
+ * 0 unless specialized, which is exact for types that own no memory.
+ * Specialize it for action types owning heap memory, to have it
+ * included in URStack::memoryUsage.
+ */
+template<class T, class = void>
+struct PayloadBytes {
+    /*
+     * Pre-Conditions:
+     *      const reference to a value.
+     *
+     * Post-Conditions:
+     *      Returns 0.
+     */
+    static std::size_t of(const T&) {
+        return 0;
+    }
+};
+
+/*
+ * Heap bytes of a string, 0 for short strings stored inside the object.
+ */
+template<class Char, class Traits, class Allocator>
+struct PayloadBytes<std::basic_string<Char, Traits, Allocator>> {
+    /*
+     * Pre-Conditions:
+     *      const reference to a string.
+     *
+     * Post-Conditions:
+     *      Returns its allocated capacity, terminator included,
+     *      or 0 if its characters are inside the object.
+     */
+    static std::size_t of(const std::basic_string<Char, Traits,
+                                                  Allocator>& text) {
+        const auto object = reinterpret_cast<std::uintptr_t>(&text);
+        const auto data = reinterpret_cast<std::uintptr_t>(text.data());
+
+        /* Short string optimisation, nothing on the heap */
+        if (data >= object and data < object + sizeof(text)) {
+            return 0;
+        }
+
+        return (text.capacity() + 1) * sizeof(Char);
+    }
+};
+
+/*
+ * Heap bytes of a vector, its capacity & the heap bytes of its elements.
+ */
+template<class Element, class Allocator>
+struct PayloadBytes<std::vector<Element, Allocator>> {
+    /*
+     * Pre-Conditions:
+     *      const reference to a vector.
+     *
+     * Post-Conditions:
+     *      Returns its allocated capacity in bytes, plus the heap bytes
+     *      owned by each of its elements.
+     */
+    static std::size_t of(const std::vector<Element, Allocator>& values) {
+        std::size_t bytes = values.capacity() * sizeof(Element);
+
+        for (const Element& value: values) {
+            bytes += PayloadBytes<Element>::of(value);
+        }
+
+        return bytes;
+    }
+};
+
+/*
+ * Memory owned by a URStack, split by where it lives.
+ * The *_bytes fields are exact, they count requested bytes & leave out
+ * the bookkeeping of the heap allocator.
+ */
+struct MemoryUsage {
+    /* sizeof the URStack object itself */
+    std::size_t object_bytes = 0;
+
+    /* Nodes in the chain, previous & next actions */
+    std::size_t nodes = 0;
+
+    /* nodes * sizeof(Node), actions included */
+    std::size_t node_bytes = 0;
+
+    /* Heap bytes owned by the actions, see PayloadBytes */
+    std::size_t payload_bytes = 0;
+
+    /* Nodes of the actions that can be redone */
+    std::size_t redo_nodes = 0;
+
+    /* Share of node_bytes & payload_bytes taken by those Nodes */
+    std::size_t redo_bytes = 0;
+
+    /* Freed Node memory kept for reuse by the next insert */
+    std::size_t pooled_bytes = 0;
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns object_bytes + node_bytes + payload_bytes
+     *      + pooled_bytes.
+     *
+     * Returns the bytes owned by the stack.
+     */
+    [[nodiscard]] inline std::size_t getTotalBytes() const {
+        return object_bytes + node_bytes + payload_bytes + pooled_bytes;
+    }
+};
+
+#endif //URSTACK_URSTACKMEMORY_H
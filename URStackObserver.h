@@ -0,0 +1,77 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackObserver.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of NoObserver, the default observer policy of
+ *              URStack, compiled away entirely.
+ *
+ *              An Observer policy is told of every change to the actions
+ *              of a URStack, with a reference to the affected action,
+ *              never a copy:
+ *                  static constexpr bool kEnabled
+ *                  void onInsert(const DataType&)
+ *                      After the action is inserted on top.
+ *                  void onEvict(const DataType&)
+ *                      Before the oldest action of a full stack
+ *                      is handed to the eviction policy, then destroyed,
+ *                      to make room for an insert.
+ *                  void onDiscard(DataType&)
+ *                      Before an undone action is destroyed by an insert,
+ *                      newest first.
+ *                  void onUndo(const DataType&)
+ *                      After the action is undone.
+ *                  void onRedo(const DataType&)
+ *                      After the action is redone.
+ *
+ *              Discarded actions are destroyed right after, an observer
+ *              may move them out. Evicted ones are the eviction policy's
+ *              to take (see URStackEviction.h), so observers only read
+ *              them.
+ *              An insert whose eviction policy throws is still observed,
+ *              onInsert runs before the exception propagates.
+ *              Discarded actions are only walked if kEnabled is true.
+ *              Hooks must not throw, they run in the middle of
+ *              the operation.
+ *
+ *              SequenceIndex, in URStackSequence.h, is an observer giving
+ *              every action a stable sequence number, KeyIndex,
+ *              in URStackKeyIndex.h, one indexing actions by a key, &
+ *              AggregateIndex, in URStackAggregate.h, one keeping the sum,
+ *              minimum & maximum of their values.
+ */
+
+#ifndef URSTACK_URSTACKOBSERVER_H
+#define URSTACK_URSTACKOBSERVER_H
+
+
+/*
+ * Observer policy observing nothing, the default of URStack.
+ * Empty & every function is an inline no-op, so a URStack using it
+ * is the same size & does the same work as one without hooks.
+ */
+struct NoObserver {
+    static constexpr bool kEnabled = false;
+
+    template<class DataType>
+    inline void onInsert(const DataType&) {}
+
+    template<class DataType>
+    inline void onEvict(const DataType&) {}
+
+    template<class DataType>
+    inline void onDiscard(DataType&) {}
+
+    template<class DataType>
+    inline void onUndo(const DataType&) {}
+
+    template<class DataType>
+    inline void onRedo(const DataType&) {}
+};
+
+#endif //URSTACK_URSTACKOBSERVER_H
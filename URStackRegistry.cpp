@@ -0,0 +1,781 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackRegistry.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in URStackRegistry.h
+ *
+ * List of public URStackRegistry<DataType> class Functions:
+ *      URStackRegistry()
+ *          No-arg constructor, creates an empty registry.
+ *
+ *      explicit URStackRegistry(const std::string&)
+ *          Opens the pack at the given path, reading only its index.
+ *
+ *      URStack<DataType>& get(const std::string&)
+ *          Returns the named session, materialising it if needed.
+ *
+ *      URStack<DataType>& create(const std::string&, int capacity)
+ *          Creates a new empty session, replacing an existing one.
+ *
+ *      bool erase(const std::string&)
+ *          Removes the named session.
+ *
+ *      bool contains(const std::string&) const
+ *          Checks if the named session exists.
+ *
+ *      bool isLoaded(const std::string&) const
+ *          Checks if the named session has been materialised.
+ *
+ *      SessionInfo getInfo(const std::string&) const
+ *          Returns the size & capacity of a session,
+ *          without materialising it.
+ *
+ *      std::vector<std::string> getNames() const
+ *          Returns the names of all sessions.
+ *
+ *      void save(const std::string&) const
+ *          Writes all sessions to a pack at the given path.
+ *
+ *      CompactionReport compact(const CompactionOptions& = {})
+ *          Packs the idle sessions, in parallel, within a time slice.
+ *
+ *      bool isCompacted(const std::string&) const
+ *          Checks if the named session is packed by compact.
+ *
+ * List of private URStackRegistry<DataType> class Functions:
+ *      const Slot& slotOf(const std::string&) const
+ *          Finds the slot of the named session.
+ *
+ *      static std::vector<SnapshotBlock> pack(const URStack<DataType>&)
+ *          Encodes a session as a snapshot, in aligned memory.
+ *
+ * List of protected BlockSink class Functions:
+ *      int_type overflow(int_type)
+ *          Appends a single character to the blocks.
+ *
+ *      std::streamsize xsputn(const char_type*, std::streamsize)
+ *          Appends characters to the blocks.
+ */
+
+#ifndef URSTACK_URSTACKREGISTRY_CPP
+#define URSTACK_URSTACKREGISTRY_CPP
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "URStack.cpp"
+#include "URStackRegistry.h"
+#include "WorkerPool.h"
+
+
+/*
+ * Magic bytes at the beginning of every pack.
+ */
+inline constexpr char kPackMagic[8] = "URSPACK";
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      An empty URStackRegistry instance is created.
+ *
+ * No-arg constructor of the URStackRegistry class.
+ */
+template<class DataType>
+URStackRegistry<DataType>::URStackRegistry(): loaded{0}, compacted{0} {}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of a pack written by save.
+ *
+ * Post-Conditions:
+ *      A URStackRegistry holding every session of the pack is created.
+ *      No session is materialised.
+ *      Throws std::runtime_error if the file is not a valid pack.
+ *
+ * Opens the pack at the given path, reading only its index.
+ * Work is proportional to the number of sessions,
+ * the snapshot pages of the mapping are not touched.
+ * Offsets are compared by difference, so no sum wraps around, & the
+ * summary of every entry must fit an int, as getInfo returns it.
+ * A repeated name would leave a slot no name leads to.
+ */
+template<class DataType>
+URStackRegistry<DataType>::URStackRegistry(const std::string& path):
+        file{path}, loaded{0}, compacted{0} {
+    using std::runtime_error;
+
+    const char *data = file.getData();
+    const std::size_t length = file.getLength();
+
+    if (length < sizeof(PackHeader)) {
+        throw runtime_error("\nTruncated pack.\n");
+    }
+
+    const auto *header = reinterpret_cast<const PackHeader*>(data);
+
+    if (std::memcmp(header->magic, kPackMagic, sizeof(kPackMagic))
+        or header->version != kPackVersion
+        or header->pack_bytes != length) {
+        throw runtime_error("\nNot a URStack pack.\n");
+    }
+
+    const std::uint64_t count = header->session_count;
+
+    if (count > (length - sizeof(PackHeader)) / sizeof(PackIndexEntry)
+        or header->names_offset > length
+        or header->snapshots_offset > length
+        or header->snapshots_offset < header->names_offset) {
+        throw runtime_error("\nCorrupted pack header.\n");
+    }
+
+    const auto *entries = reinterpret_cast<const PackIndexEntry*>(
+            data + sizeof(PackHeader));
+    const char *names = data + header->names_offset;
+    const std::uint64_t names_bytes = header->snapshots_offset
+                                      - header->names_offset;
+
+    slots.reserve(count);
+    positions.reserve(count);
+
+    for (std::uint64_t i = 0; i < count; i++) {
+        const PackIndexEntry& entry = entries[i];
+
+        if (entry.snapshot_offset > length
+            or entry.snapshot_bytes > length - entry.snapshot_offset
+            or entry.name_offset > names_bytes
+            or entry.name_length > names_bytes - entry.name_offset
+            or entry.capacity <= 0
+            or entry.capacity > std::numeric_limits<int>::max()
+            or entry.size < 0 or entry.size > entry.capacity) {
+            throw runtime_error("\nCorrupted pack index.\n");
+        }
+
+        std::string name(names + entry.name_offset, entry.name_length);
+
+        if (not positions.emplace(name, slots.size()).second) {
+            throw runtime_error("\nRepeated session in pack index.\n");
+        }
+
+        slots.push_back(Slot{std::move(name), &entry});
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the name of an existing session.
+ *
+ * Post-Conditions:
+ *      Returns a reference to the slot of the session.
+ *      Throws std::out_of_range if the session does not exist.
+ *
+ * Finds the slot of the named session.
+ */
+template<class DataType>
+const typename URStackRegistry<DataType>::Slot&
+    URStackRegistry<DataType>::slotOf(const std::string& name) const {
+    auto position = positions.find(name);
+
+    if (position == positions.end()) {
+        throw std::out_of_range("\nNo session named " + name + ".\n");
+    }
+
+    return slots[position->second];
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the name of an existing session.
+ *
+ * Post-Conditions:
+ *      The session is materialised if it was not already.
+ *      Returns a reference to its URStack.
+ *      Throws std::out_of_range if the session does not exist.
+ *
+ * Returns the named session, materialising it if needed.
+ * The first access decodes the snapshot straight from the mapping,
+ * the first after a compaction from the memory it was packed in,
+ * which is then freed. The session moves to the back of recency, in O(1).
+ */
+template<class DataType>
+URStack<DataType>& URStackRegistry<DataType>::get(const std::string& name) {
+    auto& slot = const_cast<Slot&>(slotOf(name));
+
+    slot.used = std::chrono::steady_clock::now();
+
+    if (slot.stack) {
+        recency.splice(recency.end(), recency, slot.recent);
+        return *slot.stack;
+    }
+
+    std::unique_ptr<URStack<DataType>> stack;
+
+    if (not slot.packed.empty()) {
+        URStackSnapshot<DataType> snapshot{
+                reinterpret_cast<const char*>(slot.packed.data()),
+                slot.packed.size() * sizeof(SnapshotBlock)};
+
+        stack = std::make_unique<URStack<DataType>>(snapshot);
+    } else {
+        const PackIndexEntry& entry = *slot.entry;
+
+        URStackSnapshot<DataType> snapshot{
+                file.getData() + entry.snapshot_offset,
+                static_cast<std::size_t>(entry.snapshot_bytes)};
+
+        stack = std::make_unique<URStack<DataType>>(snapshot);
+    }
+
+    slot.recent = recency.insert(recency.end(),
+                                 static_cast<std::size_t>(&slot - &slots[0]));
+    slot.stack = std::move(stack);
+
+    if (not slot.packed.empty()) {
+        slot.packed = std::vector<SnapshotBlock>{};
+        compacted--;
+    }
+
+    loaded++;
+
+    return *slot.stack;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the name of the session.
+ *      Capacity of the new session.
+ *
+ * Post-Conditions:
+ *      An empty session is stored under the given name,
+ *      any existing session with that name is discarded.
+ *      Returns a reference to its URStack.
+ *
+ * Creates a new empty session, replacing an existing one.
+ */
+template<class DataType>
+URStack<DataType>& URStackRegistry<DataType>::create(const std::string& name,
+                                                     int capacity) {
+    auto stack = std::make_unique<URStack<DataType>>(capacity);
+    auto position = positions.find(name);
+
+    if (position == positions.end()) {
+        positions[name] = slots.size();
+        slots.push_back(Slot{name});
+        position = positions.find(name);
+    }
+
+    Slot& slot = slots[position->second];
+
+    if (slot.stack) {
+        recency.splice(recency.end(), recency, slot.recent);
+    } else {
+        slot.recent = recency.insert(recency.end(), position->second);
+        loaded++;
+    }
+
+    if (not slot.packed.empty()) {
+        compacted--;
+    }
+
+    slot.entry = nullptr;
+    slot.stack = std::move(stack);
+    slot.packed = std::vector<SnapshotBlock>{};
+    slot.used = std::chrono::steady_clock::now();
+
+    return *slot.stack;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the name of the session.
+ *
+ * Post-Conditions:
+ *      The session is removed, if it exists.
+ *      Returns true if a session was removed.
+ *
+ * Removes the named session.
+ * The last slot takes the place of the removed one,
+ * its entry in recency follows it.
+ */
+template<class DataType>
+bool URStackRegistry<DataType>::erase(const std::string& name) {
+    auto position = positions.find(name);
+
+    if (position == positions.end()) {
+        return false;
+    }
+
+    const std::size_t index = position->second;
+
+    if (slots[index].stack) {
+        recency.erase(slots[index].recent);
+        loaded--;
+    }
+
+    if (not slots[index].packed.empty()) {
+        compacted--;
+    }
+
+    positions.erase(position);
+
+    if (index != slots.size() - 1) {
+        slots[index] = std::move(slots.back());
+        positions[slots[index].name] = index;
+
+        if (slots[index].stack) {
+            *slots[index].recent = index;
+        }
+    }
+
+    slots.pop_back();
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the name of the session.
+ *
+ * Post-Conditions:
+ *      True if the session exists, otherwise false.
+ *
+ * Checks if the named session exists.
+ */
+template<class DataType>
+bool URStackRegistry<DataType>::contains(const std::string& name) const {
+    return positions.count(name);
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the name of an existing session.
+ *
+ * Post-Conditions:
+ *      True if the session has been materialised, otherwise false.
+ *
+ * Checks if the named session has been materialised.
+ */
+template<class DataType>
+bool URStackRegistry<DataType>::isLoaded(const std::string& name) const {
+    return static_cast<bool>(slotOf(name).stack);
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the name of an existing session.
+ *
+ * Post-Conditions:
+ *      Returns the summary of the session.
+ *
+ * Returns the size & capacity of a session,
+ * without materialising it.
+ */
+template<class DataType>
+typename URStackRegistry<DataType>::SessionInfo
+    URStackRegistry<DataType>::getInfo(const std::string& name) const {
+    const Slot& slot = slotOf(name);
+
+    if (slot.stack) {
+        return {slot.stack->getSize(), slot.stack->getCapacity()};
+    }
+
+    if (not slot.packed.empty()) {
+        const auto *header = reinterpret_cast<const SnapshotHeader*>(
+                slot.packed.data());
+
+        return {static_cast<int>(header->size),
+                static_cast<int>(header->capacity)};
+    }
+
+    return {static_cast<int>(slot.entry->size),
+            static_cast<int>(slot.entry->capacity)};
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *
+ * Post-Conditions:
+ *      Returns the names of all sessions, in no particular order.
+ *
+ * Returns the names of all sessions.
+ */
+template<class DataType>
+std::vector<std::string> URStackRegistry<DataType>::getNames() const {
+    std::vector<std::string> result;
+
+    result.reserve(slots.size());
+
+    for (const Slot& slot : slots) {
+        result.push_back(slot.name);
+    }
+
+    return result;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the path of the pack.
+ *
+ * Post-Conditions:
+ *      Every session is written to the pack.
+ *      Throws std::runtime_error if the file cannot be written.
+ *
+ * Writes all sessions to a pack at the given path.
+ * Sessions that were never materialised are copied from the mapping as
+ * raw bytes, compacted ones from their snapshot. The pack is written next
+ * to the given path & renamed over it, so saving over the pack the
+ * registry was opened from is safe.
+ */
+template<class DataType>
+void URStackRegistry<DataType>::save(const std::string& path) const {
+    using std::runtime_error;
+
+    static const char kPadding[kSnapshotAlignment] = {};
+
+    const std::string temporary = path + ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+
+    if (not out) {
+        throw runtime_error("\nCannot open " + temporary + ".\n");
+    }
+
+    PackHeader header{};
+    std::vector<PackIndexEntry> entries(slots.size());
+    std::string names;
+
+    for (std::size_t i = 0; i < slots.size(); i++) {
+        entries[i].name_offset = names.size();
+        entries[i].name_length = slots[i].name.size();
+        names += slots[i].name;
+    }
+
+    std::memcpy(header.magic, kPackMagic, sizeof(kPackMagic));
+    header.version = kPackVersion;
+    header.session_count = slots.size();
+    header.names_offset = sizeof(PackHeader)
+                          + slots.size() * sizeof(PackIndexEntry);
+    header.snapshots_offset = alignSnapshot(header.names_offset
+                                            + names.size());
+
+    /* Header & index are rewritten once the snapshots are placed */
+    out.seekp(static_cast<std::streamoff>(header.names_offset));
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+    out.write(kPadding, static_cast<std::streamsize>(
+            header.snapshots_offset - header.names_offset - names.size()));
+
+    std::uint64_t offset = header.snapshots_offset;
+
+    for (std::size_t i = 0; i < slots.size(); i++) {
+        const Slot& slot = slots[i];
+        PackIndexEntry& entry = entries[i];
+
+        entry.snapshot_offset = offset;
+
+        if (slot.stack) {
+            const SnapshotHeader written = slot.stack->save(out);
+
+            entry.snapshot_bytes = sizeof(SnapshotHeader)
+                                   + written.payload_bytes;
+            entry.length = written.length;
+            entry.current = written.current;
+            entry.size = written.size;
+            entry.capacity = written.capacity;
+        } else if (not slot.packed.empty()) {
+            const auto *packed = reinterpret_cast<const SnapshotHeader*>(
+                    slot.packed.data());
+
+            out.write(reinterpret_cast<const char*>(slot.packed.data()),
+                      static_cast<std::streamsize>(
+                              sizeof(SnapshotHeader) + packed->payload_bytes));
+
+            entry.snapshot_bytes = sizeof(SnapshotHeader)
+                                   + packed->payload_bytes;
+            entry.length = packed->length;
+            entry.current = packed->current;
+            entry.size = packed->size;
+            entry.capacity = packed->capacity;
+        } else {
+            const PackIndexEntry& previous = *slot.entry;
+
+            out.write(file.getData() + previous.snapshot_offset,
+                      static_cast<std::streamsize>(previous.snapshot_bytes));
+
+            entry.snapshot_bytes = previous.snapshot_bytes;
+            entry.length = previous.length;
+            entry.current = previous.current;
+            entry.size = previous.size;
+            entry.capacity = previous.capacity;
+        }
+
+        offset += entry.snapshot_bytes;
+    }
+
+    header.pack_bytes = offset;
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<std::streamsize>(
+                      entries.size() * sizeof(PackIndexEntry)));
+
+    if (not out.flush()) {
+        throw runtime_error("\nCannot write " + temporary + ".\n");
+    }
+
+    out.close();
+
+    if (std::rename(temporary.c_str(), path.c_str())) {
+        throw runtime_error("\nCannot replace " + path + ".\n");
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the budget (optional, default budget).
+ *      No reference returned by get or create is in use by another
+ *      thread.
+ *
+ * Post-Conditions:
+ *      Materialised sessions not accessed for options.idle are packed
+ *      into snapshots, least recently used first, their URStacks
+ *      destroyed, until none is left or options.slice has passed.
+ *      References to the packed sessions are invalidated, get
+ *      materialises them again.
+ *      Returns the packed sessions & the memory they reclaimed.
+ *      Throws std::system_error if a thread cannot be started,
+ *      std::bad_alloc if a snapshot cannot be allocated, with the
+ *      session it was for left as is.
+ *
+ * Packs the idle sessions, in parallel, within a time slice.
+ * The idle sessions are the front of recency, found without a sort or
+ * a look at the sessions in use. A session is packed in one go, so it
+ * is skipped unless its estimated cost, its length times pack_cost,
+ * ends within the slice: the caller is blocked for the slice, give or
+ * take the error of the estimate, learnt from the sessions packed.
+ * The threads of the WorkerPool, started by the first call, take the
+ * idlest session left, so a thread stuck on a long history never holds
+ * up the short ones. Every thread packs & destroys sessions of its own,
+ * the slots are not moved meanwhile, the counts & recency are updated
+ * once the run is done.
+ */
+template<class DataType>
+CompactionReport URStackRegistry<DataType>::compact(
+        const CompactionOptions& options) {
+    typedef std::chrono::steady_clock Clock;
+
+    /*
+     * Outcome of packing a single session.
+     */
+    struct Packing {
+        std::size_t stack_bytes = 0;
+        std::size_t actions = 0;
+        Clock::duration spent{0};
+    };
+
+    const Clock::time_point now = Clock::now();
+    const Clock::time_point deadline = now + options.slice;
+    std::vector<std::size_t> idle;
+    CompactionReport report;
+
+    /* Least recently used first, the most likely to stay idle */
+    for (std::size_t position: recency) {
+        if (now - slots[position].used < options.idle) {
+            break;
+        }
+
+        idle.push_back(position);
+    }
+
+    if (idle.empty()) {
+        return report;
+    }
+
+    const unsigned threads = WorkerPool::resolveThreads(options.threads);
+
+    if (not pool or pool->getThreads() != threads) {
+        pool = std::make_unique<WorkerPool>(threads);
+    }
+
+    const std::chrono::duration<double, std::nano> cost{pack_cost};
+    std::vector<Packing> packings(idle.size());
+    std::exception_ptr error;
+
+    /* The counts are updated before an error propagates */
+    try {
+        pool->run(idle.size(), [&](std::size_t i) {
+            Slot& slot = slots[idle[i]];
+            const Clock::time_point start = Clock::now();
+            const int actions = slot.stack->getLength();
+
+            if (deadline - start <= cost * actions) {
+                return;
+            }
+
+            packings[i].stack_bytes =
+                    slot.stack->memoryUsage().getTotalBytes();
+            slot.packed = pack(*slot.stack);
+            slot.stack.reset();
+            packings[i].actions = static_cast<std::size_t>(actions);
+            packings[i].spent = Clock::now() - start;
+        });
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    std::size_t actions = 0;
+    Clock::duration spent{0};
+
+    for (std::size_t i = 0; i < idle.size(); i++) {
+        const Slot& slot = slots[idle[i]];
+
+        if (slot.stack) {
+            report.remaining++;
+            continue;
+        }
+
+        recency.erase(slot.recent);
+        report.sessions++;
+        report.stack_bytes += packings[i].stack_bytes;
+        report.packed_bytes += slot.packed.capacity() * sizeof(SnapshotBlock);
+        actions += packings[i].actions;
+        spent += packings[i].spent;
+    }
+
+    /* Halfway to the cost measured, so a single slow run does not stick */
+    if (actions) {
+        pack_cost = (pack_cost
+                     + std::chrono::duration<double, std::nano>{spent}.count()
+                       / static_cast<double>(actions)) / 2;
+    }
+
+    loaded -= report.sessions;
+    compacted += report.sessions;
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return report;
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackRegistry is initialized.
+ *      const reference to the name of an existing session.
+ *
+ * Post-Conditions:
+ *      True if the session was packed by compact & not accessed
+ *      since, otherwise false.
+ *      Throws std::out_of_range if the session does not exist.
+ *
+ * Checks if the named session is packed by compact.
+ */
+template<class DataType>
+bool URStackRegistry<DataType>::isCompacted(const std::string& name) const {
+    return not slotOf(name).packed.empty();
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to a session.
+ *
+ * Post-Conditions:
+ *      Returns the snapshot of the session, in as many blocks
+ *      as it needs.
+ *      Throws std::bad_alloc if the blocks cannot be allocated.
+ *
+ * Encodes a session as a snapshot, in aligned memory.
+ * Snapshots are padded to whole blocks, so none is wasted.
+ */
+template<class DataType>
+std::vector<SnapshotBlock> URStackRegistry<DataType>::pack(
+        const URStack<DataType>& stack) {
+    std::vector<SnapshotBlock> blocks;
+    BlockSink sink{blocks};
+    std::ostream out{&sink};
+
+    /* Rethrows the errors of the sink, instead of setting badbit */
+    out.exceptions(std::ios::badbit);
+    stack.save(out);
+    blocks.shrink_to_fit();
+
+    return blocks;
+}
+
+/*
+ * Pre-Conditions:
+ *      Character to append, or eof.
+ *
+ * Post-Conditions:
+ *      The character is appended to the blocks.
+ *
+ * Appends a single character to the blocks.
+ */
+template<class DataType>
+typename URStackRegistry<DataType>::BlockSink::int_type
+    URStackRegistry<DataType>::BlockSink::overflow(int_type c) {
+    if (not traits_type::eq_int_type(c, traits_type::eof())) {
+        const char_type character = traits_type::to_char_type(c);
+
+        xsputn(&character, 1);
+    }
+
+    return traits_type::not_eof(c);
+}
+
+/*
+ * Pre-Conditions:
+ *      Characters to append & their count.
+ *
+ * Post-Conditions:
+ *      The characters are appended to the blocks.
+ *      Returns the count.
+ *
+ * Appends characters to the blocks.
+ * The blocks grow as a vector does, pack trims them once written.
+ */
+template<class DataType>
+std::streamsize URStackRegistry<DataType>::BlockSink::xsputn(
+        const char_type *characters, std::streamsize count) {
+    /* Empty values are written as null pointers, memcpy forbids them */
+    if (count <= 0) {
+        return 0;
+    }
+
+    const std::size_t end = length + static_cast<std::size_t>(count);
+
+    if (end > blocks.size() * sizeof(SnapshotBlock)) {
+        blocks.resize((end + sizeof(SnapshotBlock) - 1)
+                      / sizeof(SnapshotBlock));
+    }
+
+    std::memcpy(reinterpret_cast<char*>(blocks.data()) + length,
+                characters, static_cast<std::size_t>(count));
+    length = end;
+
+    return count;
+}
+
+#endif //URSTACK_URSTACKREGISTRY_CPP
@@ -0,0 +1,606 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackRegistry.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the URStackRegistry<DataType> class,
+ *              a set of named URStack sessions persisted as a single pack
+ *              & loaded lazily, one session at a time.
+ *
+ * Pack layout (native byte order, every section 64-byte aligned):
+ *      PackHeader          64 bytes, see below.
+ *      PackIndexEntry[]    One 64-byte entry per session.
+ *      Names               Session names, referenced by the entries.
+ *      Snapshots           One URStackSnapshot per session,
+ *                          referenced by the entries.
+ *
+ *      Opening a pack reads only the header, the index & the names,
+ *      the snapshots are decoded on the first access to their session.
+ *
+ * Compaction: sessions idle for long enough are packed back into their
+ *      snapshot, held in memory, & materialised again on their next
+ *      access. A URStack holds a Node per action, a snapshot a single
+ *      block of values. compact packs the idlest sessions on a pool of
+ *      threads, within a time slice, & reports the reclaimed bytes.
+ *      Materialised sessions are kept in order of last access, so the
+ *      idle ones are found without scanning the others, & the threads
+ *      are started by the first compaction only.
+ *
+ * List of public URStackRegistry<DataType> class Functions:
+ *      URStackRegistry()
+ *          No-arg constructor, creates an empty registry.
+ *
+ *      explicit URStackRegistry(const std::string&)
+ *          Opens the pack at the given path, reading only its index.
+ *
+ *      URStack<DataType>& get(const std::string&)
+ *          Returns the named session, materialising it if needed.
+ *
+ *      URStack<DataType>& create(const std::string&, int capacity)
+ *          Creates a new empty session, replacing an existing one.
+ *
+ *      bool erase(const std::string&)
+ *          Removes the named session.
+ *
+ *      bool contains(const std::string&) const
+ *          Checks if the named session exists.
+ *
+ *      bool isLoaded(const std::string&) const
+ *          Checks if the named session has been materialised.
+ *
+ *      SessionInfo getInfo(const std::string&) const
+ *          Returns the size & capacity of a session,
+ *          without materialising it.
+ *
+ *      std::vector<std::string> getNames() const
+ *          Returns the names of all sessions.
+ *
+ *      void save(const std::string&) const
+ *          Writes all sessions to a pack at the given path.
+ *
+ *      CompactionReport compact(const CompactionOptions& = {})
+ *          Packs the idle sessions, in parallel, within a time slice.
+ *
+ *      bool isCompacted(const std::string&) const
+ *          Checks if the named session is packed by compact.
+ *
+ *      inline std::size_t getSessionCount() const
+ *          Returns the number of sessions.
+ *
+ *      inline std::size_t getLoadedCount() const
+ *          Returns the number of materialised sessions.
+ *
+ *      inline std::size_t getCompactedCount() const
+ *          Returns the number of sessions packed by compact.
+ *
+ * List of public CompactionReport struct Functions:
+ *      inline std::size_t getReclaimedBytes() const
+ *          Returns the bytes freed by the compaction.
+ *
+ *      inline void add(const CompactionReport&)
+ *          Adds the counts of another report.
+ */
+
+#ifndef URSTACK_URSTACKREGISTRY_H
+#define URSTACK_URSTACKREGISTRY_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "MappedFile.h"
+#include "URStack.h"
+#include "URStackSnapshot.h"
+#include "WorkerPool.h"
+
+
+/*
+ * Version of the pack format written by URStackRegistry::save.
+ */
+constexpr std::uint32_t kPackVersion = 1;
+
+/*
+ * Fixed-size header at the beginning of every pack.
+ */
+struct PackHeader {
+    /* "URSPACK" followed by a null byte */
+    char magic[8];
+
+    /* kPackVersion at the time of writing */
+    std::uint32_t version;
+
+    /* Reserved, written as 0 */
+    std::uint32_t reserved;
+
+    /* Number of PackIndexEntry following the header */
+    std::uint64_t session_count;
+
+    /* Offset of the names section from the beginning of the pack */
+    std::uint64_t names_offset;
+
+    /* Offset of the first snapshot from the beginning of the pack */
+    std::uint64_t snapshots_offset;
+
+    /* Total number of bytes in the pack */
+    std::uint64_t pack_bytes;
+
+    /* Padding up to kSnapshotAlignment */
+    std::uint64_t padding[2];
+};
+
+static_assert(sizeof(PackHeader) == kSnapshotAlignment,
+              "PackHeader must occupy exactly one aligned section");
+
+/*
+ * Index entry of a single session in a pack.
+ */
+struct PackIndexEntry {
+    /* Offset of the name, relative to the names section */
+    std::uint64_t name_offset;
+
+    /* Number of bytes in the name */
+    std::uint64_t name_length;
+
+    /* Offset of the snapshot from the beginning of the pack */
+    std::uint64_t snapshot_offset;
+
+    /* Number of bytes in the snapshot, padding included */
+    std::uint64_t snapshot_bytes;
+
+    /* Number of actions in the chain */
+    std::uint64_t length;
+
+    /* Number of hops from top to current */
+    std::uint64_t current;
+
+    /* URStack::size at the time of writing */
+    std::int64_t size;
+
+    /* URStack::capacity at the time of writing */
+    std::int64_t capacity;
+};
+
+static_assert(sizeof(PackIndexEntry) == kSnapshotAlignment,
+              "PackIndexEntry must occupy exactly one aligned section");
+
+/*
+ * Unit of the memory holding a compacted session, aligned so its
+ * snapshot is read in place, as a mapped one.
+ */
+struct alignas(kSnapshotAlignment) SnapshotBlock {
+    char bytes[kSnapshotAlignment];
+};
+
+/*
+ * Budget of URStackRegistry::compact: its threads, its time slice
+ * & how often callers such as URStackServer grant one.
+ * CPU use is at most threads * slice every interval, give or take the
+ * error of the estimated cost of the packed sessions.
+ */
+struct CompactionOptions {
+    /* Time since the last access after which a session is idle */
+    std::chrono::milliseconds idle{30000};
+
+    /* Time after which no more sessions are packed by a call,
+     * sessions estimated to take longer are never packed */
+    std::chrono::microseconds slice{2000};
+
+    /* Time between two slices, for callers granting them periodically */
+    std::chrono::milliseconds interval{1000};
+
+    /* Threads packing the sessions, 0 for one per core */
+    unsigned threads = 1;
+};
+
+/*
+ * Outcome of URStackRegistry::compact.
+ */
+struct CompactionReport {
+    /* Sessions packed */
+    std::size_t sessions = 0;
+
+    /* Idle sessions left for the next slice, or too long for one */
+    std::size_t remaining = 0;
+
+    /* Memory of the packed sessions as URStacks, see memoryUsage */
+    std::size_t stack_bytes = 0;
+
+    /* Memory of the packed sessions as snapshots */
+    std::size_t packed_bytes = 0;
+
+    /*
+     * Pre-Conditions:
+     *      CompactionReport is initialized.
+     *
+     * Post-Conditions:
+     *      Returns stack_bytes minus packed_bytes.
+     *
+     * Returns the bytes freed by the compaction.
+     * Snapshots never hold more than the Nodes of their actions,
+     * barring actions smaller than their 64-byte header.
+     */
+    [[nodiscard]] inline std::size_t getReclaimedBytes() const {
+        return stack_bytes > packed_bytes ? stack_bytes - packed_bytes : 0;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      CompactionReport is initialized.
+     *      const reference to a later report.
+     *
+     * Post-Conditions:
+     *      The counts of the given report are added, remaining is
+     *      replaced by the later one.
+     *
+     * Adds the counts of another report.
+     */
+    inline void add(const CompactionReport& later) {
+        sessions += later.sessions;
+        remaining = later.remaining;
+        stack_bytes += later.stack_bytes;
+        packed_bytes += later.packed_bytes;
+    }
+};
+
+/*
+ * Named URStack sessions, persisted together & materialised on demand.
+ */
+template<class DataType>
+class URStackRegistry {
+public:
+    /*
+     * Summary of a session, available without materialising it.
+     */
+    struct SessionInfo {
+        /* Number of actions that can be undone */
+        int size;
+
+        /* Maximum number of actions */
+        int capacity;
+    };
+
+    /*
+     * Pre-Conditions:
+     *      No preconditions.
+     *
+     * Post-Conditions:
+     *      An empty URStackRegistry instance is created.
+     *
+     * No-arg constructor of the URStackRegistry class.
+     */
+    URStackRegistry();
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the path of a pack written by save.
+     *
+     * Post-Conditions:
+     *      A URStackRegistry holding every session of the pack is created.
+     *      No session is materialised.
+     *      Throws std::runtime_error if the file is not a valid pack.
+     *
+     * Opens the pack at the given path, reading only its index.
+     */
+    explicit URStackRegistry(const std::string&);
+
+    URStackRegistry(URStackRegistry&&) noexcept = default;
+
+    URStackRegistry& operator=(URStackRegistry&&) noexcept = default;
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the name of an existing session.
+     *
+     * Post-Conditions:
+     *      The session is materialised if it was not already.
+     *      Returns a reference to its URStack, valid until the session
+     *      is erased or replaced.
+     *      Throws std::out_of_range if the session does not exist.
+     *
+     * Returns the named session, materialising it if needed.
+     */
+    URStack<DataType>& get(const std::string&);
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the name of the session.
+     *      Capacity of the new session.
+     *
+     * Post-Conditions:
+     *      An empty session is stored under the given name,
+     *      any existing session with that name is discarded.
+     *      Returns a reference to its URStack.
+     *
+     * Creates a new empty session, replacing an existing one.
+     */
+    URStack<DataType>& create(const std::string&, int /* capacity */);
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the name of the session.
+     *
+     * Post-Conditions:
+     *      The session is removed, if it exists.
+     *      Returns true if a session was removed.
+     *
+     * Removes the named session.
+     */
+    bool erase(const std::string&);
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the name of the session.
+     *
+     * Post-Conditions:
+     *      True if the session exists, otherwise false.
+     *
+     * Checks if the named session exists.
+     */
+    [[nodiscard]] bool contains(const std::string&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the name of an existing session.
+     *
+     * Post-Conditions:
+     *      True if the session has been materialised, otherwise false.
+     *      Throws std::out_of_range if the session does not exist.
+     *
+     * Checks if the named session has been materialised.
+     */
+    [[nodiscard]] bool isLoaded(const std::string&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the name of an existing session.
+     *
+     * Post-Conditions:
+     *      Returns the summary of the session, read from the index
+     *      or from the materialised URStack.
+     *      Throws std::out_of_range if the session does not exist.
+     *
+     * Returns the size & capacity of a session,
+     * without materialising it.
+     */
+    [[nodiscard]] SessionInfo getInfo(const std::string&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the names of all sessions, in no particular order.
+     *
+     * Returns the names of all sessions.
+     */
+    [[nodiscard]] std::vector<std::string> getNames() const;
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the path of the pack.
+     *
+     * Post-Conditions:
+     *      Every session is written to the pack.
+     *      Sessions that were never materialised are copied as raw bytes.
+     *      Throws std::runtime_error if the file cannot be written.
+     *
+     * Writes all sessions to a pack at the given path.
+     */
+    void save(const std::string&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the budget (optional, default budget).
+     *      No reference returned by get or create is in use by another
+     *      thread.
+     *
+     * Post-Conditions:
+     *      Materialised sessions not accessed for options.idle are packed
+     *      into snapshots, least recently used first, their URStacks
+     *      destroyed, until none is left or options.slice has passed.
+     *      Sessions estimated to take longer than what is left of the
+     *      slice are skipped.
+     *      References to the packed sessions are invalidated, get
+     *      materialises them again.
+     *      Returns the packed sessions & the memory they reclaimed.
+     *      Throws std::system_error if a thread cannot be started,
+     *      std::bad_alloc if a snapshot cannot be allocated, with the
+     *      session it was for left as is.
+     *
+     * Packs the idle sessions, in parallel, within a time slice.
+     */
+    CompactionReport compact(const CompactionOptions& = CompactionOptions{});
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the name of an existing session.
+     *
+     * Post-Conditions:
+     *      True if the session was packed by compact & not accessed
+     *      since, otherwise false.
+     *      Throws std::out_of_range if the session does not exist.
+     *
+     * Checks if the named session is packed by compact.
+     */
+    [[nodiscard]] bool isCompacted(const std::string&) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *
+     * Post-Conditions:
+     *      Number of sessions is returned.
+     *
+     * Returns the number of sessions.
+     */
+    [[nodiscard]] inline std::size_t getSessionCount() const {
+        return slots.size();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *
+     * Post-Conditions:
+     *      Number of materialised sessions is returned.
+     *
+     * Returns the number of materialised sessions.
+     */
+    [[nodiscard]] inline std::size_t getLoadedCount() const {
+        return loaded;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *
+     * Post-Conditions:
+     *      Number of sessions packed by compact is returned.
+     *
+     * Returns the number of sessions packed by compact.
+     */
+    [[nodiscard]] inline std::size_t getCompactedCount() const {
+        return compacted;
+    }
+
+private:
+    /*
+     * A single session, either still in the pack or materialised.
+     */
+    struct Slot {
+        /* Name of the session */
+        std::string name;
+
+        /* Index entry in the pack, nullptr for sessions created later */
+        const PackIndexEntry *entry = nullptr;
+
+        /* Materialised session, nullptr until the first access */
+        std::unique_ptr<URStack<DataType>> stack = nullptr;
+
+        /* Snapshot of a compacted session, empty otherwise */
+        std::vector<SnapshotBlock> packed = {};
+
+        /* Last access, sessions are idle some time after it */
+        std::chrono::steady_clock::time_point used = {};
+
+        /* Position in recency, only while the session is materialised */
+        typename std::list<std::size_t>::iterator recent = {};
+    };
+
+    /*
+     * streambuf appending everything written to it to aligned blocks,
+     * so a snapshot is written straight into the memory it is read from.
+     */
+    class BlockSink: public std::streambuf {
+    public:
+        explicit BlockSink(std::vector<SnapshotBlock>& blocks):
+                blocks{blocks}, length{0} {}
+
+    protected:
+        int_type overflow(int_type) override;
+
+        std::streamsize xsputn(const char_type*, std::streamsize) override;
+
+    private:
+        std::vector<SnapshotBlock>& blocks;
+
+        /* Bytes written, the last block may be partly used */
+        std::size_t length;
+    };
+
+    /*
+     * Mapping of the pack the registry was opened from.
+     * Empty for registries that were not opened from a pack.
+     */
+    MappedFile file;
+
+    /*
+     * All sessions, erased ones are replaced by the last slot.
+     */
+    std::vector<Slot> slots;
+
+    /*
+     * Position of every session in slots, by name.
+     */
+    std::unordered_map<std::string, std::size_t> positions;
+
+    /*
+     * Number of materialised sessions.
+     */
+    std::size_t loaded;
+
+    /*
+     * Number of sessions packed by compact.
+     */
+    std::size_t compacted;
+
+    /*
+     * Positions in slots of the materialised sessions,
+     * least recently used first.
+     */
+    std::list<std::size_t> recency;
+
+    /*
+     * Threads of compact, started by its first call.
+     */
+    std::unique_ptr<WorkerPool> pool;
+
+    /*
+     * Estimate of pack_cost until a session is packed, on the safe side.
+     */
+    static constexpr double kInitialPackCost = 200;
+
+    /*
+     * Estimated nanoseconds to pack a single action, learnt by compact.
+     */
+    double pack_cost = kInitialPackCost;
+
+    /*
+     * Pre-Conditions:
+     *      URStackRegistry is initialized.
+     *      const reference to the name of an existing session.
+     *
+     * Post-Conditions:
+     *      Returns a reference to the slot of the session.
+     *      Throws std::out_of_range if the session does not exist.
+     *
+     * Finds the slot of the named session.
+     */
+    [[nodiscard]] const Slot& slotOf(const std::string&) const;
+
+    /*
+     * Pre-Conditions:
+     *      const reference to a session.
+     *
+     * Post-Conditions:
+     *      Returns the snapshot of the session, in as many blocks
+     *      as it needs.
+     *      Throws std::bad_alloc if the blocks cannot be allocated.
+     *
+     * Encodes a session as a snapshot, in aligned memory.
+     */
+    [[nodiscard]] static std::vector<SnapshotBlock> pack(
+            const URStack<DataType>&);
+};
+
+#endif //URSTACK_URSTACKREGISTRY_H
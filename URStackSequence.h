@@ -0,0 +1,358 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackSequence.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of SequenceIndex, an observer policy of URStack
+ *              (see URStackObserver.h) giving every inserted action a
+ *              stable identity: a 64-bit sequence number, counting the
+ *              inserts into the stack from 0, never reused.
+ *
+ *              Hop counts from top change with every insert & eviction,
+ *              sequence numbers do not, so other systems can keep them.
+ *              The index finds the action of a sequence number, its state
+ *              & its position in O(1), & the sequence number of a position
+ *              in O(1), at the cost of a pointer, a sequence number & a
+ *              hash map entry per held action.
+ *
+ *              Usage:
+ *                  URStack<std::string, NoStats,
+ *                          SequenceIndex<std::string>> stack;
+ *                  const std::uint64_t id =
+ *                          stack.getObserver().getNextSequence();
+ *                  stack.insertNewAction("edit");
+ *                  stack.getObserver().find(id);
+ *
+ *              Only actions inserted through the observed stack are
+ *              indexed, those of a loaded snapshot have no sequence number.
+ *
+ * List of public SequenceIndex<DataType> class Functions:
+ *      void onInsert(const DataType&)
+ *          Gives the inserted action the next sequence number.
+ *
+ *      void onEvict(const DataType&)
+ *          Forgets the evicted action.
+ *
+ *      void onDiscard(DataType&)
+ *          Forgets the discarded action.
+ *
+ *      inline void onUndo(const DataType&)
+ *          Counts the undone action.
+ *
+ *      inline void onRedo(const DataType&)
+ *          Counts the redone action.
+ *
+ *      const DataType* find(std::uint64_t) const
+ *          Returns the action of a sequence number.
+ *
+ *      SequenceState getState(std::uint64_t) const
+ *          Returns the state of the action of a sequence number.
+ *
+ *      int getPosition(std::uint64_t) const
+ *          Returns the position of the action of a sequence number.
+ *
+ *      std::uint64_t getSequence(int) const
+ *          Returns the sequence number of the action at a position.
+ *
+ *      inline std::uint64_t getNextSequence() const
+ *          Returns the sequence number of the next inserted action.
+ *
+ *      inline int getUndone() const
+ *          Returns the number of actions that can be redone.
+ *
+ *      inline std::size_t getLength() const
+ *          Returns the number of indexed actions.
+ *
+ * List of private SequenceIndex<DataType> class Functions:
+ *      std::size_t indexOf(std::uint64_t) const
+ *          Returns the index in entries of a sequence number.
+ */
+
+#ifndef URSTACK_URSTACKSEQUENCE_H
+#define URSTACK_URSTACKSEQUENCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+
+
+/*
+ * Sequence number of no action, returned by getSequence.
+ */
+inline constexpr std::uint64_t kNoSequence =
+        std::numeric_limits<std::uint64_t>::max();
+
+/*
+ * States of the action of a sequence number.
+ */
+enum class SequenceState {
+    /* Held by the stack & can be undone */
+    kApplied,
+
+    /* Held by the stack & can be redone */
+    kUndone,
+
+    /* Evicted, or discarded by an insert after it was undone */
+    kGone,
+
+    /* Not given yet */
+    kUnassigned
+};
+
+/*
+ * Observer policy indexing the held actions by sequence number.
+ * The actions are indexed by address, a Node never moves,
+ * not even when the stack is moved.
+ */
+template<class DataType>
+class SequenceIndex {
+public:
+    static constexpr bool kEnabled = true;
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the inserted action, on top of the stack.
+     *
+     * Post-Conditions:
+     *      The action is indexed with the next sequence number.
+     *      No action can be redone.
+     */
+    void onInsert(const DataType& action) {
+        sequences.emplace(next, evicted + entries.size());
+        entries.push_back({&action, next});
+        next++;
+        undone = 0;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the evicted action, the oldest of the stack.
+     *
+     * Post-Conditions:
+     *      The action is no longer indexed, if it was.
+     */
+    void onEvict(const DataType& action) {
+        if (not entries.empty() and entries.front().action == &action) {
+            sequences.erase(entries.front().sequence);
+            entries.pop_front();
+            evicted++;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Reference to the discarded action, the newest of the stack.
+     *
+     * Post-Conditions:
+     *      The action is no longer indexed, if it was.
+     *      One less action can be redone.
+     *
+     * Discarded actions are always undone ones, whether an insert
+     * follows (insertNewAction) or not (setCapacity).
+     */
+    void onDiscard(DataType& action) {
+        if (not entries.empty() and entries.back().action == &action) {
+            sequences.erase(entries.back().sequence);
+            entries.pop_back();
+        }
+
+        if (undone) {
+            undone--;
+        }
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the undone action.
+     *
+     * Post-Conditions:
+     *      One more action can be redone.
+     */
+    inline void onUndo(const DataType&) {
+        undone++;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the redone action.
+     *
+     * Post-Conditions:
+     *      One less action can be redone.
+     */
+    inline void onRedo(const DataType&) {
+        undone--;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      A sequence number.
+     *
+     * Post-Conditions:
+     *      Returns a pointer to the action of the sequence number,
+     *      nullptr if it is not held by the stack.
+     *
+     * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+     * wasteful calls. For example `index.find(5);`.
+     * The pointer stays valid until the action is evicted or discarded.
+     */
+    [[nodiscard]] const DataType* find(std::uint64_t sequence) const {
+        const std::size_t index = indexOf(sequence);
+
+        return index < entries.size() ? entries[index].action : nullptr;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      A sequence number.
+     *
+     * Post-Conditions:
+     *      Returns kApplied or kUndone if the action is held by the stack,
+     *      kUnassigned if the sequence number was not given yet,
+     *      otherwise kGone.
+     *
+     * Returns the state of the action of a sequence number.
+     */
+    [[nodiscard]] SequenceState getState(std::uint64_t sequence) const {
+        if (sequence >= next) {
+            return SequenceState::kUnassigned;
+        }
+
+        const int position = getPosition(sequence);
+
+        if (position < 0) {
+            return SequenceState::kGone;
+        }
+
+        return position < undone ? SequenceState::kUndone
+                                 : SequenceState::kApplied;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      A sequence number.
+     *
+     * Post-Conditions:
+     *      Returns the number of hops from top to the action of the
+     *      sequence number, as Node::skip, or -1 if it is not held.
+     *      The position minus getUndone() is the number of undos from
+     *      current, negative for undone actions.
+     *
+     * Returns the position of the action of a sequence number.
+     */
+    [[nodiscard]] int getPosition(std::uint64_t sequence) const {
+        const std::size_t index = indexOf(sequence);
+
+        if (index >= entries.size()) {
+            return -1;
+        }
+
+        return static_cast<int>(entries.size() - 1 - index);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Number of hops from top.
+     *
+     * Post-Conditions:
+     *      Returns the sequence number of the action at the position,
+     *      or kNoSequence if there is no indexed action there.
+     *
+     * Returns the sequence number of the action at a position.
+     */
+    [[nodiscard]] std::uint64_t getSequence(int position) const {
+        if (position < 0 or static_cast<std::size_t>(position)
+                            >= entries.size()) {
+            return kNoSequence;
+        }
+
+        return entries[entries.size() - 1 - position].sequence;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the sequence number the next insert gives.
+     */
+    [[nodiscard]] inline std::uint64_t getNextSequence() const {
+        return next;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of actions that can be redone,
+     *      the number of hops from top to current.
+     */
+    [[nodiscard]] inline int getUndone() const {
+        return undone;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of actions with a sequence number
+     *      held by the stack.
+     */
+    [[nodiscard]] inline std::size_t getLength() const {
+        return entries.size();
+    }
+
+private:
+    /*
+     * Indexed action, in insertion order.
+     */
+    struct Entry {
+        const DataType *action;
+        std::uint64_t sequence;
+    };
+
+    /* Indexed actions, oldest first */
+    std::deque<Entry> entries;
+
+    /* Sequence number to index in entries, plus evicted */
+    std::unordered_map<std::uint64_t, std::uint64_t> sequences;
+
+    /* Number of entries evicted from the front */
+    std::uint64_t evicted = 0;
+
+    std::uint64_t next = 0;
+
+    int undone = 0;
+
+    /*
+     * Pre-Conditions:
+     *      A sequence number.
+     *
+     * Post-Conditions:
+     *      Returns the index in entries of the sequence number,
+     *      or entries.size() if it is not indexed.
+     *
+     * Returns the index in entries of a sequence number.
+     * Indices are stored counting the evicted entries, so evicting
+     * does not renumber the others.
+     */
+    std::size_t indexOf(std::uint64_t sequence) const {
+        const auto found = sequences.find(sequence);
+
+        if (found == sequences.end()) {
+            return entries.size();
+        }
+
+        return static_cast<std::size_t>(found->second - evicted);
+    }
+};
+
+#endif //URSTACK_URSTACKSEQUENCE_H
@@ -0,0 +1,803 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackServer.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in URStackServer.h
+ *
+ * List of Functions:
+ *      static std::string_view nextToken(std::string_view&)
+ *          Splits the next token off a request.
+ *
+ * List of public URStackServer class Functions:
+ *      URStackServer(const std::string&, URStackRegistry<std::string>&,
+ *                    int capacity = 20)
+ *          Listens on the Unix domain socket at the given path.
+ *
+ *      ~URStackServer()
+ *          Closes every connection & removes the socket file.
+ *
+ *      void run()
+ *          Serves requests until stop is called.
+ *
+ *      void stop()
+ *          Makes run return, safe to call from a signal handler
+ *          or another thread.
+ *
+ *      void handle(std::string_view, std::string&)
+ *          Runs a single request, appending its response.
+ *
+ *      inline void setRecorder(TraceRecorder*)
+ *          Records every create, insert, undo & redo to a trace.
+ *
+ *      inline void setCompaction(const CompactionOptions*)
+ *          Compacts idle sessions between requests.
+ *
+ *      inline const CompactionReport& getCompaction() const
+ *          Returns the totals of every compaction run so far.
+ *
+ * List of private URStackServer class Functions:
+ *      void accept()
+ *          Accepts every pending connection.
+ *
+ *      bool receive(Connection&)
+ *          Reads & runs every complete request of a connection.
+ *
+ *      void runRequests(Connection&)
+ *          Runs the complete requests of a connection, up to the limit
+ *          of its pending responses.
+ *
+ *      bool flush(Connection&)
+ *          Writes as many pending responses as possible with one writev.
+ *
+ *      void close(int)
+ *          Closes a connection.
+ *
+ *      void dispatch(std::string_view, std::string&)
+ *          Runs a single request, which may throw.
+ *
+ *      URStack<std::string>* find(std::string_view, std::string&)
+ *          Returns the named session, or answers with an error.
+ */
+
+#include "URStackServer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+
+#include "URStackRegistry.cpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define URSTACK_HAS_EPOLL 1
+#endif
+
+
+/* Used std utilities */
+using std::string, std::string_view, std::runtime_error,
+        std::invalid_argument, std::to_string;
+
+/*
+ * Pre-Conditions:
+ *      Reference to the unparsed rest of a request.
+ *
+ * Post-Conditions:
+ *      Returns the text before the first space,
+ *      the given view is advanced past that space.
+ *
+ * Splits the next token off a request.
+ */
+static string_view nextToken(string_view& rest) {
+    const size_t space = rest.find(' ');
+    const string_view token = rest.substr(0, space);
+
+    rest = space == string_view::npos ? string_view{} : rest.substr(space + 1);
+
+    return token;
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the socket path, replaced if it exists.
+ *      Reference to the registry holding the sessions,
+ *      outliving the server.
+ *      Capacity of the sessions created by insert (optional, default 20).
+ *
+ * Post-Conditions:
+ *      The server listens on the socket, without serving yet.
+ *      Throws std::runtime_error if the socket cannot be set up.
+ *
+ * Listens on the Unix domain socket at the given path.
+ * Every descriptor is non-blocking, so run never stalls on one client.
+ */
+URStackServer::URStackServer(const string& socket_path,
+                             URStackRegistry<string>& sessions,
+                             int session_capacity):
+        registry{sessions}, capacity{session_capacity}, path{socket_path},
+        listener{-1}, poller{-1}, waker{-1}, stopping{false} {
+#ifdef URSTACK_HAS_EPOLL
+    sockaddr_un address{};
+
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw runtime_error("\nSocket path is too long.\n");
+    }
+
+    address.sun_family = AF_UNIX;
+    path.copy(address.sun_path, path.size());
+
+    /* Closes what was opened before throwing, the destructor will not run */
+    auto fail = [this](const string& message) {
+        for (int fd: {listener, poller, waker}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+
+        throw runtime_error("\n" + message + "\n");
+    };
+
+    listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                        0);
+
+    if (listener < 0) {
+        fail("Cannot create socket.");
+    }
+
+    ::unlink(path.c_str());
+
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address),
+               sizeof(address)) < 0
+        or ::listen(listener, SOMAXCONN) < 0) {
+        fail("Cannot listen on " + path + ".");
+    }
+
+    poller = ::epoll_create1(EPOLL_CLOEXEC);
+    waker = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (poller < 0 or waker < 0) {
+        fail("Cannot create event loop.");
+    }
+
+    for (int fd: {listener, waker}) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+
+        if (::epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event) < 0) {
+            fail("Cannot create event loop.");
+        }
+    }
+#else
+    throw runtime_error("\nServer mode requires epoll (Linux).\n");
+#endif
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` URStackServer instance is not destroyed.
+ *
+ * Post-Conditions:
+ *      Every connection is closed, the socket file is removed.
+ *
+ * Closes every connection & removes the socket file.
+ */
+URStackServer::~URStackServer() {
+#ifdef URSTACK_HAS_EPOLL
+    for (auto& [fd, connection]: connections) {
+        ::close(fd);
+    }
+
+    ::close(listener);
+    ::close(poller);
+    ::close(waker);
+    ::unlink(path.c_str());
+#endif
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *
+ * Post-Conditions:
+ *      Requests are served until stop is called.
+ *      Throws std::runtime_error if waiting for events fails.
+ *
+ * Serves requests until stop is called.
+ * A readable connection has all of its requests run in one go,
+ * so pipelined requests cost a single read & write.
+ * When compacting, the wait times out at the next slice, which runs
+ * after the events, so a busy server compacts as often as an idle one.
+ */
+void URStackServer::run() {
+#ifdef URSTACK_HAS_EPOLL
+    typedef std::chrono::steady_clock Clock;
+
+    static constexpr int kMaxEvents = 64;
+    epoll_event events[kMaxEvents];
+    Clock::time_point next_slice = Clock::now();
+
+    while (not stopping) {
+        int timeout = -1;
+
+        if (compaction) {
+            /* Rounded up, so the wait never ends before the slice */
+            const auto left = std::chrono::ceil<std::chrono::milliseconds>(
+                    next_slice - Clock::now());
+
+            timeout = static_cast<int>(std::max<long long>(0, left.count()));
+        }
+
+        const int ready = ::epoll_wait(poller, events, kMaxEvents, timeout);
+
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw runtime_error("\nCannot wait for events.\n");
+        }
+
+        for (int i = 0; i < ready; i++) {
+            const int fd = events[i].data.fd;
+            const std::uint32_t flags = events[i].events;
+
+            if (fd == listener) {
+                accept();
+                continue;
+            }
+
+            if (fd == waker) {
+                /* stopping is already set */
+                continue;
+            }
+
+            auto found = connections.find(fd);
+
+            if (found == connections.end()) {
+                continue;
+            }
+
+            Connection& connection = found->second;
+            bool open = flags & (EPOLLIN | EPOLLOUT);
+
+            if (open and (flags & EPOLLIN)) {
+                open = receive(connection);
+            }
+
+            if (open and (flags & EPOLLOUT)) {
+                open = flush(connection);
+            }
+
+            if (not open) {
+                close(fd);
+            }
+        }
+
+        if (compaction and Clock::now() >= next_slice) {
+            compacted.add(registry.compact(*compaction));
+            next_slice = Clock::now() + compaction->interval;
+        }
+    }
+#endif
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *
+ * Post-Conditions:
+ *      run returns after the current iteration.
+ *
+ * Makes run return, safe to call from a signal handler
+ * or another thread.
+ * Only sets a lock-free atomic & writes to the eventfd,
+ * both async-signal-safe.
+ */
+void URStackServer::stop() {
+    stopping = true;
+
+#ifdef URSTACK_HAS_EPOLL
+    const std::uint64_t one = 1;
+
+    /* The eventfd cannot be full, one write is enough to wake run up */
+    [[maybe_unused]] ssize_t ignored = ::write(waker, &one, sizeof(one));
+#endif
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *      A single request line, without its new line.
+ *      Reference to the responses to append to.
+ *
+ * Post-Conditions:
+ *      The request is run against the registry,
+ *      its response line is appended.
+ *      A request throwing, e.g. on a corrupted session, is answered
+ *      with ERR & the message of the exception, other sessions and
+ *      requests are unaffected.
+ *
+ * Runs a single request, appending its response.
+ * Appending to the batch of the current read keeps the responses
+ * of pipelined requests in one buffer. Whatever the failed request
+ * appended is dropped, the message is kept on a single line.
+ */
+void URStackServer::handle(string_view request, string& out) {
+    const size_t start = out.size();
+
+    try {
+        dispatch(request, out);
+    } catch (std::exception& error) {
+        out.resize(start);
+
+        string_view message = error.what();
+        const size_t first = message.find_first_not_of("\n ");
+
+        message = first == string_view::npos ? string_view{}
+                                             : message.substr(first);
+        message = message.substr(0, message.find_last_not_of("\n .") + 1);
+
+        out += "ERR ";
+
+        for (const char c: message) {
+            out += c == '\n' ? ' ' : c;
+        }
+
+        out += '\n';
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *
+ * Post-Conditions:
+ *      Every pending connection is accepted & registered in epoll.
+ *
+ * Accepts every pending connection.
+ * Stops at the first failure, e.g. too many open files,
+ * the listener stays readable so the rest are retried later.
+ */
+void URStackServer::accept() {
+#ifdef URSTACK_HAS_EPOLL
+    while (true) {
+        const int fd = ::accept4(listener, nullptr, nullptr,
+                                 SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+
+        if (::epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event) < 0) {
+            ::close(fd);
+            continue;
+        }
+
+        connections.emplace(fd, Connection{fd}).first->second.events =
+                event.events;
+    }
+#endif
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *      Reference to a readable connection.
+ *
+ * Post-Conditions:
+ *      Available bytes are read & complete requests run, until the
+ *      socket would block, the client stops sending, or the pending
+ *      responses exceed kMaxOutputBytes.
+ *      Their responses are queued, then flushed.
+ *      Returns false if the connection must be closed.
+ *
+ * Reads & runs every complete request of a connection.
+ * Requests are run after every read, so reading stops as soon as
+ * the responses reach their limit, leaving the rest in the socket.
+ * The end of the input only marks the connection as closing,
+ * its responses are still written.
+ */
+bool URStackServer::receive(Connection& connection) {
+#ifdef URSTACK_HAS_EPOLL
+    static constexpr size_t kReadBytes = 1 << 16;
+    char buffer[kReadBytes];
+
+    while (not connection.closing
+           and connection.pending <= kMaxOutputBytes) {
+        const ssize_t received = ::read(connection.fd, buffer, kReadBytes);
+
+        if (received > 0) {
+            connection.input.append(buffer, received);
+            runRequests(connection);
+        } else if (received == 0) {
+            connection.closing = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN or errno == EWOULDBLOCK) {
+            break;
+        } else {
+            return false;
+        }
+    }
+
+    return flush(connection);
+#else
+    return false;
+#endif
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *      Reference to a connection.
+ *
+ * Post-Conditions:
+ *      The complete requests of the input are run & consumed, until
+ *      the pending responses exceed kMaxOutputBytes.
+ *      Their responses are queued as one batch.
+ *
+ * Runs the complete requests of a connection, up to the limit
+ * of its pending responses.
+ * The consumed requests are erased once, after running all of them.
+ */
+void URStackServer::runRequests(Connection& connection) {
+    string batch;
+    const string& input = connection.input;
+    size_t start = 0;
+    size_t end;
+
+    while (connection.pending + batch.size() <= kMaxOutputBytes
+           and (end = input.find('\n', start)) != string::npos) {
+        string_view request{input.data() + start, end - start};
+
+        /* Tolerate CRLF clients */
+        if (not request.empty() and request.back() == '\r') {
+            request.remove_suffix(1);
+        }
+
+        if (not request.empty()) {
+            handle(request, batch);
+        }
+
+        start = end + 1;
+    }
+
+    connection.input.erase(0, start);
+
+    /* Only an incomplete request may be left this long */
+    if (connection.input.size() > kMaxLineBytes
+        and connection.input.find('\n') == string::npos) {
+        batch += "ERR Request too long\n";
+        connection.input.clear();
+        connection.closing = true;
+    }
+
+    if (not batch.empty()) {
+        connection.pending += batch.size();
+        connection.output.push_back(std::move(batch));
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *      Reference to a connection.
+ *
+ * Post-Conditions:
+ *      Pending responses are written until the socket would block,
+ *      the requests left by the limit of the responses are run
+ *      as it frees up.
+ *      Readable events are requested while the client may send &
+ *      the limit allows, writable events while responses are left.
+ *      Returns false if the connection must be closed, or if it is
+ *      closing & every response is written.
+ *
+ * Writes as many pending responses as possible with one writev.
+ * sendmsg gathers the batches like writev, but MSG_NOSIGNAL reports
+ * a closed peer as an error instead of raising SIGPIPE.
+ */
+bool URStackServer::flush(Connection& connection) {
+#ifdef URSTACK_HAS_EPOLL
+    static constexpr int kMaxVectors = 64;
+
+    bool blocked = false;
+
+    while (not blocked) {
+        while (not connection.output.empty()) {
+            iovec vectors[kMaxVectors];
+            int count = 0;
+            size_t offset = connection.written;
+
+            for (string& batch: connection.output) {
+                if (count == kMaxVectors) {
+                    break;
+                }
+
+                vectors[count++] = iovec{batch.data() + offset,
+                                         batch.size() - offset};
+                offset = 0;
+            }
+
+            msghdr message{};
+            message.msg_iov = vectors;
+            message.msg_iovlen = count;
+
+            const ssize_t sent = ::sendmsg(connection.fd, &message,
+                                           MSG_NOSIGNAL);
+
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                if (errno == EAGAIN or errno == EWOULDBLOCK) {
+                    blocked = true;
+                    break;
+                }
+
+                return false;
+            }
+
+            /* Drop the fully written batches */
+            size_t left = sent;
+
+            connection.pending -= left;
+
+            while (left) {
+                const size_t remaining = connection.output.front().size()
+                                         - connection.written;
+
+                if (left < remaining) {
+                    connection.written += left;
+                    break;
+                }
+
+                left -= remaining;
+                connection.output.pop_front();
+                connection.written = 0;
+            }
+        }
+
+        /* Requests held back by the limit, now that responses left */
+        const size_t queued = connection.output.size();
+
+        if (not blocked and connection.pending <= kMaxOutputBytes) {
+            runRequests(connection);
+        }
+
+        if (connection.output.size() == queued) {
+            break;
+        }
+    }
+
+    if (connection.closing and connection.output.empty()) {
+        return false;
+    }
+
+    std::uint32_t events = 0;
+
+    if (not connection.closing
+        and connection.pending <= kMaxOutputBytes) {
+        events |= EPOLLIN | EPOLLRDHUP;
+    }
+
+    if (not connection.output.empty()) {
+        events |= EPOLLOUT;
+    }
+
+    if (events != connection.events) {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = connection.fd;
+
+        if (::epoll_ctl(poller, EPOLL_CTL_MOD, connection.fd, &event) < 0) {
+            return false;
+        }
+
+        connection.events = events;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *      File descriptor of an accepted connection.
+ *
+ * Post-Conditions:
+ *      The connection is closed & forgotten.
+ *
+ * Closes a connection.
+ * Closing the descriptor removes it from epoll as well.
+ */
+void URStackServer::close(int fd) {
+#ifdef URSTACK_HAS_EPOLL
+    ::close(fd);
+#endif
+    connections.erase(fd);
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *      A single request line, without its new line.
+ *      Reference to the responses to append to.
+ *
+ * Post-Conditions:
+ *      The request is run against the registry,
+ *      its response line is appended.
+ *      Throws if the registry or the session does, e.g.
+ *      std::runtime_error on a corrupted snapshot.
+ *
+ * Runs a single request, which may throw.
+ * The session is looked up before anything is changed or recorded,
+ * so a corrupted one fails the request without side effects.
+ */
+void URStackServer::dispatch(string_view request, string& out) {
+    string_view rest = request;
+    const string_view command = nextToken(rest);
+    const string_view name = nextToken(rest);
+
+    if (name.empty()) {
+        out += "ERR Missing session\n";
+        return;
+    }
+
+    if (command == "insert") {
+        if (rest.empty()) {
+            out += "ERR Missing action\n";
+            return;
+        }
+
+        key.assign(name);
+
+        const bool exists = registry.contains(key);
+        URStack<string>& stack = exists ? registry.get(key)
+                                        : registry.create(key, capacity);
+
+        stack.insertNewAction(string{rest});
+        out += "OK\n";
+
+        if (recorder) {
+            const std::uint32_t session = recorder->getSession(name);
+
+            /* Replays create the session the same way */
+            if (not exists) {
+                recorder->record(TraceOperation::kCreate, session, capacity);
+            }
+
+            recorder->record(TraceOperation::kInsert, session, rest.size());
+        }
+    } else if (command == "undo" or command == "redo") {
+        URStack<string> *stack = find(name, out);
+
+        if (not stack) {
+            return;
+        }
+
+        const bool is_undo = command == "undo";
+        string *action = is_undo ? stack->undo() : stack->redo();
+
+        if (recorder) {
+            recorder->record(is_undo ? TraceOperation::kUndo
+                                     : TraceOperation::kRedo,
+                             recorder->getSession(name), 1);
+        }
+
+        if (not action) {
+            out += "NONE\n";
+            return;
+        }
+
+        out += "OK ";
+        out += *action;
+        out += '\n';
+    } else if (command == "list") {
+        URStack<string> *stack = find(name, out);
+
+        if (not stack) {
+            return;
+        }
+
+        out += "OK ";
+        out += to_string(stack->getSize());
+        out += ' ';
+        out += to_string(stack->getCapacity());
+
+        /* Escaped, so tabs inside actions cannot split them */
+        stack->visitPrevious([&out](const string& action) {
+            out += '\t';
+
+            for (const char c: action) {
+                if (c == '\t') {
+                    out += "\\t";
+                } else if (c == '\\') {
+                    out += "\\\\";
+                } else {
+                    out += c;
+                }
+            }
+        });
+
+        out += '\n';
+    } else if (command == "create") {
+        int session_capacity = capacity;
+
+        if (not rest.empty()) {
+            auto [end, error] = std::from_chars(
+                    rest.data(), rest.data() + rest.size(), session_capacity);
+
+            if (error != std::errc{} or end != rest.data() + rest.size()) {
+                out += "ERR Invalid capacity\n";
+                return;
+            }
+        }
+
+        try {
+            registry.create(key.assign(name), session_capacity);
+        } catch (invalid_argument&) {
+            out += "ERR Invalid capacity\n";
+            return;
+        }
+
+        out += "OK\n";
+
+        if (recorder) {
+            recorder->record(TraceOperation::kCreate,
+                             recorder->getSession(name), session_capacity);
+        }
+    } else {
+        out += "ERR Unknown command\n";
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackServer is initialized.
+ *      Name of the session.
+ *      Reference to the responses to append to.
+ *
+ * Post-Conditions:
+ *      Returns the session, or nullptr after appending an error.
+ *      Throws std::runtime_error if its snapshot is corrupted.
+ *
+ * Returns the named session, or answers with an error.
+ * Checks first, so a miss costs no exception.
+ */
+URStack<string>* URStackServer::find(string_view name, string& out) {
+    key.assign(name);
+
+    if (not registry.contains(key)) {
+        out += "ERR Unknown session\n";
+        return nullptr;
+    }
+
+    return &registry.get(key);
+}
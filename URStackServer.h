@@ -0,0 +1,437 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackServer.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the URStackServer class, serving the string
+ *              sessions of a URStackRegistry to local processes over a
+ *              Unix domain socket, with an epoll event loop.
+ *
+ *              Line protocol, one request per line, one response line
+ *              per request, in order. Requests may be pipelined.
+ *                  create <session> [capacity]     OK
+ *                  insert <session> <action>       OK
+ *                  undo <session>                  OK <action> | NONE
+ *                  redo <session>                  OK <action> | NONE
+ *                  list <session>                  OK <size> <capacity>
+ *                                                  followed by every
+ *                                                  previous action, newest
+ *                                                  first, tab separated
+ *              insert creates missing sessions with the default capacity.
+ *              Actions are the rest of the line, stored verbatim.
+ *              list escapes backslashes as \\ & tabs as \t in actions,
+ *              so tabs only ever separate them.
+ *              Failed requests are answered with ERR <message>.
+ *
+ *              A client shutting down its writing side still receives
+ *              the responses of every complete request it sent.
+ *              Requests of a client are no longer read while more than
+ *              kMaxOutputBytes of its responses wait to be written.
+ *
+ *              Idle sessions may be compacted (see setCompaction) in
+ *              slices run by the event loop, between requests.
+ *
+ * List of public URStackServer class Functions:
+ *      URStackServer(const std::string&, URStackRegistry<std::string>&,
+ *                    int capacity = 20)
+ *          Listens on the Unix domain socket at the given path.
+ *
+ *      ~URStackServer()
+ *          Closes every connection & removes the socket file.
+ *
+ *      void run()
+ *          Serves requests until stop is called.
+ *
+ *      void stop()
+ *          Makes run return, safe to call from a signal handler
+ *          or another thread.
+ *
+ *      void handle(std::string_view, std::string&)
+ *          Runs a single request, appending its response.
+ *
+ *      inline void setRecorder(TraceRecorder*)
+ *          Records every create, insert, undo & redo to a trace.
+ *
+ *      inline void setCompaction(const CompactionOptions*)
+ *          Compacts idle sessions between requests.
+ *
+ *      inline const CompactionReport& getCompaction() const
+ *          Returns the totals of every compaction run so far.
+ *
+ * List of private URStackServer class Functions:
+ *      void accept()
+ *          Accepts every pending connection.
+ *
+ *      bool receive(Connection&)
+ *          Reads & runs every complete request of a connection.
+ *
+ *      void runRequests(Connection&)
+ *          Runs the complete requests of a connection, up to the limit
+ *          of its pending responses.
+ *
+ *      bool flush(Connection&)
+ *          Writes as many pending responses as possible with one writev.
+ *
+ *      void close(int)
+ *          Closes a connection.
+ *
+ *      void dispatch(std::string_view, std::string&)
+ *          Runs a single request, which may throw.
+ *
+ *      URStack<std::string>* find(std::string_view, std::string&)
+ *          Returns the named session, or answers with an error.
+ */
+
+#ifndef URSTACK_URSTACKSERVER_H
+#define URSTACK_URSTACKSERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "URStackRegistry.h"
+#include "URStackTrace.h"
+
+
+/*
+ * Shared history service over a Unix domain socket.
+ * Single threaded, every request of a read is run before the responses
+ * are written back with a single writev.
+ * Only available where epoll is (Linux), the constructor throws elsewhere.
+ */
+class URStackServer {
+public:
+    /*
+     * Pre-Conditions:
+     *      const reference to the socket path, replaced if it exists.
+     *      Reference to the registry holding the sessions,
+     *      outliving the server.
+     *      Capacity of the sessions created by insert (optional, default 20).
+     *
+     * Post-Conditions:
+     *      The server listens on the socket, without serving yet.
+     *      Throws std::runtime_error if the socket cannot be set up.
+     *
+     * Listens on the Unix domain socket at the given path.
+     */
+    URStackServer(const std::string&, URStackRegistry<std::string>&,
+                  int capacity = 20);
+
+    URStackServer(const URStackServer&) = delete;
+
+    URStackServer& operator=(const URStackServer&) = delete;
+
+    /*
+     * Pre-Conditions:
+     *      `this` URStackServer instance is not destroyed.
+     *
+     * Post-Conditions:
+     *      Every connection is closed, the socket file is removed.
+     *
+     * Closes every connection & removes the socket file.
+     */
+    ~URStackServer();
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *
+     * Post-Conditions:
+     *      Requests are served until stop is called.
+     *      Throws std::runtime_error if waiting for events fails.
+     *
+     * Serves requests until stop is called.
+     */
+    void run();
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *
+     * Post-Conditions:
+     *      run returns after the current iteration.
+     *
+     * Makes run return, safe to call from a signal handler
+     * or another thread.
+     */
+    void stop();
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *      A single request line, without its new line.
+     *      Reference to the responses to append to.
+     *
+     * Post-Conditions:
+     *      The request is run against the registry,
+     *      its response line is appended.
+     *      A request throwing, e.g. on a corrupted session, is answered
+     *      with ERR & the message of the exception, other sessions and
+     *      requests are unaffected.
+     *
+     * Runs a single request, appending its response.
+     */
+    void handle(std::string_view, std::string&);
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *      Pointer to the recorder, outliving the server,
+     *      or nullptr to stop recording.
+     *
+     * Post-Conditions:
+     *      Every successful create & insert, & every undo & redo of an
+     *      existing session, is recorded with the session it targets.
+     *
+     * Records every create, insert, undo & redo to a trace.
+     */
+    inline void setRecorder(TraceRecorder *trace) {
+        recorder = trace;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *      Pointer to the budget, outliving the server,
+     *      or nullptr to stop compacting.
+     *
+     * Post-Conditions:
+     *      Every options->interval, run compacts the idle sessions of the
+     *      registry (see URStackRegistry::compact), between two reads,
+     *      waiting for no request.
+     *
+     * Compacts idle sessions between requests.
+     * A request waits at most one slice, the server being single threaded.
+     */
+    inline void setCompaction(const CompactionOptions *options) {
+        compaction = options;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the sums of the reports of every compaction.
+     *
+     * Returns the totals of every compaction run so far.
+     */
+    [[nodiscard]] inline const CompactionReport& getCompaction() const {
+        return compacted;
+    }
+
+private:
+    /*
+     * Maximum number of buffered bytes of an incomplete request.
+     */
+    static constexpr std::size_t kMaxLineBytes = 1 << 20;
+
+    /*
+     * Bytes of responses a client may leave unread before its requests
+     * stop being read, bounding the memory of a client that never reads.
+     */
+    static constexpr std::size_t kMaxOutputBytes = 1 << 22;
+
+    /*
+     * State of an accepted client.
+     */
+    struct Connection {
+        explicit Connection(int fd): fd{fd} {}
+
+        int fd;
+
+        /* Received bytes, requests not run yet & an incomplete one */
+        std::string input;
+
+        /* Responses not written yet, one string per batch of requests */
+        std::deque<std::string> output;
+
+        /* Bytes of the first pending batch already written */
+        std::size_t written = 0;
+
+        /* Bytes of output not written yet */
+        std::size_t pending = 0;
+
+        /* epoll events currently requested */
+        std::uint32_t events = 0;
+
+        /* Set once the client stops sending, closed once drained */
+        bool closing = false;
+    };
+
+    /*
+     * Sessions served.
+     */
+    URStackRegistry<std::string>& registry;
+
+    /*
+     * Capacity of the sessions created by insert.
+     */
+    int capacity;
+
+    /*
+     * Recorder of the served calls, nullptr if not recording.
+     */
+    TraceRecorder *recorder = nullptr;
+
+    /*
+     * Budget of the compactions, nullptr if not compacting.
+     */
+    const CompactionOptions *compaction = nullptr;
+
+    /*
+     * Totals of the compactions run so far.
+     */
+    CompactionReport compacted;
+
+    /*
+     * Path of the socket file.
+     */
+    std::string path;
+
+    /*
+     * Listening socket.
+     */
+    int listener;
+
+    /*
+     * epoll instance.
+     */
+    int poller;
+
+    /*
+     * eventfd written by stop to wake run up.
+     */
+    int waker;
+
+    /*
+     * Set by stop, lock-free so signal handlers & other threads may set it.
+     */
+    std::atomic<bool> stopping;
+
+    static_assert(std::atomic<bool>::is_always_lock_free,
+                  "stop must be async-signal-safe");
+
+    /*
+     * Session name of the request being run, reused across requests.
+     */
+    std::string key;
+
+    /*
+     * Accepted clients, by file descriptor.
+     */
+    std::unordered_map<int, Connection> connections;
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *
+     * Post-Conditions:
+     *      Every pending connection is accepted & registered in epoll.
+     *
+     * Accepts every pending connection.
+     */
+    void accept();
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *      Reference to a readable connection.
+     *
+     * Post-Conditions:
+     *      Available bytes are read & complete requests run, until the
+     *      socket would block, the client stops sending, or the pending
+     *      responses exceed kMaxOutputBytes.
+     *      Their responses are queued, then flushed.
+     *      Returns false if the connection must be closed.
+     *
+     * Reads & runs every complete request of a connection.
+     */
+    bool receive(Connection&);
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *      Reference to a connection.
+     *
+     * Post-Conditions:
+     *      The complete requests of the input are run & consumed, until
+     *      the pending responses exceed kMaxOutputBytes.
+     *      Their responses are queued as one batch.
+     *
+     * Runs the complete requests of a connection, up to the limit
+     * of its pending responses.
+     */
+    void runRequests(Connection&);
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *      Reference to a connection.
+     *
+     * Post-Conditions:
+     *      Pending responses are written until the socket would block,
+     *      the requests left by the limit of the responses are run
+     *      as it frees up.
+     *      Readable events are requested while the client may send &
+     *      the limit allows, writable events while responses are left.
+     *      Returns false if the connection must be closed, or if it is
+     *      closing & every response is written.
+     *
+     * Writes as many pending responses as possible with one writev.
+     */
+    bool flush(Connection&);
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *      File descriptor of an accepted connection.
+     *
+     * Post-Conditions:
+     *      The connection is closed & forgotten.
+     *
+     * Closes a connection.
+     */
+    void close(int);
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *      A single request line, without its new line.
+     *      Reference to the responses to append to.
+     *
+     * Post-Conditions:
+     *      The request is run against the registry,
+     *      its response line is appended.
+     *      Throws if the registry or the session does, e.g.
+     *      std::runtime_error on a corrupted snapshot.
+     *
+     * Runs a single request, which may throw.
+     */
+    void dispatch(std::string_view, std::string&);
+
+    /*
+     * Pre-Conditions:
+     *      URStackServer is initialized.
+     *      Name of the session.
+     *      Reference to the responses to append to.
+     *
+     * Post-Conditions:
+     *      Returns the session, or nullptr after appending an error.
+     *      Throws std::runtime_error if its snapshot is corrupted.
+     *
+     * Returns the named session, or answers with an error.
+     */
+    URStack<std::string>* find(std::string_view, std::string&);
+};
+
+#endif //URSTACK_URSTACKSERVER_H
@@ -0,0 +1,387 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackSnapshot.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in URStackSnapshot.h
+ *
+ * List of public URStackSnapshot<DataType> class Functions:
+ *      explicit URStackSnapshot(const std::string&)
+ *          Maps the snapshot file at the given path.
+ *
+ *      URStackSnapshot(const char*, std::size_t)
+ *          Views a snapshot already present in memory.
+ *
+ *      View operator[](std::size_t) const
+ *          Returns the value N-hops away from top, in place if possible.
+ *
+ *      DataType decode(std::size_t) const
+ *          Returns a copy of the value N-hops away from top.
+ *
+ * List of private URStackSnapshot<DataType> class Functions:
+ *      void bind(const char*, std::size_t)
+ *          Validates the snapshot & binds the view to it.
+ *
+ *      std::string_view bytesAt(std::size_t) const
+ *          Returns the encoded bytes of the value N-hops away from top.
+ *
+ * List of public SnapshotWriter<DataType> class Functions:
+ *      void append(const DataType&)
+ *          Appends the value of the next action in chain order.
+ *
+ *      SnapshotHeader write(std::ostream&, std::uint64_t current,
+ *                           int size, int capacity) const
+ *          Writes the snapshot of the appended values.
+ *
+ *      inline std::uint64_t getLength() const
+ *          Returns the number of appended values.
+ *
+ *      inline std::size_t getBytes() const
+ *          Returns the number of bytes held by the appended values.
+ */
+
+#ifndef URSTACK_URSTACKSNAPSHOT_CPP
+#define URSTACK_URSTACKSNAPSHOT_CPP
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "URStackSnapshot.h"
+
+
+/*
+ * Magic bytes at the beginning of every snapshot.
+ */
+inline constexpr char kSnapshotMagic[8] = "URSTACK";
+
+/*
+ * Detects whether a SnapshotCodec provides an in-place view function.
+ */
+template<class Codec, class = void>
+struct HasSnapshotView: std::false_type {};
+
+template<class Codec>
+struct HasSnapshotView<Codec,
+        std::void_t<decltype(Codec::view(std::string_view{}))>>:
+        std::true_type {};
+
+/*
+ * Pre-Conditions:
+ *      Number of bytes.
+ *
+ * Post-Conditions:
+ *      The given number rounded up to a multiple of kSnapshotAlignment.
+ *
+ * Rounds up to the snapshot alignment.
+ */
+inline std::size_t alignSnapshot(std::size_t bytes) {
+    return (bytes + kSnapshotAlignment - 1) & ~(kSnapshotAlignment - 1);
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of a snapshot file.
+ *
+ * Post-Conditions:
+ *      The file is mapped & its header validated.
+ *
+ * Maps the snapshot file at the given path.
+ */
+template<class DataType>
+URStackSnapshot<DataType>::URStackSnapshot(const std::string& path):
+        file{path}, header{nullptr}, payload{nullptr} {
+    bind(file.getData(), file.getLength());
+}
+
+/*
+ * Pre-Conditions:
+ *      Pointer to a snapshot aligned to kSnapshotAlignment.
+ *      Number of readable bytes at the given pointer.
+ *
+ * Post-Conditions:
+ *      The header is validated.
+ *
+ * Views a snapshot already present in memory.
+ */
+template<class DataType>
+URStackSnapshot<DataType>::URStackSnapshot(const char *data,
+                                           std::size_t length):
+        header{nullptr}, payload{nullptr} {
+    bind(data, length);
+}
+
+/*
+ * Pre-Conditions:
+ *      Pointer to the first byte of a snapshot.
+ *      Number of readable bytes.
+ *
+ * Post-Conditions:
+ *      header & payload point into the given memory.
+ *
+ * Validates the snapshot & binds the view to it.
+ * The header must describe a stack URStack can hold: size actions from
+ * current to the oldest one, or none, with current on the oldest action.
+ * The offset table must start at 0, never decrease & end within the
+ * payload, so bytesAt stays in bounds. The values are never touched.
+ * The capacity must fit an int, as URStack's does, & the length is bound
+ * by the payload before it is multiplied, so no product wraps around.
+ */
+template<class DataType>
+void URStackSnapshot<DataType>::bind(const char *data, std::size_t length) {
+    using std::runtime_error;
+
+    if (not data or length < sizeof(SnapshotHeader)
+        or reinterpret_cast<std::uintptr_t>(data) % kSnapshotAlignment) {
+        throw runtime_error("\nTruncated or misaligned snapshot.\n");
+    }
+
+    header = reinterpret_cast<const SnapshotHeader*>(data);
+    payload = data + sizeof(SnapshotHeader);
+
+    if (std::memcmp(header->magic, kSnapshotMagic, sizeof(kSnapshotMagic))) {
+        throw runtime_error("\nNot a URStack snapshot.\n");
+    }
+
+    if (header->version != kSnapshotVersion) {
+        throw runtime_error("\nUnsupported snapshot version.\n");
+    }
+
+    if (header->encoding != static_cast<std::uint32_t>(Codec::kEncoding)) {
+        throw runtime_error("\nSnapshot encoding does not match type.\n");
+    }
+
+    if (header->payload_bytes > length - sizeof(SnapshotHeader)) {
+        throw runtime_error("\nTruncated snapshot payload.\n");
+    }
+
+    if (header->capacity <= 0
+        or header->capacity > std::numeric_limits<int>::max()
+        or header->size < 0
+        or header->size > header->capacity
+        or header->length > static_cast<std::uint64_t>(header->capacity)
+        or header->current > header->length
+        or (header->length and header->current >= header->length)) {
+        throw runtime_error("\nCorrupted snapshot header.\n");
+    }
+
+    const auto size = static_cast<std::uint64_t>(header->size);
+
+    /* Applied actions run from current to the oldest one */
+    if (size > header->length - header->current
+        or (size and header->current + size != header->length)
+        or (not size and header->length
+            and header->current != header->length - 1)) {
+        throw runtime_error("\nCorrupted snapshot header.\n");
+    }
+
+    std::uint64_t required;
+
+    if constexpr (Codec::kEncoding == SnapshotEncoding::kFixed) {
+        if (header->element_size != sizeof(DataType)
+            or header->element_align != alignof(DataType)) {
+            throw runtime_error("\nSnapshot element size does not match.\n");
+        }
+
+        if (header->length > header->payload_bytes / sizeof(DataType)) {
+            throw runtime_error("\nTruncated snapshot payload.\n");
+        }
+
+        required = header->length * sizeof(DataType);
+    } else {
+        const auto *offsets = reinterpret_cast<const std::uint64_t*>(payload);
+
+        /* One offset more than values, before multiplying */
+        if (header->length
+            >= header->payload_bytes / sizeof(std::uint64_t)) {
+            throw runtime_error("\nTruncated snapshot payload.\n");
+        }
+
+        required = (header->length + 1) * sizeof(std::uint64_t);
+
+        if (offsets[0] != 0) {
+            throw runtime_error("\nCorrupted snapshot offsets.\n");
+        }
+
+        for (std::uint64_t i = 1; i <= header->length; i++) {
+            if (offsets[i] < offsets[i - 1]) {
+                throw runtime_error("\nCorrupted snapshot offsets.\n");
+            }
+        }
+
+        /* Compared by difference, the last offset may be near 2^64 */
+        if (offsets[header->length] > header->payload_bytes - required) {
+            throw runtime_error("\nTruncated snapshot payload.\n");
+        }
+
+        required += offsets[header->length];
+    }
+
+    if (required > header->payload_bytes) {
+        throw runtime_error("\nTruncated snapshot payload.\n");
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      kEncoding is kBytes.
+ *      Index is less than getLength().
+ *
+ * Post-Conditions:
+ *      The encoded bytes of the value are returned.
+ *
+ * Returns the encoded bytes of the value N-hops away from top.
+ */
+template<class DataType>
+std::string_view URStackSnapshot<DataType>::bytesAt(std::size_t index) const {
+    const auto *offsets = reinterpret_cast<const std::uint64_t*>(payload);
+    const char *blob = payload
+                       + (header->length + 1) * sizeof(std::uint64_t);
+
+    return {blob + offsets[index],
+            static_cast<std::size_t>(offsets[index + 1] - offsets[index])};
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackSnapshot is initialized.
+ *      Index is less than getLength().
+ *
+ * Post-Conditions:
+ *      The value N-hops away from top is returned.
+ *
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `snapshot[5];`.
+ * kFixed values are returned as a const reference into the snapshot,
+ * kBytes values through Codec::view if the codec provides it,
+ * otherwise they are decoded.
+ */
+template<class DataType>
+decltype(auto) URStackSnapshot<DataType>::operator[](std::size_t index) const {
+    if constexpr (Codec::kEncoding == SnapshotEncoding::kFixed) {
+        /* Parenthesized, so a reference is returned rather than a copy */
+        return (reinterpret_cast<const DataType*>(payload)[index]);
+    } else if constexpr (HasSnapshotView<Codec>::value) {
+        return Codec::view(bytesAt(index));
+    } else {
+        return Codec::decode(bytesAt(index));
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      URStackSnapshot is initialized.
+ *      Index is less than getLength().
+ *
+ * Post-Conditions:
+ *      A copy of the value N-hops away from top is returned.
+ *
+ * Marked [[nodiscard]] to allow the compiler to issue warnings in case of
+ * wasteful calls. For example `snapshot.decode(5);`.
+ * Returns a copy of the value N-hops away from top.
+ */
+template<class DataType>
+DataType URStackSnapshot<DataType>::decode(std::size_t index) const {
+    if constexpr (Codec::kEncoding == SnapshotEncoding::kFixed) {
+        DataType result;
+
+        /* payload may be mapped, memcpy avoids aliasing assumptions */
+        std::memcpy(&result, payload + index * sizeof(DataType),
+                    sizeof(DataType));
+
+        return result;
+    } else {
+        return Codec::decode(bytesAt(index));
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the value of the next action,
+ *      starting from top.
+ *
+ * Post-Conditions:
+ *      The value is encoded into the writer.
+ *
+ * Appends the value of the next action in chain order.
+ */
+template<class DataType>
+void SnapshotWriter<DataType>::append(const DataType& value) {
+    typedef SnapshotCodec<DataType> Codec;
+
+    if constexpr (Codec::kEncoding == SnapshotEncoding::kFixed) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(DataType));
+    } else {
+        Codec::encode(value, bytes);
+        ends.push_back(bytes.size());
+    }
+
+    length++;
+}
+
+/*
+ * Pre-Conditions:
+ *      ostream opened in binary mode.
+ *      Number of hops from top to current.
+ *      size & capacity of the stack.
+ *
+ * Post-Conditions:
+ *      Header & payload are written to the ostream.
+ *      The written header is returned.
+ *
+ * Writes the snapshot of the appended values.
+ * The payload is padded, so snapshots can be concatenated
+ * while keeping every one of them aligned.
+ */
+template<class DataType>
+SnapshotHeader SnapshotWriter<DataType>::write(std::ostream& out,
+                                               std::uint64_t current,
+                                               int size, int capacity) const {
+    typedef SnapshotCodec<DataType> Codec;
+
+    static const char kPadding[kSnapshotAlignment] = {};
+
+    SnapshotHeader header{};
+    std::size_t unpadded = bytes.size();
+
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.version = kSnapshotVersion;
+    header.encoding = static_cast<std::uint32_t>(Codec::kEncoding);
+    header.length = length;
+    header.current = current;
+    header.size = size;
+    header.capacity = capacity;
+
+    if constexpr (Codec::kEncoding == SnapshotEncoding::kFixed) {
+        header.element_size = sizeof(DataType);
+        header.element_align = alignof(DataType);
+    } else {
+        unpadded += (length + 1) * sizeof(std::uint64_t);
+    }
+
+    header.payload_bytes = alignSnapshot(unpadded);
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if constexpr (Codec::kEncoding == SnapshotEncoding::kBytes) {
+        const std::uint64_t kFirst = 0;
+
+        out.write(reinterpret_cast<const char*>(&kFirst), sizeof(kFirst));
+        out.write(reinterpret_cast<const char*>(ends.data()),
+                  static_cast<std::streamsize>(
+                          ends.size() * sizeof(std::uint64_t)));
+    }
+
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    out.write(kPadding,
+              static_cast<std::streamsize>(header.payload_bytes - unpadded));
+
+    return header;
+}
+
+#endif //URSTACK_URSTACKSNAPSHOT_CPP
@@ -0,0 +1,447 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackSnapshot.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the binary snapshot format of URStack<DataType>,
+ *              the SnapshotCodec<DataType> customisation point,
+ *              the URStackSnapshot<DataType> read-only view
+ *              & the SnapshotWriter<DataType> class.
+ *
+ * Snapshot layout (native byte order, every section 64-byte aligned):
+ *      SnapshotHeader      64 bytes, see below.
+ *      Payload             kFixed: length * element_size bytes,
+ *                                  the raw DataType values.
+ *                          kBytes: (length + 1) uint64_t offsets,
+ *                                  followed by the encoded values.
+ *
+ *      Values are stored in chain order, the top action first.
+ *      A mapped snapshot is therefore usable in place: kFixed values are
+ *      read as `const DataType&`, strings as `std::string_view`.
+ *
+ * List of SnapshotCodec<DataType> members (customisation point):
+ *      static constexpr SnapshotEncoding kEncoding
+ *          kFixed for trivially copyable types, kBytes otherwise.
+ *
+ *      static void encode(const DataType&, std::string&)      (kBytes)
+ *          Appends the encoded value to the given buffer.
+ *
+ *      static DataType decode(std::string_view)                (kBytes)
+ *          Decodes a value from the given bytes.
+ *
+ *      static View view(std::string_view)            (kBytes, optional)
+ *          Returns an in-place view of the encoded value.
+ *
+ * List of public URStackSnapshot<DataType> class Functions:
+ *      explicit URStackSnapshot(const std::string&)
+ *          Maps the snapshot file at the given path.
+ *
+ *      URStackSnapshot(const char*, std::size_t)
+ *          Views a snapshot already present in memory.
+ *
+ *      View operator[](std::size_t) const
+ *          Returns the value N-hops away from top, in place if possible.
+ *
+ *      DataType decode(std::size_t) const
+ *          Returns a copy of the value N-hops away from top.
+ *
+ *      inline std::uint64_t getLength() const
+ *          Returns the number of actions in the chain.
+ *
+ *      inline std::uint64_t getCurrent() const
+ *          Returns the number of hops from top to current.
+ *
+ *      inline int getSize() const
+ *          Returns the saved size of the stack.
+ *
+ *      inline int getCapacity() const
+ *          Returns the saved capacity of the stack.
+ *
+ *      inline std::size_t getBytes() const
+ *          Returns the number of bytes occupied by the snapshot.
+ *
+ * List of public SnapshotWriter<DataType> class Functions:
+ *      void append(const DataType&)
+ *          Appends the value of the next action in chain order.
+ *
+ *      SnapshotHeader write(std::ostream&, std::uint64_t current,
+ *                           int size, int capacity) const
+ *          Writes the snapshot of the appended values.
+ *
+ *      inline std::uint64_t getLength() const
+ *          Returns the number of appended values.
+ *
+ *      inline std::size_t getBytes() const
+ *          Returns the number of bytes held by the appended values.
+ */
+
+#ifndef URSTACK_URSTACKSNAPSHOT_H
+#define URSTACK_URSTACKSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "MappedFile.h"
+
+
+/*
+ * Version of the snapshot format written by SnapshotWriter.
+ */
+constexpr std::uint32_t kSnapshotVersion = 1;
+
+/*
+ * Alignment of every section in a snapshot, in bytes.
+ */
+constexpr std::size_t kSnapshotAlignment = 64;
+
+/*
+ * How the values of a snapshot are stored.
+ */
+enum class SnapshotEncoding : std::uint32_t {
+    /* Raw array of trivially copyable values */
+    kFixed = 0,
+
+    /* Offset table followed by variable-length encoded values */
+    kBytes = 1,
+};
+
+/*
+ * Fixed-size header at the beginning of every snapshot.
+ */
+struct SnapshotHeader {
+    /* "URSTACK" followed by a null byte */
+    char magic[8];
+
+    /* kSnapshotVersion at the time of writing */
+    std::uint32_t version;
+
+    /* SnapshotEncoding of the payload */
+    std::uint32_t encoding;
+
+    /* sizeof(DataType) for kFixed, 0 for kBytes */
+    std::uint32_t element_size;
+
+    /* alignof(DataType) for kFixed, 0 for kBytes */
+    std::uint32_t element_align;
+
+    /* Number of Nodes in the chain, from top to the oldest action */
+    std::uint64_t length;
+
+    /* Number of hops from top to current */
+    std::uint64_t current;
+
+    /* URStack::size at the time of writing */
+    std::int64_t size;
+
+    /* URStack::capacity at the time of writing */
+    std::int64_t capacity;
+
+    /* Number of payload bytes following the header, padding included */
+    std::uint64_t payload_bytes;
+};
+
+static_assert(sizeof(SnapshotHeader) == kSnapshotAlignment,
+              "SnapshotHeader must occupy exactly one aligned section");
+
+/*
+ * Customisation point describing how DataType is stored in a snapshot.
+ * Specialise it for types that are neither trivially copyable
+ * nor std::string, providing kEncoding = kBytes, encode & decode.
+ */
+template<class DataType, class Enable = void>
+struct SnapshotCodec;
+
+/*
+ * Trivially copyable values are stored as a raw array.
+ */
+template<class DataType>
+struct SnapshotCodec<DataType,
+        std::enable_if_t<std::is_trivially_copyable_v<DataType>>> {
+    static constexpr SnapshotEncoding kEncoding = SnapshotEncoding::kFixed;
+
+    typedef const DataType& View;
+};
+
+/*
+ * Strings are stored as their bytes, viewed in place as std::string_view.
+ */
+template<>
+struct SnapshotCodec<std::string> {
+    static constexpr SnapshotEncoding kEncoding = SnapshotEncoding::kBytes;
+
+    typedef std::string_view View;
+
+    static void encode(const std::string& value, std::string& out) {
+        out += value;
+    }
+
+    static std::string decode(std::string_view bytes) {
+        return std::string{bytes};
+    }
+
+    static View view(std::string_view bytes) {
+        return bytes;
+    }
+};
+
+/*
+ * Read-only view of a snapshot, either mapped from a file or
+ * located in memory owned by the caller.
+ */
+template<class DataType>
+class URStackSnapshot {
+public:
+    /*
+     * Codec used to read the values.
+     */
+    typedef SnapshotCodec<DataType> Codec;
+
+    /*
+     * Pre-Conditions:
+     *      const reference to the path of a snapshot file.
+     *
+     * Post-Conditions:
+     *      The file is mapped & its header validated.
+     *      Throws std::runtime_error if the file is not a valid snapshot
+     *      of DataType.
+     *
+     * Maps the snapshot file at the given path.
+     */
+    explicit URStackSnapshot(const std::string&);
+
+    /*
+     * Pre-Conditions:
+     *      Pointer to a snapshot aligned to kSnapshotAlignment.
+     *      Number of readable bytes at the given pointer.
+     *      The memory outlives the URStackSnapshot instance.
+     *
+     * Post-Conditions:
+     *      The header is validated.
+     *      Throws std::runtime_error if the memory is not a valid snapshot
+     *      of DataType.
+     *
+     * Views a snapshot already present in memory.
+     */
+    URStackSnapshot(const char*, std::size_t);
+
+    /*
+     * Pre-Conditions:
+     *      URStackSnapshot is initialized.
+     *      Index is less than getLength().
+     *
+     * Post-Conditions:
+     *      The value N-hops away from top is returned,
+     *      without copying for kFixed & string payloads.
+     *
+     * Returns the value N-hops away from top, in place if possible.
+     */
+    [[nodiscard]] decltype(auto) operator[](std::size_t) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStackSnapshot is initialized.
+     *      Index is less than getLength().
+     *
+     * Post-Conditions:
+     *      A copy of the value N-hops away from top is returned.
+     *
+     * Returns a copy of the value N-hops away from top.
+     */
+    [[nodiscard]] DataType decode(std::size_t) const;
+
+    /*
+     * Pre-Conditions:
+     *      URStackSnapshot is initialized.
+     *
+     * Post-Conditions:
+     *      Number of actions in the chain is returned.
+     *
+     * Returns the number of actions in the chain.
+     */
+    [[nodiscard]] inline std::uint64_t getLength() const {
+        return header->length;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackSnapshot is initialized.
+     *
+     * Post-Conditions:
+     *      Number of hops from top to current is returned.
+     *
+     * Returns the number of hops from top to current.
+     */
+    [[nodiscard]] inline std::uint64_t getCurrent() const {
+        return header->current;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackSnapshot is initialized.
+     *
+     * Post-Conditions:
+     *      Saved size is returned.
+     *
+     * Returns the saved size of the stack.
+     */
+    [[nodiscard]] inline int getSize() const {
+        return static_cast<int>(header->size);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackSnapshot is initialized.
+     *
+     * Post-Conditions:
+     *      Saved capacity is returned.
+     *
+     * Returns the saved capacity of the stack.
+     */
+    [[nodiscard]] inline int getCapacity() const {
+        return static_cast<int>(header->capacity);
+    }
+
+    /*
+     * Pre-Conditions:
+     *      URStackSnapshot is initialized.
+     *
+     * Post-Conditions:
+     *      Number of bytes of the header & payload is returned.
+     *
+     * Returns the number of bytes occupied by the snapshot.
+     */
+    [[nodiscard]] inline std::size_t getBytes() const {
+        return sizeof(SnapshotHeader) + header->payload_bytes;
+    }
+
+private:
+    /*
+     * Mapping of the snapshot file.
+     * Empty if the snapshot lives in memory owned by the caller.
+     */
+    MappedFile file;
+
+    /*
+     * Pointer to the header of the snapshot.
+     */
+    const SnapshotHeader *header;
+
+    /*
+     * Pointer to the first byte after the header.
+     */
+    const char *payload;
+
+    /*
+     * Pre-Conditions:
+     *      Pointer to the first byte of a snapshot.
+     *      Number of readable bytes.
+     *
+     * Post-Conditions:
+     *      header & payload point into the given memory.
+     *      Throws std::runtime_error if the header does not describe
+     *      a valid snapshot of DataType.
+     *
+     * Validates the snapshot & binds the view to it.
+     */
+    void bind(const char*, std::size_t);
+
+    /*
+     * Pre-Conditions:
+     *      kEncoding is kBytes.
+     *      Index is less than getLength().
+     *
+     * Post-Conditions:
+     *      The encoded bytes of the value are returned.
+     *
+     * Returns the encoded bytes of the value N-hops away from top.
+     */
+    [[nodiscard]] std::string_view bytesAt(std::size_t) const;
+};
+
+/*
+ * Accumulates values in chain order & writes them as a snapshot.
+ */
+template<class DataType>
+class SnapshotWriter {
+public:
+    /*
+     * Pre-Conditions:
+     *      const reference to the value of the next action,
+     *      starting from top.
+     *
+     * Post-Conditions:
+     *      The value is encoded into the writer.
+     *
+     * Appends the value of the next action in chain order.
+     */
+    void append(const DataType&);
+
+    /*
+     * Pre-Conditions:
+     *      ostream opened in binary mode.
+     *      Number of hops from top to current.
+     *      size & capacity of the stack.
+     *
+     * Post-Conditions:
+     *      Header & payload are written to the ostream.
+     *      The written header is returned, the number of written bytes
+     *      is always a multiple of kSnapshotAlignment.
+     *
+     * Writes the snapshot of the appended values.
+     */
+    SnapshotHeader write(std::ostream&, std::uint64_t /* current */,
+                         int /* size */, int /* capacity */) const;
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the number of appended values.
+     */
+    [[nodiscard]] inline std::uint64_t getLength() const {
+        return length;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the bytes of the encoded values & of their offsets,
+     *      the payload of the snapshot before padding.
+     *
+     * Returns the number of bytes held by the appended values.
+     */
+    [[nodiscard]] inline std::size_t getBytes() const {
+        return bytes.size() + ends.size() * sizeof(std::uint64_t);
+    }
+
+private:
+    /*
+     * Encoded values (kBytes) or raw values (kFixed).
+     */
+    std::string bytes;
+
+    /*
+     * End offsets of the encoded values (kBytes only).
+     */
+    std::vector<std::uint64_t> ends;
+
+    /*
+     * Number of appended values.
+     */
+    std::uint64_t length = 0;
+};
+
+#endif //URSTACK_URSTACKSNAPSHOT_H
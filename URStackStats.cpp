@@ -0,0 +1,365 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackStats.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in URStackStats.h
+ *
+ * List of public LogHistogram class Functions:
+ *      LogHistogram()
+ *          Creates an empty histogram.
+ *
+ *      void record(std::uint64_t)
+ *          Adds a value to the histogram.
+ *
+ *      std::uint64_t getPercentile(double) const
+ *          Returns the value at the given percentile.
+ *
+ *      void reset()
+ *          Removes every recorded value.
+ *
+ * List of private LogHistogram class Functions:
+ *      static std::size_t indexOf(std::uint64_t)
+ *          Returns the bucket of a value.
+ *
+ *      static std::uint64_t highestOf(std::size_t)
+ *          Returns the largest value of a bucket.
+ *
+ * List of public OperationStats class Functions:
+ *      void recordInsert(Stamp, long long, bool)
+ *          Records an insert started at the given time.
+ *
+ *      void recordUndo(Stamp)
+ *          Records an undo started at the given time.
+ *
+ *      void recordRedo(Stamp)
+ *          Records a redo started at the given time.
+ *
+ *      void countInsert(long long, bool)
+ *          Counts an insert, without its latency.
+ *
+ *      OperationStats snapshot() const
+ *          Returns a copy of the statistics gathered so far.
+ *
+ *      void reset()
+ *          Starts gathering statistics anew.
+ *
+ *      OutputSink& display(OutputSink&) const
+ *          Displays the counters & latency percentiles.
+ */
+
+#include "URStackStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+
+/* Used std utilities */
+using std::size_t, std::uint64_t, std::chrono::steady_clock,
+        std::chrono::duration_cast, std::chrono::nanoseconds;
+
+/*
+ * Sub-buckets of the exact range, & of every following power of 2.
+ */
+static constexpr uint64_t kExact = 1 << LogHistogram::kSubBucketBits;
+static constexpr uint64_t kHalf = kExact / 2;
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      An empty histogram is created.
+ *
+ * Creates an empty histogram.
+ * Every bucket is allocated up front, recording never allocates.
+ */
+LogHistogram::LogHistogram(): counts(kBuckets), count{0}, sum{0},
+                              min{0}, max{0} {}
+
+/*
+ * Pre-Conditions:
+ *      LogHistogram is initialized.
+ *      Value to record.
+ *
+ * Post-Conditions:
+ *      The value is counted in its bucket.
+ *
+ * Adds a value to the histogram.
+ */
+void LogHistogram::record(uint64_t value) {
+    counts[indexOf(value)]++;
+
+    min = count ? std::min(min, value) : value;
+    max = std::max(max, value);
+    sum += value;
+    count++;
+}
+
+/*
+ * Pre-Conditions:
+ *      LogHistogram is initialized.
+ *      Percentile, from 0 to 100.
+ *
+ * Post-Conditions:
+ *      Returns the largest value of the bucket holding the percentile,
+ *      at most the largest recorded value, or 0 if empty.
+ *
+ * Returns the value at the given percentile.
+ * Walks the buckets until the rank of the percentile is reached.
+ */
+uint64_t LogHistogram::getPercentile(double percentile) const {
+    if (not count) {
+        return 0;
+    }
+
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto rank = std::max<uint64_t>(
+            1, static_cast<uint64_t>(std::ceil(clamped / 100 * count)));
+
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < kBuckets; i++) {
+        seen += counts[i];
+
+        if (seen >= rank) {
+            return std::min(highestOf(i), max);
+        }
+    }
+
+    return max;
+}
+
+/*
+ * Pre-Conditions:
+ *      LogHistogram is initialized.
+ *
+ * Post-Conditions:
+ *      The histogram is empty.
+ *
+ * Removes every recorded value, keeping the buckets' memory.
+ */
+void LogHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    count = sum = min = max = 0;
+}
+
+/*
+ * Pre-Conditions:
+ *      A value.
+ *
+ * Post-Conditions:
+ *      Returns the index of the bucket counting the value.
+ *
+ * Returns the bucket of a value.
+ * Values below kExact are their own bucket. Otherwise the position of
+ * the highest set bit picks the power of 2, & the kSubBucketBits bits
+ * from it pick the bucket within it.
+ */
+size_t LogHistogram::indexOf(uint64_t value) {
+    value = std::min(value, (uint64_t{1} << kMaxBits) - 1);
+
+    if (value < kExact) {
+        return value;
+    }
+
+#if defined(__GNUC__)
+    const int highest = 63 - __builtin_clzll(value);
+#else
+    int highest = 63;
+
+    while (not (value >> highest & 1)) {
+        highest--;
+    }
+#endif
+
+    const int shift = highest - kSubBucketBits + 1;
+
+    return kExact + (highest - kSubBucketBits) * kHalf
+           + ((value >> shift) - kHalf);
+}
+
+/*
+ * Pre-Conditions:
+ *      Index of a bucket.
+ *
+ * Post-Conditions:
+ *      Returns the largest value counted by the bucket.
+ *
+ * Returns the largest value of a bucket, the inverse of indexOf.
+ */
+uint64_t LogHistogram::highestOf(size_t index) {
+    if (index < kExact) {
+        return index;
+    }
+
+    const uint64_t offset = index - kExact;
+    const uint64_t top = offset % kHalf + kHalf;
+    const int shift = static_cast<int>(offset / kHalf) + 1;
+
+    return ((top + 1) << shift) - 1;
+}
+
+/*
+ * Pre-Conditions:
+ *      Start time of the insert.
+ *      Number of undone actions it discarded.
+ *      true if it evicted the oldest action.
+ *
+ * Post-Conditions:
+ *      The insert & its latency are recorded.
+ *
+ * Records an insert started at the given time.
+ */
+void OperationStats::recordInsert(Stamp started, long long discarded_actions,
+                                  bool evicted) {
+    latencies[kInsert].record(
+            duration_cast<nanoseconds>(steady_clock::now() - started).count());
+
+    countInsert(discarded_actions, evicted);
+}
+
+/*
+ * Pre-Conditions:
+ *      Start time of a successful undo.
+ *
+ * Post-Conditions:
+ *      The undo & its latency are recorded.
+ *
+ * Records an undo started at the given time.
+ */
+void OperationStats::recordUndo(Stamp started) {
+    latencies[kUndo].record(
+            duration_cast<nanoseconds>(steady_clock::now() - started).count());
+
+    undos++;
+}
+
+/*
+ * Pre-Conditions:
+ *      Start time of a successful redo.
+ *
+ * Post-Conditions:
+ *      The redo & its latency are recorded.
+ *
+ * Records a redo started at the given time.
+ */
+void OperationStats::recordRedo(Stamp started) {
+    latencies[kRedo].record(
+            duration_cast<nanoseconds>(steady_clock::now() - started).count());
+
+    redos++;
+}
+
+/*
+ * Pre-Conditions:
+ *      An insert succeeded, as part of a batch.
+ *      Number of undone actions it discarded.
+ *      true if it evicted the oldest action.
+ *
+ * Post-Conditions:
+ *      The insert is counted, its latency is not recorded.
+ *
+ * Counts an insert, without its latency.
+ * A discarded redo chain is recorded as for recordInsert.
+ */
+void OperationStats::countInsert(long long discarded_actions, bool evicted) {
+    inserts++;
+    evictions += evicted;
+
+    if (discarded_actions) {
+        discarded += discarded_actions;
+        chains.record(discarded_actions);
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Returns a copy of the statistics, unaffected by later operations.
+ *
+ * Returns a copy of the statistics gathered so far.
+ * Pair with reset to read statistics per interval.
+ */
+OperationStats OperationStats::snapshot() const {
+    return *this;
+}
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Every counter & histogram is empty.
+ *
+ * Starts gathering statistics anew.
+ */
+void OperationStats::reset() {
+    inserts = evictions = discarded = undos = redos = 0;
+
+    for (LogHistogram& latency: latencies) {
+        latency.reset();
+    }
+
+    chains.reset();
+}
+
+/*
+ * Pre-Conditions:
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      The counters & the latency percentiles are buffered in the sink.
+ *      Returns reference to the sink.
+ *
+ * Displays the counters & latency percentiles.
+ * One line per counter, then one line per operation with its count,
+ * mean & percentiles in nanoseconds.
+ */
+OutputSink& OperationStats::display(OutputSink& out) const {
+    const std::pair<const char*, long long> counters[] = {
+            {"Inserts:\t\t", inserts},
+            {"Evictions:\t\t", evictions},
+            {"Discarded redos:\t", discarded},
+            {"Undos:\t\t\t", undos},
+            {"Redos:\t\t\t", redos},
+    };
+
+    for (const auto& [name, value]: counters) {
+        out.beginData() << name << value;
+        out.endColour() << '\n';
+    }
+
+    out.beginData() << "Longest discard:\t" << chains.getMax();
+    out.endColour() << "\n\n";
+
+    const std::pair<const char*, const LogHistogram*> histograms[] = {
+            {"insert", &latencies[kInsert]},
+            {"undo", &latencies[kUndo]},
+            {"redo", &latencies[kRedo]},
+    };
+
+    out << "Latency (ns)\tcount\tmean\tp50\tp90\tp99\tp99.9\tmax\n";
+
+    for (const auto& [name, histogram]: histograms) {
+        out.beginData() << name;
+        out.endColour()
+            << '\t' << '\t' << histogram->getCount()
+            << '\t' << static_cast<uint64_t>(histogram->getMean())
+            << '\t' << histogram->getPercentile(50)
+            << '\t' << histogram->getPercentile(90)
+            << '\t' << histogram->getPercentile(99)
+            << '\t' << histogram->getPercentile(99.9)
+            << '\t' << histogram->getMax() << '\n';
+    }
+
+    return out;
+}
@@ -0,0 +1,491 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackStats.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the statistics policies of URStack:
+ *              NoStats, the default, compiled away entirely,
+ *              & OperationStats, counting operations & recording their
+ *              latencies in LogHistogram instances.
+ *
+ *              A Stats policy provides:
+ *                  static constexpr bool kEnabled
+ *                  typedef ... Stamp
+ *                  Stamp start() const
+ *                  void recordInsert(Stamp, long long discarded, bool evicted)
+ *                  void recordUndo(Stamp)
+ *                  void recordRedo(Stamp)
+ *                  void countRedo()
+ *                  void countInsert(long long discarded, bool evicted)
+ *
+ * List of public LogHistogram class Functions:
+ *      LogHistogram()
+ *          Creates an empty histogram.
+ *
+ *      void record(std::uint64_t)
+ *          Adds a value to the histogram.
+ *
+ *      std::uint64_t getPercentile(double) const
+ *          Returns the value at the given percentile.
+ *
+ *      void reset()
+ *          Removes every recorded value.
+ *
+ *      inline std::uint64_t getCount() const
+ *          Returns the number of recorded values.
+ *
+ *      inline std::uint64_t getMin() const
+ *          Returns the smallest recorded value.
+ *
+ *      inline std::uint64_t getMax() const
+ *          Returns the largest recorded value.
+ *
+ *      inline double getMean() const
+ *          Returns the mean of the recorded values.
+ *
+ * List of public OperationStats class Functions:
+ *      inline Stamp start() const
+ *          Returns the start time of an operation.
+ *
+ *      void recordInsert(Stamp, long long, bool)
+ *          Records an insert started at the given time.
+ *
+ *      void recordUndo(Stamp)
+ *          Records an undo started at the given time.
+ *
+ *      void recordRedo(Stamp)
+ *          Records a redo started at the given time.
+ *
+ *      inline void countRedo()
+ *          Counts a redo, without its latency.
+ *
+ *      void countInsert(long long, bool)
+ *          Counts an insert, without its latency.
+ *
+ *      OperationStats snapshot() const
+ *          Returns a copy of the statistics gathered so far.
+ *
+ *      void reset()
+ *          Starts gathering statistics anew.
+ *
+ *      OutputSink& display(OutputSink&) const
+ *          Displays the counters & latency percentiles.
+ *
+ *      inline long long getInserts() const
+ *          Returns the number of inserts.
+ *
+ *      inline long long getEvictions() const
+ *          Returns the number of actions evicted at capacity.
+ *
+ *      inline long long getDiscarded() const
+ *          Returns the number of undone actions discarded by inserts.
+ *
+ *      inline long long getUndos() const
+ *          Returns the number of undos.
+ *
+ *      inline long long getRedos() const
+ *          Returns the number of redos.
+ *
+ *      inline const LogHistogram& getLatency(Operation) const
+ *          Returns the latencies of an operation, in nanoseconds.
+ *
+ *      inline const LogHistogram& getDiscardedChains() const
+ *          Returns the lengths of the redo chains discarded by inserts.
+ *
+ * List of private LogHistogram class Functions:
+ *      static std::size_t indexOf(std::uint64_t)
+ *          Returns the bucket of a value.
+ *
+ *      static std::uint64_t highestOf(std::size_t)
+ *          Returns the largest value of a bucket.
+ */
+
+#ifndef URSTACK_URSTACKSTATS_H
+#define URSTACK_URSTACKSTATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "OutputSink.h"
+
+
+/*
+ * Statistics policy gathering nothing, the default of URStack.
+ * Empty & every function is an inline no-op, so a URStack using it
+ * is the same size & does the same work as one without statistics.
+ */
+struct NoStats {
+    static constexpr bool kEnabled = false;
+
+    struct Stamp {};
+
+    [[nodiscard]] inline Stamp start() const {
+        return {};
+    }
+
+    inline void recordInsert(Stamp, long long /* discarded */,
+                             bool /* evicted */) {}
+
+    inline void recordUndo(Stamp) {}
+
+    inline void recordRedo(Stamp) {}
+
+    inline void countRedo() {}
+
+    inline void countInsert(long long /* discarded */, bool /* evicted */) {}
+};
+
+/*
+ * Histogram of unsigned values with a bounded relative error,
+ * in the manner of HDR histograms: values below 2^kSubBucketBits are
+ * counted exactly, every following power of 2 is split into
+ * 2^(kSubBucketBits - 1) equal buckets, so a percentile is reported
+ * within 1 / 2^(kSubBucketBits - 1) (about 3%) of the recorded value.
+ * Recording is a few shifts & an increment, never an allocation.
+ */
+class LogHistogram {
+public:
+    /*
+     * Bits of precision of every bucket.
+     */
+    static constexpr int kSubBucketBits = 6;
+
+    /*
+     * Values from 2^kMaxBits (about 18 minutes in nanoseconds) up are
+     * counted in the last bucket.
+     */
+    static constexpr int kMaxBits = 40;
+
+    /*
+     * Number of buckets.
+     */
+    static constexpr std::size_t kBuckets =
+            (1 << kSubBucketBits)
+            + (kMaxBits - kSubBucketBits) * (1 << (kSubBucketBits - 1));
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      An empty histogram is created.
+     *
+     * Creates an empty histogram.
+     */
+    LogHistogram();
+
+    /*
+     * Pre-Conditions:
+     *      LogHistogram is initialized.
+     *      Value to record.
+     *
+     * Post-Conditions:
+     *      The value is counted in its bucket.
+     *
+     * Adds a value to the histogram.
+     */
+    void record(std::uint64_t);
+
+    /*
+     * Pre-Conditions:
+     *      LogHistogram is initialized.
+     *      Percentile, from 0 to 100.
+     *
+     * Post-Conditions:
+     *      Returns the largest value of the bucket holding the percentile,
+     *      at most the largest recorded value, or 0 if empty.
+     *
+     * Returns the value at the given percentile.
+     */
+    [[nodiscard]] std::uint64_t getPercentile(double) const;
+
+    /*
+     * Pre-Conditions:
+     *      LogHistogram is initialized.
+     *
+     * Post-Conditions:
+     *      The histogram is empty.
+     *
+     * Removes every recorded value.
+     */
+    void reset();
+
+    /*
+     * Pre-Conditions:
+     *      LogHistogram is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the number of recorded values.
+     */
+    [[nodiscard]] inline std::uint64_t getCount() const {
+        return count;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      LogHistogram is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the smallest recorded value, or 0 if empty.
+     */
+    [[nodiscard]] inline std::uint64_t getMin() const {
+        return count ? min : 0;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      LogHistogram is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the largest recorded value, or 0 if empty.
+     */
+    [[nodiscard]] inline std::uint64_t getMax() const {
+        return max;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      LogHistogram is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the exact mean of the recorded values, or 0 if empty.
+     */
+    [[nodiscard]] inline double getMean() const {
+        return count ? static_cast<double>(sum) / count : 0;
+    }
+
+private:
+    /*
+     * Number of values in every bucket.
+     */
+    std::vector<std::uint64_t> counts;
+
+    std::uint64_t count;
+
+    std::uint64_t sum;
+
+    std::uint64_t min;
+
+    std::uint64_t max;
+
+    /*
+     * Pre-Conditions:
+     *      A value.
+     *
+     * Post-Conditions:
+     *      Returns the index of the bucket counting the value.
+     *
+     * Returns the bucket of a value.
+     */
+    static std::size_t indexOf(std::uint64_t);
+
+    /*
+     * Pre-Conditions:
+     *      Index of a bucket.
+     *
+     * Post-Conditions:
+     *      Returns the largest value counted by the bucket.
+     *
+     * Returns the largest value of a bucket.
+     */
+    static std::uint64_t highestOf(std::size_t);
+};
+
+/*
+ * Statistics policy counting inserts, evictions, discarded undone
+ * actions, undos & redos, with a latency histogram per operation &
+ * a histogram of the redo chains discarded by inserts.
+ * Timing costs two clock reads per operation.
+ */
+class OperationStats {
+public:
+    static constexpr bool kEnabled = true;
+
+    typedef std::chrono::steady_clock::time_point Stamp;
+
+    /*
+     * Operations with a latency histogram.
+     */
+    enum Operation {
+        kInsert,
+        kUndo,
+        kRedo,
+        kOperations
+    };
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the current time.
+     *
+     * Returns the start time of an operation.
+     */
+    [[nodiscard]] inline Stamp start() const {
+        return std::chrono::steady_clock::now();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Start time of the insert.
+     *      Number of undone actions it discarded.
+     *      true if it evicted the oldest action.
+     *
+     * Post-Conditions:
+     *      The insert & its latency are recorded.
+     *
+     * Records an insert started at the given time.
+     */
+    void recordInsert(Stamp, long long /* discarded */, bool /* evicted */);
+
+    /*
+     * Pre-Conditions:
+     *      Start time of a successful undo.
+     *
+     * Post-Conditions:
+     *      The undo & its latency are recorded.
+     *
+     * Records an undo started at the given time.
+     */
+    void recordUndo(Stamp);
+
+    /*
+     * Pre-Conditions:
+     *      Start time of a successful redo.
+     *
+     * Post-Conditions:
+     *      The redo & its latency are recorded.
+     *
+     * Records a redo started at the given time.
+     */
+    void recordRedo(Stamp);
+
+    /*
+     * Pre-Conditions:
+     *      A redo succeeded, as part of a batch.
+     *
+     * Post-Conditions:
+     *      The redo is counted, its latency is not recorded.
+     *
+     * Counts a redo, without its latency.
+     */
+    inline void countRedo() {
+        redos++;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      An insert succeeded, as part of a batch.
+     *      Number of undone actions it discarded.
+     *      true if it evicted the oldest action.
+     *
+     * Post-Conditions:
+     *      The insert is counted, its latency is not recorded.
+     *
+     * Counts an insert, without its latency.
+     */
+    void countInsert(long long /* discarded */, bool /* evicted */);
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns a copy of the statistics, unaffected by later operations.
+     *
+     * Returns a copy of the statistics gathered so far.
+     */
+    [[nodiscard]] OperationStats snapshot() const;
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Every counter & histogram is empty.
+     *
+     * Starts gathering statistics anew.
+     */
+    void reset();
+
+    /*
+     * Pre-Conditions:
+     *      OutputSink reference to display the output.
+     *
+     * Post-Conditions:
+     *      The counters & the latency percentiles are buffered in the sink.
+     *      Returns reference to the sink.
+     *
+     * Displays the counters & latency percentiles.
+     */
+    OutputSink& display(OutputSink&) const;
+
+    [[nodiscard]] inline long long getInserts() const {
+        return inserts;
+    }
+
+    [[nodiscard]] inline long long getEvictions() const {
+        return evictions;
+    }
+
+    [[nodiscard]] inline long long getDiscarded() const {
+        return discarded;
+    }
+
+    [[nodiscard]] inline long long getUndos() const {
+        return undos;
+    }
+
+    [[nodiscard]] inline long long getRedos() const {
+        return redos;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      An operation other than kOperations.
+     *
+     * Post-Conditions:
+     *      Returns the latencies of the operation, in nanoseconds.
+     */
+    [[nodiscard]] inline const LogHistogram& getLatency(
+            Operation operation) const {
+        return latencies[operation];
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the lengths of the redo chains discarded by inserts,
+     *      one value per insert discarding any.
+     */
+    [[nodiscard]] inline const LogHistogram& getDiscardedChains() const {
+        return chains;
+    }
+
+private:
+    long long inserts = 0;
+
+    long long evictions = 0;
+
+    long long discarded = 0;
+
+    long long undos = 0;
+
+    long long redos = 0;
+
+    LogHistogram latencies[kOperations];
+
+    LogHistogram chains;
+};
+
+#endif //URSTACK_URSTACKSTATS_H
@@ -0,0 +1,520 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackTrace.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in URStackTrace.h
+ *
+ * List of public TraceRecorder class Functions:
+ *      explicit TraceRecorder(const std::string&)
+ *          Creates the trace file at the given path.
+ *
+ *      ~TraceRecorder()
+ *          Completes the trace file, if not closed yet.
+ *
+ *      std::uint32_t getSession(std::string_view)
+ *          Returns the number of the named session.
+ *
+ *      void record(TraceOperation, std::uint32_t, std::uint64_t)
+ *          Appends a call made now.
+ *
+ *      void append(const TraceEvent&)
+ *          Appends an event with its own delay.
+ *
+ *      TraceHeader close()
+ *          Completes the trace file.
+ *
+ * List of private TraceRecorder class Functions:
+ *      void flush()
+ *          Writes the buffered events.
+ *
+ * List of public TraceReader class Functions:
+ *      explicit TraceReader(const std::string&)
+ *          Maps the trace file at the given path.
+ *
+ *      bool next(TraceEvent&)
+ *          Decodes the next event.
+ *
+ *      std::vector<TraceEvent> readAll()
+ *          Decodes every remaining event.
+ *
+ * List of Functions:
+ *      const char* getName(TraceOperation)
+ *          Returns the name of an operation.
+ *
+ *      std::vector<TraceEvent> generateWorkload(const WorkloadOptions&)
+ *          Returns a synthetic workload, the same for the same options.
+ */
+
+#include "URStackTrace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+
+/* Used std utilities */
+using std::string, std::string_view, std::vector, std::uint8_t,
+        std::uint32_t, std::uint64_t, std::runtime_error,
+        std::invalid_argument, std::chrono::steady_clock,
+        std::chrono::duration_cast, std::chrono::nanoseconds;
+
+/*
+ * Magic bytes at the beginning of every trace.
+ */
+inline constexpr char kTraceMagic[8] = "URTRACE";
+
+/*
+ * Maximum bytes of an encoded event: the operation & 3 varints.
+ */
+static constexpr std::size_t kMaxEventBytes = 1 + 3 * 10;
+
+/*
+ * Minimum bytes of an encoded event: the operation & 3 one-byte varints.
+ */
+static constexpr std::size_t kMinEventBytes = 1 + 3;
+
+/*
+ * Pre-Conditions:
+ *      Value to encode.
+ *      Reference to the buffer to append to.
+ *
+ * Post-Conditions:
+ *      The value is appended as a little-endian base 128 varint,
+ *      7 bits per byte, the high bit set on every byte but the last.
+ */
+static void putVarint(uint64_t value, string& out) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+
+    out += static_cast<char>(value);
+}
+
+/*
+ * Pre-Conditions:
+ *      Bytes of the trace.
+ *      Reference to the offset of the varint, within the bytes.
+ *      Reference to the decoded value.
+ *
+ * Post-Conditions:
+ *      Returns true with the value decoded & the offset past it,
+ *      or false if the varint is truncated or longer than 64 bits.
+ */
+static bool getVarint(string_view bytes, std::size_t& position,
+                      uint64_t& value) {
+    value = 0;
+
+    for (int shift = 0; shift < 64 and position < bytes.size(); shift += 7) {
+        const auto byte = static_cast<uint8_t>(bytes[position++]);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+
+        if (not (byte & 0x80)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of the trace, replaced if it exists.
+ *
+ * Post-Conditions:
+ *      An empty trace is created at the path.
+ *      Throws std::runtime_error if the file cannot be written.
+ *
+ * Creates the trace file at the given path.
+ * A zeroed header is written first, so the events follow it directly,
+ * close rewrites it once the counts are known.
+ */
+TraceRecorder::TraceRecorder(const string& path):
+        file{path, std::ios::binary | std::ios::trunc}, header{},
+        last{steady_clock::now()}, closed{false} {
+    if (not file) {
+        throw runtime_error("\nCannot open " + path + ".\n");
+    }
+
+    std::memcpy(header.magic, kTraceMagic, sizeof(kTraceMagic));
+    header.version = kTraceVersion;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    buffer.reserve(kBufferBytes + kMaxEventBytes);
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` TraceRecorder instance is not destroyed.
+ *
+ * Post-Conditions:
+ *      The trace file is complete, errors are ignored.
+ *
+ * Completes the trace file, if not closed yet.
+ * Call close to have errors reported.
+ */
+TraceRecorder::~TraceRecorder() {
+    try {
+        close();
+    } catch (runtime_error&) {
+        /* Destructors do not throw, the trace is left incomplete */
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      TraceRecorder is initialized.
+ *      Name of a session.
+ *
+ * Post-Conditions:
+ *      Returns the number of the session,
+ *      the next free one on its first appearance.
+ *
+ * Returns the number of the named session.
+ */
+uint32_t TraceRecorder::getSession(string_view name) {
+    const auto [entry, inserted] = sessions.try_emplace(
+            string{name}, static_cast<uint32_t>(sessions.size()));
+
+    return entry->second;
+}
+
+/*
+ * Pre-Conditions:
+ *      TraceRecorder is not closed.
+ *      Operation called.
+ *      Number of the session it was called on.
+ *      Argument of the operation, see TraceOperation.
+ *
+ * Post-Conditions:
+ *      The call is appended, timed against the previous one.
+ *
+ * Appends a call made now.
+ * The first call is timed against the creation of the recorder.
+ */
+void TraceRecorder::record(TraceOperation operation, uint32_t session,
+                           uint64_t argument) {
+    const auto now = steady_clock::now();
+    const auto delay = duration_cast<nanoseconds>(now - last).count();
+
+    last = now;
+
+    append({operation, session, argument, static_cast<uint64_t>(delay)});
+}
+
+/*
+ * Pre-Conditions:
+ *      TraceRecorder is not closed.
+ *      const reference to the event.
+ *
+ * Post-Conditions:
+ *      The event is appended as is.
+ *
+ * Appends an event with its own delay, as generated workloads do.
+ * Written to the file once kBufferBytes are buffered.
+ */
+void TraceRecorder::append(const TraceEvent& event) {
+    buffer += static_cast<char>(event.operation);
+    putVarint(event.session, buffer);
+    putVarint(event.argument, buffer);
+    putVarint(event.delay, buffer);
+
+    header.events++;
+    header.sessions = std::max<uint64_t>(header.sessions, event.session + 1);
+    header.duration += event.delay;
+
+    if (buffer.size() >= kBufferBytes) {
+        flush();
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      TraceRecorder is initialized.
+ *
+ * Post-Conditions:
+ *      Every event & the complete header are written.
+ *      Later calls do nothing, returning the same header.
+ *      Throws std::runtime_error if the file cannot be written.
+ *
+ * Completes the trace file.
+ */
+TraceHeader TraceRecorder::close() {
+    if (closed) {
+        return header;
+    }
+
+    closed = true;
+    flush();
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+
+    if (not file) {
+        throw runtime_error("\nCannot write the trace.\n");
+    }
+
+    return header;
+}
+
+/*
+ * Pre-Conditions:
+ *      TraceRecorder is not closed.
+ *
+ * Post-Conditions:
+ *      The buffered events are written to the file.
+ *      Throws std::runtime_error if the file cannot be written.
+ *
+ * Writes the buffered events.
+ */
+void TraceRecorder::flush() {
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    header.event_bytes += buffer.size();
+    buffer.clear();
+
+    if (not file) {
+        throw runtime_error("\nCannot write the trace.\n");
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of a trace written by TraceRecorder.
+ *
+ * Post-Conditions:
+ *      The trace is mapped, positioned at its first event.
+ *      Throws std::runtime_error if the file is not a valid trace.
+ *
+ * Maps the trace file at the given path.
+ * Only the header is checked, events are checked as they are decoded.
+ */
+TraceReader::TraceReader(const string& path): mapping{path}, header{},
+                                              position{sizeof(TraceHeader)},
+                                              decoded{0} {
+    if (mapping.getLength() < sizeof(TraceHeader)) {
+        throw runtime_error("\nTruncated trace.\n");
+    }
+
+    std::memcpy(&header, mapping.getData(), sizeof(header));
+
+    if (std::memcmp(header.magic, kTraceMagic, sizeof(kTraceMagic))
+        or header.version != kTraceVersion) {
+        throw runtime_error("\nNot a URStack trace.\n");
+    }
+
+    if (header.event_bytes != mapping.getLength() - sizeof(TraceHeader)) {
+        throw runtime_error("\nTruncated trace.\n");
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      TraceReader is initialized.
+ *      Reference to the decoded event.
+ *
+ * Post-Conditions:
+ *      Returns true with the next event decoded into the reference,
+ *      or false after the last event.
+ *      Throws std::runtime_error if the event is corrupted.
+ *
+ * Decodes the next event.
+ */
+bool TraceReader::next(TraceEvent& event) {
+    if (decoded == header.events) {
+        return false;
+    }
+
+    const string_view bytes{mapping.getData(), mapping.getLength()};
+    uint64_t session = 0;
+
+    if (position >= bytes.size()
+        or static_cast<uint8_t>(bytes[position]) >= kTraceOperations) {
+        throw runtime_error("\nCorrupted trace event.\n");
+    }
+
+    event.operation = static_cast<TraceOperation>(bytes[position++]);
+
+    if (not getVarint(bytes, position, session)
+        or session >= header.sessions
+        or not getVarint(bytes, position, event.argument)
+        or not getVarint(bytes, position, event.delay)) {
+        throw runtime_error("\nCorrupted trace event.\n");
+    }
+
+    event.session = static_cast<uint32_t>(session);
+    decoded++;
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      TraceReader is initialized.
+ *
+ * Post-Conditions:
+ *      Returns every remaining event, in order.
+ *      Throws std::runtime_error if an event is corrupted.
+ *
+ * Decodes every remaining event, so replaying does not time decoding.
+ * The event count of the header is not trusted for the reservation,
+ * no more events than the bytes can hold are reserved.
+ */
+vector<TraceEvent> TraceReader::readAll() {
+    vector<TraceEvent> events;
+    TraceEvent event{};
+
+    events.reserve(std::min<uint64_t>(header.events - decoded,
+                                      header.event_bytes / kMinEventBytes));
+
+    while (next(event)) {
+        events.push_back(event);
+    }
+
+    return events;
+}
+
+/*
+ * Pre-Conditions:
+ *      An operation.
+ *
+ * Post-Conditions:
+ *      Returns the name of the operation.
+ */
+const char* getName(TraceOperation operation) {
+    switch (operation) {
+        case TraceOperation::kCreate:
+            return "create";
+        case TraceOperation::kInsert:
+            return "insert";
+        case TraceOperation::kUndo:
+            return "undo";
+        case TraceOperation::kRedo:
+            return "redo";
+        default:
+            return "resize";
+    }
+}
+
+/*
+ * splitmix64, the same sequence on every platform, unlike the
+ * distributions of <random>.
+ */
+class WorkloadRandom {
+public:
+    explicit WorkloadRandom(uint64_t seed): state{seed} {}
+
+    /* Returns the next 64 random bits */
+    uint64_t next() {
+        uint64_t z = state += 0x9e3779b97f4a7c15ULL;
+        z = (z ^ z >> 30) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ z >> 27) * 0x94d049bb133111ebULL;
+
+        return z ^ z >> 31;
+    }
+
+    /* Returns a uniform double in [0, 1) */
+    double uniform() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+private:
+    uint64_t state;
+};
+
+/*
+ * Pre-Conditions:
+ *      const reference to the options, with positive sessions,
+ *      non-negative weights of positive sum, burst at least 1
+ *      & min_payload not above max_payload.
+ *
+ * Post-Conditions:
+ *      Returns options.events events, preceded by a kCreate event on
+ *      the first visit of every session.
+ *      Throws std::invalid_argument if the options are invalid.
+ *
+ * Returns a synthetic workload, the same for the same options.
+ * Every burst picks a session by its Zipf popularity, an operation by
+ * its weight & a geometric length, then emits that many calls.
+ * Session numbers are popularity ranks, 0 the most popular.
+ */
+vector<TraceEvent> generateWorkload(const WorkloadOptions& options) {
+    const double weights = options.insert_weight + options.undo_weight
+                           + options.redo_weight;
+
+    if (not options.sessions
+        or options.insert_weight < 0 or options.undo_weight < 0
+        or options.redo_weight < 0 or not (weights > 0)
+        or not (options.burst >= 1) or options.zipf < 0
+        or not options.min_payload
+        or options.min_payload > options.max_payload
+        or not options.capacity or options.mean_delay < 0) {
+        throw invalid_argument("\nInvalid workload options.\n");
+    }
+
+    /* Cumulative popularity of the sessions, by rank */
+    vector<double> popularity(options.sessions);
+    double total = 0;
+
+    for (uint32_t rank = 0; rank < options.sessions; rank++) {
+        total += 1 / std::pow(rank + 1.0, options.zipf);
+        popularity[rank] = total;
+    }
+
+    WorkloadRandom random{options.seed};
+    vector<bool> created(options.sessions, false);
+    vector<TraceEvent> events;
+
+    const double stop = 1 / options.burst;
+    const double smallest = std::log(options.min_payload);
+    const double range = std::log(options.max_payload + 1.0) - smallest;
+
+    events.reserve(options.events + std::min<uint64_t>(options.sessions,
+                                                       options.events));
+
+    for (uint64_t emitted = 0; emitted < options.events;) {
+        const auto rank = static_cast<uint32_t>(
+                std::upper_bound(popularity.begin(), popularity.end(),
+                                 random.uniform() * total)
+                - popularity.begin());
+        const uint32_t session = std::min(rank, options.sessions - 1);
+
+        const double roll = random.uniform() * weights;
+        const TraceOperation operation =
+                roll < options.insert_weight ? TraceOperation::kInsert
+                : roll < options.insert_weight + options.undo_weight
+                  ? TraceOperation::kUndo : TraceOperation::kRedo;
+
+        if (not created[session]) {
+            created[session] = true;
+            events.push_back({TraceOperation::kCreate, session,
+                              options.capacity, 0});
+        }
+
+        /* Geometric length, each call ends the burst with odds 1 / burst */
+        do {
+            uint64_t argument = 1;
+
+            if (operation == TraceOperation::kInsert) {
+                argument = std::min<uint64_t>(
+                        options.max_payload, static_cast<uint64_t>(
+                                std::exp(smallest + random.uniform() * range)));
+            }
+
+            const auto delay = static_cast<uint64_t>(
+                    -std::log(1 - random.uniform()) * options.mean_delay);
+
+            events.push_back({operation, session, argument, delay});
+            emitted++;
+        } while (emitted < options.events and random.uniform() >= stop);
+    }
+
+    return events;
+}
@@ -0,0 +1,412 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackTrace.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the workload trace format of URStack,
+ *              the TraceRecorder class capturing URStack calls to a trace
+ *              file, the TraceReader class reading them back,
+ *              & generateWorkload, producing parametric synthetic traces.
+ *
+ * Trace layout (native byte order):
+ *      TraceHeader         64 bytes, see below.
+ *      Events              One encoded event after the other:
+ *                              1 byte      TraceOperation
+ *                              varint      session
+ *                              varint      argument
+ *                              varint      delay
+ *                          varints are little-endian base 128,
+ *                          so most events take 4 to 8 bytes.
+ *
+ *      Sessions are numbered from 0 in order of first appearance,
+ *      their names are not recorded, neither are the actions,
+ *      only their sizes.
+ *
+ * List of public TraceRecorder class Functions:
+ *      explicit TraceRecorder(const std::string&)
+ *          Creates the trace file at the given path.
+ *
+ *      ~TraceRecorder()
+ *          Completes the trace file, if not closed yet.
+ *
+ *      std::uint32_t getSession(std::string_view)
+ *          Returns the number of the named session.
+ *
+ *      void record(TraceOperation, std::uint32_t, std::uint64_t)
+ *          Appends a call made now.
+ *
+ *      void append(const TraceEvent&)
+ *          Appends an event with its own delay.
+ *
+ *      TraceHeader close()
+ *          Completes the trace file.
+ *
+ * List of public TraceReader class Functions:
+ *      explicit TraceReader(const std::string&)
+ *          Maps the trace file at the given path.
+ *
+ *      bool next(TraceEvent&)
+ *          Decodes the next event.
+ *
+ *      std::vector<TraceEvent> readAll()
+ *          Decodes every remaining event.
+ *
+ *      inline const TraceHeader& getHeader() const
+ *          Returns the header of the trace.
+ *
+ * List of Functions:
+ *      const char* getName(TraceOperation)
+ *          Returns the name of an operation.
+ *
+ *      std::vector<TraceEvent> generateWorkload(const WorkloadOptions&)
+ *          Returns a synthetic workload, the same for the same options.
+ */
+
+#ifndef URSTACK_URSTACKTRACE_H
+#define URSTACK_URSTACKTRACE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "MappedFile.h"
+
+
+/*
+ * Version of the trace format written by TraceRecorder.
+ */
+constexpr std::uint32_t kTraceVersion = 1;
+
+/*
+ * URStack calls recorded in a trace.
+ */
+enum class TraceOperation : std::uint8_t {
+    /* Session (re)created, argument is its capacity */
+    kCreate = 0,
+
+    /* insertNewAction, argument is the size of the action in bytes */
+    kInsert = 1,
+
+    /* Undo, argument is the number of actions */
+    kUndo = 2,
+
+    /* Redo, argument is the number of actions */
+    kRedo = 3,
+
+    /* setCapacity, argument is the new capacity */
+    kResize = 4,
+};
+
+/*
+ * Number of TraceOperation values.
+ */
+constexpr std::size_t kTraceOperations = 5;
+
+/*
+ * A single recorded call.
+ */
+struct TraceEvent {
+    TraceOperation operation;
+
+    /* Number of the session the call was made on */
+    std::uint32_t session;
+
+    /* Meaning depends on the operation, see TraceOperation */
+    std::uint64_t argument;
+
+    /* Nanoseconds since the previous event, 0 for the first one */
+    std::uint64_t delay;
+};
+
+/*
+ * Fixed-size header at the beginning of every trace.
+ */
+struct TraceHeader {
+    /* "URTRACE" followed by a null byte */
+    char magic[8];
+
+    /* kTraceVersion at the time of writing */
+    std::uint32_t version;
+
+    /* Reserved, written as 0 */
+    std::uint32_t reserved;
+
+    /* Number of events following the header */
+    std::uint64_t events;
+
+    /* Number of distinct sessions, the largest session number + 1 */
+    std::uint64_t sessions;
+
+    /* Number of bytes of the encoded events */
+    std::uint64_t event_bytes;
+
+    /* Sum of the delays of every event, in nanoseconds */
+    std::uint64_t duration;
+
+    /* Padding up to 64 bytes */
+    std::uint64_t padding[2];
+};
+
+static_assert(sizeof(TraceHeader) == 64,
+              "TraceHeader must occupy exactly 64 bytes");
+
+/*
+ * Parameters of a synthetic workload.
+ * Sessions are visited with Zipf popularity: the session of rank k is
+ * visited in proportion to 1 / k^zipf. Every visit is a burst of the
+ * same operation, its length geometric with mean burst, so inserts,
+ * undo storms & redo chains come in runs as in real use.
+ */
+struct WorkloadOptions {
+    /* Number of events, session creations excluded */
+    std::uint64_t events = 1000000;
+
+    /* Number of sessions */
+    std::uint32_t sessions = 1000;
+
+    /* Zipf exponent of the session popularity, 0 for uniform */
+    double zipf = 1.0;
+
+    /* Relative weights of the operations of a burst */
+    double insert_weight = 0.6;
+    double undo_weight = 0.25;
+    double redo_weight = 0.15;
+
+    /* Mean number of calls of a burst, at least 1 */
+    double burst = 4;
+
+    /* Bounds of the action sizes in bytes, log-uniform in between */
+    std::uint32_t min_payload = 8;
+    std::uint32_t max_payload = 256;
+
+    /* Capacity of the created sessions */
+    std::uint32_t capacity = 20;
+
+    /* Mean nanoseconds between calls, exponentially distributed */
+    double mean_delay = 1000;
+
+    std::uint64_t seed = 0x5eed5eed5eed5eedULL;
+};
+
+/*
+ * Captures a sequence of URStack calls to a trace file, timing each one
+ * against the previous. Events are buffered & written in blocks,
+ * the header is completed by close.
+ */
+class TraceRecorder {
+public:
+    /*
+     * Pre-Conditions:
+     *      const reference to the path of the trace, replaced if it exists.
+     *
+     * Post-Conditions:
+     *      An empty trace is created at the path.
+     *      Throws std::runtime_error if the file cannot be written.
+     *
+     * Creates the trace file at the given path.
+     */
+    explicit TraceRecorder(const std::string&);
+
+    TraceRecorder(const TraceRecorder&) = delete;
+
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    /*
+     * Pre-Conditions:
+     *      `this` TraceRecorder instance is not destroyed.
+     *
+     * Post-Conditions:
+     *      The trace file is complete, errors are ignored.
+     *
+     * Completes the trace file, if not closed yet.
+     */
+    ~TraceRecorder();
+
+    /*
+     * Pre-Conditions:
+     *      TraceRecorder is initialized.
+     *      Name of a session.
+     *
+     * Post-Conditions:
+     *      Returns the number of the session,
+     *      the next free one on its first appearance.
+     *
+     * Returns the number of the named session.
+     */
+    std::uint32_t getSession(std::string_view);
+
+    /*
+     * Pre-Conditions:
+     *      TraceRecorder is not closed.
+     *      Operation called.
+     *      Number of the session it was called on.
+     *      Argument of the operation, see TraceOperation.
+     *
+     * Post-Conditions:
+     *      The call is appended, timed against the previous one.
+     *
+     * Appends a call made now.
+     */
+    void record(TraceOperation, std::uint32_t /* session */,
+                std::uint64_t /* argument */);
+
+    /*
+     * Pre-Conditions:
+     *      TraceRecorder is not closed.
+     *      const reference to the event.
+     *
+     * Post-Conditions:
+     *      The event is appended as is.
+     *
+     * Appends an event with its own delay, as generated workloads do.
+     */
+    void append(const TraceEvent&);
+
+    /*
+     * Pre-Conditions:
+     *      TraceRecorder is initialized.
+     *
+     * Post-Conditions:
+     *      Every event & the complete header are written.
+     *      Later calls do nothing, returning the same header.
+     *      Throws std::runtime_error if the file cannot be written.
+     *
+     * Completes the trace file.
+     */
+    TraceHeader close();
+
+private:
+    /*
+     * Encoded events are written once they exceed this size.
+     */
+    static constexpr std::size_t kBufferBytes = 1 << 16;
+
+    std::ofstream file;
+
+    /* Encoded events not written yet */
+    std::string buffer;
+
+    TraceHeader header;
+
+    /* Numbers of the named sessions */
+    std::unordered_map<std::string, std::uint32_t> sessions;
+
+    /* Time of the last recorded call */
+    std::chrono::steady_clock::time_point last;
+
+    bool closed;
+
+    /*
+     * Pre-Conditions:
+     *      TraceRecorder is not closed.
+     *
+     * Post-Conditions:
+     *      The buffered events are written to the file.
+     *      Throws std::runtime_error if the file cannot be written.
+     *
+     * Writes the buffered events.
+     */
+    void flush();
+};
+
+/*
+ * Sequential reader of a trace file, mapped in memory.
+ */
+class TraceReader {
+public:
+    /*
+     * Pre-Conditions:
+     *      const reference to the path of a trace written by TraceRecorder.
+     *
+     * Post-Conditions:
+     *      The trace is mapped, positioned at its first event.
+     *      Throws std::runtime_error if the file is not a valid trace.
+     *
+     * Maps the trace file at the given path.
+     */
+    explicit TraceReader(const std::string&);
+
+    /*
+     * Pre-Conditions:
+     *      TraceReader is initialized.
+     *      Reference to the decoded event.
+     *
+     * Post-Conditions:
+     *      Returns true with the next event decoded into the reference,
+     *      or false after the last event.
+     *      Throws std::runtime_error if the event is corrupted.
+     *
+     * Decodes the next event.
+     */
+    bool next(TraceEvent&);
+
+    /*
+     * Pre-Conditions:
+     *      TraceReader is initialized.
+     *
+     * Post-Conditions:
+     *      Returns every remaining event, in order.
+     *      Throws std::runtime_error if an event is corrupted.
+     *
+     * Decodes every remaining event.
+     */
+    [[nodiscard]] std::vector<TraceEvent> readAll();
+
+    /*
+     * Pre-Conditions:
+     *      TraceReader is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the header of the trace.
+     */
+    [[nodiscard]] inline const TraceHeader& getHeader() const {
+        return header;
+    }
+
+private:
+    MappedFile mapping;
+
+    TraceHeader header;
+
+    /* Offset of the next event from the beginning of the file */
+    std::size_t position;
+
+    /* Number of events decoded so far */
+    std::uint64_t decoded;
+};
+
+/*
+ * Pre-Conditions:
+ *      An operation.
+ *
+ * Post-Conditions:
+ *      Returns the name of the operation.
+ */
+const char* getName(TraceOperation);
+
+/*
+ * Pre-Conditions:
+ *      const reference to the options, with positive sessions,
+ *      non-negative weights of positive sum, burst at least 1
+ *      & min_payload not above max_payload.
+ *
+ * Post-Conditions:
+ *      Returns options.events events, preceded by a kCreate event on
+ *      the first visit of every session.
+ *      Throws std::invalid_argument if the options are invalid.
+ *
+ * Returns a synthetic workload, the same for the same options.
+ */
+std::vector<TraceEvent> generateWorkload(const WorkloadOptions&);
+
+#endif //URSTACK_URSTACKTRACE_H
@@ -0,0 +1,242 @@
+/*
+ * URStack Project
+ *
+ *
+ * WorkerPool.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Implementation of the functions defined in WorkerPool.h
+ *
+ * List of public WorkerPool class Functions:
+ *      explicit WorkerPool(unsigned threads = 0)
+ *          Starts the threads of the pool.
+ *
+ *      ~WorkerPool()
+ *          Stops & joins the threads of the pool.
+ *
+ *      void run(std::size_t, const std::function<void(std::size_t)>&)
+ *          Runs a task for every index of a range, in parallel.
+ *
+ *      static unsigned resolveThreads(unsigned)
+ *          Returns the number of threads a request stands for.
+ *
+ * List of private WorkerPool class Functions:
+ *      void work()
+ *          Runs the tasks of every run, until the pool is destroyed.
+ *
+ *      void runTasks()
+ *          Runs tasks of the current run until none is left.
+ */
+
+#include <algorithm>
+
+#include "WorkerPool.h"
+
+
+/* Used std utilities */
+using std::mutex, std::unique_lock, std::lock_guard;
+
+/*
+ * Pre-Conditions:
+ *      Number of threads running tasks, the calling thread included
+ *      (optional, default 0, one per core).
+ *
+ * Post-Conditions:
+ *      The threads but the calling one are started, waiting for a run.
+ *      Throws std::system_error if a thread cannot be started,
+ *      with the started ones joined.
+ *
+ * Starts the threads of the pool.
+ * The destructor does not run if the constructor throws,
+ * so the threads started so far are stopped here.
+ */
+WorkerPool::WorkerPool(unsigned threads) {
+    threads = resolveThreads(threads);
+    workers.reserve(threads - 1);
+
+    try {
+        for (unsigned worker = 1; worker < threads; worker++) {
+            workers.emplace_back(&WorkerPool::work, this);
+        }
+    } catch (...) {
+        {
+            lock_guard<mutex> lock{guard};
+            stopping = true;
+        }
+
+        started.notify_all();
+
+        for (std::thread& worker: workers) {
+            worker.join();
+        }
+
+        throw;
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      `this` WorkerPool instance is not destroyed.
+ *      No run is in progress.
+ *
+ * Post-Conditions:
+ *      Every thread of the pool is stopped & joined.
+ *
+ * Stops & joins the threads of the pool.
+ */
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> lock{guard};
+        stopping = true;
+    }
+
+    started.notify_all();
+
+    for (std::thread& worker: workers) {
+        worker.join();
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      WorkerPool is initialized.
+ *      Number of tasks.
+ *      const reference to the task, called with every index from 0
+ *      to the number of tasks, excluded, safe to call concurrently
+ *      with other indices.
+ *
+ * Post-Conditions:
+ *      The task ran once for every index, on the calling thread &
+ *      the threads of the pool, in no particular order.
+ *      If tasks throw, the error of the lowest index is rethrown once
+ *      the run is done, as a serial loop would, tasks of higher
+ *      indices may or may not have run.
+ *
+ * Runs a task for every index of a range, in parallel.
+ * A single task, or a pool of a single thread, runs on the calling thread
+ * without waking the pool. Every task writes the error of its own index,
+ * which the calling thread reads once the pool is done.
+ */
+void WorkerPool::run(std::size_t tasks,
+                     const std::function<void(std::size_t)>& function) {
+    if (tasks == 0) {
+        return;
+    }
+
+    if (tasks == 1 or workers.empty()) {
+        for (std::size_t index = 0; index < tasks; index++) {
+            function(index);
+        }
+
+        return;
+    }
+
+    errors.assign(tasks, nullptr);
+    cursor = 0;
+
+    {
+        lock_guard<mutex> lock{guard};
+        task = &function;
+        count = tasks;
+        busy = static_cast<unsigned>(workers.size());
+        generation++;
+    }
+
+    started.notify_all();
+    runTasks();
+
+    {
+        unique_lock<mutex> lock{guard};
+        finished.wait(lock, [this] { return busy == 0; });
+        task = nullptr;
+    }
+
+    for (const std::exception_ptr& error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      Requested number of threads, 0 for one per core.
+ *
+ * Post-Conditions:
+ *      Returns the given number, or the number of cores if 0,
+ *      at least 1.
+ *
+ * Returns the number of threads a request stands for.
+ * hardware_concurrency may report 0 if unknown.
+ */
+unsigned WorkerPool::resolveThreads(unsigned threads) {
+    return threads ? threads
+                   : std::max(1U, std::thread::hardware_concurrency());
+}
+
+/*
+ * Pre-Conditions:
+ *      WorkerPool is initialized.
+ *
+ * Post-Conditions:
+ *      Tasks of every run are run until the pool is destroyed.
+ *
+ * Runs the tasks of every run, until the pool is destroyed.
+ * A run only starts once every thread finished the previous one,
+ * so no thread misses a generation.
+ */
+void WorkerPool::work() {
+    std::uint64_t seen = 0;
+
+    for (;;) {
+        {
+            unique_lock<mutex> lock{guard};
+            started.wait(lock, [&] {
+                return stopping or generation != seen;
+            });
+
+            if (stopping) {
+                return;
+            }
+
+            seen = generation;
+        }
+
+        runTasks();
+
+        bool last;
+
+        {
+            lock_guard<mutex> lock{guard};
+            last = --busy == 0;
+        }
+
+        if (last) {
+            finished.notify_one();
+        }
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      WorkerPool is initialized, a run is in progress.
+ *
+ * Post-Conditions:
+ *      Tasks are taken from the cursor & run until none is left,
+ *      their errors recorded.
+ *
+ * Runs tasks of the current run until none is left.
+ * task & count are only written between runs, while no thread runs tasks.
+ */
+void WorkerPool::runTasks() {
+    for (std::size_t index = cursor++; index < count; index = cursor++) {
+        try {
+            (*task)(index);
+        } catch (...) {
+            errors[index] = std::current_exception();
+        }
+    }
+}
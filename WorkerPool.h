@@ -0,0 +1,221 @@
+/*
+ * URStack Project
+ *
+ *
+ * WorkerPool.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Definition of the WorkerPool class, a fixed set of threads
+ *              running the tasks of a parallel for, started once & reused
+ *              by every run, so callers running in rounds (exports) or
+ *              periodically (compactions) never start threads again.
+ *
+ *              Usage:
+ *                  WorkerPool pool{4};
+ *                  pool.run(chunks.size(), [&](std::size_t chunk) {
+ *                      parse(chunks[chunk]);
+ *                  });
+ *
+ * List of public WorkerPool class Functions:
+ *      explicit WorkerPool(unsigned threads = 0)
+ *          Starts the threads of the pool.
+ *
+ *      ~WorkerPool()
+ *          Stops & joins the threads of the pool.
+ *
+ *      void run(std::size_t, const std::function<void(std::size_t)>&)
+ *          Runs a task for every index of a range, in parallel.
+ *
+ *      inline unsigned getThreads() const
+ *          Returns the number of threads running tasks.
+ *
+ *      static unsigned resolveThreads(unsigned)
+ *          Returns the number of threads a request stands for.
+ *
+ * List of private WorkerPool class Functions:
+ *      void work()
+ *          Runs the tasks of every run, until the pool is destroyed.
+ *
+ *      void runTasks()
+ *          Runs tasks of the current run until none is left.
+ */
+
+#ifndef URSTACK_WORKERPOOL_H
+#define URSTACK_WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*
+ * Threads running the tasks of a parallel for, the calling thread
+ * being one of them. Tasks are taken from a shared cursor, so a thread
+ * stuck on a long task never holds up the short ones.
+ * A single run at a time, run is not thread safe.
+ */
+class WorkerPool {
+public:
+    /*
+     * Pre-Conditions:
+     *      Number of threads running tasks, the calling thread included
+     *      (optional, default 0, one per core).
+     *
+     * Post-Conditions:
+     *      The threads but the calling one are started, waiting for a run.
+     *      Throws std::system_error if a thread cannot be started,
+     *      with the started ones joined.
+     *
+     * Starts the threads of the pool.
+     */
+    explicit WorkerPool(unsigned threads = 0);
+
+    WorkerPool(const WorkerPool&) = delete;
+
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /*
+     * Pre-Conditions:
+     *      `this` WorkerPool instance is not destroyed.
+     *      No run is in progress.
+     *
+     * Post-Conditions:
+     *      Every thread of the pool is stopped & joined.
+     *
+     * Stops & joins the threads of the pool.
+     */
+    ~WorkerPool();
+
+    /*
+     * Pre-Conditions:
+     *      WorkerPool is initialized.
+     *      Number of tasks.
+     *      const reference to the task, called with every index from 0
+     *      to the number of tasks, excluded, safe to call concurrently
+     *      with other indices.
+     *
+     * Post-Conditions:
+     *      The task ran once for every index, on the calling thread &
+     *      the threads of the pool, in no particular order.
+     *      If tasks throw, the error of the lowest index is rethrown once
+     *      the run is done, as a serial loop would, tasks of higher
+     *      indices may or may not have run.
+     *
+     * Runs a task for every index of a range, in parallel.
+     */
+    void run(std::size_t, const std::function<void(std::size_t)>&);
+
+    /*
+     * Pre-Conditions:
+     *      WorkerPool is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the number of threads running tasks,
+     *      the calling thread included.
+     */
+    [[nodiscard]] inline unsigned getThreads() const {
+        return static_cast<unsigned>(workers.size()) + 1;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Requested number of threads, 0 for one per core.
+     *
+     * Post-Conditions:
+     *      Returns the given number, or the number of cores if 0,
+     *      at least 1.
+     *
+     * Returns the number of threads a request stands for.
+     */
+    [[nodiscard]] static unsigned resolveThreads(unsigned);
+
+private:
+    /*
+     * Threads of the pool, the calling thread excluded.
+     */
+    std::vector<std::thread> workers;
+
+    /*
+     * Guards the fields below up to stopping, & wakes the threads.
+     */
+    std::mutex guard;
+
+    /*
+     * Notified when a run starts or the pool is destroyed.
+     */
+    std::condition_variable started;
+
+    /*
+     * Notified when the last thread of the pool finishes a run.
+     */
+    std::condition_variable finished;
+
+    /*
+     * Task of the current run, nullptr between runs.
+     */
+    const std::function<void(std::size_t)> *task = nullptr;
+
+    /*
+     * Number of tasks of the current run.
+     */
+    std::size_t count = 0;
+
+    /*
+     * Serial of the current run, threads wait for it to change.
+     */
+    std::uint64_t generation = 0;
+
+    /*
+     * Threads of the pool still running tasks of the current run.
+     */
+    unsigned busy = 0;
+
+    /*
+     * Set by the destructor.
+     */
+    bool stopping = false;
+
+    /*
+     * Next index of the current run to be taken.
+     */
+    std::atomic<std::size_t> cursor{0};
+
+    /*
+     * Error of every index of the current run, reused between runs.
+     */
+    std::vector<std::exception_ptr> errors;
+
+    /*
+     * Pre-Conditions:
+     *      WorkerPool is initialized.
+     *
+     * Post-Conditions:
+     *      Tasks of every run are run until the pool is destroyed.
+     *
+     * Runs the tasks of every run, until the pool is destroyed.
+     */
+    void work();
+
+    /*
+     * Pre-Conditions:
+     *      WorkerPool is initialized, a run is in progress.
+     *
+     * Post-Conditions:
+     *      Tasks are taken from the cursor & run until none is left,
+     *      their errors recorded.
+     *
+     * Runs tasks of the current run until none is left.
+     */
+    void runTasks();
+};
+
+#endif //URSTACK_WORKERPOOL_H
@@ -0,0 +1,588 @@
+/*
+ * URStack Project
+ *
+ *
+ * BenchHarness.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Shared pieces of the benchmarks: a resumable stopwatch,
+ *              a discarding ostream counting its bytes, summaries of
+ *              repeated measurements, a resident memory tracker & a small
+ *              JSON writer, so results of different builds can be
+ *              compared by tools.
+ *
+ * List of public Stopwatch class Functions:
+ *      inline void start()
+ *          Starts or resumes measuring.
+ *
+ *      inline void stop()
+ *          Pauses measuring, adding the elapsed time.
+ *
+ *      inline double getSeconds() const
+ *          Returns the measured seconds.
+ *
+ * List of public NullStream class Functions:
+ *      NullStream()
+ *          Creates an ostream discarding everything written to it.
+ *
+ *      inline long long getBytes() const
+ *          Returns the number of bytes written so far.
+ *
+ * List of public RssSampler class Functions:
+ *      RssSampler()
+ *          Starts tracking the resident memory.
+ *
+ *      inline void record()
+ *          Adds a sample of the resident memory.
+ *
+ *      RssSample stop() const
+ *          Returns the resident memory before, at its peak & now.
+ *
+ * List of public JsonWriter class Functions:
+ *      explicit JsonWriter(std::ostream&)
+ *          Creates a writer of a single JSON document.
+ *
+ *      JsonWriter& beginObject(std::string_view key = {})
+ *          Opens an object, named if inside an object.
+ *
+ *      JsonWriter& endObject()
+ *          Closes the innermost object.
+ *
+ *      JsonWriter& beginArray(std::string_view key = {})
+ *          Opens an array, named if inside an object.
+ *
+ *      JsonWriter& endArray()
+ *          Closes the innermost array.
+ *
+ *      template<class T>
+ *      JsonWriter& field(std::string_view, const T&)
+ *          Writes a named value inside an object.
+ *
+ *      template<class T>
+ *      JsonWriter& value(const T&)
+ *          Writes a value inside an array.
+ *
+ * List of Functions:
+ *      inline Summary summarize(std::vector<double>)
+ *          Returns the minimum, median & maximum of measurements.
+ *
+ *      inline long long readRss()
+ *          Returns the resident memory of the process in bytes.
+ *
+ *      inline long long readPeakRss()
+ *          Returns the peak resident memory of the process in bytes.
+ *
+ *      inline bool resetPeakRss()
+ *          Resets the peak resident memory to the current one.
+ */
+
+#ifndef URSTACK_BENCHHARNESS_H
+#define URSTACK_BENCHHARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+
+/*
+ * Accumulates the time between start & stop calls,
+ * so untimed setup can be interleaved with the measured work.
+ */
+class Stopwatch {
+public:
+    /*
+     * Pre-Conditions:
+     *      Stopwatch is stopped.
+     *
+     * Post-Conditions:
+     *      Time is measured from now on.
+     *
+     * Starts or resumes measuring.
+     */
+    inline void start() {
+        started = std::chrono::steady_clock::now();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Stopwatch is started.
+     *
+     * Post-Conditions:
+     *      The time since start is added to the measured time.
+     *
+     * Pauses measuring, adding the elapsed time.
+     */
+    inline void stop() {
+        elapsed += std::chrono::steady_clock::now() - started;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      Stopwatch is stopped.
+     *
+     * Post-Conditions:
+     *      Returns the measured seconds.
+     */
+    [[nodiscard]] inline double getSeconds() const {
+        return std::chrono::duration<double>(elapsed).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point started;
+
+    std::chrono::steady_clock::duration elapsed{};
+};
+
+/*
+ * ostream discarding its output, counting the written bytes,
+ * measures formatting without the cost of a terminal or a file.
+ */
+class NullStream: public std::ostream {
+public:
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      An ostream discarding everything written to it is created.
+     *
+     * Creates an ostream discarding everything written to it.
+     */
+    NullStream(): std::ostream{&counter} {}
+
+    /*
+     * Pre-Conditions:
+     *      NullStream is initialized.
+     *
+     * Post-Conditions:
+     *      Returns the number of bytes written so far.
+     */
+    [[nodiscard]] inline long long getBytes() const {
+        return counter.bytes;
+    }
+
+private:
+    struct Counter: public std::streambuf {
+        long long bytes = 0;
+
+    protected:
+        int_type overflow(int_type c) override {
+            bytes += not traits_type::eq_int_type(c, traits_type::eof());
+
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char_type*,
+                               std::streamsize count) override {
+            bytes += count;
+
+            return count;
+        }
+    };
+
+    Counter counter;
+};
+
+/*
+ * Minimum, median & maximum of repeated measurements.
+ */
+struct Summary {
+    double min;
+    double median;
+    double max;
+};
+
+/*
+ * Pre-Conditions:
+ *      Non-empty measurements.
+ *
+ * Post-Conditions:
+ *      Returns their minimum, median & maximum.
+ */
+inline Summary summarize(std::vector<double> measurements) {
+    std::sort(measurements.begin(), measurements.end());
+
+    const std::size_t middle = measurements.size() / 2;
+    const double median = measurements.size() % 2
+            ? measurements[middle]
+            : (measurements[middle - 1] + measurements[middle]) / 2;
+
+    return {measurements.front(), median, measurements.back()};
+}
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Returns the resident set size of the process in bytes,
+ *      or 0 where it cannot be read.
+ *
+ * Returns the resident memory of the process in bytes.
+ * Reads the second field of /proc/self/statm, in pages.
+ */
+inline long long readRss() {
+#if defined(__linux__)
+    std::ifstream statm{"/proc/self/statm"};
+    long long total_pages = 0, resident_pages = 0;
+
+    if (statm >> total_pages >> resident_pages) {
+        return resident_pages * sysconf(_SC_PAGESIZE);
+    }
+#endif
+
+    return 0;
+}
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Returns the peak resident set size of the process in bytes,
+ *      since it started or since the last resetPeakRss,
+ *      or 0 where it cannot be read.
+ *
+ * Returns the peak resident memory of the process in bytes.
+ * Reads the VmHWM line of /proc/self/status, in kB.
+ */
+inline long long readPeakRss() {
+#if defined(__linux__)
+    std::ifstream status{"/proc/self/status"};
+    std::string key;
+    long long kilobytes = 0;
+
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            return status >> kilobytes ? kilobytes * 1024 : 0;
+        }
+
+        status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+#endif
+
+    return 0;
+}
+
+/*
+ * Pre-Conditions:
+ *      No code-related preconditions.
+ *
+ * Post-Conditions:
+ *      Returns true if the peak resident memory is now the current one,
+ *      false where it cannot be reset.
+ *
+ * Resets the peak resident memory to the current one,
+ * by writing 5 to /proc/self/clear_refs (Linux 4.0 & later).
+ */
+inline bool resetPeakRss() {
+#if defined(__linux__)
+    std::ofstream clear_refs{"/proc/self/clear_refs"};
+    clear_refs << '5';
+    clear_refs.close();
+
+    return static_cast<bool>(clear_refs);
+#else
+    return false;
+#endif
+}
+
+/*
+ * Resident memory of the process over a measurement, in bytes.
+ */
+struct RssSample {
+    long long before;
+    long long peak;
+    long long after;
+
+    /* Resident memory after every repetition, in order */
+    std::vector<long long> samples;
+};
+
+/*
+ * Tracks the resident memory over a measurement, so memory regressions
+ * are reported next to the latencies.
+ * The peak is the exact high water mark kept by the kernel, reset when
+ * tracking starts. Where it cannot be reset, the peak is the largest
+ * recorded sample.
+ * Sampling from a thread is avoided on purpose: a second thread makes
+ * the allocator lock, slowing every measured insert.
+ */
+class RssSampler {
+public:
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      The resident memory is sampled, its peak is reset if possible.
+     *
+     * Starts tracking the resident memory.
+     */
+    RssSampler(): exact_peak{resetPeakRss()} {
+        sample.before = sample.peak = readRss();
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      The current resident memory is added to the samples.
+     *
+     * Adds a sample of the resident memory, between repetitions.
+     */
+    inline void record() {
+        sample.samples.push_back(readRss());
+        sample.peak = std::max(sample.peak, sample.samples.back());
+    }
+
+    /*
+     * Pre-Conditions:
+     *      No code-related preconditions.
+     *
+     * Post-Conditions:
+     *      Returns the resident memory when tracking started,
+     *      at its peak since, now, & every recorded sample.
+     *
+     * Returns the resident memory before, at its peak & now.
+     */
+    [[nodiscard]] RssSample stop() const {
+        RssSample result = sample;
+
+        result.after = readRss();
+        result.peak = std::max(result.peak, result.after);
+
+        if (exact_peak) {
+            result.peak = std::max(result.peak, readPeakRss());
+        }
+
+        return result;
+    }
+
+private:
+    RssSample sample{};
+
+    /* True if the kernel's peak was reset when tracking started */
+    bool exact_peak;
+};
+
+/*
+ * Writes a single JSON document, pretty printed, one value per line.
+ * Commas & indentation are tracked, callers only open, write & close.
+ */
+class JsonWriter {
+public:
+    /*
+     * Pre-Conditions:
+     *      ostream reference to write to, outliving the writer.
+     *
+     * Post-Conditions:
+     *      A writer of a single JSON document is created.
+     *
+     * Creates a writer of a single JSON document.
+     */
+    explicit JsonWriter(std::ostream& out): out{out} {}
+
+    /*
+     * Pre-Conditions:
+     *      JsonWriter is initialized.
+     *      Name of the object inside an object, empty otherwise.
+     *
+     * Post-Conditions:
+     *      An object is opened.
+     *
+     * Opens an object, named if inside an object.
+     */
+    JsonWriter& beginObject(std::string_view key = {}) {
+        open(key, '{');
+
+        return *this;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      JsonWriter has an open object.
+     *
+     * Post-Conditions:
+     *      The innermost object is closed.
+     *
+     * Closes the innermost object.
+     */
+    JsonWriter& endObject() {
+        close('}');
+
+        return *this;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      JsonWriter is initialized.
+     *      Name of the array inside an object, empty otherwise.
+     *
+     * Post-Conditions:
+     *      An array is opened.
+     *
+     * Opens an array, named if inside an object.
+     */
+    JsonWriter& beginArray(std::string_view key = {}) {
+        open(key, '[');
+
+        return *this;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      JsonWriter has an open array.
+     *
+     * Post-Conditions:
+     *      The innermost array is closed.
+     *
+     * Closes the innermost array.
+     */
+    JsonWriter& endArray() {
+        close(']');
+
+        return *this;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      JsonWriter has an open object.
+     *      Name of the value.
+     *      String-like, bool or arithmetic value.
+     *
+     * Post-Conditions:
+     *      The named value is written.
+     *
+     * Writes a named value inside an object.
+     */
+    template<class T>
+    JsonWriter& field(std::string_view key, const T& data) {
+        separate();
+        string(key);
+        out << ": ";
+        scalar(data);
+
+        return *this;
+    }
+
+    /*
+     * Pre-Conditions:
+     *      JsonWriter has an open array.
+     *      String-like, bool or arithmetic value.
+     *
+     * Post-Conditions:
+     *      The value is written.
+     *
+     * Writes a value inside an array.
+     */
+    template<class T>
+    JsonWriter& value(const T& data) {
+        separate();
+        scalar(data);
+
+        return *this;
+    }
+
+private:
+    std::ostream& out;
+
+    /* Number of open objects & arrays */
+    int depth = 0;
+
+    /* True until the innermost object or array holds a value */
+    bool first = true;
+
+    /* Ends the previous value & indents the next one */
+    void separate() {
+        if (depth) {
+            out << (first ? "\n" : ",\n") << std::string(depth * 2, ' ');
+        }
+
+        first = false;
+    }
+
+    /* Writes the key, if any, & an opening bracket */
+    void open(std::string_view key, char bracket) {
+        separate();
+
+        if (not key.empty()) {
+            string(key);
+            out << ": ";
+        }
+
+        out << bracket;
+        depth++;
+        first = true;
+    }
+
+    /* Writes a closing bracket on its own line, unless empty */
+    void close(char bracket) {
+        depth--;
+
+        if (not first) {
+            out << '\n' << std::string(depth * 2, ' ');
+        }
+
+        out << bracket;
+        first = false;
+
+        if (not depth) {
+            out << '\n';
+        }
+    }
+
+    /* Writes a quoted, escaped string */
+    void string(std::string_view text) {
+        out << '"';
+
+        for (char c: text) {
+            if (c == '"' or c == '\\') {
+                out << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out << escaped;
+            } else {
+                out << c;
+            }
+        }
+
+        out << '"';
+    }
+
+    /* Writes a string, bool or number */
+    template<class T>
+    void scalar(const T& data) {
+        if constexpr (std::is_same_v<T, bool>) {
+            out << (data ? "true" : "false");
+        } else if constexpr (std::is_convertible_v<const T&,
+                                                   std::string_view>) {
+            string(data);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            out << std::setprecision(6) << std::fixed << data
+                << std::defaultfloat;
+        } else {
+            out << data;
+        }
+    }
+};
+
+#endif //URSTACK_BENCHHARNESS_H
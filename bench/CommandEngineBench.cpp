@@ -0,0 +1,181 @@
+/*
+ * URStack Project
+ *
+ *
+ * CommandEngineBench.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Throughput of CommandEngine<State> against a naive engine
+ *              dispatching through a pair of std::function per action.
+ *              Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+ *
+ * List of Functions:
+ *      template<class Body>
+ *      double measure(Body&&)
+ *          Returns the number of seconds taken by the given callable.
+ *
+ *      template<class Engine, size_t kCaptureBytes>
+ *      void run(const std::string&, int actions)
+ *          Executes, undoes & redoes the given number of actions,
+ *          displaying the throughput of every phase.
+ *
+ *      int main(int, char**)
+ *          Runs every benchmark.
+ */
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "../CommandEngine.cpp"
+
+
+using namespace std;
+
+/*
+ * Target state of the benchmarks.
+ */
+typedef long long Counter;
+
+/*
+ * Engine storing each action as a pair of std::function,
+ * the way callers re-implemented dispatch before CommandEngine.
+ */
+class NaiveEngine {
+public:
+    explicit NaiveEngine(int capacity): state{0}, history{capacity} {}
+
+    template<class Apply, class Revert>
+    void execute(Apply&& apply, Revert&& revert) {
+        apply(state);
+        history.insertNewAction(Action{std::forward<Apply>(apply),
+                                       std::forward<Revert>(revert)});
+    }
+
+    int undo(int count) {
+        return history.undo(count, [this](Action& action) {
+            action.revert(state);
+        });
+    }
+
+    int redo(int count) {
+        return history.redo(count, [this](Action& action) {
+            action.apply(state);
+        });
+    }
+
+    [[nodiscard]] const Counter& getState() const {
+        return state;
+    }
+
+private:
+    struct Action {
+        function<void(Counter&)> apply;
+        function<void(Counter&)> revert;
+    };
+
+    Counter state;
+    URStack<Action> history;
+};
+
+/*
+ * Adapts CommandEngine<Counter> to the interface of NaiveEngine.
+ */
+class SmallBufferEngine: public CommandEngine<Counter> {
+public:
+    explicit SmallBufferEngine(int capacity):
+            CommandEngine<Counter>(0, capacity) {}
+};
+
+/*
+ * Pre-Conditions:
+ *      Callable taking no arguments.
+ *
+ * Post-Conditions:
+ *      Returns the number of seconds taken by the given callable.
+ */
+template<class Body>
+double measure(Body&& body) {
+    const auto start = chrono::steady_clock::now();
+
+    body();
+
+    return chrono::duration<double>(chrono::steady_clock::now() - start)
+            .count();
+}
+
+/*
+ * Pre-Conditions:
+ *      Name of the engine.
+ *      Number of actions, also used as capacity.
+ *      Number of bytes captured by each callable, at least 8.
+ *
+ * Post-Conditions:
+ *      Displays the throughput of execute, undo(N) & redo(N).
+ */
+template<class Engine, size_t kCaptureBytes>
+void run(const string& name, int actions) {
+    Engine engine{actions};
+
+    /* Padding makes the capture exceed std::function's inline buffer */
+    array<char, kCaptureBytes - sizeof(Counter)> padding{};
+
+    const double executing = measure([&] {
+        for (int i = 0; i < actions; i++) {
+            const Counter delta = i & 7;
+
+            engine.execute([delta, padding](Counter& state) {
+                               state += delta + padding.size();
+                           },
+                           [delta, padding](Counter& state) {
+                               state -= delta + padding.size();
+                           });
+        }
+    });
+
+    const double undoing = measure([&] { engine.undo(actions); });
+    const double redoing = measure([&] { engine.redo(actions); });
+
+    auto rate = [actions](double seconds) {
+        return actions / seconds / 1e6;
+    };
+
+    cout << left << setw(24) << name
+         << setw(8) << kCaptureBytes
+         << fixed << setprecision(2)
+         << setw(14) << rate(executing)
+         << setw(14) << rate(undoing)
+         << setw(14) << rate(redoing)
+         << engine.getState() << '\n';
+}
+
+/*
+ * Pre-Conditions:
+ *      Optional number of actions as the first argument.
+ *
+ * Post-Conditions:
+ *      Displays the throughput in millions of actions per second.
+ */
+int main(int argc, char **argv) {
+    const int actions = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    cout << left << setw(24) << "engine"
+         << setw(8) << "bytes"
+         << setw(14) << "execute M/s"
+         << setw(14) << "undo M/s"
+         << setw(14) << "redo M/s"
+         << "state" << '\n';
+
+    run<NaiveEngine, 8>("std::function", actions);
+    run<SmallBufferEngine, 8>("CommandEngine", actions);
+    run<NaiveEngine, 24>("std::function", actions);
+    run<SmallBufferEngine, 24>("CommandEngine", actions);
+
+    return 0;
+}
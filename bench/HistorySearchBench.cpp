@@ -0,0 +1,377 @@
+/*
+ * URStack Project
+ *
+ *
+ * HistorySearchBench.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Benchmark of the history search of URStack<std::string>,
+ *              written as JSON so results of different builds can be
+ *              compared.
+ *              A history of --entries random strings is searched for a
+ *              text only its oldest action contains, so every search
+ *              scans the whole history:
+ *                  dump_find           displayAll to memory, then
+ *                                      std::string::find on the dump.
+ *                  find_last           findLast with std::string_view::find.
+ *                  find_last_containing
+ *                                      findLastContaining with every kernel
+ *                                      the CPU supports.
+ *              The kernels are also run alone over a single buffer of the
+ *              same bytes, as the upper bound of the search.
+ *              The same history is searched in an ArenaStringStack,
+ *                  arena_dump_find     as dump_find.
+ *                  arena_find_last_containing
+ *                                      findLastContaining with the default
+ *                                      kernel.
+ *              & the memory of both stacks is written.
+ *              Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+ *
+ *              Usage: URStackSearchBench [--entries N] [--length N]
+ *                                        [--repetitions N] [--output path]
+ *
+ * List of Functions:
+ *      std::string makeAction(std::uint64_t&, std::size_t)
+ *          Returns a random action of lowercase letters.
+ *
+ *      template<class Search>
+ *      void runSearch(const char*, const char*, Search&&, long long,
+ *                     long long, const Options&, JsonWriter&)
+ *          Runs & writes a single benchmark.
+ *
+ *      bool parseOptions(int, char**, Options&)
+ *          Parses the command line options.
+ *
+ *      int main(int, char**)
+ *          Runs every benchmark.
+ */
+
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../ArenaStringStack.h"
+#include "../StringSearch.h"
+#include "../URStack.cpp"
+#include "BenchHarness.h"
+
+
+using namespace std;
+
+/*
+ * Seed of the random actions.
+ */
+constexpr uint64_t kSeed = 0x5eed5eed5eed5eedULL;
+
+/*
+ * Text searched for, its '-' never appears in the random actions.
+ */
+constexpr string_view kNeedle = "needle-in-history";
+
+/*
+ * Every kernel benchmarked, those the CPU does not support are skipped.
+ */
+constexpr SearchKernel kKernels[] = {SearchKernel::kScalar,
+                                     SearchKernel::kSse2,
+                                     SearchKernel::kAvx2};
+
+/*
+ * Command line options.
+ */
+struct Options {
+    long long entries = 1000000;
+    long long length = 64;
+    int repetitions = 5;
+    string output;
+};
+
+/*
+ * Pre-Conditions:
+ *      Reference to the state of the generator.
+ *      Length of the action.
+ *
+ * Post-Conditions:
+ *      Returns a string of the given length, of random lowercase letters.
+ *      The state is advanced.
+ *
+ * Returns a random action of lowercase letters.
+ * Uses splitmix64, so actions are the same on every platform.
+ */
+string makeAction(uint64_t& state, size_t length) {
+    string action(length, 'a');
+
+    for (char& letter: action) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        letter = static_cast<char>('a' + (z ^ (z >> 31)) % 26);
+    }
+
+    return action;
+}
+
+/*
+ * Pre-Conditions:
+ *      Name of the benchmark.
+ *      Name of the kernel.
+ *      Callable running a single search, returning its result.
+ *      Expected result of every search.
+ *      Bytes scanned by every search.
+ *      const reference to the options.
+ *      Reference to the JSON writer, inside the results array.
+ *
+ * Post-Conditions:
+ *      The search is run --repetitions times, the time of every run,
+ *      its throughput & whether its results were correct are written.
+ *
+ * Runs & writes a single benchmark.
+ */
+template<class Search>
+void runSearch(const char *name, const char *kernel, Search&& search,
+               long long expected, long long bytes, const Options& options,
+               JsonWriter& json) {
+    vector<double> milliseconds;
+    bool correct = true;
+
+    for (int r = 0; r < options.repetitions; r++) {
+        Stopwatch watch;
+
+        watch.start();
+        const long long found = search();
+        watch.stop();
+
+        correct = correct and found == expected;
+        milliseconds.push_back(watch.getSeconds() * 1e3);
+    }
+
+    const Summary summary = summarize(milliseconds);
+    const double gigabytes_per_second = bytes / (summary.median * 1e6);
+
+    json.beginObject()
+        .field("benchmark", name)
+        .field("kernel", kernel)
+        .field("correct", correct)
+        .field("bytes", bytes)
+        .beginObject("ms_per_search")
+        .field("min", summary.min)
+        .field("median", summary.median)
+        .field("max", summary.max)
+        .endObject()
+        .field("gb_per_second", gigabytes_per_second)
+        .endObject();
+
+    cerr << name << '/' << kernel << ": " << summary.median << " ms, "
+         << gigabytes_per_second << " GB/s"
+         << (correct ? "\n" : ", WRONG RESULT\n");
+}
+
+/*
+ * Pre-Conditions:
+ *      Command line arguments.
+ *      Reference to the parsed options.
+ *
+ * Post-Conditions:
+ *      The options are parsed into the given reference.
+ *      Returns false, after displaying the usage, if any is invalid.
+ *
+ * Parses the command line options.
+ */
+bool parseOptions(int argc, char **argv, Options& options) {
+    for (int i = 1; i < argc; i += 2) {
+        const string_view option = argv[i];
+        const string_view argument = i + 1 < argc ? argv[i + 1] : "";
+
+        long long number = 0;
+        const bool positive =
+                parseNumber(argument, number) == ParseStatus::kOk
+                and number > 0;
+
+        if (i + 1 == argc) {
+            /* Every option takes an argument */
+        } else if (option == "--entries" and positive
+                   and number <= INT_MAX) {
+            options.entries = number;
+            continue;
+        } else if (option == "--length" and positive
+                   and number >= static_cast<long long>(kNeedle.size())) {
+            options.length = number;
+            continue;
+        } else if (option == "--repetitions" and positive
+                   and number <= 1000) {
+            options.repetitions = static_cast<int>(number);
+            continue;
+        } else if (option == "--output") {
+            options.output = argument;
+            continue;
+        }
+
+        cerr << "Usage: " << argv[0]
+             << " [--entries N] [--length N] [--repetitions N]"
+                " [--output path]\n";
+
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      Options described in parseOptions.
+ *
+ * Post-Conditions:
+ *      The results are written as JSON to --output, or to stdout.
+ *      Progress is displayed to stderr.
+ */
+int main(int argc, char **argv) {
+    Options options;
+
+    if (not parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    ofstream file;
+
+    if (not options.output.empty()) {
+        file.open(options.output, ios::trunc);
+
+        if (not file) {
+            cerr << "Cannot open " << options.output << '\n';
+            return 1;
+        }
+    }
+
+    const int entries = static_cast<int>(options.entries);
+    const auto length = static_cast<size_t>(options.length);
+
+    /* Only the oldest action, entries - 1 undos away, contains kNeedle */
+    URStack<string> stack(entries);
+    ArenaStringStack arena(entries);
+    string haystack;
+    string oldest;
+    uint64_t state = kSeed;
+
+    haystack.reserve(static_cast<size_t>(entries) * length);
+
+    for (int i = 0; i < entries; i++) {
+        string action = makeAction(state, length);
+
+        if (i == 0) {
+            action.replace(length - kNeedle.size(), kNeedle.size(), kNeedle);
+            oldest = action;
+        } else {
+            haystack += action;
+        }
+
+        arena.insertNewAction(action);
+        stack.insertNewAction(std::move(action));
+    }
+
+    /* The buffer is in search order, kNeedle at its very end */
+    haystack += oldest;
+
+    const long long bytes = static_cast<long long>(haystack.size());
+    const long long position = entries - 1;
+
+    JsonWriter json{file.is_open() ? file : cout};
+
+    json.beginObject()
+        .field("suite", "URStackSearch")
+        .beginObject("build")
+        .field("compiler", __VERSION__)
+        .field("cxx_standard", static_cast<long long>(__cplusplus))
+#ifdef NDEBUG
+        .field("assertions", false)
+#else
+        .field("assertions", true)
+#endif
+        .field("default_kernel", getName(getSearchKernel()))
+        .endObject()
+        .beginObject("options")
+        .field("entries", options.entries)
+        .field("length", options.length)
+        .field("repetitions", options.repetitions)
+        .field("seed", kSeed)
+        .field("needle", kNeedle)
+        .endObject()
+        .beginArray("results");
+
+    /* The dump holds a space after every action */
+    runSearch("dump_find", "scalar", [&stack]() {
+        ostringstream dump;
+
+        {
+            OutputSink sink{dump, false};
+
+            stack.displayAll(sink);
+            sink.flush();
+        }
+
+        return dump.str().find(kNeedle) == string::npos ? -1LL : 0LL;
+    }, 0, bytes, options, json);
+
+    runSearch("find_last", "scalar", [&stack]() {
+        return stack.findLast([](const string& action) {
+            return string_view{action}.find(kNeedle) != string_view::npos;
+        });
+    }, position, bytes, options, json);
+
+    for (SearchKernel kernel: kKernels) {
+        if (not isSupported(kernel)) {
+            continue;
+        }
+
+        runSearch("find_last_containing", getName(kernel),
+                  [&stack, kernel]() {
+            return stack.findLast([kernel](const string& action) {
+                return findSubstring(action, kNeedle, kernel)
+                       != string_view::npos;
+            });
+        }, position, bytes, options, json);
+
+        runSearch("buffer", getName(kernel), [&haystack, kernel]() {
+            return static_cast<long long>(
+                    findSubstring(haystack, kNeedle, kernel));
+        }, bytes - static_cast<long long>(kNeedle.size()), bytes, options,
+                  json);
+    }
+
+    runSearch("find_last_containing", "default", [&stack]() {
+        return stack.findLastContaining(kNeedle);
+    }, position, bytes, options, json);
+
+    runSearch("arena_dump_find", "scalar", [&arena]() {
+        ostringstream dump;
+
+        {
+            OutputSink sink{dump, false};
+
+            arena.displayAll(sink);
+            sink.flush();
+        }
+
+        return dump.str().find(kNeedle) == string::npos ? -1LL : 0LL;
+    }, 0, bytes, options, json);
+
+    runSearch("arena_find_last_containing", "default", [&arena]() {
+        return arena.findLastContaining(kNeedle);
+    }, position, bytes, options, json);
+
+    json.endArray()
+        .beginObject("memory_bytes")
+        .field("urstack", stack.memoryUsage().getTotalBytes())
+        .field("arena", arena.memoryUsage().getTotalBytes())
+        .endObject()
+        .endObject();
+
+    return 0;
+}
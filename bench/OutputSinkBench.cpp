@@ -0,0 +1,160 @@
+/*
+ * URStack Project
+ *
+ *
+ * OutputSinkBench.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Cost of displayAll on a large URStack, through OutputSink
+ *              with & without colours, against the former per-value
+ *              coloured display.
+ *              Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+ *
+ * List of Functions:
+ *      template<class Body>
+ *      double measure(Body&&)
+ *          Returns the number of seconds taken by the given callable.
+ *
+ *      template<class T>
+ *      void displayPerValue(const URStack<T>&, std::ostream&)
+ *          Displays every action the way displayDirectional used to.
+ *
+ *      template<class T>
+ *      void run(const std::string&, const URStack<T>&, std::ostream&)
+ *          Displays the given stack in every mode & reports the cost.
+ *
+ *      int main(int, char**)
+ *          Runs every benchmark.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "../URStack.cpp"
+
+
+using namespace std;
+
+/*
+ * Pre-Conditions:
+ *      Callable taking no arguments.
+ *
+ * Post-Conditions:
+ *      Returns the number of seconds taken by the given callable.
+ */
+template<class Body>
+double measure(Body&& body) {
+    const auto start = chrono::steady_clock::now();
+
+    body();
+
+    return chrono::duration<double>(chrono::steady_clock::now() - start)
+            .count();
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to a URStack.
+ *      ostream reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays every action, each value & separator wrapped in its own
+ *      colour codes & written straight to the ostream.
+ *
+ * Displays every action the way displayDirectional used to.
+ * Iterative, the recursion would overflow the call stack at this size.
+ */
+template<class T>
+void displayPerValue(const URStack<T>& stack, ostream& out) {
+    bool first = true;
+
+    stack.visitPrevious([&](const T& action) {
+        if (not first) {
+            display(", ", out);
+        }
+
+        display(action, out);
+        first = false;
+    });
+
+    out << endl;
+}
+
+/*
+ * Pre-Conditions:
+ *      Name of the stack.
+ *      const reference to the stack.
+ *      ostream reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays the time & bytes taken by each mode.
+ */
+template<class T>
+void run(const string& name, const URStack<T>& stack, ostream& out) {
+    auto report = [&](const string& mode, double seconds,
+                      streamoff bytes) {
+        cout << left << setw(10) << name
+             << setw(20) << mode
+             << fixed << setprecision(2)
+             << setw(12) << seconds * 1e3
+             << bytes / 1e6 << '\n';
+    };
+
+    streamoff start = out.tellp();
+    double seconds = measure([&] { displayPerValue(stack, out); });
+
+    report("per-value colour", seconds, out.tellp() - start);
+
+    for (bool coloured: {true, false}) {
+        start = out.tellp();
+        seconds = measure([&] {
+            OutputSink sink{out, coloured};
+
+            stack.displayAll(sink) << '\n';
+            sink.flush();
+        });
+
+        report(coloured ? "sink colour" : "sink plain", seconds,
+               out.tellp() - start);
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      Optional number of actions as the first argument.
+ *      Optional output path as the second argument, a scratch file
+ *      by default, so the written bytes can be counted.
+ *
+ * Post-Conditions:
+ *      Displays the milliseconds & megabytes taken by displayAll.
+ */
+int main(int argc, char **argv) {
+    const int actions = argc > 1 ? stoi(argv[1]) : 1000000;
+    const string path = argc > 2 ? argv[2] : "URStackOutputBench.txt";
+
+    ofstream out{path, ios::binary | ios::trunc};
+
+    URStack<int> numbers{actions};
+    URStack<string> strings{actions};
+
+    for (int i = 0; i < actions; i++) {
+        numbers.insertNewAction(i);
+        strings.insertNewAction("action " + to_string(i));
+    }
+
+    cout << left << setw(10) << "stack"
+         << setw(20) << "mode"
+         << setw(12) << "ms"
+         << "MB" << '\n';
+
+    run("int", numbers, out);
+    run("string", strings, out);
+
+    return 0;
+}
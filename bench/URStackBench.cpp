@@ -0,0 +1,886 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackBench.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Benchmark suite of the URStack operations, written as JSON
+ *              so results of different builds can be compared.
+ *              Every benchmark is run for int, small string & large string
+ *              payloads, at capacities from 20 to 10M.
+ *              The work of every benchmark depends only on its capacity &
+ *              the options, never on timing, so runs are reproducible.
+ *              The resident memory is tracked during every benchmark, &
+ *              the exact memory of a stack is reported per capacity.
+ *              Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+ *
+ *              Usage: URStackBench [--repetitions N] [--operations N]
+ *                                  [--max-capacity N] [--max-bytes N]
+ *                                  [--filter text] [--output path]
+ *
+ * List of Functions:
+ *      template<class T>
+ *      std::vector<T> makePool(Payload)
+ *          Returns the actions inserted by the benchmarks.
+ *
+ *      template<class T>
+ *      long long estimateEntryBytes(const T&)
+ *          Returns the approximate memory taken by a single action.
+ *
+ *      long long boundedOperations(int, const Options&)
+ *          Returns the number of operations of a benchmark whose
+ *          operations may walk the whole stack.
+ *
+ *      template<class T>
+ *      void fill(std::vector<URStack<T>>&, const std::vector<T>&, int, int)
+ *          Creates the given number of stacks, each filled to capacity.
+ *
+ *      template<class T>
+ *      Measurement insertBelowCapacity(const std::vector<T>&, int,
+ *                                      const Options&)
+ *          Measures insertNewAction into stacks that are not full.
+ *
+ *      template<class T>
+ *      Measurement insertAtCapacity(const std::vector<T>&, int,
+ *                                   const Options&)
+ *          Measures insertNewAction into a full stack.
+ *
+ *      template<class T>
+ *      Measurement undoAll(const std::vector<T>&, int, const Options&)
+ *          Measures undo on full stacks, until they are empty.
+ *
+ *      template<class T>
+ *      Measurement redoAll(const std::vector<T>&, int, const Options&)
+ *          Measures redo on fully undone stacks.
+ *
+ *      template<class T>
+ *      Measurement mixed(const std::vector<T>&, int, const Options&)
+ *          Measures a seeded mix of inserts, undos & redos.
+ *
+ *      template<class T>
+ *      Measurement displayAll(const std::vector<T>&, int, const Options&)
+ *          Measures displayAll of full stacks.
+ *
+ *      template<class T>
+ *      Measurement destroy(const std::vector<T>&, int, const Options&)
+ *          Measures the destruction of full stacks.
+ *
+ *      template<class T>
+ *      MemoryUsage measureMemory(const std::vector<T>&, int)
+ *          Returns the memory of a full stack, half of it undone.
+ *
+ *      void writeMemory(const MemoryUsage&, JsonWriter&)
+ *          Writes the memory of a stack.
+ *
+ *      template<class T>
+ *      void runPayload(Payload, const Options&, JsonWriter&)
+ *          Runs every benchmark for a payload, writing its results.
+ *
+ *      bool parseOptions(int, char**, Options&)
+ *          Parses the command line options.
+ *
+ *      int main(int, char**)
+ *          Runs every benchmark.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../URStack.cpp"
+#include "BenchHarness.h"
+
+
+using namespace std;
+
+/*
+ * Capacities every benchmark is run at.
+ */
+const vector<int> kCapacities{20, 1000, 100000, 1000000, 10000000};
+
+/*
+ * Number of distinct actions inserted, a power of 2.
+ */
+constexpr size_t kPoolSize = 1 << 12;
+
+/*
+ * Actions held at once by benchmarks of small stacks, so the clock is
+ * read once per batch of stacks rather than once per stack.
+ */
+constexpr long long kBatchEntries = 1 << 16;
+
+/*
+ * Node hops allowed to benchmarks whose operations walk the stack,
+ * bounds insertNewAction at capacity & redo to a few seconds.
+ */
+constexpr long long kWalkBudget = 20000000;
+
+/*
+ * Seed of the mixed workload.
+ */
+constexpr uint64_t kSeed = 0x5eed5eed5eed5eedULL;
+
+/*
+ * Size of a large string action.
+ */
+constexpr size_t kLargeBytes = 1024;
+
+/*
+ * Kinds of actions benchmarked.
+ */
+enum class Payload {
+    kInt,           /* int */
+    kSmallString,   /* string short enough to be stored inline */
+    kLargeString    /* string of kLargeBytes, always on the heap */
+};
+
+/*
+ * Command line options.
+ */
+struct Options {
+    int repetitions = 3;
+    long long operations = 1000000;
+    long long max_capacity = 10000000;
+    long long max_bytes = 1LL << 30;
+    string filter;
+    string output;
+};
+
+/*
+ * Result of a single run of a benchmark.
+ */
+struct Measurement {
+    double seconds;
+    long long operations;
+
+    /* Bytes written, displayAll only */
+    long long bytes = 0;
+};
+
+/*
+ * Pre-Conditions:
+ *      A payload.
+ *
+ * Post-Conditions:
+ *      Returns the name of the payload.
+ */
+const char* getName(Payload payload) {
+    switch (payload) {
+        case Payload::kInt:
+            return "int";
+        case Payload::kSmallString:
+            return "small_string";
+        default:
+            return "large_string";
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      Payload matching T, int or string.
+ *
+ * Post-Conditions:
+ *      Returns kPoolSize distinct actions, the same on every run.
+ *
+ * Returns the actions inserted by the benchmarks.
+ * Inserts copy them, as a caller keeping its own copy would.
+ */
+template<class T>
+vector<T> makePool(Payload payload) {
+    vector<T> pool;
+    pool.reserve(kPoolSize);
+
+    for (size_t i = 0; i < kPoolSize; i++) {
+        if constexpr (is_same_v<T, int>) {
+            pool.push_back(static_cast<int>(i * 2654435761U));
+        } else if (payload == Payload::kSmallString) {
+            pool.push_back("action " + to_string(i));
+        } else {
+            T action(kLargeBytes, static_cast<char>('a' + i % 26));
+            action.replace(0, 8, to_string(i + 10000000));
+            pool.push_back(std::move(action));
+        }
+    }
+
+    return pool;
+}
+
+/*
+ * Pre-Conditions:
+ *      A representative action.
+ *
+ * Post-Conditions:
+ *      Returns the approximate bytes taken by a Node holding it,
+ *      including allocator overhead & the string's own buffer.
+ *
+ * Returns the approximate memory taken by a single action.
+ * Used to skip benchmarks that would not fit in --max-bytes.
+ */
+template<class T>
+long long estimateEntryBytes(const T& action) {
+    constexpr long long kOverhead = 16;
+    auto rounded = [](long long bytes) { return (bytes + 15) / 16 * 16; };
+
+    long long bytes = rounded(sizeof(T) + sizeof(void*)) + kOverhead;
+
+    if constexpr (is_same_v<T, string>) {
+        if (action.capacity() > 15) {
+            bytes += rounded(action.capacity() + 1) + kOverhead;
+        }
+    }
+
+    return bytes;
+}
+
+/*
+ * Pre-Conditions:
+ *      Capacity of the benchmarked stacks.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Returns --operations, lowered so that operations walking the
+ *      whole stack stay within kWalkBudget hops, at least 16.
+ *
+ * Returns the number of operations of a benchmark whose
+ * operations may walk the whole stack.
+ */
+long long boundedOperations(int capacity, const Options& options) {
+    return max(16LL, min(options.operations, kWalkBudget / capacity));
+}
+
+/*
+ * Pre-Conditions:
+ *      Capacity of the benchmarked stacks.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Returns --operations rounded up to whole stacks,
+ *      at least one full stack.
+ */
+long long filledOperations(int capacity, const Options& options) {
+    return max(1LL, (options.operations + capacity - 1) / capacity)
+           * capacity;
+}
+
+/*
+ * Pre-Conditions:
+ *      Capacity of the benchmarked stacks.
+ *
+ * Post-Conditions:
+ *      Returns the number of full stacks held at once.
+ */
+int getBatchStacks(int capacity) {
+    return static_cast<int>(max(1LL, kBatchEntries / capacity));
+}
+
+/*
+ * Pre-Conditions:
+ *      Reference to the stacks to append to.
+ *      const reference to the actions.
+ *      Capacity of the stacks.
+ *      Number of stacks to create.
+ *
+ * Post-Conditions:
+ *      The given number of stacks, each filled to capacity, are appended.
+ *
+ * Creates the given number of stacks, each filled to capacity.
+ */
+template<class T>
+void fill(vector<URStack<T>>& stacks, const vector<T>& pool,
+          int capacity, int count) {
+    for (int s = 0; s < count; s++) {
+        URStack<T>& stack = stacks.emplace_back(capacity);
+
+        for (int i = 0; i < capacity; i++) {
+            stack.insertNewAction(pool[i & (kPoolSize - 1)]);
+        }
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the actions.
+ *      Capacity of the stacks.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Returns the time taken to create & fill stacks to capacity,
+ *      never evicting.
+ *
+ * Measures insertNewAction into stacks that are not full.
+ * The stacks are destroyed after every batch, outside the measurement.
+ */
+template<class T>
+Measurement insertBelowCapacity(const vector<T>& pool, int capacity,
+                                const Options& options) {
+    const long long operations = filledOperations(capacity, options);
+    const int batch = getBatchStacks(capacity);
+
+    Stopwatch watch;
+    vector<URStack<T>> stacks;
+    stacks.reserve(batch);
+
+    for (long long done = 0; done < operations; stacks.clear()) {
+        const int count = static_cast<int>(
+                min<long long>(batch, (operations - done) / capacity));
+
+        watch.start();
+        fill(stacks, pool, capacity, count);
+        watch.stop();
+
+        done += static_cast<long long>(count) * capacity;
+    }
+
+    return {watch.getSeconds(), operations};
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the actions.
+ *      Capacity of the stack.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Returns the time taken by inserts, each evicting the oldest action.
+ *
+ * Measures insertNewAction into a full stack.
+ */
+template<class T>
+Measurement insertAtCapacity(const vector<T>& pool, int capacity,
+                             const Options& options) {
+    const long long operations = boundedOperations(capacity, options);
+
+    Stopwatch watch;
+    vector<URStack<T>> stacks;
+    fill(stacks, pool, capacity, 1);
+
+    URStack<T>& stack = stacks.front();
+
+    watch.start();
+
+    for (long long i = 0; i < operations; i++) {
+        stack.insertNewAction(pool[(capacity + i) & (kPoolSize - 1)]);
+    }
+
+    watch.stop();
+
+    return {watch.getSeconds(), operations};
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the actions.
+ *      Capacity of the stacks.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Returns the time taken to undo every action of full stacks,
+ *      one call each.
+ *
+ * Measures undo on full stacks, until they are empty.
+ */
+template<class T>
+Measurement undoAll(const vector<T>& pool, int capacity,
+                    const Options& options) {
+    const long long operations = filledOperations(capacity, options);
+    const int batch = getBatchStacks(capacity);
+
+    Stopwatch watch;
+    vector<URStack<T>> stacks;
+    stacks.reserve(batch);
+
+    for (long long done = 0; done < operations; stacks.clear()) {
+        const int count = static_cast<int>(
+                min<long long>(batch, (operations - done) / capacity));
+
+        fill(stacks, pool, capacity, count);
+
+        watch.start();
+
+        for (URStack<T>& stack: stacks) {
+            while (stack.undo()) {}
+        }
+
+        watch.stop();
+
+        done += static_cast<long long>(count) * capacity;
+    }
+
+    return {watch.getSeconds(), operations};
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the actions.
+ *      Capacity of the stacks.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Returns the time taken to redo actions of fully undone stacks,
+ *      one call each, oldest first.
+ *
+ * Measures redo on fully undone stacks.
+ * Each redo walks from the newest action down to the current one.
+ */
+template<class T>
+Measurement redoAll(const vector<T>& pool, int capacity,
+                    const Options& options) {
+    const long long operations = boundedOperations(capacity, options);
+    const int batch = getBatchStacks(capacity);
+
+    Stopwatch watch;
+    vector<URStack<T>> stacks;
+    stacks.reserve(batch);
+
+    for (long long done = 0; done < operations; stacks.clear()) {
+        const int count = static_cast<int>(min<long long>(
+                batch, (operations - done + capacity - 1) / capacity));
+
+        fill(stacks, pool, capacity, count);
+
+        for (URStack<T>& stack: stacks) {
+            while (stack.undo()) {}
+        }
+
+        watch.start();
+
+        for (URStack<T>& stack: stacks) {
+            for (int i = 0; i < capacity and done < operations; i++) {
+                stack.redo();
+                done++;
+            }
+        }
+
+        watch.stop();
+    }
+
+    return {watch.getSeconds(), operations};
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the actions.
+ *      Capacity of the stack.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Returns the time taken by a seeded sequence of operations on a
+ *      full stack, 50% inserts, 30% undos & 20% redos.
+ *
+ * Measures a seeded mix of inserts, undos & redos.
+ * The sequence depends only on kSeed.
+ */
+template<class T>
+Measurement mixed(const vector<T>& pool, int capacity,
+                  const Options& options) {
+    const long long operations = boundedOperations(capacity, options);
+
+    Stopwatch watch;
+    vector<URStack<T>> stacks;
+    fill(stacks, pool, capacity, 1);
+
+    URStack<T>& stack = stacks.front();
+    uint64_t state = kSeed;
+
+    watch.start();
+
+    for (long long i = 0; i < operations; i++) {
+        /* xorshift64, cheap enough not to be measured */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        const int roll = static_cast<int>(state % 10);
+
+        if (roll < 5) {
+            stack.insertNewAction(pool[i & (kPoolSize - 1)]);
+        } else if (roll < 8) {
+            stack.undo();
+        } else {
+            stack.redo();
+        }
+    }
+
+    watch.stop();
+
+    return {watch.getSeconds(), operations};
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the actions.
+ *      Capacity of the stacks.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Returns the time taken to display every action of full stacks,
+ *      without colours, to a discarding ostream.
+ *
+ * Measures displayAll of full stacks.
+ */
+template<class T>
+Measurement displayAll(const vector<T>& pool, int capacity,
+                       const Options& options) {
+    const long long operations = filledOperations(capacity, options);
+    const int batch = getBatchStacks(capacity);
+
+    Stopwatch watch;
+    NullStream out;
+    vector<URStack<T>> stacks;
+    stacks.reserve(batch);
+
+    for (long long done = 0; done < operations; stacks.clear()) {
+        const int count = static_cast<int>(
+                min<long long>(batch, (operations - done) / capacity));
+
+        fill(stacks, pool, capacity, count);
+
+        watch.start();
+
+        {
+            OutputSink sink{out, false};
+
+            for (const URStack<T>& stack: stacks) {
+                stack.displayAll(sink) << '\n';
+            }
+
+            sink.flush();
+        }
+
+        watch.stop();
+
+        done += static_cast<long long>(count) * capacity;
+    }
+
+    return {watch.getSeconds(), operations, out.getBytes()};
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the actions.
+ *      Capacity of the stacks.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Returns the time taken to destroy full stacks.
+ *
+ * Measures the destruction of full stacks.
+ */
+template<class T>
+Measurement destroy(const vector<T>& pool, int capacity,
+                    const Options& options) {
+    const long long operations = filledOperations(capacity, options);
+    const int batch = getBatchStacks(capacity);
+
+    Stopwatch watch;
+    vector<URStack<T>> stacks;
+    stacks.reserve(batch);
+
+    for (long long done = 0; done < operations;) {
+        const int count = static_cast<int>(
+                min<long long>(batch, (operations - done) / capacity));
+
+        fill(stacks, pool, capacity, count);
+
+        watch.start();
+        stacks.clear();
+        watch.stop();
+
+        done += static_cast<long long>(count) * capacity;
+    }
+
+    return {watch.getSeconds(), operations};
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the actions.
+ *      Capacity of the stack.
+ *
+ * Post-Conditions:
+ *      Returns the exact memory of a full stack with half of its actions
+ *      undone, so the redo share is reported as well.
+ *
+ * Returns the memory of a full stack, half of it undone.
+ */
+template<class T>
+MemoryUsage measureMemory(const vector<T>& pool, int capacity) {
+    vector<URStack<T>> stacks;
+    fill(stacks, pool, capacity, 1);
+
+    URStack<T>& stack = stacks.front();
+
+    for (int i = 0; i < capacity / 2; i++) {
+        stack.undo();
+    }
+
+    return stack.memoryUsage();
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the memory of a stack.
+ *      Reference to the writer, inside an object.
+ *
+ * Post-Conditions:
+ *      The memory is written as a "memory_usage" object.
+ *
+ * Writes the memory of a stack.
+ */
+void writeMemory(const MemoryUsage& usage, JsonWriter& json) {
+    json.beginObject("memory_usage")
+        .field("nodes", usage.nodes)
+        .field("object_bytes", usage.object_bytes)
+        .field("node_bytes", usage.node_bytes)
+        .field("payload_bytes", usage.payload_bytes)
+        .field("redo_nodes", usage.redo_nodes)
+        .field("redo_bytes", usage.redo_bytes)
+        .field("pooled_bytes", usage.pooled_bytes)
+        .field("total_bytes", usage.getTotalBytes())
+        .endObject();
+}
+
+/*
+ * Pre-Conditions:
+ *      Payload matching T.
+ *      const reference to the options.
+ *      Reference to the writer, inside the results array.
+ *
+ * Post-Conditions:
+ *      Every benchmark matching --filter is run --repetitions times for
+ *      every capacity up to --max-capacity, its nanoseconds per operation
+ *      are written with the resident memory while they ran.
+ *      The exact memory of a stack is written per capacity, as the
+ *      memory_usage benchmark. Benchmarks exceeding --max-bytes are
+ *      written as skipped.
+ *
+ * Runs every benchmark for a payload, writing its results.
+ */
+template<class T>
+void runPayload(Payload payload, const Options& options, JsonWriter& json) {
+    typedef Measurement (*Benchmark)(const vector<T>&, int, const Options&);
+
+    const pair<const char*, Benchmark> benchmarks[] = {
+            {"insert_below_capacity", insertBelowCapacity<T>},
+            {"insert_at_capacity", insertAtCapacity<T>},
+            {"undo", undoAll<T>},
+            {"redo", redoAll<T>},
+            {"mixed", mixed<T>},
+            {"display_all", displayAll<T>},
+            {"destroy", destroy<T>},
+    };
+
+    const vector<T> pool = makePool<T>(payload);
+    const long long entry_bytes = estimateEntryBytes(pool.back());
+
+    for (int capacity: kCapacities) {
+        if (capacity > options.max_capacity) {
+            continue;
+        }
+
+        /* Batches of small stacks hold up to kBatchEntries */
+        const long long bytes = entry_bytes
+                                * max<long long>(capacity, kBatchEntries);
+
+        /* The memory_usage entry has no Benchmark, it is not timed */
+        for (size_t b = 0; b <= size(benchmarks); b++) {
+            const bool timed = b < size(benchmarks);
+            const char *name = timed ? benchmarks[b].first : "memory_usage";
+            const string id = string(name) + '/' + getName(payload)
+                              + '/' + to_string(capacity);
+
+            if (id.find(options.filter) == string::npos) {
+                continue;
+            }
+
+            json.beginObject()
+                .field("benchmark", name)
+                .field("payload", getName(payload))
+                .field("capacity", capacity);
+
+            if (bytes > options.max_bytes) {
+                json.field("skipped", true)
+                    .field("estimated_bytes", bytes)
+                    .endObject();
+                cerr << id << ": skipped, about " << bytes / (1 << 20)
+                     << " MiB\n";
+                continue;
+            }
+
+            if (not timed) {
+                const MemoryUsage usage = measureMemory(pool, capacity);
+
+                json.field("skipped", false);
+                writeMemory(usage, json);
+                json.endObject();
+
+                cerr << id << ": " << usage.getTotalBytes() << " bytes\n";
+                continue;
+            }
+
+            vector<double> nanoseconds;
+            Measurement measurement{};
+            RssSampler sampler;
+
+            for (int r = 0; r < options.repetitions; r++) {
+                measurement = benchmarks[b].second(pool, capacity, options);
+                nanoseconds.push_back(measurement.seconds * 1e9
+                                      / measurement.operations);
+                sampler.record();
+            }
+
+            const RssSample rss = sampler.stop();
+            const Summary summary = summarize(nanoseconds);
+
+            json.field("skipped", false)
+                .field("operations", measurement.operations)
+                .field("repetitions", options.repetitions);
+
+            if (measurement.bytes) {
+                json.field("bytes", measurement.bytes);
+            }
+
+            json.beginObject("ns_per_op")
+                .field("min", summary.min)
+                .field("median", summary.median)
+                .field("max", summary.max)
+                .endObject()
+                .beginObject("rss_bytes")
+                .field("before", rss.before)
+                .field("peak", rss.peak)
+                .field("after", rss.after)
+                .beginArray("samples");
+
+            for (long long resident: rss.samples) {
+                json.value(resident);
+            }
+
+            json.endArray()
+                .endObject()
+                .endObject();
+
+            cerr << id << ": " << summary.median << " ns/op\n";
+        }
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      Command line arguments.
+ *      Reference to the parsed options.
+ *
+ * Post-Conditions:
+ *      The options are parsed into the given reference.
+ *      Returns false, after displaying the usage, if any is invalid.
+ *
+ * Parses the command line options.
+ */
+bool parseOptions(int argc, char **argv, Options& options) {
+    for (int i = 1; i < argc; i += 2) {
+        const string_view option = argv[i];
+        const string_view argument = i + 1 < argc ? argv[i + 1] : "";
+
+        long long number = 0;
+        const bool positive =
+                parseNumber(argument, number) == ParseStatus::kOk
+                and number > 0;
+
+        if (i + 1 == argc) {
+            /* Every option takes an argument */
+        } else if (option == "--repetitions" and positive
+                   and number <= 1000) {
+            options.repetitions = static_cast<int>(number);
+            continue;
+        } else if (option == "--operations" and positive) {
+            options.operations = number;
+            continue;
+        } else if (option == "--max-capacity" and positive) {
+            options.max_capacity = number;
+            continue;
+        } else if (option == "--max-bytes" and positive) {
+            options.max_bytes = number;
+            continue;
+        } else if (option == "--filter") {
+            options.filter = argument;
+            continue;
+        } else if (option == "--output") {
+            options.output = argument;
+            continue;
+        }
+
+        cerr << "Usage: " << argv[0]
+             << " [--repetitions N] [--operations N] [--max-capacity N]"
+                " [--max-bytes N] [--filter text] [--output path]\n";
+
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      Options described in parseOptions.
+ *
+ * Post-Conditions:
+ *      The results are written as JSON to --output, or to stdout.
+ *      Progress is displayed to stderr.
+ */
+int main(int argc, char **argv) {
+    Options options;
+
+    if (not parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    ofstream file;
+
+    if (not options.output.empty()) {
+        file.open(options.output, ios::trunc);
+
+        if (not file) {
+            cerr << "Cannot open " << options.output << '\n';
+            return 1;
+        }
+    }
+
+    JsonWriter json{file.is_open() ? file : cout};
+
+    json.beginObject()
+        .field("suite", "URStack")
+        .beginObject("build")
+        .field("compiler", __VERSION__)
+        .field("cxx_standard", static_cast<long long>(__cplusplus))
+#ifdef NDEBUG
+        .field("assertions", false)
+#else
+        .field("assertions", true)
+#endif
+        .endObject()
+        .beginObject("options")
+        .field("repetitions", options.repetitions)
+        .field("operations", options.operations)
+        .field("max_capacity", options.max_capacity)
+        .field("max_bytes", options.max_bytes)
+        .field("filter", options.filter)
+        .field("seed", kSeed)
+        .field("large_string_bytes", static_cast<long long>(kLargeBytes))
+        .endObject()
+        .beginArray("results");
+
+    runPayload<int>(Payload::kInt, options, json);
+    runPayload<string>(Payload::kSmallString, options, json);
+    runPayload<string>(Payload::kLargeString, options, json);
+
+    json.endArray().endObject();
+
+    return 0;
+}
@@ -0,0 +1,546 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackReplay.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Generator of synthetic workload traces & deterministic
+ *              replayer of traces, recorded or generated, against URStack.
+ *              Replays report the throughput & the latency percentiles of
+ *              every operation as JSON, so backends & builds can be compared
+ *              on the same workload.
+ *              A trace holds the sizes of the actions, not their contents,
+ *              every action is replayed as a string of its recorded size,
+ *              or as an int by the int backend.
+ *              Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+ *
+ *              Usage: URStackReplay generate <trace> [--events N]
+ *                                   [--sessions N] [--zipf X] [--inserts X]
+ *                                   [--undos X] [--redos X] [--burst X]
+ *                                   [--min-payload N] [--max-payload N]
+ *                                   [--capacity N] [--mean-delay X]
+ *                                   [--seed N]
+ *                     URStackReplay replay <trace> [--backend string|int]
+ *                                   [--capacity N] [--repetitions N]
+ *                                   [--paced] [--output path]
+ *
+ * List of Functions:
+ *      template<class T>
+ *      T makeAction(std::uint64_t)
+ *          Returns an action of the given size.
+ *
+ *      int toCapacity(std::uint64_t)
+ *          Returns a recorded capacity as a valid URStack capacity.
+ *
+ *      template<class T>
+ *      Replay replay(const std::vector<TraceEvent>&, const TraceHeader&,
+ *                    const ReplayOptions&)
+ *          Replays the events on one URStack<T> per session.
+ *
+ *      void writeReplay(const Replay&, JsonWriter&)
+ *          Writes the results of a replay.
+ *
+ *      bool parseGenerate(int, char**, WorkloadOptions&)
+ *          Parses the options of the generate command.
+ *
+ *      bool parseReplay(int, char**, ReplayOptions&)
+ *          Parses the options of the replay command.
+ *
+ *      int generate(const std::string&, const WorkloadOptions&)
+ *          Writes a synthetic workload to a trace.
+ *
+ *      int replayTrace(const std::string&, const ReplayOptions&)
+ *          Replays a trace, writing the results as JSON.
+ *
+ *      int main(int, char**)
+ *          Runs the given command.
+ */
+
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../CommonIO.h"
+#include "../URStack.cpp"
+#include "../URStackStats.h"
+#include "../URStackTrace.h"
+#include "BenchHarness.h"
+
+
+using namespace std;
+
+/*
+ * Percentiles reported for every operation.
+ */
+constexpr array<double, 4> kPercentiles{50, 90, 99, 99.9};
+
+/*
+ * Options of the replay command.
+ */
+struct ReplayOptions {
+    /* "string" or "int" */
+    string backend = "string";
+
+    /* Capacity of sessions used before any recorded creation */
+    int capacity = 20;
+
+    int repetitions = 3;
+
+    /* Waits the recorded delay before every event */
+    bool paced = false;
+
+    string output;
+};
+
+/*
+ * Results of a single replay.
+ */
+struct Replay {
+    /* Time spent in URStack calls */
+    double busy_seconds = 0;
+
+    /* Time of the whole replay, waits included */
+    double wall_seconds = 0;
+
+    /* Latency in nanoseconds of every operation */
+    array<LogHistogram, kTraceOperations> latency;
+};
+
+/*
+ * Pre-Conditions:
+ *      Recorded size of the action in bytes.
+ *
+ * Post-Conditions:
+ *      Returns a string of that size, or an int for the int backend.
+ *
+ * Returns an action of the given size.
+ */
+template<class T>
+T makeAction(uint64_t bytes) {
+    if constexpr (is_same_v<T, string>) {
+        return string(bytes, 'a');
+    } else {
+        return static_cast<T>(bytes);
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      Recorded capacity.
+ *
+ * Post-Conditions:
+ *      Returns the capacity, clamped between 1 & INT_MAX.
+ *
+ * Returns a recorded capacity as a valid URStack capacity.
+ */
+int toCapacity(uint64_t capacity) {
+    if (capacity == 0) {
+        return 1;
+    }
+
+    return capacity > INT_MAX ? INT_MAX : static_cast<int>(capacity);
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the events of a trace.
+ *      const reference to its header.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      Every event is replayed on the URStack<T> of its session,
+ *      its latency recorded. Actions are built before the clock is read.
+ *      Returns the results of the replay.
+ *
+ * Replays the events on one URStack<T> per session.
+ */
+template<class T>
+Replay replay(const vector<TraceEvent>& events, const TraceHeader& header,
+              const ReplayOptions& options) {
+    typedef chrono::steady_clock Clock;
+
+    Replay result;
+    vector<URStack<T>> stacks;
+
+    stacks.reserve(header.sessions);
+
+    for (uint64_t i = 0; i < header.sessions; ++i) {
+        stacks.emplace_back(options.capacity);
+    }
+
+    auto ignore = [](T&) {};
+    const Clock::time_point began = Clock::now();
+    Clock::time_point due = began;
+    Clock::duration busy{};
+
+    for (const TraceEvent& event: events) {
+        URStack<T>& stack = stacks[event.session];
+        T action;
+
+        if (event.operation == TraceOperation::kInsert) {
+            action = makeAction<T>(event.argument);
+        }
+
+        if (options.paced) {
+            due += chrono::nanoseconds(event.delay);
+
+            /* Delays are mostly below the resolution of a sleep */
+            while (Clock::now() < due) {}
+        }
+
+        const Clock::time_point start = Clock::now();
+
+        switch (event.operation) {
+            case TraceOperation::kCreate:
+                stack = URStack<T>(toCapacity(event.argument));
+                break;
+            case TraceOperation::kInsert:
+                stack.insertNewAction(std::move(action));
+                break;
+            case TraceOperation::kUndo:
+                stack.undo(toCapacity(event.argument), ignore);
+                break;
+            case TraceOperation::kRedo:
+                stack.redo(toCapacity(event.argument), ignore);
+                break;
+            case TraceOperation::kResize:
+                stack.setCapacity(toCapacity(event.argument));
+                break;
+        }
+
+        const Clock::duration elapsed = Clock::now() - start;
+
+        busy += elapsed;
+        result.latency[static_cast<size_t>(event.operation)].record(
+                chrono::duration_cast<chrono::nanoseconds>(elapsed).count());
+    }
+
+    result.busy_seconds = chrono::duration<double>(busy).count();
+    result.wall_seconds = chrono::duration<double>(Clock::now()
+                                                   - began).count();
+
+    return result;
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the results of a replay.
+ *      Reference to the JsonWriter, inside an array.
+ *
+ * Post-Conditions:
+ *      The results are written as an object.
+ */
+void writeReplay(const Replay& result, JsonWriter& json) {
+    uint64_t operations = 0;
+
+    for (const LogHistogram& latency: result.latency) {
+        operations += latency.getCount();
+    }
+
+    json.beginObject()
+        .field("busy_seconds", result.busy_seconds)
+        .field("wall_seconds", result.wall_seconds)
+        .field("operations_per_second", result.busy_seconds > 0
+                                        ? operations / result.busy_seconds
+                                        : 0.0)
+        .beginArray("operations");
+
+    for (size_t i = 0; i < kTraceOperations; ++i) {
+        const LogHistogram& latency = result.latency[i];
+
+        json.beginObject()
+            .field("name", getName(static_cast<TraceOperation>(i)))
+            .field("count", latency.getCount())
+            .field("mean_ns", latency.getMean())
+            .field("p50_ns", latency.getPercentile(kPercentiles[0]))
+            .field("p90_ns", latency.getPercentile(kPercentiles[1]))
+            .field("p99_ns", latency.getPercentile(kPercentiles[2]))
+            .field("p999_ns", latency.getPercentile(kPercentiles[3]))
+            .field("max_ns", latency.getMax())
+            .endObject();
+    }
+
+    json.endArray().endObject();
+}
+
+/*
+ * Pre-Conditions:
+ *      Command line arguments, the options starting at argv[3].
+ *      Reference to the options.
+ *
+ * Post-Conditions:
+ *      The options are parsed into the given reference.
+ *      Returns false if any is invalid.
+ *
+ * Parses the options of the generate command.
+ */
+bool parseGenerate(int argc, char **argv, WorkloadOptions& options) {
+    for (int i = 3; i < argc; i += 2) {
+        const string_view option = argv[i];
+        const string_view argument = i + 1 < argc ? argv[i + 1] : "";
+
+        long long number = 0;
+        double real = 0;
+        const bool integer =
+                parseNumber(argument, number) == ParseStatus::kOk
+                and number >= 0;
+        const bool positive = integer and number > 0;
+        const bool non_negative =
+                parseNumber(argument, real) == ParseStatus::kOk
+                and real >= 0;
+
+        if (i + 1 == argc) {
+            /* Every option takes an argument */
+        } else if (option == "--events" and positive) {
+            options.events = number;
+            continue;
+        } else if (option == "--sessions" and positive
+                   and number <= UINT32_MAX) {
+            options.sessions = static_cast<uint32_t>(number);
+            continue;
+        } else if (option == "--zipf" and non_negative) {
+            options.zipf = real;
+            continue;
+        } else if (option == "--inserts" and non_negative) {
+            options.insert_weight = real;
+            continue;
+        } else if (option == "--undos" and non_negative) {
+            options.undo_weight = real;
+            continue;
+        } else if (option == "--redos" and non_negative) {
+            options.redo_weight = real;
+            continue;
+        } else if (option == "--burst" and non_negative) {
+            options.burst = real;
+            continue;
+        } else if (option == "--min-payload" and integer
+                   and number <= UINT32_MAX) {
+            options.min_payload = static_cast<uint32_t>(number);
+            continue;
+        } else if (option == "--max-payload" and positive
+                   and number <= UINT32_MAX) {
+            options.max_payload = static_cast<uint32_t>(number);
+            continue;
+        } else if (option == "--capacity" and positive
+                   and number <= INT_MAX) {
+            options.capacity = static_cast<uint32_t>(number);
+            continue;
+        } else if (option == "--mean-delay" and non_negative) {
+            options.mean_delay = real;
+            continue;
+        } else if (option == "--seed" and positive) {
+            options.seed = number;
+            continue;
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      Command line arguments, the options starting at argv[3].
+ *      Reference to the options.
+ *
+ * Post-Conditions:
+ *      The options are parsed into the given reference.
+ *      Returns false if any is invalid.
+ *
+ * Parses the options of the replay command.
+ */
+bool parseReplay(int argc, char **argv, ReplayOptions& options) {
+    for (int i = 3; i < argc; i += 2) {
+        const string_view option = argv[i];
+        const string_view argument = i + 1 < argc ? argv[i + 1] : "";
+
+        long long number = 0;
+        const bool positive =
+                parseNumber(argument, number) == ParseStatus::kOk
+                and number > 0;
+
+        if (option == "--paced") {
+            options.paced = true;
+
+            /* The only option without an argument */
+            --i;
+            continue;
+        } else if (i + 1 == argc) {
+            /* Every other option takes an argument */
+        } else if (option == "--backend"
+                   and (argument == "string" or argument == "int")) {
+            options.backend = argument;
+            continue;
+        } else if (option == "--capacity" and positive
+                   and number <= INT_MAX) {
+            options.capacity = static_cast<int>(number);
+            continue;
+        } else if (option == "--repetitions" and positive
+                   and number <= 1000) {
+            options.repetitions = static_cast<int>(number);
+            continue;
+        } else if (option == "--output") {
+            options.output = argument;
+            continue;
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of the trace.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      The workload is written to the trace, a summary to stderr.
+ *      Returns 0 on success, otherwise 1.
+ *
+ * Writes a synthetic workload to a trace.
+ */
+int generate(const string& path, const WorkloadOptions& options) {
+    try {
+        const vector<TraceEvent> events = generateWorkload(options);
+        TraceRecorder recorder{path};
+
+        for (const TraceEvent& event: events) {
+            recorder.append(event);
+        }
+
+        const TraceHeader header = recorder.close();
+
+        cerr << "Wrote " << header.events << " events of "
+             << header.sessions << " sessions, " << header.event_bytes
+             << " bytes, to " << path << '\n';
+    } catch (exception& error) {
+        cerr << error.what();
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of the trace.
+ *      const reference to the options.
+ *
+ * Post-Conditions:
+ *      The trace is replayed options.repetitions times, the results
+ *      written as JSON to --output, or to stdout.
+ *      Returns 0 on success, otherwise 1.
+ *
+ * Replays a trace, writing the results as JSON.
+ */
+int replayTrace(const string& path, const ReplayOptions& options) {
+    vector<TraceEvent> events;
+    TraceHeader header;
+
+    try {
+        TraceReader reader{path};
+
+        header = reader.getHeader();
+        events = reader.readAll();
+    } catch (exception& error) {
+        cerr << error.what();
+        return 1;
+    }
+
+    ofstream file;
+
+    if (not options.output.empty()) {
+        file.open(options.output, ios::trunc);
+
+        if (not file) {
+            cerr << "Cannot open " << options.output << '\n';
+            return 1;
+        }
+    }
+
+    JsonWriter json{file.is_open() ? file : cout};
+
+    json.beginObject()
+        .field("suite", "URStackReplay")
+        .beginObject("build")
+        .field("compiler", __VERSION__)
+#ifdef NDEBUG
+        .field("assertions", false)
+#else
+        .field("assertions", true)
+#endif
+        .endObject()
+        .beginObject("trace")
+        .field("path", path)
+        .field("events", header.events)
+        .field("sessions", header.sessions)
+        .field("event_bytes", header.event_bytes)
+        .field("duration_ns", header.duration)
+        .endObject()
+        .beginObject("options")
+        .field("backend", options.backend)
+        .field("capacity", options.capacity)
+        .field("repetitions", options.repetitions)
+        .field("paced", options.paced)
+        .endObject()
+        .beginArray("results");
+
+    for (int i = 0; i < options.repetitions; ++i) {
+        cerr << "Replay " << i + 1 << '/' << options.repetitions << '\n';
+
+        if (options.backend == "int") {
+            writeReplay(replay<int>(events, header, options), json);
+        } else {
+            writeReplay(replay<string>(events, header, options), json);
+        }
+    }
+
+    json.endArray().endObject();
+
+    return 0;
+}
+
+/*
+ * Pre-Conditions:
+ *      Command & options described in the usage.
+ *
+ * Post-Conditions:
+ *      The command is run, displaying the usage if invalid.
+ */
+int main(int argc, char **argv) {
+    const string_view command = argc > 1 ? argv[1] : "";
+    WorkloadOptions workload;
+    ReplayOptions options;
+
+    if (argc > 2 and command == "generate"
+        and parseGenerate(argc, argv, workload)) {
+        return generate(argv[2], workload);
+    }
+
+    if (argc > 2 and command == "replay"
+        and parseReplay(argc, argv, options)) {
+        return replayTrace(argv[2], options);
+    }
+
+    cerr << "Usage: " << argv[0] << " generate <trace> [--events N]"
+            " [--sessions N] [--zipf X] [--inserts X] [--undos X]"
+            " [--redos X] [--burst X] [--min-payload N] [--max-payload N]"
+            " [--capacity N] [--mean-delay X] [--seed N]\n"
+         << "       " << argv[0] << " replay <trace> [--backend string|int]"
+            " [--capacity N] [--repetitions N] [--paced] [--output path]\n";
+
+    return 1;
+}
@@ -11,70 +11,122 @@
  * Purpose:     File containing the main function & other vital functions.
  *
  * List of Functions:
- *      template<class T>
- *      void clear(URStack<T>&, ostream&, istream&)
- *          Assigns a new URStack<T> to the given reference.
+ *      template<class T, class Stats>
+ *      void clear(URStack<T, Stats>&, ostream&, istream&)
+ *          Assigns a new URStack<T, Stats> to the given reference.
  *
- *      int displayMenu(ostream&)
+ *      int displayMenu(OutputSink&)
  *          Displays the option menu.
  *
- *       template<class T>
- *       void insertNewAction(URStack<T>&, ostream&, istream&)
+ *       template<class T, class Stats>
+ *       void insertNewAction(URStack<T, Stats>&, ostream&, istream&)
  *          Handles all the necessary input and output to
  *          insert a new action to the URStack
  *          using its insertNewAction function.
  *          If T is string, a different variant of the function is called.
  *
- *       void insertNewAction(URStack<string>&, ostream&, istream&)
+ *       template<class Stats>
+ *       void insertNewAction(URStack<string, Stats>&, ostream&, istream&)
  *          Handles all the necessary input and output to
  *          insert a new action string to the URStack,
  *          using its insertNewAction function.
  *          Takes the whole line as input for the action string.
  *
- *       template<class T>
- *       void undo(URStack<T>&, ostream&)
+ *       template<class T, class Stats>
+ *       void undo(URStack<T, Stats>&, OutputSink&)
  *           Handles all the necessary output
  *           to undo an action in the URStack,
  *           using the undo function.
  *
- *       template<class T>
- *       void redo(URStack<T>&, ostream&)
+ *       template<class T, class Stats>
+ *       void redo(URStack<T, Stats>&, OutputSink&)
  *          Handles all the necessary output
  *          to redo an action in the URStack,
  *          using the redo function.
  *
- *       template<class T>
- *       ostream& displayAll(URStack<T>&, ostream&)
+ *       template<class T, class Stats>
+ *       OutputSink& displayAll(URStack<T, Stats>&, OutputSink&)
  *          Handles all the necessary output
  *          to display all actions in the URStack,
  *          using the displayAll function.
  *
- *       template<class T>
- *       ostream& displayPrevious(URStack<T>&, ostream&)
+ *       template<class T, class Stats>
+ *       OutputSink& displayPrevious(URStack<T, Stats>&, OutputSink&)
  *          Handles all the necessary output to display all previous
  *          actions in the URStack, using the displayPrevious function.
  *
- *       template<class T>
- *       ostream& displayNext(URStack<T>&, ostream&)
+ *       template<class T, class Stats>
+ *       OutputSink& displayNext(URStack<T, Stats>&, OutputSink&)
  *          Handles all the necessary output to display all next
  *          actions in the URStack, using the displayNext function.
  *
- *      template<class T>
- *      void displayStackInfo(URStack<T>&, ostream&)
+ *      template<class T, class Stats>
+ *      void displayStackInfo(URStack<T, Stats>&, OutputSink&)
  *          Handles all the necessary output to display
  *          the current size, capacity, & whether the type
  *          stored in the URStack is string or not.
  *
- *      int main()
+ *      template<class T, class Stats>
+ *      void displayMemory(const URStack<T, Stats>&, OutputSink&)
+ *          Handles all the necessary output to display the memory
+ *          owned by the URStack.
+ *
+ *      template<class T, class Stats>
+ *      void displayStats(URStack<T, Stats>&, OutputSink&)
+ *          Handles all the necessary output to display the statistics
+ *          gathered by the URStack.
+ *
+ *      bool parseCount(string_view, int&)
+ *          Parses the optional count argument of a batch command.
+ *
+ *      template<class T>
+ *      void parseAction(string_view, T&)
+ *          Parses the action argument of a batch insert command.
+ *          If T is string, a different variant of the function is called.
+ *
+ *      void parseAction(string_view, string&)
+ *          Parses the action argument of a batch insert command,
+ *          taking the whole argument as the action string.
+ *
+ *      template<class T>
+ *      uint64_t getTraceBytes(const T&)
+ *          Returns the size of an action, as recorded in traces.
+ *
+ *      template<class T, class Stats>
+ *      int runBatch(URStack<T, Stats>&, istream&, OutputSink&, ostream&,
+ *                   TraceRecorder*)
+ *          Runs a batch script against the given URStack,
+ *          without prompts, colours or per-line flushes.
+ *
+ *      void stopServer(int)
+ *          Signal handler stopping the running server.
+ *
+ *      int serve(const string&, const string&, const string&,
+ *                const CompactionOptions*)
+ *          Serves the sessions of a pack over a Unix domain socket.
+ *
+ *      int main(int, char**)
  *          Main function of the program
  */
 
+#include <csignal>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
+#include "ActionLog.h"
 #include "CommonIO.h"
+#include "OutputSink.h"
 #include "URStack.cpp"
+#include "URStackRegistry.cpp"
+#include "URStackServer.h"
+#include "URStackTrace.h"
 
 
 using namespace std;
@@ -89,10 +141,10 @@ using namespace std;
  *      Given reference refers to a new URStack of the given, or default,
  *      capacity.
  *
- * Assigns a new URStack<T> to the given reference.
+ * Assigns a new URStack<T, Stats> to the given reference.
  */
-template<class T>
-void clear(URStack<T>& result, ostream& out, istream& in) {
+template<class T, class Stats>
+void clear(URStack<T, Stats>& result, ostream& out, istream& in) {
     /* Default is -1 */
     int new_capacity = getInt("Enter Stack capacity", out,
                               in, 1);
@@ -101,21 +153,23 @@ void clear(URStack<T>& result, ostream& out, istream& in) {
     out << endl;
 
     /* Use default capacity in the constructor (presumably unknown) */
-    result = new_capacity < 0 ? URStack<T>() : URStack<T>(new_capacity);
+    result = new_capacity < 0 ? URStack<T, Stats>()
+                              : URStack<T, Stats>(new_capacity);
 }
 
 /*
  * Pre-Conditions:
- *      ostream reference to display a prompt..
+ *      OutputSink reference to display the menu.
  *
  * Post-Conditions:
  *      Displays the option menu.
  *      Returns the number of options in the menu as an int.
  *
  * Displays the option menu.
+ * The options are built once, not on every call.
  */
-int displayMenu(ostream& out) {
-    vector<string> options{
+int displayMenu(OutputSink& out) {
+    static const vector<string> options{
             "Insert a new action",
             "Undo action",
             "Redo action",
@@ -123,18 +177,21 @@ int displayMenu(ostream& out) {
             "Display all previous actions",
             "Display all next actions",
             "Clear stack",
+            "Display statistics",
             "Exit",
     };
 
     /* Loop over all options */
     for (int i = 0; i < options.size(); i++) {
-        displayDataMessage(to_string(i + 1) + '-', out)
-            << string(4, '\t')
+        out.beginData() << i + 1 << '-';
+        out.endColour()
+            << "\t\t\t\t"
             << options[i]
             << '\n';
     }
 
-    displaySeparator(out);
+    /* Same separator as displaySeparator */
+    out << '\n' << string(70, '-') << '\n';
 
     /* cast from vector<string>::size_t to int */
     return (int) options.size();
@@ -142,7 +199,7 @@ int displayMenu(ostream& out) {
 
 /*
  * Pre-Conditions:
- *      Reference to the URStack<T> in use by the program.
+ *      Reference to the URStack<T, Stats> in use by the program.
  *      Type T must have operator>>(istream&, T&) defined or be a string.
  *      ostream reference to display a prompt.
  *      istream reference read user input.
@@ -155,8 +212,8 @@ int displayMenu(ostream& out) {
  * insert a new action to the URStack using its insertNewAction function.
  * If T is string, a variant of the function is called.
  */
-template<class T>
-void insertNewAction(URStack<T>& stack, ostream& out, istream& in) {
+template<class T, class Stats>
+void insertNewAction(URStack<T, Stats>& stack, ostream& out, istream& in) {
     T new_action;
 
     /* use operator>> defined in T */
@@ -170,7 +227,7 @@ void insertNewAction(URStack<T>& stack, ostream& out, istream& in) {
 
 /*
  * Pre-Conditions:
- *      Reference to the URStack<string> in use by the program.
+ *      Reference to the URStack<string, Stats> in use by the program.
  *      ostream reference to display a prompt.
  *      istream reference read user input.
  *
@@ -182,7 +239,9 @@ void insertNewAction(URStack<T>& stack, ostream& out, istream& in) {
  * insert a new action string to the URStack using its insertNewAction function.
  * Takes the whole line as input for the action string.
  */
-void insertNewAction(URStack<string>& stack, ostream& out, istream& in) {
+template<class Stats>
+void insertNewAction(URStack<string, Stats>& stack, ostream& out,
+                     istream& in) {
     string new_action = getString("Enter a new action", out, in);
 
     stack.insertNewAction(new_action);
@@ -193,9 +252,9 @@ void insertNewAction(URStack<string>& stack, ostream& out, istream& in) {
 
 /*
  * Pre-Conditions:
- *      Reference to the URStack<T> in use by the program.
+ *      Reference to the URStack<T, Stats> in use by the program.
  *      Type T must have operator<<(ostream&, const T&) defined.
- *      ostream reference to display a prompt.
+ *      OutputSink reference to display the output.
  *
  * Post-Conditions:
  *      The latest action in the URStack is undone & displayed,
@@ -203,23 +262,25 @@ void insertNewAction(URStack<string>& stack, ostream& out, istream& in) {
  *
  * Handles all the necessary output to undo an action in the URStack,
  * using the undo function.
+ * The output is flushed once, as a single operation.
  */
-template<class T>
-void undo(URStack<T>& stack, ostream& out) {
+template<class T, class Stats>
+void undo(URStack<T, Stats>& stack, OutputSink& out) {
     /* Display empty line */
     out << '\n';
 
     stack.undo(out);
 
     /* Display two new lines, flush buffer */
-    out << '\n' << endl;
+    out << "\n\n";
+    out.flush();
 }
 
 /*
  * Pre-Conditions:
- *      Reference to the URStack<T> in use by the program.
+ *      Reference to the URStack<T, Stats> in use by the program.
  *      Type T must have operator<<(ostream&, const T&) defined.
- *      ostream reference to display a prompt.
+ *      OutputSink reference to display the output.
  *
  * Post-Conditions:
  *      The latest action in the URStack is redone & displayed,
@@ -227,126 +288,700 @@ void undo(URStack<T>& stack, ostream& out) {
  *
  * Handles all the necessary output to redo an action in the URStack,
  * using the redo function.
+ * The output is flushed once, as a single operation.
  */
-template<class T>
-void redo(URStack<T>& stack, ostream& out) {
+template<class T, class Stats>
+void redo(URStack<T, Stats>& stack, OutputSink& out) {
     /* Display empty line */
     out << '\n';
 
     stack.redo(out);
 
     /* Display two new lines, flush buffer */
-    out << '\n' << endl;
+    out << "\n\n";
+    out.flush();
 }
 
 /*
  * Pre-Conditions:
- *      Reference to the URStack<T> in use by the program.
+ *      Reference to the URStack<T, Stats> in use by the program.
  *      Type T must have operator<<(ostream&, const T&) defined.
- *      ostream reference to display a prompt.
+ *      OutputSink reference to display the output.
  *
  * Post-Conditions:
  *      Displays all the actions in the given URStack.
  *
  * Handles all the necessary output to display all actions in the URStack,
  * using the displayAll function.
+ * The output is flushed once, as a single operation.
  */
-template<class T>
-ostream& displayAll(URStack<T>& stack, ostream& out) {
+template<class T, class Stats>
+OutputSink& displayAll(URStack<T, Stats>& stack, OutputSink& out) {
     /* Display empty line */
     out << '\n';
 
     /* Display the actions followed by two new lines */
-    return stack.displayAll(out) << '\n' << endl;
+    stack.displayAll(out) << "\n\n";
+    out.flush();
+
+    return out;
 }
 
 /*
  * Pre-Conditions:
- *      Reference to the URStack<T> in use by the program.
+ *      Reference to the URStack<T, Stats> in use by the program.
  *      Type T must have operator<<(ostream&, const T&) defined.
- *      ostream reference to display a prompt.
+ *      OutputSink reference to display the output.
  *
  * Post-Conditions:
  *      Displays all the previous actions in the given URStack.
  *
  * Handles all the necessary output to display all previous
  * actions in the URStack, using the displayPrevious function.
+ * The output is flushed once, as a single operation.
  */
-template<class T>
-ostream& displayPrevious(URStack<T>& stack, ostream& out) {
+template<class T, class Stats>
+OutputSink& displayPrevious(URStack<T, Stats>& stack, OutputSink& out) {
     /* Display empty line */
     out << '\n';
 
     /* Display the actions followed by two new lines */
-    return stack.displayPrevious(out) << '\n' << endl;
+    stack.displayPrevious(out) << "\n\n";
+    out.flush();
+
+    return out;
 }
 
 /*
  * Pre-Conditions:
- *      Reference to the URStack<T> in use by the program.
+ *      Reference to the URStack<T, Stats> in use by the program.
  *      Type T must have operator<<(ostream&, const T&) defined.
- *      ostream reference to display a prompt.
+ *      OutputSink reference to display the output.
  *
  * Post-Conditions:
  *      Displays all the next actions in the given URStack.
  *
  * Handles all the necessary output to display all next
  * actions in the URStack, using the displayNext function.
+ * The output is flushed once, as a single operation.
  */
-template<class T>
-ostream& displayNext(URStack<T>& stack, ostream& out) {
+template<class T, class Stats>
+OutputSink& displayNext(URStack<T, Stats>& stack, OutputSink& out) {
     /* Display empty line */
     out << '\n';
 
     /* Display the actions followed by two new lines */
-    return stack.displayNext(out) << '\n' << endl;
+    stack.displayNext(out) << "\n\n";
+    out.flush();
+
+    return out;
 }
 
 /*
  * Pre-Conditions:
- *      Reference to the URStack<T> in use by the program.
+ *      Reference to the URStack<T, Stats> in use by the program.
  *      Type T must have operator<<(ostream&, const T&) defined.
- *      ostream reference to display a prompt.
+ *      OutputSink reference to display the output.
  *
  * Post-Conditions:
  *      Displays information about the given URStack.
  *
  * Handles all the necessary output to display the current size, capacity, &
  * whether the type stored in the URStack is string or not.
+ * Buffered only, flushed with the menu that follows it.
  */
-template<class T>
-void displayStackInfo(URStack<T>& stack, ostream& out) {
+template<class T, class Stats>
+void displayStackInfo(URStack<T, Stats>& stack, OutputSink& out) {
     /* Display empty line */
     out << '\n';
 
     /* Displays {size} / {capacity} */
-    displayDataMessage(
-            "Stack size:\t\t" + to_string(stack.getSize())
-                            + " / " + to_string(stack.getCapacity()),
-            out) << '\n';
-
-    displayDataMessage("Datatype:\t\t", out);
+    out.beginData() << "Stack size:\t\t" << stack.getSize()
+                    << " / " << stack.getCapacity();
+    out.endColour() << '\n';
 
     /* Displays "String" or "Custom" based on the type of T */
-    displayDataMessage(is_same_v<T, string> ? "String" : "Custom",
-            out) << '\n';
+    out.beginData() << "Datatype:\t\t"
+                    << (is_same_v<T, string> ? "String" : "Custom");
+    out.endColour() << '\n';
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the URStack<T, Stats> in use by the program.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays the bytes owned by the given URStack.
+ *
+ * Handles all the necessary output to display the memory owned by the
+ * URStack, with the share of the actions that can be redone.
+ * Buffered only, flushed by the caller.
+ */
+template<class T, class Stats>
+void displayMemory(const URStack<T, Stats>& stack, OutputSink& out) {
+    const MemoryUsage usage = stack.memoryUsage();
+
+    const pair<const char*, size_t> sizes[] = {
+            {"Nodes:\t\t\t", usage.nodes},
+            {"Node bytes:\t\t", usage.node_bytes},
+            {"Payload bytes:\t\t", usage.payload_bytes},
+            {"Redo nodes:\t\t", usage.redo_nodes},
+            {"Redo bytes:\t\t", usage.redo_bytes},
+            {"Pooled bytes:\t\t", usage.pooled_bytes},
+            {"Total bytes:\t\t", usage.getTotalBytes()},
+    };
+
+    for (const auto& [name, value]: sizes) {
+        out.beginData() << name << value;
+        out.endColour() << '\n';
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      Reference to the URStack<T, Stats> in use by the program.
+ *      OutputSink reference to display the output.
+ *
+ * Post-Conditions:
+ *      Displays the statistics gathered by the given URStack,
+ *      or an error message if it gathers none,
+ *      followed by the memory it owns.
+ *
+ * Handles all the necessary output to display the statistics
+ * gathered by the URStack, since it was created.
+ * Buffered only, flushed by the caller.
+ */
+template<class T, class Stats>
+void displayStats(URStack<T, Stats>& stack, OutputSink& out) {
+    /* Display empty line */
+    out << '\n';
+
+    if constexpr (Stats::kEnabled) {
+        stack.getStats().display(out);
+    } else {
+        out.invalid("Statistics are disabled");
+        out << '\n';
+    }
+
+    out << '\n';
+    displayMemory(stack, out);
+    out << '\n';
+}
+
+/*
+ * Pre-Conditions:
+ *      The argument of a batch command, the text after the command letter.
+ *      Reference to the parsed count.
+ *
+ * Post-Conditions:
+ *      The count is parsed into the given reference, 1 if omitted.
+ *      Returns false if the argument is not a positive integer.
+ *
+ * Parses the optional count argument of a batch command.
+ * Uses parseNumber, which neither allocates nor throws.
+ */
+bool parseCount(string_view argument, int& count) {
+    switch (parseNumber(argument, count)) {
+        case ParseStatus::kOk:
+            return count > 0;
+        case ParseStatus::kEmpty:
+            count = 1;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      The argument of a batch insert command.
+ *      Type T must be arithmetic, have operator>>(istream&, T&) defined
+ *      or be a string.
+ *      Reference to the parsed action.
+ *
+ * Post-Conditions:
+ *      The action is parsed into the given reference.
+ *      Throws std::invalid_argument if the argument cannot be parsed.
+ *
+ * Parses the action argument of a batch insert command.
+ * Numbers are parsed in place with parseNumber, other types
+ * go through their operator>>.
+ * If T is string, a variant of the function is called.
+ */
+template<class T>
+void parseAction(string_view argument, T& action) {
+    if constexpr (is_arithmetic_v<T> and not is_same_v<T, bool>) {
+        if (parseNumber(argument, action) != ParseStatus::kOk) {
+            throw invalid_argument("Invalid action");
+        }
+    } else {
+        istringstream parser{string{argument}};
+
+        /* use operator>> defined in T */
+        if (not (parser >> action)) {
+            throw invalid_argument("Invalid action");
+        }
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      The argument of a batch insert command.
+ *      Reference to the parsed action string.
+ *
+ * Post-Conditions:
+ *      The action string is the argument without its separating space.
+ *
+ * Parses the action argument of a batch insert command,
+ * taking the whole argument as the action string.
+ */
+void parseAction(string_view argument, string& action) {
+    if (not argument.empty() and argument[0] == ' ') {
+        argument.remove_prefix(1);
+    }
+
+    action.assign(argument);
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to an action.
+ *
+ * Post-Conditions:
+ *      Returns the number of characters of a string action, otherwise
+ *      its size & the heap bytes it owns (see PayloadBytes).
+ *
+ * Returns the size of an action, as recorded in traces.
+ */
+template<class T>
+uint64_t getTraceBytes(const T& action) {
+    if constexpr (is_same_v<T, string>) {
+        return action.size();
+    } else {
+        return sizeof(T) + PayloadBytes<T>::of(action);
+    }
 }
 
 /*
  * Pre-Conditions:
- *      No code-related preconditions.
+ *      Reference to the URStack<T, Stats> in use by the program.
+ *      Type T must have operator>>(istream&, T&) defined or be a string,
+ *      & operator<<(ostream&, const T&) defined.
+ *      istream reference to read the script from.
+ *      OutputSink reference to display the requested output.
+ *      ostream reference to display errors.
+ *      Pointer to the recorder of the calls, nullptr to not record.
+ *
+ * Post-Conditions:
+ *      Every command of the script is run in order, until the first
+ *      invalid one, which is reported with its line number.
+ *      Every insert, undo, redo, clear & resize is recorded, as session 0,
+ *      imported actions are not.
+ *      Returns 0 if the whole script was run, otherwise 1.
+ *
+ * Runs a batch script against the given URStack,
+ * without prompts, colours or per-line flushes.
+ * The output is left in the sink, flushed by the caller.
+ *
+ * The script has one command per line, letter first:
+ *      i <action>      Insert a new action.
+ *      u [count]       Undo count actions, default 1.
+ *      r [count]       Redo count actions, default 1.
+ *      a               Display all actions.
+ *      p               Display all previous actions.
+ *      n               Display all next actions.
+ *      s               Display size / capacity.
+ *      c [capacity]    Clear the stack, default capacity if omitted.
+ *      k <capacity>    Change the capacity, keeping the newest actions.
+ *      l <path>        Insert the last lines of an action log that fit,
+ *                      parsed in parallel (see ActionLog).
+ *      x <path>        Export all actions to a file as JSON lines,
+ *                      formatted in parallel (see exportAll).
+ *      t               Display the statistics, if gathered.
+ *      m               Display the memory owned by the stack.
+ *      f <text>        Display the position of the newest previous
+ *                      action containing text, -1 if none.
+ *      # ...           Comment, empty lines are ignored as well.
+ * Only display commands produce output, one line each.
+ */
+template<class T, class Stats>
+int runBatch(URStack<T, Stats>& stack, istream& in, OutputSink& out,
+             ostream& err, TraceRecorder *recorder = nullptr) {
+    LineReader reader;
+    string_view line;
+    string_view argument;
+    T action;
+    string path;
+    int count;
+    long long line_number = 0;
+
+    /* Discards undone & redone actions */
+    auto ignore = [](T&) {};
+
+    /* Every call is made on the single session of the batch */
+    auto record = [recorder](TraceOperation operation, uint64_t argument) {
+        if (recorder) {
+            recorder->record(operation, 0, argument);
+        }
+    };
+
+    record(TraceOperation::kCreate, stack.getCapacity());
+
+    while (reader.read(in)) {
+        line = reader.getLine();
+        line_number++;
+
+        if (line.empty() or line[0] == '#') {
+            continue;
+        }
+
+        argument = line.substr(1);
+
+        try {
+            switch (line[0]) {
+                case 'i':
+                    parseAction(argument, action);
+                    record(TraceOperation::kInsert, getTraceBytes(action));
+                    stack.insertNewAction(std::move(action));
+                    continue;
+                case 'u':
+                    if (not parseCount(argument, count)) {
+                        break;
+                    }
+
+                    record(TraceOperation::kUndo, count);
+                    stack.undo(count, ignore);
+                    continue;
+                case 'r':
+                    if (not parseCount(argument, count)) {
+                        break;
+                    }
+
+                    record(TraceOperation::kRedo, count);
+                    stack.redo(count, ignore);
+                    continue;
+                case 'a':
+                    stack.displayAll(out) << '\n';
+                    continue;
+                case 'p':
+                    stack.displayPrevious(out) << '\n';
+                    continue;
+                case 'n':
+                    stack.displayNext(out) << '\n';
+                    continue;
+                case 's':
+                    out << stack.getSize() << " / "
+                        << stack.getCapacity() << '\n';
+                    continue;
+                case 't':
+                    if constexpr (Stats::kEnabled) {
+                        stack.getStats().display(out);
+                        continue;
+                    } else {
+                        err << "Line " << line_number
+                            << ": Statistics are disabled, use --stats\n";
+                        return 1;
+                    }
+                case 'm':
+                    displayMemory(stack, out);
+                    continue;
+                case 'f':
+                    if constexpr (is_convertible_v<const T&, string_view>) {
+                        /* The text is the argument, as for an insert */
+                        parseAction(argument, action);
+                        out << stack.findLastContaining(action) << '\n';
+                        continue;
+                    } else {
+                        err << "Line " << line_number
+                            << ": Search requires string actions\n";
+                        return 1;
+                    }
+                case 'c':
+                    /* An omitted capacity parses as 1, use the default */
+                    if (argument.find_first_not_of(' ') == string_view::npos) {
+                        stack = URStack<T, Stats>();
+                        record(TraceOperation::kCreate, stack.getCapacity());
+                        continue;
+                    }
+
+                    if (not parseCount(argument, count)) {
+                        break;
+                    }
+
+                    stack = URStack<T, Stats>(count);
+                    record(TraceOperation::kCreate, count);
+                    continue;
+                case 'k':
+                    /* Unlike c, the capacity is required */
+                    if (argument.find_first_not_of(' ') == string_view::npos
+                        or not parseCount(argument, count)) {
+                        break;
+                    }
+
+                    record(TraceOperation::kResize, count);
+                    stack.setCapacity(count);
+                    continue;
+                case 'l':
+                    /* The path is the argument, as for a string insert */
+                    parseAction(argument, path);
+                    ActionLog{path}.importInto(stack);
+                    continue;
+                case 'x': {
+                    /* The path is the argument, as for an import */
+                    parseAction(argument, path);
+
+                    ofstream file{path, ios::binary | ios::trunc};
+
+                    stack.exportAll(file, ExportFormat::kJsonLines);
+
+                    /* An unopened file fails every write, & the flush */
+                    if (not file.flush()) {
+                        throw runtime_error("\nCannot write " + path + ".\n");
+                    }
+
+                    continue;
+                }
+                default:
+                    break;
+            }
+        } catch (exception& error) {
+            /* Invalid actions, unreadable logs & unwritable exports */
+            err << "Line " << line_number << ": " << error.what() << '\n';
+            return 1;
+        }
+
+        err << "Line " << line_number << ": Invalid command\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Server stopped by stopServer, only set while serve runs.
+ */
+static URStackServer *running_server = nullptr;
+
+/*
+ * Pre-Conditions:
+ *      Number of the received signal.
+ *
+ * Post-Conditions:
+ *      The running server, if any, returns from run.
+ *
+ * Signal handler stopping the running server.
+ */
+void stopServer(int) {
+    if (running_server) {
+        running_server->stop();
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the socket path.
+ *      const reference to the pack path, empty to keep sessions in memory.
+ *      const reference to the trace path, empty to record nothing.
+ *      Pointer to the compaction budget, nullptr to never compact.
+ *
+ * Post-Conditions:
+ *      Sessions are served until SIGINT or SIGTERM,
+ *      then saved to the pack.
+ *      Every call is recorded to the trace, if any.
+ *      Idle sessions are compacted, if requested, & the reclaimed
+ *      memory is displayed on exit.
+ *      Returns 0 on success, otherwise 1.
+ *      The sessions are saved even if serving fails.
+ *
+ * Serves the sessions of a pack over a Unix domain socket.
+ * The pack is created on exit if it does not exist yet.
+ * A failing event loop must not lose the changes made to the sessions,
+ * so its error is only reported once they are saved.
+ */
+int serve(const string& socket_path, const string& pack_path,
+          const string& trace_path, const CompactionOptions *compaction) {
+    try {
+        URStackRegistry<string> registry;
+
+        if (not pack_path.empty() and ifstream(pack_path).good()) {
+            registry = URStackRegistry<string>(pack_path);
+        }
+
+        URStackServer server{socket_path, registry};
+        unique_ptr<TraceRecorder> recorder;
+
+        if (not trace_path.empty()) {
+            recorder = make_unique<TraceRecorder>(trace_path);
+            server.setRecorder(recorder.get());
+        }
+
+        server.setCompaction(compaction);
+
+        running_server = &server;
+        signal(SIGINT, stopServer);
+        signal(SIGTERM, stopServer);
+
+        string failure;
+
+        try {
+            server.run();
+        } catch (exception& error) {
+            failure = error.what();
+        }
+
+        running_server = nullptr;
+
+        if (compaction) {
+            const CompactionReport& compacted = server.getCompaction();
+
+            cout << "Compacted " << compacted.sessions << " sessions, "
+                 << compacted.getReclaimedBytes() << " bytes reclaimed\n";
+        }
+
+        if (not pack_path.empty()) {
+            registry.save(pack_path);
+        }
+
+        if (recorder) {
+            recorder->close();
+        }
+
+        if (not failure.empty()) {
+            cerr << failure;
+            return 1;
+        }
+    } catch (exception& error) {
+        running_server = nullptr;
+        cerr << error.what();
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Pre-Conditions:
+ *      Command line arguments, either none for the interactive menu,
+ *      "--batch" followed by an optional script path
+ *      (stdin if omitted or "-"), an optional "--stats"
+ *      & an optional "--record" followed by a trace path,
+ *      or "--serve" followed by a socket path, an optional pack path,
+ *      an optional "--record" followed by a trace path
+ *      & an optional "--compact" followed by the seconds after which
+ *      an idle session is compacted.
  *
  * Post-Conditions:
  *      Program startup.
  */
-int main() {
+int main(int argc, char **argv) {
+    if (argc > 1 and string(argv[1]) == "--batch") {
+        /* Output is consumed by other programs */
+        setColoured(false);
+        ios::sync_with_stdio(false);
+
+        ifstream script;
+        bool stats = false;
+        unique_ptr<TraceRecorder> recorder;
+
+        for (int i = 3; i < argc; ++i) {
+            const string option = argv[i];
+
+            if (option == "--stats") {
+                stats = true;
+            } else if (option == "--record" and i + 1 < argc) {
+                try {
+                    recorder = make_unique<TraceRecorder>(argv[++i]);
+                } catch (exception& error) {
+                    cerr << error.what();
+                    return 1;
+                }
+            } else {
+                cerr << "Unknown option " << option << '\n';
+                return 1;
+            }
+        }
+
+        if (argc > 2 and string(argv[2]) != "-") {
+            script.open(argv[2]);
+
+            if (not script) {
+                cerr << "Cannot open " << argv[2] << '\n';
+                return 1;
+            }
+        }
+
+        OutputSink sink{cout};
+        istream& input = script.is_open() ? script : cin;
+        int status;
+
+        /* Statistics cost two clock reads per operation, opt in */
+        if (stats) {
+            URStack<string, OperationStats> stack;
+
+            status = runBatch(stack, input, sink, cerr, recorder.get());
+        } else {
+            URStack<string> stack;
+
+            status = runBatch(stack, input, sink, cerr, recorder.get());
+        }
+
+        sink.flush();
+
+        if (recorder) {
+            try {
+                recorder->close();
+            } catch (exception& error) {
+                cerr << error.what();
+                return 1;
+            }
+        }
+
+        return status;
+    }
+
+    if (argc > 2 and string(argv[1]) == "--serve") {
+        string pack_path;
+        string trace_path;
+        CompactionOptions compaction;
+        bool compacting = false;
+        int idle_seconds;
+
+        for (int i = 3; i < argc; ++i) {
+            const string option = argv[i];
+
+            if (option == "--record" and i + 1 < argc) {
+                trace_path = argv[++i];
+            } else if (option == "--compact" and i + 1 < argc) {
+                if (not parseCount(argv[++i], idle_seconds)) {
+                    cerr << "Invalid idle time " << argv[i] << '\n';
+                    return 1;
+                }
+
+                compaction.idle = chrono::seconds{idle_seconds};
+                compacting = true;
+            } else if (pack_path.empty()) {
+                pack_path = option;
+            } else {
+                cerr << "Unknown option " << option << '\n';
+                return 1;
+            }
+        }
+
+        return serve(argv[2], pack_path, trace_path,
+                     compacting ? &compaction : nullptr);
+    }
+
     int selected_option;
     int options_num;
     ostream& out = cout;
     istream& in = cin;
 
+    /* Output of every operation, flushed once per operation */
+    OutputSink sink{out};
+
     /* Change DataType only here */
-    URStack<string> stack;
+    URStack<string, OperationStats> stack;
 
     displaySeparator(out);
 
@@ -355,8 +990,11 @@ int main() {
 
     /* Process user input till exit is triggered */
     while (true) {
-        displayStackInfo(stack, out);
-        options_num = displayMenu(out);
+        displayStackInfo(stack, sink);
+        options_num = displayMenu(sink);
+
+        /* The prompt is written straight to out */
+        sink.flush();
 
         /* Get selected option */
         selected_option = getInt("Choose an option", out, in,
@@ -367,24 +1005,28 @@ int main() {
                 insertNewAction(stack, out, in);
                 break;
             case 2:
-                undo(stack, out);
+                undo(stack, sink);
                 break;
             case 3:
-                redo(stack, out);
+                redo(stack, sink);
                 break;
             case 4:
-                displayAll(stack, out);
+                displayAll(stack, sink);
                 break;
             case 5:
-                displayPrevious(stack, out);
+                displayPrevious(stack, sink);
                 break;
             case 6:
-                displayNext(stack, out);
+                displayNext(stack, sink);
                 break;
             case 7:
                 clear(stack, out, in);
                 break;
             case 8:
+                displayStats(stack, sink);
+                sink.flush();
+                break;
+            case 9:
                 return 0;
             default:
                 displayInvalidMessage("Invalid option!", out)
@@ -0,0 +1,310 @@
+/*
+ * URStack Project
+ *
+ *
+ * SegmentedURStackTest.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Tests of SegmentedURStack<DataType>: random inserts, undos,
+ *              redos & trims checked against a vector of the held actions,
+ *              & the displays checked against URStack<DataType>, bounded
+ *              or not, across segment boundaries.
+ *
+ * List of Functions:
+ *      template<class Stack>
+ *      std::string describe(const Stack&)
+ *          Returns every display of a stack, to compare stacks.
+ *
+ *      void check(const SegmentedURStack<std::string>&,
+ *                 const std::vector<std::string>&, std::size_t)
+ *          Checks a stack holds the actions of the model.
+ *
+ *      void testRandom(std::uint64_t, int)
+ *          Random operations against the model & URStack.
+ *
+ *      void testTrim()
+ *          trim destroys the oldest actions, applied ones first.
+ *
+ *      void testMove()
+ *          Moved stacks keep their actions.
+ *
+ *      void testCopyInsert()
+ *          Inserting by const reference copies the action.
+ *
+ *      int main()
+ *          Runs every test.
+ */
+
+#include <any>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../SegmentedURStack.cpp"
+#include "../URStack.cpp"
+#include "TestHarness.h"
+
+
+/* Used std utilities */
+using std::string, std::vector;
+
+/*
+ * Pre-Conditions:
+ *      const reference to a URStack or SegmentedURStack.
+ *
+ * Post-Conditions:
+ *      Returns the output of every display function, without colours.
+ *
+ * Returns every display of a stack, to compare stacks.
+ */
+template<class Stack>
+string describe(const Stack& stack) {
+    std::ostringstream out;
+
+    {
+        OutputSink sink{out, false};
+
+        stack.displayAll(sink) << '|';
+        stack.displayPrevious(sink) << '|';
+        stack.displayNext(sink) << '|';
+    }
+
+    return out.str();
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to a stack.
+ *      const reference to the held actions, oldest first.
+ *      Number of held actions that are applied, the oldest ones.
+ *
+ * Post-Conditions:
+ *      Checks the size, the length, every action by operator[]
+ *      & the visited actions match the model.
+ *
+ * Checks a stack holds the actions of the model.
+ */
+void check(const SegmentedURStack<string>& stack, const vector<string>& held,
+           std::size_t applied) {
+    CHECK(stack.getSize() == applied);
+    CHECK(stack.getLength() == held.size());
+
+    bool same = true;
+
+    for (std::size_t hops = 0; hops < held.size(); hops++) {
+        same = same and stack[hops] == held[held.size() - 1 - hops];
+    }
+
+    CHECK(same);
+    CHECK_THROWS(stack[held.size()], std::out_of_range);
+
+    std::size_t visited = 0;
+
+    stack.visitPrevious([&](const string& action) {
+        visited++;
+        same = same and action == held[applied - visited];
+    });
+
+    CHECK(same and visited == applied);
+}
+
+/*
+ * Pre-Conditions:
+ *      Capacity of the stacks, SegmentedURStack::kUnbounded for none.
+ *      Number of operations.
+ *
+ * Post-Conditions:
+ *      Checks a stack against the model after every operation,
+ *      & its displays against a URStack of the same capacity.
+ *
+ * Random operations against the model & URStack.
+ * Bursts of inserts push the held actions across several segments,
+ * bursts of undos discard them again on the next insert.
+ */
+void testRandom(std::uint64_t capacity, int operations) {
+    const bool bounded = capacity != SegmentedURStack<string>::kUnbounded;
+
+    SegmentedURStack<string> stack{capacity};
+    URStack<string> reference{bounded ? static_cast<int>(capacity) : 1 << 30};
+    vector<string> held;
+    std::size_t applied = 0;
+    std::uint64_t seed = 42;
+
+    for (int i = 0; i < operations; i++) {
+        /* Linear congruential, the same sequence on every platform */
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        const unsigned roll = static_cast<unsigned>(seed >> 33) % 10;
+
+        if (roll < 6) {
+            const string action = "action " + std::to_string(i);
+
+            held.resize(applied);
+            held.push_back(action);
+            applied++;
+
+            if (held.size() > capacity) {
+                held.erase(held.begin());
+                applied--;
+            }
+
+            stack.insertNewAction(action);
+            reference.insertNewAction(action);
+        } else if (roll < 8) {
+            string *undone = stack.undo();
+
+            CHECK((undone == nullptr) == (applied == 0));
+            CHECK(not undone or *undone == held[--applied]);
+            reference.undo();
+        } else {
+            string *redone = stack.redo();
+
+            CHECK((redone == nullptr) == (applied == held.size()));
+            CHECK(not redone or *redone == held[applied++]);
+            reference.redo();
+        }
+
+        check(stack, held, applied);
+    }
+
+    CHECK(describe(stack) == describe(reference));
+    CHECK(stack.getCapacity() == capacity);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks trim destroys the oldest actions, applied ones first,
+ *      & releases the segments left empty.
+ *
+ * trim destroys the oldest actions, applied ones first.
+ */
+void testTrim() {
+    constexpr std::size_t kEntries = SegmentedURStack<string>::kSegmentEntries;
+
+    SegmentedURStack<string> stack;
+    vector<string> held;
+
+    for (std::size_t i = 0; i < 3 * kEntries; i++) {
+        held.push_back("action " + std::to_string(i));
+        stack.insertNewAction(held.back());
+    }
+
+    for (int i = 0; i < 10; i++) {
+        stack.undo();
+    }
+
+    /* Past the first segment */
+    CHECK(stack.trim(kEntries + 1) == kEntries + 1);
+    held.erase(held.begin(), held.begin() + kEntries + 1);
+    check(stack, held, held.size() - 10);
+
+    /* Every applied action, then 4 undone ones */
+    CHECK(stack.trim(held.size() - 6) == held.size() - 6);
+    held.erase(held.begin(), held.end() - 6);
+    check(stack, held, 0);
+    CHECK(stack.peek() == nullptr);
+    CHECK(stack.redo() and *stack.peek() == held[0]);
+
+    CHECK(stack.trim(100) == 6);
+    check(stack, {}, 0);
+    CHECK(stack.undo() == nullptr and stack.redo() == nullptr);
+
+    /* Every segment is released, one kept as the spare */
+    CHECK(stack.memoryUsage().pooled_bytes == kEntries * sizeof(string));
+
+    URStack<string> reference{4};
+
+    stack.insertNewAction("after");
+    reference.insertNewAction("after");
+    check(stack, {"after"}, 1);
+    CHECK(describe(stack) == describe(reference));
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks moved stacks keep their actions & capacity, & the
+ *      moved-from ones are empty.
+ *
+ * Moved stacks keep their actions.
+ */
+void testMove() {
+    SegmentedURStack<string> stack{3};
+
+    CHECK_THROWS(SegmentedURStack<string>{0}, std::invalid_argument);
+
+    for (int i = 0; i < 5; i++) {
+        stack.insertNewAction("action " + std::to_string(i));
+    }
+
+    stack.undo();
+
+    SegmentedURStack<string> moved{std::move(stack)};
+
+    check(moved, {"action 2", "action 3", "action 4"}, 2);
+    CHECK(moved.getCapacity() == 3);
+    check(stack, {}, 0);
+
+    stack = std::move(moved);
+    check(stack, {"action 2", "action 3", "action 4"}, 2);
+    CHECK(stack.redo() and *stack.peek() == "action 4");
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks an action list-initialisable from its own type is
+ *      copied whole by SegmentedURStack & URStack, not wrapped.
+ *
+ * Inserting by const reference copies the action.
+ */
+void testCopyInsert() {
+    typedef vector<std::any> Action;
+
+    const Action action{1, 2, 3};
+    SegmentedURStack<Action> stack;
+    URStack<Action> reference{2};
+
+    stack.insertNewAction(action);
+    reference.insertNewAction(action);
+
+    CHECK(stack.peek()->size() == 3);
+    CHECK(reference.peek()->size() == 3);
+
+    /* Held by the stack itself */
+    stack.insertNewAction(*stack.peek());
+    CHECK(stack.getLength() == 2 and stack.peek()->size() == 3);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Returns 0 if every check held, otherwise 1.
+ *
+ * Runs every test.
+ */
+int main() {
+    testRandom(SegmentedURStack<string>::kUnbounded, 2000);
+    testRandom(300, 3000);
+    testRandom(1, 200);
+    testTrim();
+    testMove();
+    testCopyInsert();
+
+    return finish();
+}
@@ -0,0 +1,93 @@
+/*
+ * URStack Project
+ *
+ *
+ * TestHarness.h
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Minimal helpers shared by the tests, run by ctest:
+ *              every failed check is reported with its location,
+ *              the test fails if any did.
+ *
+ * List of Macros:
+ *      CHECK(condition)
+ *          Reports the condition if it does not hold.
+ *
+ *      CHECK_THROWS(expression, Exception)
+ *          Reports the expression if it does not throw Exception.
+ *
+ * List of Functions:
+ *      inline int& failures()
+ *          Returns the number of failed checks.
+ *
+ *      inline int finish()
+ *          Returns the exit status of the test.
+ */
+
+#ifndef URSTACK_TESTHARNESS_H
+#define URSTACK_TESTHARNESS_H
+
+#include <iostream>
+
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Returns a reference to the number of failed checks.
+ */
+inline int& failures() {
+    static int count = 0;
+
+    return count;
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Returns 0 if every check held, otherwise 1.
+ *
+ * Returns the exit status of the test.
+ */
+inline int finish() {
+    if (failures()) {
+        std::cerr << failures() << " checks failed\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+#define CHECK(condition)                                                    \
+    do {                                                                    \
+        if (not (condition)) {                                              \
+            std::cerr << __FILE__ << ':' << __LINE__                        \
+                      << ": CHECK(" #condition ") failed\n";                \
+            failures()++;                                                   \
+        }                                                                   \
+    } while (false)
+
+#define CHECK_THROWS(expression, Exception)                                 \
+    do {                                                                    \
+        bool thrown = false;                                                \
+                                                                            \
+        try {                                                               \
+            (void) (expression);                                            \
+        } catch (const Exception&) {                                        \
+            thrown = true;                                                  \
+        }                                                                   \
+                                                                            \
+        if (not thrown) {                                                   \
+            std::cerr << __FILE__ << ':' << __LINE__                        \
+                      << ": " #expression " did not throw " #Exception "\n";\
+            failures()++;                                                   \
+        }                                                                   \
+    } while (false)
+
+#endif //URSTACK_TESTHARNESS_H
@@ -0,0 +1,311 @@
+/*
+ * URStack Project
+ *
+ *
+ * TimeTravelEngineTest.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Tests of TimeTravelEngine<State>: the state at every
+ *              retained position checked against a naive replay, across
+ *              evictions, undos & redos, & the checkpoints taken by the
+ *              interval & cost_budget policies.
+ *
+ * List of Functions:
+ *      void execute(TimeTravelEngine<std::string>&, char, double)
+ *          Executes a command appending a character, counting replays.
+ *
+ *      void executeReverse(TimeTravelEngine<std::string>&, double)
+ *          Executes a command reversing the state, counting replays.
+ *
+ *      void testRandom(int, CheckpointPolicy, int)
+ *          Random commands, undos & redos against a naive replay.
+ *
+ *      void testInterval()
+ *          A checkpoint every interval commands, bounding replays.
+ *
+ *      void testCostBudget()
+ *          A checkpoint every cost_budget of replay cost.
+ *
+ *      void testDiscard()
+ *          Undone checkpoints are kept for redo, discarded by execute.
+ *
+ *      int main()
+ *          Runs every test.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../TimeTravelEngine.cpp"
+#include "TestHarness.h"
+
+
+/* Used std utilities */
+using std::string, std::vector;
+
+/*
+ * Number of commands applied since the last reset, replays included.
+ */
+static int applied = 0;
+
+/*
+ * Pre-Conditions:
+ *      Reference to an engine.
+ *      Character to append.
+ *      Replay cost of the command.
+ *
+ * Post-Conditions:
+ *      The character is appended to the state & recorded.
+ *
+ * Executes a command appending a character, counting replays.
+ */
+void execute(TimeTravelEngine<string>& engine, char c, double cost) {
+    engine.execute([c](string& state) {
+        state += c;
+        applied++;
+    }, [](string& state) {
+        state.pop_back();
+    }, cost);
+}
+
+/*
+ * Pre-Conditions:
+ *      Reference to an engine.
+ *      Replay cost of the command.
+ *
+ * Post-Conditions:
+ *      The state is reversed & the command recorded.
+ *
+ * Executes a command reversing the state, counting replays.
+ * Reversing does not commute with appending, so replays out of order
+ * are caught.
+ */
+void executeReverse(TimeTravelEngine<string>& engine, double cost) {
+    engine.execute([](string& state) {
+        std::reverse(state.begin(), state.end());
+        applied++;
+    }, [](string& state) {
+        std::reverse(state.begin(), state.end());
+    }, cost);
+}
+
+/*
+ * Pre-Conditions:
+ *      Capacity of the history.
+ *      Checkpoint policy.
+ *      Number of operations.
+ *
+ * Post-Conditions:
+ *      Checks the state at every retained position, & the retained
+ *      range, against the states of a naive replay after every
+ *      operation.
+ *
+ * Random commands, undos & redos against a naive replay.
+ */
+void testRandom(int capacity, CheckpointPolicy policy, int operations) {
+    TimeTravelEngine<string> engine{"", capacity, policy};
+
+    /* State at every position of the current line, from position 0 */
+    vector<string> states{""};
+    std::uint64_t position = 0;
+    std::uint64_t seed = 7;
+
+    for (int i = 0; i < operations; i++) {
+        /* Linear congruential, the same sequence on every platform */
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        const unsigned roll = static_cast<unsigned>(seed >> 33) % 10;
+        const double cost = 1 + static_cast<double>((seed >> 20) % 4);
+
+        if (roll < 6) {
+            string next = states[position];
+
+            if (roll == 0) {
+                std::reverse(next.begin(), next.end());
+                executeReverse(engine, cost);
+            } else {
+                next += static_cast<char>('a' + i % 26);
+                execute(engine, next.back(), cost);
+            }
+
+            states.resize(++position);
+            states.push_back(next);
+        } else if (roll < 8) {
+            const int count = 1 + static_cast<int>((seed >> 40) % 3);
+            const std::uint64_t undone = std::min<std::uint64_t>(
+                    count, position - engine.getFirstPosition());
+
+            CHECK(engine.undo(count) == static_cast<int>(undone));
+            position -= undone;
+        } else {
+            const int count = 1 + static_cast<int>((seed >> 40) % 3);
+            const std::uint64_t redone = std::min<std::uint64_t>(
+                    count, states.size() - 1 - position);
+
+            CHECK(engine.redo(count) == static_cast<int>(redone));
+            position += redone;
+        }
+
+        const std::uint64_t first = engine.getFirstPosition();
+        const std::uint64_t last = engine.getLastPosition();
+
+        CHECK(engine.getPosition() == position);
+        CHECK(engine.getState() == states[position]);
+        CHECK(last == states.size() - 1);
+        CHECK(last - first <= static_cast<std::uint64_t>(capacity));
+        CHECK(first <= position);
+
+        bool same = true;
+
+        for (std::uint64_t at = first; at <= last; at++) {
+            same = same and engine.stateAt(at) == states[at];
+        }
+
+        CHECK(same);
+        CHECK_THROWS(engine.stateAt(last + 1), std::out_of_range);
+
+        if (first > 0) {
+            CHECK_THROWS(engine.stateAt(first - 1), std::out_of_range);
+        }
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks a checkpoint is taken every interval commands, & that
+ *      materialising any position replays less than an interval.
+ *
+ * A checkpoint every interval commands, bounding replays.
+ */
+void testInterval() {
+    TimeTravelEngine<string> engine{"", 100, CheckpointPolicy{4, 0}};
+
+    for (int i = 0; i < 10; i++) {
+        execute(engine, 'a', 1);
+    }
+
+    /* 0, 4 & 8 */
+    CHECK(engine.getCheckpointCount() == 3);
+
+    int replayed = 0;
+
+    for (std::uint64_t at = 0; at <= 10; at++) {
+        applied = 0;
+        CHECK(engine.stateAt(at) == string(at, 'a'));
+        replayed = std::max(replayed, applied);
+    }
+
+    CHECK(replayed == 3);
+
+    /* Evicting rolls the first checkpoint forward, never past the next */
+    TimeTravelEngine<string> bounded{"", 6, CheckpointPolicy{4, 0}};
+
+    for (int i = 0; i < 30; i++) {
+        execute(bounded, static_cast<char>('a' + i % 26), 1);
+    }
+
+    CHECK(bounded.getFirstPosition() == 24);
+    CHECK(bounded.getCheckpointCount() <= 3);
+    CHECK(bounded.stateAt(24) == "abcdefghijklmnopqrstuvwx");
+
+    CHECK_THROWS((TimeTravelEngine<string>{"", 6, CheckpointPolicy{0, 0}}),
+                 std::invalid_argument);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks a checkpoint is taken once the commands since the last
+ *      one cost cost_budget, before the interval is reached.
+ *
+ * A checkpoint every cost_budget of replay cost.
+ */
+void testCostBudget() {
+    TimeTravelEngine<string> engine{"", 100, CheckpointPolicy{64, 5}};
+
+    /* Costs 2, 4 & 6: checkpoints at 3, 6 & 9 */
+    for (int i = 0; i < 10; i++) {
+        execute(engine, 'a', 2);
+    }
+
+    CHECK(engine.getCheckpointCount() == 4);
+
+    /* A single command over the budget is checkpointed right after */
+    execute(engine, 'b', 10);
+    CHECK(engine.getCheckpointCount() == 5);
+
+    applied = 0;
+    CHECK(engine.stateAt(11) == string(10, 'a') + "b");
+    CHECK(applied == 0);
+
+    applied = 0;
+    CHECK(engine.stateAt(8) == string(8, 'a'));
+    CHECK(applied == 2);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks checkpoints above the position survive undo & serve
+ *      redone positions, then are discarded by the next execute.
+ *
+ * Undone checkpoints are kept for redo, discarded by execute.
+ */
+void testDiscard() {
+    TimeTravelEngine<string> engine{"", 100, CheckpointPolicy{2, 0}};
+
+    for (int i = 0; i < 8; i++) {
+        execute(engine, 'a', 1);
+    }
+
+    /* 0, 2, 4, 6 & 8 */
+    CHECK(engine.getCheckpointCount() == 5);
+    CHECK(engine.undo(5) == 5);
+    CHECK(engine.getCheckpointCount() == 5);
+    CHECK(engine.stateAt(8) == string(8, 'a'));
+    CHECK(engine.getState() == "aaa");
+
+    CHECK(engine.redo() == 1);
+    CHECK(engine.getState() == "aaaa");
+
+    /* 6 & 8 are discarded, 5 only needs the checkpoint at 4 */
+    execute(engine, 'b', 1);
+    CHECK(engine.getLastPosition() == 5);
+    CHECK(engine.getCheckpointCount() == 3);
+    CHECK(engine.stateAt(5) == "aaaab");
+    CHECK_THROWS(engine.stateAt(6), std::out_of_range);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Returns 0 if every check held, otherwise 1.
+ *
+ * Runs every test.
+ */
+int main() {
+    testRandom(10, CheckpointPolicy{3, 0}, 2000);
+    testRandom(10, CheckpointPolicy{64, 5}, 2000);
+    testRandom(1, CheckpointPolicy{1, 0}, 300);
+    testRandom(50, CheckpointPolicy{7, 4}, 2000);
+    testInterval();
+    testCostBudget();
+    testDiscard();
+
+    return finish();
+}
@@ -0,0 +1,250 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackCapacityTest.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Tests of setCapacity on observed stacks: every index
+ *              observer agrees with the stack once undone actions are
+ *              discarded & applied ones evicted, with no insert after,
+ *              & numbers bulk inserts past capacity as sequential ones.
+ *
+ * List of Functions:
+ *      template<class Observer>
+ *      void shrink(URStack<int, NoStats, Observer>&, int, int)
+ *          Inserts 0 to 5, undoes some, then shrinks the capacity to 3.
+ *
+ *      void testSequenceIndex()
+ *          SequenceIndex counts the undone actions left by setCapacity.
+ *
+ *      void testKeyIndex()
+ *          KeyIndex keeps the applied actions of every key.
+ *
+ *      void testAggregateIndex()
+ *          AggregateIndex keeps the applied & held aggregates.
+ *
+ *      void testBulkSequence()
+ *          SequenceIndex numbers a bulk insert as sequential inserts.
+ *
+ *      int main()
+ *          Runs every test.
+ */
+
+#include "../URStack.cpp"
+#include "../URStackAggregate.h"
+#include "../URStackKeyIndex.h"
+#include "../URStackSequence.h"
+#include "TestHarness.h"
+
+
+/*
+ * Key of the actions of KeyIndex, their parity.
+ */
+struct Parity {
+    int operator()(int action) const {
+        return action % 2;
+    }
+};
+
+/*
+ * Pre-Conditions:
+ *      Reference to an empty stack of capacity 10.
+ *      Number of actions to undo, at most 6.
+ *      Number of applied actions expected once shrunk.
+ *
+ * Post-Conditions:
+ *      0 to 5 are inserted, undone actions undone, then the capacity is
+ *      3: the newest undone actions are discarded until the undone ones
+ *      fit, then the oldest applied ones are evicted.
+ *
+ * Inserts 0 to 5, undoes some, then shrinks the capacity to 3.
+ */
+template<class Observer>
+void shrink(URStack<int, NoStats, Observer>& stack, int undone,
+            int applied) {
+    for (int i = 0; i < 6; i++) {
+        stack.insertNewAction(i);
+    }
+
+    for (int i = 0; i < undone; i++) {
+        stack.undo();
+    }
+
+    CHECK(stack.setCapacity(3) == 3);
+    CHECK(stack.getSize() == applied);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks the undone actions & the states of the sequence numbers
+ *      after setCapacity discards, then after a redo & an insert.
+ *
+ * SequenceIndex counts the undone actions left by setCapacity.
+ */
+void testSequenceIndex() {
+    typedef URStack<int, NoStats, SequenceIndex<int>> Stack;
+
+    /* 4 undone, 5 discarded, 0 & 1 evicted: 2, 3 & 4 left, all undone */
+    {
+        Stack stack{10};
+
+        shrink(stack, 4, 0);
+
+        const SequenceIndex<int>& index = stack.getObserver();
+
+        CHECK(index.getUndone() == 3);
+        CHECK(index.getLength() == 3);
+        CHECK(index.getState(5) == SequenceState::kGone);
+        CHECK(index.getState(1) == SequenceState::kGone);
+
+        CHECK(stack.redo() and *stack.peek() == 2);
+        CHECK(index.getUndone() == 2);
+        CHECK(index.getState(2) == SequenceState::kApplied);
+        CHECK(index.getState(3) == SequenceState::kUndone);
+
+        stack.insertNewAction(6);
+        CHECK(index.getUndone() == 0);
+        CHECK(index.getState(3) == SequenceState::kGone);
+        CHECK(index.getState(6) == SequenceState::kApplied);
+        CHECK(index.getPosition(2) == 1);
+    }
+
+    /* 1 undone, kept: 3 & 4 applied, 5 undone */
+    {
+        Stack stack{10};
+
+        shrink(stack, 1, 2);
+
+        const SequenceIndex<int>& index = stack.getObserver();
+
+        CHECK(index.getUndone() == 1);
+        CHECK(index.getState(5) == SequenceState::kUndone);
+        CHECK(index.getState(4) == SequenceState::kApplied);
+        CHECK(index.getState(2) == SequenceState::kGone);
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks the applied actions of every key after setCapacity
+ *      discards, then after a redo.
+ *
+ * KeyIndex keeps the applied actions of every key.
+ */
+void testKeyIndex() {
+    URStack<int, NoStats, KeyIndex<int, Parity>> stack{10};
+
+    shrink(stack, 4, 0);
+
+    const KeyIndex<int, Parity>& index = stack.getObserver();
+
+    CHECK(index.getKeys() == 2);
+    CHECK(index.count(0) == 0 and index.count(1) == 0);
+
+    CHECK(stack.redo() and *stack.peek() == 2);
+    CHECK(index.count(0) == 1 and index.count(1) == 0);
+    CHECK(index.findLast(0) and *index.findLast(0) == 2);
+
+    CHECK(stack.redo() and *stack.peek() == 3);
+    CHECK(index.findLast(1) and *index.findLast(1) == 3);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks the applied & held aggregates after setCapacity discards,
+ *      then after a redo.
+ *
+ * AggregateIndex keeps the applied & held aggregates.
+ */
+void testAggregateIndex() {
+    URStack<int, NoStats, AggregateIndex<int>> stack{10};
+
+    shrink(stack, 4, 0);
+
+    const AggregateIndex<int>& index = stack.getObserver();
+
+    CHECK(index.getUndone() == 3);
+    CHECK(index.getHeld().sum == 2 + 3 + 4);
+    CHECK(index.getApplied().sum == 0);
+
+    CHECK(stack.redo() and *stack.peek() == 2);
+    CHECK(index.getUndone() == 2);
+    CHECK(index.getApplied().sum == 2);
+    CHECK(index.getCumulative(1) == 2 + 3);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks the sequence numbers of a bulk insert overflowing the
+ *      capacity against those of the same actions inserted one by one.
+ *
+ * SequenceIndex numbers a bulk insert as sequential inserts.
+ * Actions of the range falling off capacity never become Nodes,
+ * yet still take their sequence numbers.
+ */
+void testBulkSequence() {
+    typedef URStack<int, NoStats, SequenceIndex<int>> Stack;
+
+    Stack bulk{3};
+    Stack sequential{3};
+    int actions[] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    bulk.insertNewAction(-1);
+    sequential.insertNewAction(-1);
+    bulk.undo();
+    sequential.undo();
+
+    CHECK(bulk.insertNewActions(std::begin(actions), std::end(actions)) == 8);
+
+    for (int action: actions) {
+        sequential.insertNewAction(action);
+    }
+
+    const SequenceIndex<int>& index = bulk.getObserver();
+    const SequenceIndex<int>& expected = sequential.getObserver();
+
+    CHECK(index.getNextSequence() == expected.getNextSequence());
+    CHECK(index.getLength() == expected.getLength());
+
+    for (std::uint64_t sequence = 0; sequence < expected.getNextSequence();
+         sequence++) {
+        CHECK(index.getState(sequence) == expected.getState(sequence));
+    }
+
+    CHECK(index.getState(8) == SequenceState::kApplied);
+    CHECK(index.getState(3) == SequenceState::kGone);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Returns 0 if every check held, otherwise 1.
+ *
+ * Runs every test.
+ */
+int main() {
+    testSequenceIndex();
+    testKeyIndex();
+    testAggregateIndex();
+    testBulkSequence();
+
+    return finish();
+}
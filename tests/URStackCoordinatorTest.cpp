@@ -0,0 +1,235 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackCoordinatorTest.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Tests of URStackCoordinator<DataType>: rejected attaches &
+ *              logical actions, the rollback of undo & redo when a
+ *              participant was modified elsewhere, & retained logical
+ *              actions never being partially evicted.
+ *
+ * List of Functions:
+ *      void testAttach()
+ *          attach rejects small & repeated participants.
+ *
+ *      void testInsert()
+ *          Invalid logical actions insert nothing.
+ *
+ *      void testRollback()
+ *          undo & redo restore every participant when one fails.
+ *
+ *      void testEviction()
+ *          Retained logical actions are undone whole, after evictions.
+ *
+ *      int main()
+ *          Runs every test.
+ */
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../URStackCoordinator.cpp"
+#include "TestHarness.h"
+
+
+/* Used std utilities */
+using std::vector, std::invalid_argument, std::logic_error;
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks participants smaller than the coordinator, or attached
+ *      twice, are rejected without being attached.
+ *
+ * attach rejects small & repeated participants.
+ */
+void testAttach() {
+    URStackCoordinator<int> coordinator{5};
+    URStack<int> small{4}, equal{5}, large{8};
+
+    CHECK_THROWS(coordinator.attach(small), invalid_argument);
+    CHECK(coordinator.getParticipantCount() == 0);
+
+    CHECK(coordinator.attach(equal) == 0);
+    CHECK(coordinator.attach(large) == 1);
+
+    CHECK_THROWS(coordinator.attach(equal), invalid_argument);
+    CHECK(coordinator.getParticipantCount() == 2);
+    CHECK(&coordinator.getParticipant(1) == &large);
+
+    CHECK_THROWS(URStackCoordinator<int>{0}, invalid_argument);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks empty logical actions, unknown & repeated participants
+ *      are rejected before any participant is touched.
+ *
+ * Invalid logical actions insert nothing.
+ */
+void testInsert() {
+    URStackCoordinator<int> coordinator{3};
+    URStack<int> a{3}, b{3};
+
+    coordinator.attach(a);
+    coordinator.attach(b);
+
+    vector<URStackCoordinator<int>::Entry> none;
+
+    CHECK_THROWS(coordinator.insertNewAction(none.begin(), none.end()),
+                 invalid_argument);
+    CHECK_THROWS(coordinator.insertNewAction({{0, 1}, {2, 1}}),
+                 invalid_argument);
+    CHECK_THROWS(coordinator.insertNewAction({{1, 1}, {0, 1}, {1, 2}}),
+                 invalid_argument);
+    CHECK_THROWS(coordinator.insertNewAction({{-1, 1}}), invalid_argument);
+
+    CHECK(coordinator.getSize() == 0);
+    CHECK(a.getSize() == 0 and b.getSize() == 0);
+
+    /* Participants validated by an earlier insert are accepted again */
+    coordinator.insertNewAction({{0, 1}, {1, 1}});
+    coordinator.insertNewAction({{1, 2}, {0, 2}});
+    CHECK(coordinator.getSize() == 2);
+    CHECK(*a.peek() == 2 and *b.peek() == 2);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks a participant with nothing to undo or redo makes undo &
+ *      redo throw, with every participant & the logical action as they
+ *      were before the call.
+ *
+ * undo & redo restore every participant when one fails.
+ */
+void testRollback() {
+    URStackCoordinator<int> coordinator{4};
+    URStack<int> a{4}, b{4}, c{4};
+
+    coordinator.attach(a);
+    coordinator.attach(b);
+    coordinator.attach(c);
+
+    coordinator.insertNewAction({{0, 1}, {1, 1}, {2, 1}});
+
+    /* c is undone behind the coordinator's back, a & b come first */
+    c.undo();
+
+    CHECK_THROWS(coordinator.undo(), logic_error);
+    CHECK(coordinator.getSize() == 1);
+    CHECK(a.peek() and *a.peek() == 1);
+    CHECK(b.peek() and *b.peek() == 1);
+    CHECK(c.getSize() == 0);
+
+    /* Repaired, the logical action undoes & redoes whole */
+    c.redo();
+    CHECK(coordinator.undo());
+    CHECK(a.getSize() == 0 and b.getSize() == 0 and c.getSize() == 0);
+
+    /* b is redone behind the coordinator's back */
+    b.redo();
+
+    CHECK_THROWS(coordinator.redo(), logic_error);
+    CHECK(coordinator.getSize() == 0);
+    CHECK(a.getSize() == 0 and c.getSize() == 0);
+    CHECK(b.getSize() == 1);
+
+    b.undo();
+    CHECK(coordinator.redo());
+    CHECK(*a.peek() == 1 and *b.peek() == 1 and *c.peek() == 1);
+
+    CHECK(not coordinator.redo());
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks, after more logical actions than the capacity of the
+ *      coordinator, that every retained one is undone on each of its
+ *      participants, which then hold the actions of evicted logical
+ *      actions only.
+ *
+ * Retained logical actions are undone whole, after evictions.
+ */
+void testEviction() {
+    constexpr int kCapacity = 3;
+    constexpr int kActions = 20;
+
+    URStackCoordinator<int> coordinator{kCapacity};
+    URStack<int> tight{kCapacity}, loose{kCapacity + 4};
+
+    coordinator.attach(tight);
+    coordinator.attach(loose);
+
+    /* Logical action i touches tight if i % 3, loose if i % 2 */
+    for (int i = 1; i <= kActions; i++) {
+        vector<URStackCoordinator<int>::Entry> entries;
+
+        if (i % 3) {
+            entries.emplace_back(0, i);
+        }
+
+        if (i % 2 or entries.empty()) {
+            entries.emplace_back(1, i);
+        }
+
+        coordinator.insertNewAction(entries.begin(), entries.end());
+    }
+
+    CHECK(coordinator.getSize() == kCapacity);
+
+    for (int i = kActions; i > kActions - kCapacity; i--) {
+        const bool on_tight = i % 3;
+        const bool on_loose = i % 2 or not on_tight;
+
+        CHECK((not on_tight) or (tight.peek() and *tight.peek() == i));
+        CHECK((not on_loose) or (loose.peek() and *loose.peek() == i));
+        CHECK(coordinator.undo());
+    }
+
+    CHECK(not coordinator.undo());
+
+    /* Whatever is left belongs to evicted logical actions */
+    CHECK(not tight.peek() or *tight.peek() <= kActions - kCapacity);
+    CHECK(not loose.peek() or *loose.peek() <= kActions - kCapacity);
+
+    for (int i = 0; i < kCapacity; i++) {
+        CHECK(coordinator.redo());
+    }
+
+    CHECK(*loose.peek() == kActions - 1 and *tight.peek() == kActions);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Returns 0 if every check held, otherwise 1.
+ *
+ * Runs every test.
+ */
+int main() {
+    testAttach();
+    testInsert();
+    testRollback();
+    testEviction();
+
+    return finish();
+}
@@ -0,0 +1,350 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackRegistryTest.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Tests of URStackRegistry: sessions opened lazily from a
+ *              pack, materialised by get, replaced by create, removed by
+ *              erase & compacted, the save & reopen round trip, & the
+ *              rejection of corrupted pack indices.
+ *
+ * List of Functions:
+ *      void fill(URStack<std::string>&, int)
+ *          Inserts numbered actions into a session.
+ *
+ *      std::string readFile(const std::string&)
+ *          Returns the bytes of a file.
+ *
+ *      void writeFile(const std::string&, const std::string&)
+ *          Replaces the bytes of a file.
+ *
+ *      void testLazyOpen()
+ *          Sessions of a pack are only materialised by get.
+ *
+ *      void testCreateErase()
+ *          create replaces sessions, erase removes them.
+ *
+ *      void testRoundTrip()
+ *          Materialised, untouched & compacted sessions survive a save.
+ *
+ *      void testCorruptIndex()
+ *          Rejection of index entries out of range or repeated.
+ *
+ *      int main()
+ *          Runs every test.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "../URStackRegistry.cpp"
+#include "TestHarness.h"
+
+
+/* Used std utilities */
+using std::string, std::runtime_error;
+
+/*
+ * Pack written by the tests, in the working directory.
+ */
+static const string kPackPath = "URStackRegistryTest.pack";
+
+/*
+ * Pre-Conditions:
+ *      Reference to a session.
+ *      Number of actions.
+ *
+ * Post-Conditions:
+ *      "action 0" to "action N - 1" are inserted, in order.
+ *
+ * Inserts numbered actions into a session.
+ */
+void fill(URStack<string>& stack, int count) {
+    for (int i = 0; i < count; i++) {
+        stack.insertNewAction("action " + std::to_string(i));
+    }
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of a file.
+ *
+ * Post-Conditions:
+ *      Returns every byte of the file.
+ *
+ * Returns the bytes of a file.
+ */
+string readFile(const string& path) {
+    std::ifstream in{path, std::ios::binary};
+
+    return string{std::istreambuf_iterator<char>{in},
+                  std::istreambuf_iterator<char>{}};
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the path of a file.
+ *      const reference to the bytes to write.
+ *
+ * Post-Conditions:
+ *      The file holds the given bytes only.
+ *
+ * Replaces the bytes of a file.
+ */
+void writeFile(const string& path, const string& bytes) {
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks a reopened pack summarises its sessions without
+ *      materialising them, & get materialises them once.
+ *
+ * Sessions of a pack are only materialised by get.
+ */
+void testLazyOpen() {
+    {
+        URStackRegistry<string> registry;
+
+        fill(registry.create("a", 5), 3);
+        fill(registry.create("b", 2), 4);
+        registry.get("b").undo();
+        registry.save(kPackPath);
+    }
+
+    URStackRegistry<string> registry{kPackPath};
+
+    CHECK(registry.getNames().size() == 2);
+    CHECK(registry.contains("a") and not registry.contains("c"));
+    CHECK(not registry.isLoaded("a") and not registry.isLoaded("b"));
+
+    const auto info = registry.getInfo("b");
+
+    CHECK(info.size == 1 and info.capacity == 2);
+    CHECK(not registry.isLoaded("b"));
+
+    URStack<string>& b = registry.get("b");
+
+    CHECK(registry.isLoaded("b") and not registry.isLoaded("a"));
+    CHECK(&registry.get("b") == &b);
+    CHECK(*b.peek() == "action 2");
+    CHECK(b.redo() and *b.peek() == "action 3");
+    CHECK(b.getSize() == 2 and b.getCapacity() == 2);
+
+    CHECK(registry.get("a").getSize() == 3);
+
+    CHECK_THROWS(registry.get("c"), std::out_of_range);
+    CHECK_THROWS(registry.getInfo("c"), std::out_of_range);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks create discards existing sessions, materialised or not,
+ *      & erase keeps the other sessions reachable.
+ *
+ * create replaces sessions, erase removes them.
+ */
+void testCreateErase() {
+    {
+        URStackRegistry<string> registry;
+
+        fill(registry.create("a", 5), 3);
+        fill(registry.create("b", 5), 2);
+        fill(registry.create("c", 5), 1);
+        registry.save(kPackPath);
+    }
+
+    URStackRegistry<string> registry{kPackPath};
+
+    /* Replacing a session never materialised */
+    URStack<string>& a = registry.create("a", 7);
+
+    CHECK(a.getSize() == 0 and a.getCapacity() == 7);
+    CHECK(registry.isLoaded("a"));
+
+    /* Replacing a materialised one */
+    CHECK(registry.get("b").getSize() == 2);
+    CHECK(registry.create("b", 3).getSize() == 0);
+    CHECK(registry.getInfo("b").capacity == 3);
+
+    /* The last slot moves in place of the erased one */
+    CHECK(registry.erase("a"));
+    CHECK(not registry.erase("a"));
+    CHECK(not registry.contains("a"));
+    CHECK(registry.getNames().size() == 2);
+    CHECK(registry.get("c").getSize() == 1);
+    CHECK(*registry.get("c").peek() == "action 0");
+    CHECK(registry.getInfo("b").capacity == 3);
+
+    CHECK(registry.erase("c") and registry.erase("b"));
+    CHECK(registry.getNames().empty());
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks a pack saved over the one it was opened from holds the
+ *      sessions as they were, whether materialised, untouched or
+ *      compacted.
+ *
+ * Materialised, untouched & compacted sessions survive a save.
+ */
+void testRoundTrip() {
+    {
+        URStackRegistry<string> registry;
+
+        fill(registry.create("untouched", 4), 6);
+        fill(registry.create("changed", 4), 2);
+        fill(registry.create("packed", 4), 3);
+        registry.save(kPackPath);
+    }
+
+    {
+        URStackRegistry<string> registry{kPackPath};
+
+        registry.get("changed").undo();
+        registry.get("changed").insertNewAction("new");
+        registry.create("created", 2).insertNewAction("only");
+
+        registry.get("packed").undo();
+
+        CompactionOptions options;
+
+        options.idle = std::chrono::milliseconds{0};
+        options.slice = std::chrono::microseconds{1000000};
+
+        const CompactionReport report = registry.compact(options);
+
+        CHECK(report.sessions == 3);
+        CHECK(registry.isCompacted("packed"));
+        CHECK(not registry.isLoaded("packed"));
+        CHECK(registry.getInfo("packed").size == 2);
+
+        /* Saved over the pack it is mapped from */
+        registry.save(kPackPath);
+    }
+
+    URStackRegistry<string> registry{kPackPath};
+
+    CHECK(registry.getNames().size() == 4);
+    CHECK(registry.get("untouched").getSize() == 4);
+    CHECK(*registry.get("untouched").peek() == "action 5");
+    CHECK(*registry.get("changed").peek() == "new");
+    CHECK(registry.get("changed").getSize() == 2);
+    CHECK(*registry.get("created").peek() == "only");
+    CHECK(registry.get("created").getCapacity() == 2);
+
+    URStack<string>& packed = registry.get("packed");
+
+    CHECK(packed.getSize() == 2 and *packed.peek() == "action 1");
+    CHECK(packed.redo() and *packed.peek() == "action 2");
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks packs whose index has names out of the names section,
+ *      summaries out of range or repeated names are rejected.
+ *
+ * Rejection of index entries out of range or repeated.
+ */
+void testCorruptIndex() {
+    {
+        URStackRegistry<string> registry;
+
+        fill(registry.create("first", 4), 2);
+        fill(registry.create("second", 4), 3);
+        registry.save(kPackPath);
+    }
+
+    const string original = readFile(kPackPath);
+
+    const auto corrupt = [&](auto change) {
+        string bytes = original;
+        auto *entries = reinterpret_cast<PackIndexEntry*>(
+                bytes.data() + sizeof(PackHeader));
+
+        change(entries[0], entries[1]);
+        writeFile(kPackPath, bytes);
+
+        return URStackRegistry<string>{kPackPath};
+    };
+
+    CHECK(corrupt([](PackIndexEntry&, PackIndexEntry&) {}).contains("second"));
+
+    /* A name whose end wraps around past the names section */
+    CHECK_THROWS(corrupt([](PackIndexEntry& entry, PackIndexEntry&) {
+        entry.name_offset = std::numeric_limits<std::uint64_t>::max()
+                            - (std::uint64_t{1} << 30) + 1;
+        entry.name_length = (std::uint64_t{1} << 30) + 3;
+    }), runtime_error);
+
+    CHECK_THROWS(corrupt([](PackIndexEntry& entry, PackIndexEntry&) {
+        entry.name_length = 1 << 20;
+    }), runtime_error);
+
+    /* Summaries getInfo could not return */
+    CHECK_THROWS(corrupt([](PackIndexEntry& entry, PackIndexEntry&) {
+        entry.capacity = (std::int64_t{1} << 32) + 3;
+    }), runtime_error);
+
+    CHECK_THROWS(corrupt([](PackIndexEntry& entry, PackIndexEntry&) {
+        entry.capacity = 0;
+    }), runtime_error);
+
+    CHECK_THROWS(corrupt([](PackIndexEntry& entry, PackIndexEntry&) {
+        entry.size = 5;
+    }), runtime_error);
+
+    CHECK_THROWS(corrupt([](PackIndexEntry& entry, PackIndexEntry&) {
+        entry.size = -1;
+    }), runtime_error);
+
+    /* Both entries naming the same session */
+    CHECK_THROWS(corrupt([](PackIndexEntry& first, PackIndexEntry& second) {
+        second.name_offset = first.name_offset;
+        second.name_length = first.name_length;
+    }), runtime_error);
+
+    std::remove(kPackPath.c_str());
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Returns 0 if every check held, otherwise 1.
+ *
+ * Runs every test.
+ */
+int main() {
+    testLazyOpen();
+    testCreateErase();
+    testRoundTrip();
+    testCorruptIndex();
+
+    return finish();
+}
@@ -0,0 +1,312 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackServerTest.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Tests of URStackServer: the responses of every request,
+ *              escaping in list, ERR replies, a corrupted session failing
+ *              its own requests only, & pipelined requests over the socket,
+ *              past the limit of the pending responses.
+ *
+ * List of Functions:
+ *      std::string request(URStackServer&, const std::string&)
+ *          Returns the response of a single request.
+ *
+ *      std::string converse(const std::string&, const std::string&)
+ *          Sends requests to a running server, returns every response.
+ *
+ *      void testRequests()
+ *          Responses of every command, valid or not.
+ *
+ *      void testCorruptSession()
+ *          A corrupted session fails its requests, the others are served
+ *          & saved.
+ *
+ *      void testPipelining()
+ *          Pipelined requests over the socket, drained after EOF.
+ *
+ *      int main()
+ *          Runs every test.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../URStackRegistry.cpp"
+#include "../URStackServer.h"
+#include "TestHarness.h"
+
+
+/* Used std utilities */
+using std::string;
+
+/*
+ * Socket of the servers of the tests, in the working directory.
+ */
+static const string kSocketPath = "URStackServerTest.sock";
+
+/*
+ * Pre-Conditions:
+ *      Reference to a server.
+ *      const reference to a request line, without its new line.
+ *
+ * Post-Conditions:
+ *      Returns the response line, new line included.
+ *
+ * Returns the response of a single request.
+ */
+string request(URStackServer& server, const string& line) {
+    string out;
+
+    server.handle(line, out);
+
+    return out;
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to the socket path of a running server.
+ *      const reference to request lines, each ending with a new line.
+ *
+ * Post-Conditions:
+ *      Every request is sent at once, the writing side is shut down,
+ *      then every response is read until the server closes.
+ *      Returns the responses, or an empty string if connecting failed.
+ *
+ * Sends requests to a running server, returns every response.
+ * Nothing is read before every request is sent, so the responses pile
+ * up on the server as they would for a slow client.
+ */
+string converse(const string& path, const string& requests) {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    string responses;
+
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    if (fd < 0 or ::connect(fd, reinterpret_cast<sockaddr*>(&address),
+                            sizeof(address))) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+
+        return responses;
+    }
+
+    for (std::size_t sent = 0; sent < requests.size();) {
+        const ssize_t count = ::write(fd, requests.data() + sent,
+                                      requests.size() - sent);
+
+        if (count <= 0) {
+            break;
+        }
+
+        sent += static_cast<std::size_t>(count);
+    }
+
+    ::shutdown(fd, SHUT_WR);
+
+    char buffer[1 << 16];
+    ssize_t count;
+
+    while ((count = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        responses.append(buffer, static_cast<std::size_t>(count));
+    }
+
+    ::close(fd);
+
+    return responses;
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks the response of every command, of malformed requests,
+ *      & the escaping of tabs & backslashes by list.
+ *
+ * Responses of every command, valid or not.
+ */
+void testRequests() {
+    URStackRegistry<string> registry;
+    URStackServer server{kSocketPath, registry, 5};
+
+    CHECK(request(server, "create a 3") == "OK\n");
+    CHECK(request(server, "insert a one") == "OK\n");
+    CHECK(request(server, "insert a two\tparts") == "OK\n");
+    CHECK(request(server, "insert a back\\slash") == "OK\n");
+    CHECK(request(server, "insert a with spaces") == "OK\n");
+
+    /* Capacity 3, one was evicted */
+    CHECK(request(server, "list a")
+          == "OK 3 3\twith spaces\tback\\\\slash\ttwo\\tparts\n");
+
+    CHECK(request(server, "undo a") == "OK with spaces\n");
+    CHECK(request(server, "redo a") == "OK with spaces\n");
+    CHECK(request(server, "redo a") == "NONE\n");
+
+    /* insert creates missing sessions with the server's capacity */
+    CHECK(request(server, "insert b x") == "OK\n");
+    CHECK(request(server, "list b") == "OK 1 5\tx\n");
+
+    /* create replaces an existing session */
+    CHECK(request(server, "create b") == "OK\n");
+    CHECK(request(server, "list b") == "OK 0 5\n");
+    CHECK(request(server, "undo b") == "NONE\n");
+
+    CHECK(request(server, "list") == "ERR Missing session\n");
+    CHECK(request(server, "insert a") == "ERR Missing action\n");
+    CHECK(request(server, "undo missing") == "ERR Unknown session\n");
+    CHECK(request(server, "list missing") == "ERR Unknown session\n");
+    CHECK(request(server, "create c x") == "ERR Invalid capacity\n");
+    CHECK(request(server, "create c 0") == "ERR Invalid capacity\n");
+    CHECK(request(server, "drop a") == "ERR Unknown command\n");
+    CHECK(not registry.contains("c"));
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks requests to a session whose snapshot is corrupted are
+ *      answered with ERR, while the other sessions are served,
+ *      & every session survives a save.
+ *
+ * A corrupted session fails its requests, the others are served & saved.
+ */
+void testCorruptSession() {
+    const string path = "URStackServerTest.pack";
+    const string saved = "URStackServerTest.saved.pack";
+
+    {
+        URStackRegistry<string> registry;
+
+        registry.create("bad", 4).insertNewAction("lost");
+        registry.create("good", 4).insertNewAction("kept");
+        registry.save(path);
+    }
+
+    /* Overwrite the magic of the snapshot of bad */
+    {
+        std::fstream file{path, std::ios::in | std::ios::out
+                                | std::ios::binary};
+        PackHeader header{};
+        PackIndexEntry entries[2];
+
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        file.read(reinterpret_cast<char*>(entries), sizeof(entries));
+
+        for (const PackIndexEntry& entry: entries) {
+            string name(entry.name_length, '\0');
+
+            file.seekg(static_cast<std::streamoff>(header.names_offset
+                                                   + entry.name_offset));
+            file.read(name.data(), static_cast<std::streamsize>(name.size()));
+
+            if (name == "bad") {
+                file.seekp(static_cast<std::streamoff>(entry.snapshot_offset));
+                file.write("XXXXXXXX", 8);
+            }
+        }
+    }
+
+    {
+        URStackRegistry<string> registry{path};
+        URStackServer server{kSocketPath, registry};
+
+        CHECK(request(server, "list bad")
+              == "ERR Not a URStack snapshot\n");
+        CHECK(request(server, "insert bad x")
+              == "ERR Not a URStack snapshot\n");
+        CHECK(request(server, "insert good z") == "OK\n");
+        CHECK(request(server, "create fresh") == "OK\n");
+        CHECK(request(server, "insert fresh hello") == "OK\n");
+        CHECK(request(server, "list good") == "OK 2 4\tz\tkept\n");
+
+        /* The response of a batch keeps what the failed request preceded */
+        string out = "OK\n";
+
+        server.handle("undo bad", out);
+        CHECK(out == "OK\nERR Not a URStack snapshot\n");
+
+        registry.save(saved);
+    }
+
+    URStackRegistry<string> reopened{saved};
+
+    CHECK(reopened.contains("bad"));
+    CHECK(reopened.get("good").getSize() == 2);
+    CHECK(*reopened.get("fresh").peek() == "hello");
+    CHECK_THROWS(reopened.get("bad"), std::runtime_error);
+
+    std::remove(path.c_str());
+    std::remove(saved.c_str());
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks pipelined requests are answered in order, every one of
+ *      them after the client shuts down its writing side, even once the
+ *      responses exceed the limit of those pending.
+ *
+ * Pipelined requests over the socket, drained after EOF.
+ */
+void testPipelining() {
+    URStackRegistry<string> registry;
+    URStackServer server{kSocketPath, registry};
+    std::thread loop{[&server] { server.run(); }};
+
+    CHECK(converse(kSocketPath, "insert p a\ninsert p b\nlist p\n"
+                                "undo p\nundo p\nundo p\nlist p\n")
+          == "OK\nOK\nOK 2 20\tb\ta\nOK b\nOK a\nNONE\nOK 0 20\n");
+
+    /* 16 responses of 512 KiB, twice the limit of pending responses */
+    const string action(1 << 19, 'x');
+    string requests = "insert big " + action + "\n";
+    string expected = "OK\n";
+
+    for (int i = 0; i < 16; i++) {
+        requests += "list big\n";
+        expected += "OK 1 20\t" + action + "\n";
+    }
+
+    CHECK(converse(kSocketPath, requests) == expected);
+
+    server.stop();
+    loop.join();
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Returns 0 if every check held, otherwise 1.
+ *
+ * Runs every test.
+ */
+int main() {
+    testRequests();
+    testCorruptSession();
+    testPipelining();
+
+    return finish();
+}
@@ -0,0 +1,358 @@
+/*
+ * URStack Project
+ *
+ *
+ * URStackSnapshotTest.cpp
+ *
+ * Date:        18/10/2026
+ *
+ * Author:      Mahmoud Yaman Seraj Alddin
+ *
+ * Purpose:     Tests of the snapshot format: stacks survive a save & load
+ *              unchanged, & snapshots describing a stack URStack cannot
+ *              hold are rejected before a single Node is built.
+ *
+ * List of Functions:
+ *      template<class DataType>
+ *      std::string describe(URStack<DataType>&)
+ *          Returns every display of a stack, to compare stacks.
+ *
+ *      template<class DataType>
+ *      std::vector<Block> encode(const URStack<DataType>&)
+ *          Returns the snapshot of a stack, in aligned memory.
+ *
+ *      template<class DataType>
+ *      void checkRoundTrip(URStack<DataType>&)
+ *          Checks a stack is unchanged by a save & load.
+ *
+ *      void testRoundTrips()
+ *          Round trips of empty, partly & fully undone stacks.
+ *
+ *      void testCorruptHeaders()
+ *          Rejection of headers disagreeing on size, current & length,
+ *          or out of range.
+ *
+ *      void testCorruptOffsets()
+ *          Rejection of out of order & out of bounds offset tables.
+ *
+ *      int main()
+ *          Runs every test.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../URStack.cpp"
+#include "TestHarness.h"
+
+
+/* Used std utilities */
+using std::string, std::vector, std::runtime_error;
+
+/*
+ * Unit of the aligned memory snapshots are loaded from.
+ */
+struct alignas(kSnapshotAlignment) Block {
+    char bytes[kSnapshotAlignment];
+};
+
+/*
+ * Pre-Conditions:
+ *      Reference to a stack.
+ *
+ * Post-Conditions:
+ *      Returns the size, the capacity & the output of every display
+ *      function, without colours.
+ *
+ * Returns every display of a stack, to compare stacks.
+ */
+template<class DataType>
+string describe(URStack<DataType>& stack) {
+    std::ostringstream out;
+
+    {
+        OutputSink sink{out, false};
+
+        stack.displayAll(sink) << '|';
+        stack.displayPrevious(sink) << '|';
+        stack.displayNext(sink) << '|';
+    }
+
+    out << stack.getSize() << '/' << stack.getCapacity();
+
+    return out.str();
+}
+
+/*
+ * Pre-Conditions:
+ *      const reference to a stack.
+ *
+ * Post-Conditions:
+ *      Returns the snapshot of the stack, in 64-byte aligned blocks.
+ *
+ * Returns the snapshot of a stack, in aligned memory.
+ */
+template<class DataType>
+vector<Block> encode(const URStack<DataType>& stack) {
+    std::ostringstream out;
+
+    stack.save(out);
+
+    const string bytes = out.str();
+    vector<Block> blocks(bytes.size() / sizeof(Block));
+
+    std::memcpy(blocks.data(), bytes.data(), bytes.size());
+
+    return blocks;
+}
+
+/*
+ * Pre-Conditions:
+ *      Reference to a stack.
+ *
+ * Post-Conditions:
+ *      Checks the loaded stack displays the same as the saved one,
+ *      then undoes & redoes the same actions.
+ *
+ * Checks a stack is unchanged by a save & load.
+ */
+template<class DataType>
+void checkRoundTrip(URStack<DataType>& stack) {
+    const vector<Block> blocks = encode(stack);
+    const URStackSnapshot<DataType> snapshot{
+            reinterpret_cast<const char*>(blocks.data()),
+            blocks.size() * sizeof(Block)};
+    URStack<DataType> loaded{snapshot};
+
+    CHECK(describe(loaded) == describe(stack));
+
+    /* Walks every Node both ways, on both stacks */
+    for (int i = 0; i <= stack.getCapacity(); i++) {
+        const DataType *expected = stack.undo();
+        const DataType *actual = loaded.undo();
+
+        CHECK((expected == nullptr) == (actual == nullptr));
+        CHECK(not expected or *expected == *actual);
+    }
+
+    for (int i = 0; i <= stack.getCapacity(); i++) {
+        const DataType *expected = stack.redo();
+        const DataType *actual = loaded.redo();
+
+        CHECK((expected == nullptr) == (actual == nullptr));
+        CHECK(not expected or *expected == *actual);
+    }
+
+    CHECK(describe(loaded) == describe(stack));
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks the round trip of empty, full, partly & fully undone
+ *      stacks, of both encodings.
+ *
+ * Round trips of empty, partly & fully undone stacks.
+ */
+void testRoundTrips() {
+    for (int undone = 0; undone <= 6; undone++) {
+        URStack<int> numbers{5};
+        URStack<string> texts{5};
+
+        /* 6 inserts into 5 slots, the first one is evicted */
+        for (int i = 0; i < 6; i++) {
+            numbers.insertNewAction(i);
+            texts.insertNewAction(string(static_cast<size_t>(i) * 7, 'a')
+                                  + std::to_string(i));
+        }
+
+        for (int i = 0; i < undone; i++) {
+            numbers.undo();
+            texts.undo();
+        }
+
+        checkRoundTrip(numbers);
+        checkRoundTrip(texts);
+    }
+
+    URStack<int> empty{3};
+    URStack<string> empty_texts{3};
+
+    checkRoundTrip(empty);
+    checkRoundTrip(empty_texts);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks snapshots whose size, current & length disagree
+ *      are rejected.
+ *
+ * Rejection of headers disagreeing on size, current & length.
+ */
+void testCorruptHeaders() {
+    URStack<int> stack{10};
+
+    /* 5 actions, 2 of them undone: current 2 hops from top, size 3 */
+    for (int i = 0; i < 5; i++) {
+        stack.insertNewAction(i);
+    }
+
+    stack.undo();
+    stack.undo();
+
+    const vector<Block> original = encode(stack);
+
+    const auto load = [](const vector<Block>& blocks) {
+        return URStackSnapshot<int>{
+                reinterpret_cast<const char*>(blocks.data()),
+                blocks.size() * sizeof(Block)};
+    };
+
+    const auto corrupt = [&](auto change) {
+        vector<Block> blocks = original;
+
+        change(*reinterpret_cast<SnapshotHeader*>(blocks.data()));
+
+        return blocks;
+    };
+
+    CHECK(load(original).getSize() == 3);
+
+    /* More applied actions than Nodes after current */
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.size = 5;
+    })), runtime_error);
+
+    /* Applied actions not reaching the oldest one */
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.size = 2;
+    })), runtime_error);
+
+    /* Empty stacks keep current on the oldest action */
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.size = 0;
+    })), runtime_error);
+
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.current = 5;
+    })), runtime_error);
+
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.length = 0;
+    })), runtime_error);
+
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.capacity = 4;
+    })), runtime_error);
+
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.magic[0] = 'X';
+    })), runtime_error);
+
+    /* Capacities past an int would be truncated to 3 */
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.capacity = (std::int64_t{1} << 32) + 3;
+    })), runtime_error);
+
+    /* A length whose payload size wraps around to 0 */
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.length = std::uint64_t{1} << 61;
+        header.current = header.length - 3;
+        header.capacity = (std::int64_t{1} << 62) + 3;
+    })), runtime_error);
+
+    /* A length within capacity, past the payload */
+    CHECK_THROWS(load(corrupt([](SnapshotHeader& header) {
+        header.capacity = std::numeric_limits<int>::max();
+        header.length = static_cast<std::uint64_t>(header.capacity);
+        header.current = header.length - 3;
+    })), runtime_error);
+
+    /* A fully undone stack is valid, current on its oldest action */
+    const vector<Block> undone = corrupt([](SnapshotHeader& header) {
+        header.size = 0;
+        header.current = 4;
+    });
+
+    URStack<int> loaded{load(undone)};
+
+    CHECK(loaded.getSize() == 0);
+    CHECK(loaded.undo() == nullptr);
+    CHECK(loaded.redo() and *loaded.peek() == 0);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Checks kBytes snapshots with a corrupted offset table
+ *      are rejected.
+ *
+ * Rejection of out of order & out of bounds offset tables.
+ */
+void testCorruptOffsets() {
+    URStack<string> stack{10};
+
+    for (int i = 0; i < 4; i++) {
+        stack.insertNewAction("action " + std::to_string(i));
+    }
+
+    const vector<Block> original = encode(stack);
+
+    const auto load = [](const vector<Block>& blocks) {
+        return URStackSnapshot<string>{
+                reinterpret_cast<const char*>(blocks.data()),
+                blocks.size() * sizeof(Block)};
+    };
+
+    /* Offsets follow the header, length + 1 of them */
+    const auto corrupt = [&](std::size_t index, std::uint64_t offset) {
+        vector<Block> blocks = original;
+        auto *offsets = reinterpret_cast<std::uint64_t*>(blocks.data() + 1);
+
+        offsets[index] = offset;
+
+        return blocks;
+    };
+
+    CHECK(load(original).decode(0) == "action 3");
+
+    CHECK_THROWS(load(corrupt(0, 1)), runtime_error);
+
+    /* Decreasing, the second value would have a negative length */
+    CHECK_THROWS(load(corrupt(2, 1)), runtime_error);
+
+    /* Past the payload, & wrapping around once added to the table */
+    CHECK_THROWS(load(corrupt(4, 1 << 20)), runtime_error);
+    CHECK_THROWS(load(corrupt(
+            4, std::numeric_limits<std::uint64_t>::max() - 8)),
+            runtime_error);
+}
+
+/*
+ * Pre-Conditions:
+ *      No preconditions.
+ *
+ * Post-Conditions:
+ *      Returns 0 if every check held, otherwise 1.
+ *
+ * Runs every test.
+ */
+int main() {
+    testRoundTrips();
+    testCorruptHeaders();
+    testCorruptOffsets();
+
+    return finish();
+}